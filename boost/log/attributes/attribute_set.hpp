@@ -131,10 +131,52 @@ private:
         public node_base
     {
         value_type m_Value;
+        //! The flag indicates that the node is owned by a scoped attribute guard rather than the container
+        bool m_fExternal;
 
         node(key_type const& key, mapped_type const& data);
     };
 
+public:
+    /*!
+     * \brief A container node owned by a scoped attribute guard
+     *
+     * The node can be linked into the container and unlinked from it without memory allocation.
+     * The container never destroys such nodes, it only unlinks them when the element is erased.
+     * The node may be accompanied with a function that returns an attribute equivalent to the one in the node,
+     * but not referring to the node owner. The function is used when the container is copied, and the presence
+     * of such nodes in the container indicates that log records have to be detached from the node owner.
+     */
+    class external_node :
+        public node
+    {
+        friend struct implementation;
+
+    public:
+        //! The type of the function that returns an attribute that does not refer to the node owner
+        typedef attribute (*detach_function)(external_node const&);
+
+    private:
+        //! The function that returns an attribute that does not refer to the node owner, or \c NULL
+        const detach_function m_pDetach;
+
+    public:
+        //! Constructor. The node is not linked into any container.
+        BOOST_LOG_API external_node(key_type const& key, mapped_type const& data, detach_function detach = NULL);
+        //! Copying constructor. The node is not linked into any container.
+        BOOST_LOG_API external_node(external_node const& that);
+
+        //! Returns the attribute name
+        key_type const& name() const BOOST_NOEXCEPT { return this->m_Value.first; }
+        //! Returns the attribute
+        mapped_type const& value() const BOOST_NOEXCEPT { return this->m_Value.second; }
+        //! Returns \c true if the node is linked into a container
+        bool is_linked() const BOOST_NOEXCEPT { return this->m_pNext != NULL; }
+
+        BOOST_LOG_DELETED_FUNCTION(external_node& operator= (external_node const&))
+    };
+
+private:
     //! Iterator class
 #ifndef BOOST_LOG_NO_MEMBER_TEMPLATE_FRIENDS
     template< bool fConstV > class iter;
@@ -456,6 +498,29 @@ public:
      * \post <tt>empty() == true</tt>
      */
     BOOST_LOG_API void clear() BOOST_NOEXCEPT;
+
+#ifndef BOOST_LOG_DOXYGEN_PASS
+    /*!
+     * The method links the node owned by a scoped attribute guard into the container.
+     * For internal use by scoped attributes.
+     *
+     * \pre The node is not linked into any container.
+     * \returns A pair of values. If second is true, the node was linked and the first component points to it.
+     *          Otherwise the first component points to the element that prevents insertion.
+     */
+    BOOST_LOG_API std::pair< iterator, bool > insert_external(external_node& n);
+    /*!
+     * The method unlinks the node owned by a scoped attribute guard from the container. Does nothing if the node
+     * has already been unlinked (e.g. if the element was erased or the container was cleared). For internal use by scoped attributes.
+     */
+    BOOST_LOG_API void erase_external(external_node& n) BOOST_NOEXCEPT;
+    /*!
+     * \returns \c true if the container has nodes whose attributes refer to the storage of scoped attribute guards.
+     *          The log records that include values of such attributes must be detached from the guards
+     *          before they leave the scope.
+     */
+    BOOST_LOG_API bool has_scoped_values() const BOOST_NOEXCEPT;
+#endif // BOOST_LOG_DOXYGEN_PASS
 };
 
 /*!
@@ -0,0 +1,246 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   call_site.hpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * The header contains implementation of the call site attribute.
+ */
+
+#ifndef BOOST_LOG_ATTRIBUTES_CALL_SITE_HPP_INCLUDED_
+#define BOOST_LOG_ATTRIBUTES_CALL_SITE_HPP_INCLUDED_
+
+#include <cstddef>
+#include <ostream>
+#include <boost/cstdint.hpp>
+#include <boost/atomic/atomic.hpp>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/attributes/attribute.hpp>
+#include <boost/log/attributes/attribute_cast.hpp>
+#include <boost/log/attributes/attribute_value.hpp>
+#include <boost/log/attributes/attribute_value_impl.hpp>
+#include <boost/log/detail/header.hpp>
+
+#ifdef BOOST_LOG_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+/*!
+ * \brief The class identifies a place in the source code where log records are made
+ *
+ * Call sites are captured by the logging macros. Two call sites are equivalent if they refer
+ * to the same line and the same file name string literal. Note that the same file name may be
+ * represented with different string literals in different translation units, in which case
+ * call sites in a header are distinguished by the translation unit they are compiled in.
+ */
+class call_site
+{
+private:
+    //! Source file name
+    const char* m_FileName;
+    //! Line number
+    unsigned int m_Line;
+
+public:
+    /*!
+     * Default constructor. Creates an empty call site.
+     */
+    call_site() BOOST_NOEXCEPT : m_FileName(NULL), m_Line(0u)
+    {
+    }
+    /*!
+     * Initializing constructor
+     *
+     * \param file_name Source file name. Must be a string with static storage duration, such as \c __FILE__.
+     * \param line Line number
+     */
+    call_site(const char* file_name, unsigned int line) BOOST_NOEXCEPT : m_FileName(file_name), m_Line(line)
+    {
+    }
+
+    //! Returns the source file name or \c NULL if the call site is empty
+    const char* file_name() const BOOST_NOEXCEPT { return m_FileName; }
+    //! Returns the line number
+    unsigned int line() const BOOST_NOEXCEPT { return m_Line; }
+
+    //! Equality comparison
+    bool operator== (call_site const& that) const BOOST_NOEXCEPT
+    {
+        return m_FileName == that.m_FileName && m_Line == that.m_Line;
+    }
+    //! Inequality comparison
+    bool operator!= (call_site const& that) const BOOST_NOEXCEPT
+    {
+        return !operator== (that);
+    }
+    //! Ordering operator
+    bool operator< (call_site const& that) const BOOST_NOEXCEPT
+    {
+        return m_FileName < that.m_FileName || (m_FileName == that.m_FileName && m_Line < that.m_Line);
+    }
+
+    //! Hashing function
+    friend std::size_t hash_value(call_site const& site) BOOST_NOEXCEPT
+    {
+        return (reinterpret_cast< std::size_t >(site.m_FileName) >> 3u) ^ (static_cast< std::size_t >(site.m_Line) * 2654435761u);
+    }
+};
+
+//! Outputs the call site in form "file:line"
+template< typename CharT, typename TraitsT >
+inline std::basic_ostream< CharT, TraitsT >& operator<< (std::basic_ostream< CharT, TraitsT >& strm, call_site const& site)
+{
+    if (site.file_name())
+        strm << site.file_name() << ':' << site.line();
+    return strm;
+}
+
+namespace aux {
+
+//! Thread-specific state of call site tracking
+struct call_site_context
+{
+    //! The call site of the log record being opened, if any
+    call_site const* m_pCurrent;
+    //! Indicates that the log record being opened reports suppressed log records
+    bool m_fSummary;
+    //! The file name of the call site at which the log records were suppressed by filters
+    const char* m_pSuppressedFileName;
+    //! The line number of the call site at which the log records were suppressed by filters
+    unsigned int m_SuppressedLine;
+    //! The number of suppressed log records to be reported
+    uintmax_t m_SuppressedCount;
+};
+
+//! The function returns the call site tracking state of the current thread
+BOOST_LOG_API call_site_context& get_call_site_context();
+
+/*!
+ * The flag indicates that the logging macros track call sites. The flag is set when the first call site attribute
+ * or call site limiter is created, until then the logging macros do not access the thread-specific call site context.
+ */
+extern BOOST_LOG_API boost::atomic< bool > call_site_tracking_enabled;
+
+//! The function enables call site tracking in the logging macros
+inline void enable_call_site_tracking() BOOST_NOEXCEPT
+{
+    if (!call_site_tracking_enabled.load(boost::memory_order_relaxed))
+        call_site_tracking_enabled.store(true, boost::memory_order_relaxed);
+}
+
+//! The function returns \c true if the logging macros track call sites
+inline bool is_call_site_tracking_enabled() BOOST_NOEXCEPT
+{
+    return call_site_tracking_enabled.load(boost::memory_order_relaxed);
+}
+
+//! The class makes the call site current while a log record is being opened
+class call_site_sentry
+{
+private:
+    call_site_context& m_Context;
+    call_site const* const m_pPrevious;
+    const bool m_fPreviousSummary;
+
+public:
+    explicit call_site_sentry(call_site const& site, bool summary = false) :
+        m_Context(get_call_site_context()),
+        m_pPrevious(m_Context.m_pCurrent),
+        m_fPreviousSummary(m_Context.m_fSummary)
+    {
+        m_Context.m_pCurrent = &site;
+        m_Context.m_fSummary = summary;
+    }
+    ~call_site_sentry()
+    {
+        m_Context.m_pCurrent = m_pPrevious;
+        m_Context.m_fSummary = m_fPreviousSummary;
+    }
+
+    call_site_context& context() const BOOST_NOEXCEPT { return m_Context; }
+
+    BOOST_LOG_DELETED_FUNCTION(call_site_sentry(call_site_sentry const&))
+    BOOST_LOG_DELETED_FUNCTION(call_site_sentry& operator= (call_site_sentry const&))
+};
+
+} // namespace aux
+
+namespace attributes {
+
+/*!
+ * \brief A class of an attribute that returns the call site of the log record
+ *
+ * The attribute value is the call site captured by the logging macro that makes the log record.
+ * If the log record is made without a logging macro, the attribute does not produce a value.
+ *
+ * \note This attribute can be registered globally, it will still return the correct
+ *       call site, no matter which thread emits the log record.
+ *
+ * \note The logging macros only start tracking call sites when the first call site attribute is created.
+ *       Log records that are being made by other threads at that moment may not have the call site value.
+ */
+class current_call_site :
+    public attribute
+{
+public:
+    //! A held attribute value type
+    typedef call_site value_type;
+
+protected:
+    //! Factory implementation
+    class BOOST_LOG_VISIBLE impl :
+        public attribute::impl
+    {
+    public:
+        impl()
+        {
+            boost::log::aux::enable_call_site_tracking();
+        }
+
+        attribute_value get_value()
+        {
+            call_site const* site = boost::log::aux::get_call_site_context().m_pCurrent;
+            if (site)
+                return attribute_value(new attribute_value_impl< value_type >(*site));
+            else
+                return attribute_value();
+        }
+    };
+
+public:
+    /*!
+     * Default constructor
+     */
+    current_call_site() : attribute(new impl())
+    {
+    }
+    /*!
+     * Constructor for casting support
+     */
+    explicit current_call_site(cast_source const& source) :
+        attribute(source.as< impl >())
+    {
+    }
+};
+
+} // namespace attributes
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+//! The macro expands to the call site at the point of expansion
+#define BOOST_LOG_CURRENT_CALL_SITE() ::boost::log::call_site(__FILE__, __LINE__)
+
+#endif // BOOST_LOG_ATTRIBUTES_CALL_SITE_HPP_INCLUDED_
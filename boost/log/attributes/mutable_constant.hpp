@@ -27,6 +27,9 @@
 #include <boost/log/attributes/attribute.hpp>
 #include <boost/log/attributes/attribute_cast.hpp>
 #include <boost/log/attributes/attribute_value_impl.hpp>
+#if !defined(BOOST_LOG_NO_THREADS)
+#include <boost/log/detail/atomic_intrusive_ptr.hpp>
+#endif
 #include <boost/log/detail/header.hpp>
 
 #ifdef BOOST_LOG_HAS_PRAGMA_ONCE
@@ -39,6 +42,15 @@ BOOST_LOG_OPEN_NAMESPACE
 
 namespace attributes {
 
+/*!
+ * \brief Synchronization tag for the \c mutable_constant attribute
+ *
+ * When specified as the mutex type of the \c mutable_constant attribute, the tag makes the attribute
+ * replace the stored value atomically, without locking. Readers acquire the current value without
+ * locking as well and are never blocked by concurrent updates.
+ */
+struct lock_free_update {};
+
 /*!
  * \brief A class of an attribute that holds a single constant value with ability to change it
  *
@@ -51,7 +63,8 @@ namespace attributes {
  * the lock types are automatically deduced based on the mutex type.
  *
  * The implementation may avoid using these types to actually create and use the mutex, if a more efficient synchronization method is
- * available (such as atomic operations on the value type). By default no synchronization is done.
+ * available (such as atomic operations on the value type). By default no synchronization is done. If \c lock_free_update
+ * is specified as the mutex type, the value is updated and acquired without locking.
  */
 #ifdef BOOST_LOG_DOXYGEN_PASS
 template< typename T, typename MutexT = void, typename ScopedWriteLockT = auto, typename ScopedReadLockT = auto >
@@ -322,6 +335,187 @@ protected:
     }
 };
 
+#if !defined(BOOST_LOG_NO_THREADS)
+
+/*!
+ * \brief Specialization for lock-free updates
+ *
+ * This version of attribute atomically replaces the stored value on modification. The values are immutable,
+ * so the attribute values that were acquired before the modification are not affected by it. Acquiring
+ * the value does not involve locking and is not blocked by concurrent modifications.
+ */
+template< typename T >
+class mutable_constant< T, lock_free_update, void, void > :
+    public attribute
+{
+public:
+    //! The attribute value type
+    typedef T value_type;
+
+protected:
+    //! Factory implementation
+    class BOOST_LOG_VISIBLE impl :
+        public attribute::impl
+    {
+    private:
+        //! Attribute value wrapper
+        typedef attribute_value_impl< value_type > attr_value;
+
+    private:
+        //! Pointer to the actual attribute value
+        boost::log::aux::atomic_intrusive_ptr< attr_value > m_Value;
+
+    public:
+        /*!
+         * Initializing constructor
+         */
+        explicit impl(value_type const& value) : m_Value(new attr_value(value))
+        {
+        }
+        /*!
+         * Initializing constructor
+         */
+        explicit impl(BOOST_RV_REF(value_type) value) : m_Value(new attr_value(boost::move(value)))
+        {
+        }
+
+        attribute_value get_value()
+        {
+            return attribute_value(m_Value.load());
+        }
+
+        attribute_value set(value_type const& value)
+        {
+            intrusive_ptr< attr_value > p = new attr_value(value);
+            m_Value.store(p);
+            return attribute_value(p);
+        }
+        attribute_value set(BOOST_RV_REF(value_type) value)
+        {
+            intrusive_ptr< attr_value > p = new attr_value(boost::move(value));
+            m_Value.store(p);
+            return attribute_value(p);
+        }
+        attribute_value update(value_type const& value)
+        {
+            // Leave the current value if it is equal to the new one, which avoids serializing with other writers
+            intrusive_ptr< attr_value > p = m_Value.load();
+            if (!(p->get() == value))
+            {
+                p = new attr_value(value);
+                m_Value.store(p);
+            }
+            return attribute_value(p);
+        }
+
+        value_type get() const
+        {
+            return m_Value.load()->get();
+        }
+    };
+
+public:
+    /*!
+     * Constructor with the stored value initialization
+     */
+    explicit mutable_constant(value_type const& value) : attribute(new impl(value))
+    {
+    }
+    /*!
+     * Constructor with the stored value initialization
+     */
+    explicit mutable_constant(BOOST_RV_REF(value_type) value) : attribute(new impl(boost::move(value)))
+    {
+    }
+    /*!
+     * Constructor for casting support
+     */
+    explicit mutable_constant(cast_source const& source) : attribute(source.as< impl >())
+    {
+    }
+
+    /*!
+     * The method sets a new attribute value. The value is replaced atomically.
+     */
+    void set(value_type const& value)
+    {
+        get_impl()->set(value);
+    }
+
+    /*!
+     * The method sets a new attribute value. The value is replaced atomically.
+     */
+    void set(BOOST_RV_REF(value_type) value)
+    {
+        get_impl()->set(boost::move(value));
+    }
+
+    /*!
+     * The method acquires the current attribute value.
+     */
+    value_type get() const
+    {
+        return get_impl()->get();
+    }
+
+protected:
+    /*!
+     * Constructor for derived attributes
+     */
+    explicit mutable_constant(impl* p) : attribute(p)
+    {
+    }
+
+    /*!
+     * \returns Pointer to the factory implementation
+     */
+    impl* get_impl() const
+    {
+        return static_cast< impl* >(attribute::get_impl());
+    }
+};
+
+#else // !defined(BOOST_LOG_NO_THREADS)
+
+/*!
+ * \brief Specialization for lock-free updates
+ *
+ * With multithreading disabled this version of attribute is equivalent to the unlocked one.
+ */
+template< typename T >
+class mutable_constant< T, lock_free_update, void, void > :
+    public mutable_constant< T, void, void, void >
+{
+    //! Base type
+    typedef mutable_constant< T, void, void, void > base_type;
+
+public:
+    //! The attribute value type
+    typedef T value_type;
+
+public:
+    /*!
+     * Constructor with the stored value initialization
+     */
+    explicit mutable_constant(value_type const& value) : base_type(value)
+    {
+    }
+    /*!
+     * Constructor with the stored value initialization
+     */
+    explicit mutable_constant(BOOST_RV_REF(value_type) value) : base_type(boost::move(value))
+    {
+    }
+    /*!
+     * Constructor for casting support
+     */
+    explicit mutable_constant(cast_source const& source) : base_type(source)
+    {
+    }
+};
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
+
 } // namespace attributes
 
 BOOST_LOG_CLOSE_NAMESPACE // namespace log
@@ -16,16 +16,23 @@
 #define BOOST_LOG_ATTRIBUTES_SCOPED_ATTRIBUTE_HPP_INCLUDED_
 
 #include <utility>
+#include <boost/assert.hpp>
+#include <boost/intrusive_ptr.hpp>
+#include <boost/mpl/if.hpp>
 #include <boost/move/core.hpp>
 #include <boost/move/utility.hpp>
+#include <boost/type_traits/is_same.hpp>
 #include <boost/utility/addressof.hpp>
 #include <boost/log/detail/config.hpp>
 #include <boost/log/core/core.hpp>
 #include <boost/log/sources/basic_logger.hpp>
+#include <boost/log/sources/threading_models.hpp>
 #include <boost/log/attributes/attribute.hpp>
 #include <boost/log/attributes/attribute_set.hpp>
 #include <boost/log/attributes/attribute_name.hpp>
 #include <boost/log/attributes/constant.hpp>
+#include <boost/log/attributes/attribute_value_impl.hpp>
+#include <boost/log/detail/embedded_string_type.hpp>
 #include <boost/log/utility/unused_variable.hpp>
 #include <boost/log/utility/unique_identifier_name.hpp>
 #include <boost/log/detail/header.hpp>
@@ -52,8 +59,115 @@ typedef aux::attribute_scope_guard const& scoped_attribute;
 
 namespace aux {
 
+/*!
+ * \brief A scoped tag value
+ *
+ * The value resides in the scoped attribute guard. The guard holds a reference to the value, so that
+ * the value is never deleted when the last attribute value referring to it is released. The log records
+ * that include the value are detached from it when they are locked, before they are passed to sinks.
+ *
+ * \note The value cannot be detached from the references that exist when the guard is destroyed.
+ *       Any other reference to the value, e.g. an attribute value or an attribute value set saved
+ *       by a filter, must be released before the scope is left. The contract is only checked
+ *       in debug builds; in release builds such a reference refers to a destroyed object.
+ */
+template< typename T >
+class scoped_attribute_value :
+    public attributes::attribute_value_impl< T >
+{
+    //! Base type
+    typedef attributes::attribute_value_impl< T > base_type;
+
+public:
+    //! Constructor
+    explicit scoped_attribute_value(T const& value) : base_type(value)
+    {
+        intrusive_ptr_add_ref(this);
+    }
+    //! Destructor
+    ~scoped_attribute_value()
+    {
+        // A log record that refers to the value must not outlive the scope
+        BOOST_ASSERT(this->use_count() == 1u);
+    }
+
+    //! The method returns a copy of the value that does not refer to the guard
+    intrusive_ptr< attribute_value::impl > detach_from_thread()
+    {
+        return new base_type(this->get());
+    }
+};
+
+//! A base class that holds the scoped tag value. Used to construct the value before the container node.
+template< typename T >
+struct scoped_tag_value_holder
+{
+    //! The tag value
+    scoped_attribute_value< T > m_TagValue;
+
+    explicit scoped_tag_value_holder(T const& value) : m_TagValue(value) {}
+};
+
+//! The container node of a scoped tag, the tag value resides in the node
+template< typename T >
+class scoped_tag_node :
+    private scoped_tag_value_holder< T >,
+    public attribute_set::external_node
+{
+    //! Value holder type
+    typedef scoped_tag_value_holder< T > holder_type;
+
+public:
+    //! Constructor
+    scoped_tag_node(attribute_name const& name, T const& value) :
+        holder_type(value),
+        attribute_set::external_node(name, attribute(intrusive_ptr< attribute::impl >(&this->m_TagValue)), &scoped_tag_node::detach)
+    {
+    }
+    //! Copying constructor. The node is not linked into any container.
+    scoped_tag_node(scoped_tag_node const& that) :
+        holder_type(that.m_TagValue.get()),
+        attribute_set::external_node(that.name(), attribute(intrusive_ptr< attribute::impl >(&this->m_TagValue)), &scoped_tag_node::detach)
+    {
+    }
+
+private:
+    //! Returns an attribute with a copy of the tag value
+    static attribute detach(attribute_set::external_node const& n)
+    {
+        return attributes::constant< T >(static_cast< scoped_tag_node const& >(n).m_TagValue.get());
+    }
+};
+
+//! The container node of a scoped tag, the tag value is allocated separately
+template< typename T >
+class shared_tag_node :
+    public attribute_set::external_node
+{
+public:
+    //! Constructor
+    shared_tag_node(attribute_name const& name, T const& value) :
+        attribute_set::external_node(name, attributes::constant< T >(value))
+    {
+    }
+};
+
+/*!
+ * Selects the container node type of a scoped logger tag. Log records made with multithreaded loggers may still
+ * refer to the tag value in other threads when the scope is left, so such loggers keep the tag value in a separately allocated attribute.
+ */
+template< typename LoggerT, typename T >
+struct scoped_logger_tag_node
+{
+    typedef typename mpl::if_<
+        is_same< typename LoggerT::threading_model, sources::single_thread_model >,
+        scoped_tag_node< T >,
+        shared_tag_node< T >
+    >::type type;
+};
+
 //! A scoped logger attribute guard
-template< typename LoggerT >
+template< typename LoggerT, typename NodeT = attribute_set::external_node >
 class scoped_logger_attribute :
     public attribute_scope_guard
 {
@@ -66,48 +180,56 @@ private:
 private:
     //! A reference to the logger
     logger_type* m_pLogger;
-    //! An iterator to the added attribute
-    attribute_set::iterator m_itAttribute;
+    //! The container node of the attribute
+    NodeT m_Node;
 
 public:
     //! Constructor
-    scoped_logger_attribute(logger_type& l, attribute_name const& name, attribute const& attr) :
-        m_pLogger(boost::addressof(l))
-    {
-        std::pair<
-            attribute_set::iterator,
-            bool
-        > res = l.add_attribute(name, attr);
-        if (res.second)
-            m_itAttribute = res.first;
-        else
+    template< typename ArgT >
+    scoped_logger_attribute(logger_type& l, attribute_name const& name, ArgT const& arg) :
+        m_pLogger(boost::addressof(l)),
+        m_Node(name, arg)
+    {
+        if (!l.add_scoped_attribute(m_Node).second)
             m_pLogger = 0; // if there already is a same-named attribute, don't register anything
     }
     //! Move constructor
     scoped_logger_attribute(BOOST_RV_REF(scoped_logger_attribute) that) :
         m_pLogger(that.m_pLogger),
-        m_itAttribute(that.m_itAttribute)
+        m_Node(that.m_Node)
     {
-        that.m_pLogger = 0;
+        relink(static_cast< scoped_logger_attribute& >(that));
     }
 
     //! Destructor
     ~scoped_logger_attribute()
     {
         if (m_pLogger)
-            m_pLogger->remove_attribute(m_itAttribute);
+            m_pLogger->remove_scoped_attribute(m_Node);
     }
 
 #ifndef BOOST_LOG_BROKEN_REFERENCE_FROM_RVALUE_INIT
     BOOST_LOG_DELETED_FUNCTION(scoped_logger_attribute(scoped_logger_attribute const&))
 #else // BOOST_LOG_BROKEN_REFERENCE_FROM_RVALUE_INIT
-    scoped_logger_attribute(scoped_logger_attribute const& that) : m_pLogger(that.m_pLogger), m_itAttribute(that.m_itAttribute)
+    scoped_logger_attribute(scoped_logger_attribute const& that) : m_pLogger(that.m_pLogger), m_Node(that.m_Node)
     {
-        const_cast< scoped_logger_attribute& >(that).m_pLogger = 0;
+        relink(const_cast< scoped_logger_attribute& >(that));
     }
 #endif // BOOST_LOG_BROKEN_REFERENCE_FROM_RVALUE_INIT
 
     BOOST_LOG_DELETED_FUNCTION(scoped_logger_attribute& operator= (scoped_logger_attribute const&))
+
+private:
+    //! Replaces the node of the moved guard with the own node in the logger
+    void relink(scoped_logger_attribute& that)
+    {
+        if (m_pLogger)
+        {
+            m_pLogger->remove_scoped_attribute(that.m_Node);
+            that.m_pLogger = 0;
+            m_pLogger->add_scoped_attribute(m_Node);
+        }
+    }
 };
 
 } // namespace aux
@@ -132,12 +254,47 @@ BOOST_LOG_FORCEINLINE aux::scoped_logger_attribute< LoggerT > add_scoped_logger_
 #endif
 }
 
+/*!
+ * Registers a constant attribute with the specified value in the logger. Unlike \c add_scoped_logger_attribute,
+ * the function does not allocate memory for the attribute if the logger is not thread-safe.
+ *
+ * \note If the logger is not thread-safe, the attribute value resides in the returned guard object. Log records
+ *       are detached from the value when they are passed to sinks, but attribute values acquired from the records
+ *       before that, e.g. in filters, must not be used after the guard is destroyed.
+ *
+ * \param l Logger to register the attribute in
+ * \param name Attribute name
+ * \param value Attribute value
+ * \return An unspecified guard object which may be used to initialize a \c scoped_attribute variable.
+ */
+template< typename LoggerT, typename T >
+BOOST_LOG_FORCEINLINE aux::scoped_logger_attribute<
+    LoggerT,
+    typename aux::scoped_logger_tag_node< LoggerT, typename aux::make_embedded_string_type< T >::type >::type
+> add_scoped_logger_tag(LoggerT& l, attribute_name const& name, T const& value)
+{
+    typedef aux::scoped_logger_attribute<
+        LoggerT,
+        typename aux::scoped_logger_tag_node< LoggerT, typename aux::make_embedded_string_type< T >::type >::type
+    > guard_type;
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+    return guard_type(l, name, value);
+#else
+    guard_type guard(l, name, value);
+    return boost::move(guard);
+#endif
+}
+
 #ifndef BOOST_LOG_DOXYGEN_PASS
 
 #define BOOST_LOG_SCOPED_LOGGER_ATTR_INTERNAL(logger, attr_name, attr, sentry_var_name)\
     BOOST_LOG_UNUSED_VARIABLE(::boost::log::scoped_attribute, sentry_var_name,\
         = ::boost::log::add_scoped_logger_attribute(logger, attr_name, (attr)));
 
+#define BOOST_LOG_SCOPED_LOGGER_TAG_INTERNAL(logger, attr_name, attr_value, sentry_var_name)\
+    BOOST_LOG_UNUSED_VARIABLE(::boost::log::scoped_attribute, sentry_var_name,\
+        = ::boost::log::add_scoped_logger_tag(logger, attr_name, (attr_value)));
+
 #endif // BOOST_LOG_DOXYGEN_PASS
 
 //! The macro sets a scoped logger-wide attribute in a more compact way
@@ -150,11 +307,16 @@ BOOST_LOG_FORCEINLINE aux::scoped_logger_attribute< LoggerT > add_scoped_logger_
 
 //! The macro sets a scoped logger-wide tag in a more compact way
 #define BOOST_LOG_SCOPED_LOGGER_TAG(logger, attr_name, attr_value)\
-    BOOST_LOG_SCOPED_LOGGER_ATTR(logger, attr_name, ::boost::log::attributes::make_constant(attr_value))
+    BOOST_LOG_SCOPED_LOGGER_TAG_INTERNAL(\
+        logger,\
+        attr_name,\
+        attr_value,\
+        BOOST_LOG_UNIQUE_IDENTIFIER_NAME(_boost_log_scoped_logger_attr_sentry_))
 
 namespace aux {
 
 //! A scoped thread-specific attribute guard
+template< typename NodeT = attribute_set::external_node >
 class scoped_thread_attribute :
     public attribute_scope_guard
 {
@@ -163,46 +325,54 @@ class scoped_thread_attribute :
 private:
     //! A pointer to the logging core
     core_ptr m_pCore;
-    //! An iterator to the added attribute
-    attribute_set::iterator m_itAttribute;
+    //! The container node of the attribute
+    NodeT m_Node;
 
 public:
     //! Constructor
-    scoped_thread_attribute(attribute_name const& name, attribute const& attr) :
-        m_pCore(core::get())
-    {
-        std::pair<
-            attribute_set::iterator,
-            bool
-        > res = m_pCore->add_thread_attribute(name, attr);
-        if (res.second)
-            m_itAttribute = res.first;
-        else
+    template< typename ArgT >
+    scoped_thread_attribute(attribute_name const& name, ArgT const& arg) :
+        m_pCore(core::get()),
+        m_Node(name, arg)
+    {
+        if (!m_pCore->add_thread_attribute(m_Node).second)
             m_pCore.reset(); // if there already is a same-named attribute, don't register anything
     }
     //! Move constructor
-    scoped_thread_attribute(BOOST_RV_REF(scoped_thread_attribute) that) : m_itAttribute(that.m_itAttribute)
+    scoped_thread_attribute(BOOST_RV_REF(scoped_thread_attribute) that) : m_Node(that.m_Node)
     {
-        m_pCore.swap(that.m_pCore);
+        relink(static_cast< scoped_thread_attribute& >(that));
     }
 
     //! Destructor
     ~scoped_thread_attribute()
     {
         if (!!m_pCore)
-            m_pCore->remove_thread_attribute(m_itAttribute);
+            m_pCore->remove_thread_attribute(m_Node);
     }
 
 #ifndef BOOST_LOG_BROKEN_REFERENCE_FROM_RVALUE_INIT
     BOOST_LOG_DELETED_FUNCTION(scoped_thread_attribute(scoped_thread_attribute const&))
 #else // BOOST_LOG_BROKEN_REFERENCE_FROM_RVALUE_INIT
-    scoped_thread_attribute(scoped_thread_attribute const& that) : m_itAttribute(that.m_itAttribute)
+    scoped_thread_attribute(scoped_thread_attribute const& that) : m_Node(that.m_Node)
     {
-        m_pCore.swap(const_cast< scoped_thread_attribute& >(that).m_pCore);
+        relink(const_cast< scoped_thread_attribute& >(that));
     }
 #endif // BOOST_LOG_BROKEN_REFERENCE_FROM_RVALUE_INIT
 
     BOOST_LOG_DELETED_FUNCTION(scoped_thread_attribute& operator= (scoped_thread_attribute const&))
+
+private:
+    //! Replaces the node of the moved guard with the own node in the thread-specific attribute set
+    void relink(scoped_thread_attribute& that)
+    {
+        if (!!that.m_pCore)
+        {
+            that.m_pCore->remove_thread_attribute(that.m_Node);
+            m_pCore.swap(that.m_pCore);
+            m_pCore->add_thread_attribute(m_Node);
+        }
+    }
 };
 
 } // namespace aux
@@ -215,12 +385,39 @@ public:
  * \param attr The attribute. Must not be NULL.
  * \return An unspecified guard object which may be used to initialize a \c scoped_attribute variable.
  */
-BOOST_LOG_FORCEINLINE aux::scoped_thread_attribute add_scoped_thread_attribute(attribute_name const& name, attribute const& attr)
+BOOST_LOG_FORCEINLINE aux::scoped_thread_attribute< > add_scoped_thread_attribute(attribute_name const& name, attribute const& attr)
+{
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+    return aux::scoped_thread_attribute< >(name, attr);
+#else
+    aux::scoped_thread_attribute< > guard(name, attr);
+    return boost::move(guard);
+#endif
+}
+
+/*!
+ * Registers a thread-specific constant attribute with the specified value. Unlike \c add_scoped_thread_attribute,
+ * the function does not allocate memory: the attribute value resides in the returned guard object.
+ *
+ * \note Log records are detached from the value when they are passed to sinks, but attribute values acquired
+ *       from the records before that, e.g. in filters, must not be used after the guard is destroyed.
+ *
+ * \param name Attribute name
+ * \param value Attribute value
+ * \return An unspecified guard object which may be used to initialize a \c scoped_attribute variable.
+ */
+template< typename T >
+BOOST_LOG_FORCEINLINE aux::scoped_thread_attribute<
+    aux::scoped_tag_node< typename aux::make_embedded_string_type< T >::type >
+> add_scoped_thread_tag(attribute_name const& name, T const& value)
 {
+    typedef aux::scoped_thread_attribute<
+        aux::scoped_tag_node< typename aux::make_embedded_string_type< T >::type >
+    > guard_type;
 #if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
-    return aux::scoped_thread_attribute(name, attr);
+    return guard_type(name, value);
 #else
-    aux::scoped_thread_attribute guard(name, attr);
+    guard_type guard(name, value);
     return boost::move(guard);
 #endif
 }
@@ -231,6 +428,10 @@ BOOST_LOG_FORCEINLINE aux::scoped_thread_attribute add_scoped_thread_attribute(a
     BOOST_LOG_UNUSED_VARIABLE(::boost::log::scoped_attribute, sentry_var_name,\
         = ::boost::log::add_scoped_thread_attribute(attr_name, (attr)));
 
+#define BOOST_LOG_SCOPED_THREAD_TAG_INTERNAL(attr_name, attr_value, sentry_var_name)\
+    BOOST_LOG_UNUSED_VARIABLE(::boost::log::scoped_attribute, sentry_var_name,\
+        = ::boost::log::add_scoped_thread_tag(attr_name, (attr_value)));
+
 #endif // BOOST_LOG_DOXYGEN_PASS
 
 //! The macro sets a scoped thread-wide attribute in a more compact way
@@ -242,7 +443,10 @@ BOOST_LOG_FORCEINLINE aux::scoped_thread_attribute add_scoped_thread_attribute(a
 
 //! The macro sets a scoped thread-wide tag in a more compact way
 #define BOOST_LOG_SCOPED_THREAD_TAG(attr_name, attr_value)\
-    BOOST_LOG_SCOPED_THREAD_ATTR(attr_name, ::boost::log::attributes::make_constant(attr_value))
+    BOOST_LOG_SCOPED_THREAD_TAG_INTERNAL(\
+        attr_name,\
+        attr_value,\
+        BOOST_LOG_UNIQUE_IDENTIFIER_NAME(_boost_log_scoped_thread_attr_sentry_))
 
 BOOST_LOG_CLOSE_NAMESPACE // namespace log
 
@@ -0,0 +1,203 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   string_view_value.hpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * The header contains implementation of a string attribute value that refers to an external string.
+ */
+
+#ifndef BOOST_LOG_ATTRIBUTES_STRING_VIEW_VALUE_HPP_INCLUDED_
+#define BOOST_LOG_ATTRIBUTES_STRING_VIEW_VALUE_HPP_INCLUDED_
+
+#include <cstddef>
+#include <string>
+#include <boost/intrusive_ptr.hpp>
+#include <boost/type_traits/remove_cv.hpp>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/attributes/attribute_value.hpp>
+#include <boost/log/utility/string_literal.hpp>
+#include <boost/log/utility/type_dispatch/type_dispatcher.hpp>
+#include <boost/log/detail/header.hpp>
+
+#ifdef BOOST_LOG_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace attributes {
+
+/*!
+ * \brief A string attribute value that refers to an external string
+ *
+ * The attribute value does not copy the string it is constructed with. Instead, it refers to the caller's
+ * characters, which must stay valid for as long as the value is used in the thread that created it.
+ * When the value is passed to another thread (e.g. to an asynchronous sink), the \c detach_from_thread
+ * method creates a copy of the value that owns the string.
+ *
+ * The value can be extracted or visited both as \c basic_string_literal and \c std::basic_string. If the visitor
+ * supports both types, the value is passed as a string literal, which does not involve copying. The string object
+ * is only constructed when the value is requested as a string, which is done at most once for every value.
+ * Note that this means the value must not be visited concurrently by multiple threads before it is detached.
+ */
+template< typename CharT >
+class basic_string_view_value :
+    public attribute_value::impl
+{
+public:
+    //! Character type
+    typedef CharT char_type;
+    //! String type
+    typedef std::basic_string< char_type > string_type;
+    //! String literal type
+    typedef basic_string_literal< char_type > literal_type;
+
+private:
+    //! A tag type for the constructor that copies the string
+    struct owning_tag {};
+
+private:
+    //! The string characters. If the value owns the string, refers to \c m_String.
+    literal_type m_View;
+    //! The string copy. Only filled if the value owns the string or if the value has been requested as a string.
+    string_type m_String;
+    //! The flag indicates that \c m_String contains a copy of the string
+    bool m_fHasString;
+    //! The flag indicates that the value owns the string
+    bool m_fOwning;
+
+public:
+    /*!
+     * Constructor. Creates a value that refers to the specified characters.
+     *
+     * \param p A zero-terminated sequence of characters
+     * \param len The number of characters in the sequence, not counting the terminating zero
+     */
+    basic_string_view_value(const char_type* p, std::size_t len) :
+        m_View(p, len),
+        m_fHasString(false),
+        m_fOwning(false)
+    {
+    }
+
+    /*!
+     * Attribute value dispatching method.
+     *
+     * \param dispatcher The dispatcher that receives the stored value
+     *
+     * \return \c true if the value has been dispatched, \c false otherwise
+     */
+    virtual bool dispatch(type_dispatcher& dispatcher)
+    {
+        type_dispatcher::callback< literal_type > literal_callback = dispatcher.get_callback< literal_type >();
+        if (literal_callback)
+        {
+            literal_callback(m_View);
+            return true;
+        }
+
+        type_dispatcher::callback< string_type > string_callback = dispatcher.get_callback< string_type >();
+        if (string_callback)
+        {
+            if (!m_fHasString)
+            {
+                m_String.assign(m_View.c_str(), m_View.size());
+                m_fHasString = true;
+            }
+            string_callback(m_String);
+            return true;
+        }
+
+        return false;
+    }
+
+    /*!
+     * The method is called when the attribute value is passed to another thread.
+     *
+     * \return A value that owns the string. Returns \c this if the value already owns the string.
+     */
+    virtual intrusive_ptr< attribute_value::impl > detach_from_thread()
+    {
+        if (m_fOwning)
+            return this;
+        return new basic_string_view_value(m_View.c_str(), m_View.size(), owning_tag());
+    }
+
+    /*!
+     * \return The attribute value type
+     */
+    virtual type_info_wrapper get_type() const { return type_info_wrapper(typeid(string_type)); }
+
+    /*!
+     * \return \c true if the value owns the string, \c false if it refers to an external string.
+     */
+    bool is_owning() const { return m_fOwning; }
+
+    /*!
+     * \return The string literal that refers to the string characters.
+     */
+    literal_type const& get() const { return m_View; }
+
+private:
+    //! Constructor. Creates a value that owns a copy of the specified characters.
+    basic_string_view_value(const char_type* p, std::size_t len, owning_tag) :
+        m_String(p, len),
+        m_fHasString(true),
+        m_fOwning(true)
+    {
+        m_View = literal_type(m_String.c_str(), m_String.size());
+    }
+};
+
+#ifdef BOOST_LOG_USE_CHAR
+typedef basic_string_view_value< char > string_view_value;      //!< String view value for narrow-character strings
+#endif
+#ifdef BOOST_LOG_USE_WCHAR_T
+typedef basic_string_view_value< wchar_t > wstring_view_value;  //!< String view value for wide-character strings
+#endif
+
+/*!
+ * The function creates an attribute value that refers to the string. The string must not be modified or destroyed
+ * while the value is used in the current thread.
+ */
+template< typename CharT, typename AllocatorT >
+inline attribute_value make_string_view_value(std::basic_string< CharT, std::char_traits< CharT >, AllocatorT > const& str)
+{
+    return attribute_value(new basic_string_view_value< CharT >(str.c_str(), str.size()));
+}
+
+/*!
+ * The function creates an attribute value that refers to the zero-terminated string in the array. The array contents
+ * must not be modified or destroyed while the value is used in the current thread. If the array does not contain
+ * a terminating zero, the value is a copy of the whole array.
+ */
+template< typename CharT, std::size_t SizeV >
+inline attribute_value make_string_view_value(CharT (&str)[SizeV])
+{
+    typedef typename remove_cv< CharT >::type char_type;
+    typedef std::char_traits< char_type > traits_type;
+
+    const char_type* end = traits_type::find(str, SizeV, char_type());
+    if (end)
+        return attribute_value(new basic_string_view_value< char_type >(str, static_cast< std::size_t >(end - str)));
+    else
+        return attribute_value(basic_string_view_value< char_type >(str, SizeV).detach_from_thread());
+}
+
+} // namespace attributes
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_ATTRIBUTES_STRING_VIEW_VALUE_HPP_INCLUDED_
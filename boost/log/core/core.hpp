@@ -207,6 +207,23 @@ public:
      */
     BOOST_LOG_API void remove_thread_attribute(attribute_set::iterator it);
 
+#ifndef BOOST_LOG_DOXYGEN_PASS
+    /*!
+     * The method links the node owned by a scoped attribute guard into the thread-specific attribute set.
+     * For internal use by scoped attributes.
+     *
+     * \return A pair of values. If the second member is \c true, then the node is linked and the first member points to the
+     *         attribute. Otherwise the node was not linked and the first member points to the attribute that prevents
+     *         addition.
+     */
+    BOOST_LOG_API std::pair< attribute_set::iterator, bool > add_thread_attribute(attribute_set::external_node& n);
+    /*!
+     * The method unlinks the node owned by a scoped attribute guard from the thread-specific attribute set.
+     * For internal use by scoped attributes.
+     */
+    BOOST_LOG_API void remove_thread_attribute(attribute_set::external_node& n);
+#endif // BOOST_LOG_DOXYGEN_PASS
+
     /*!
      * The method returns a copy of the complete set of currently registered thread-specific attributes.
      */
@@ -254,6 +271,26 @@ public:
      *            throw if one of the sinks throws, or some system resource limitation is reached.
      */
     BOOST_LOG_API record open_record(attribute_set const& source_attributes);
+    /*!
+     * The method attempts to open a new record to be written. While attempting to open a log record all filtering is applied.
+     * A successfully opened record can be pushed further to sinks by calling the \c push_record method or simply destroyed by
+     * destroying the returned object.
+     *
+     * This overload additionally attaches a record-specific attribute value to the record. The value takes precedence over
+     * any attributes with the same name. Loggers use it to pass values that differ between records, such as the severity level,
+     * without storing them in attributes.
+     *
+     * The returned records can be copied, however, they must not be passed between different threads.
+     *
+     * \param source_attributes The set of source-specific attributes to be attached to the record to be opened.
+     * \param name The name of the record-specific attribute value.
+     * \param value The record-specific attribute value.
+     * \return A valid log record if the record is opened, an invalid record object if not (e.g. because it didn't pass filtering).
+     *
+     * \b Throws: If an exception handler is installed, only throws if the handler throws. Otherwise may
+     *            throw if one of the sinks throws, or some system resource limitation is reached.
+     */
+    BOOST_LOG_API record open_record(attribute_set const& source_attributes, attribute_name const& name, attribute_value const& value);
     /*!
      * The method attempts to open a new record to be written. While attempting to open a log record all filtering is applied.
      * A successfully opened record can be pushed further to sinks by calling the \c push_record method or simply destroyed by
@@ -37,6 +37,14 @@ BOOST_LOG_OPEN_NAMESPACE
 #ifndef BOOST_LOG_DOXYGEN_PASS
 class core;
 class record;
+class record_view;
+
+namespace aux {
+
+//! Creates a log record view with the specified attribute values. The record view is not bound to any sinks.
+BOOST_LOG_API record_view make_record_view(BOOST_RV_REF(attribute_value_set) values);
+
+} // namespace aux
 #endif // BOOST_LOG_DOXYGEN_PASS
 
 /*!
@@ -52,6 +60,9 @@ class record_view
 
     friend class core;
     friend class record;
+#ifndef BOOST_LOG_DOXYGEN_PASS
+    friend BOOST_LOG_API record_view aux::make_record_view(BOOST_RV_REF(attribute_value_set) values);
+#endif // BOOST_LOG_DOXYGEN_PASS
 
 #ifndef BOOST_LOG_DOXYGEN_PASS
 private:
@@ -0,0 +1,196 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   atomic_intrusive_ptr.hpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/libs/log/doc/log.html.
+ */
+
+#ifndef BOOST_LOG_DETAIL_ATOMIC_INTRUSIVE_PTR_HPP_INCLUDED_
+#define BOOST_LOG_DETAIL_ATOMIC_INTRUSIVE_PTR_HPP_INCLUDED_
+
+#include <boost/log/detail/config.hpp>
+
+#ifdef BOOST_LOG_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+#include <cstddef>
+#include <vector>
+#include <boost/intrusive_ptr.hpp>
+#include <boost/atomic/atomic.hpp>
+#include <boost/log/detail/locks.hpp>
+#include <boost/log/detail/spin_mutex.hpp>
+#include <boost/log/detail/header.hpp>
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace aux {
+
+//! Hazard pointer of a thread
+struct hazard_slot
+{
+    //! The object that must not be released while the slot refers to it
+    boost::atomic< const void* > m_pObject;
+    //! The flag indicates that the slot is in use. Only accessed by the thread that owns the slot.
+    bool m_fBusy;
+};
+
+//! The function returns a hazard pointer of the current thread that is not in use and marks it as used
+BOOST_LOG_API hazard_slot* acquire_hazard_slot();
+//! The function returns \c true if a hazard pointer of any thread refers to the object
+BOOST_LOG_API bool is_hazardous(const void* p);
+
+/*!
+ * \brief A reference-counted pointer that can be read and replaced concurrently
+ *
+ * Readers acquire a reference to the current object without locking. Every reader publishes the pointer it reads
+ * in a hazard pointer of its thread, so that reads do not modify shared data. Writers are serialized and
+ * atomically replace the pointer. The reference held by the pointer on the replaced object is not released
+ * immediately, since a concurrent reader may have loaded the pointer but not yet acquired its reference.
+ * Such objects are retired and released by the writers as soon as no hazard pointer refers to them.
+ * The number of retired objects is thus limited by the number of concurrent readers.
+ */
+template< typename T >
+class atomic_intrusive_ptr
+{
+private:
+    //! Pointer to the current object. The pointer holds a reference to the object.
+    boost::atomic< T* > m_pObject;
+    //! The mutex serializes writers
+    spin_mutex m_Mutex;
+    //! The replaced objects that may still be referred to by readers
+    std::vector< T* > m_Retired;
+
+public:
+    /*!
+     * \brief Scoped read access to the current object
+     *
+     * The guard does not acquire a reference to the object. The object is not released while the guard exists.
+     */
+    class read_guard
+    {
+    private:
+        //! The hazard pointer that protects the object
+        hazard_slot* m_pSlot;
+        //! The current object
+        T* m_pObject;
+
+    public:
+        //! Constructor. Marks the beginning of the read.
+        explicit read_guard(atomic_intrusive_ptr const& owner) : m_pSlot(acquire_hazard_slot())
+        {
+            // The object is protected if the pointer is not replaced after the hazard pointer is published
+            T* p = owner.m_pObject.load(boost::memory_order_relaxed);
+            while (true)
+            {
+                m_pSlot->m_pObject.store(p, boost::memory_order_seq_cst);
+                T* q = owner.m_pObject.load(boost::memory_order_seq_cst);
+                if (q == p)
+                    break;
+                p = q;
+            }
+            m_pObject = p;
+        }
+        //! Destructor. Marks the end of the read.
+        ~read_guard()
+        {
+            m_pSlot->m_pObject.store(NULL, boost::memory_order_release);
+            m_pSlot->m_fBusy = false;
+        }
+
+        //! Returns the pointer to the object
+        T* get() const { return m_pObject; }
+        //! Returns the pointer to the object
+        T* operator-> () const { return m_pObject; }
+        //! Returns the reference to the object
+        T& operator* () const { return *m_pObject; }
+
+        //  Copying prohibited
+        BOOST_LOG_DELETED_FUNCTION(read_guard(read_guard const&))
+        BOOST_LOG_DELETED_FUNCTION(read_guard& operator= (read_guard const&))
+    };
+
+public:
+    //! Initializing constructor
+    explicit atomic_intrusive_ptr(intrusive_ptr< T > const& p) : m_pObject(p.get())
+    {
+        if (p)
+            intrusive_ptr_add_ref(p.get());
+    }
+
+    //! Destructor. There must be no readers when the pointer is destroyed.
+    ~atomic_intrusive_ptr()
+    {
+        for (typename std::vector< T* >::const_iterator it = m_Retired.begin(), end = m_Retired.end(); it != end; ++it)
+            intrusive_ptr_release(*it);
+        T* p = m_pObject.load(boost::memory_order_relaxed);
+        if (p)
+            intrusive_ptr_release(p);
+    }
+
+    //! Acquires a reference to the current object
+    intrusive_ptr< T > load() const
+    {
+        read_guard guard(*this);
+        return intrusive_ptr< T >(guard.get());
+    }
+
+    //! Replaces the current object
+    void store(intrusive_ptr< T > const& p)
+    {
+        exclusive_lock_guard< spin_mutex > lock(m_Mutex);
+
+        m_Retired.reserve(m_Retired.size() + 1u);
+        if (p)
+            intrusive_ptr_add_ref(p.get());
+        T* old = m_pObject.exchange(p.get(), boost::memory_order_seq_cst);
+        if (old)
+            m_Retired.push_back(old);
+
+        release_retired();
+    }
+
+private:
+    //! Releases the retired objects that are not referred to by hazard pointers. The mutex must be locked.
+    void release_retired()
+    {
+        // Readers that publish their hazard pointers after this point will load the pointer that replaced the retired objects
+        typename std::vector< T* >::iterator it = m_Retired.begin(), end = m_Retired.end(), kept = it;
+        for (; it != end; ++it)
+        {
+            if (is_hazardous(*it))
+                *kept++ = *it;
+            else
+                intrusive_ptr_release(*it);
+        }
+        m_Retired.erase(kept, end);
+    }
+
+    //  Copying prohibited
+    BOOST_LOG_DELETED_FUNCTION(atomic_intrusive_ptr(atomic_intrusive_ptr const&))
+    BOOST_LOG_DELETED_FUNCTION(atomic_intrusive_ptr& operator= (atomic_intrusive_ptr const&))
+};
+
+} // namespace aux
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
+
+#endif // BOOST_LOG_DETAIL_ATOMIC_INTRUSIVE_PTR_HPP_INCLUDED_
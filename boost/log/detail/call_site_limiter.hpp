@@ -0,0 +1,100 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   call_site_limiter.hpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/libs/log/doc/log.html.
+ */
+
+#ifndef BOOST_LOG_DETAIL_CALL_SITE_LIMITER_HPP_INCLUDED_
+#define BOOST_LOG_DETAIL_CALL_SITE_LIMITER_HPP_INCLUDED_
+
+#include <boost/cstdint.hpp>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/attributes/call_site.hpp>
+#include <boost/log/attributes/attribute_name.hpp>
+#include <boost/log/detail/header.hpp>
+
+#ifdef BOOST_LOG_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace aux {
+
+/*!
+ * \brief The state of a filter that limits the number of log records made at every call site
+ *
+ * The limiter keeps counters for every call site it encounters. The counters are distributed
+ * between a number of independently locked partitions, so that threads logging at different call sites
+ * rarely contend. When a log record is checked at a call site where some records were suppressed and
+ * the reporting period has expired, the number of the suppressed records is saved in the thread-specific
+ * call site context, to be reported by the logging macro at that call site. The report is made whether
+ * the checked record passes or not, so that it is made with the logger and the named arguments
+ * of the call site.
+ */
+class call_site_limiter
+{
+public:
+    //! Limiting strategies
+    enum strategy
+    {
+        token_bucket,   //!< At most a given number of records pass per period of time, excess records are suppressed
+        sampling        //!< Only every N-th record passes
+    };
+
+private:
+    struct implementation;
+    implementation* m_pImpl;
+
+public:
+    /*!
+     * Constructor
+     *
+     * \param strat The limiting strategy
+     * \param count For the token bucket strategy, the number of records that pass per period of time.
+     *              For the sampling strategy, the sampling ratio: one of \a count records pass.
+     * \param period For the token bucket strategy, the period of time, in milliseconds. For the sampling strategy,
+     *               the minimum interval between reporting the suppressed records at every call site, in milliseconds.
+     */
+    BOOST_LOG_API call_site_limiter(strategy strat, uintmax_t count, uint64_t period);
+    //! Destructor
+    BOOST_LOG_API ~call_site_limiter();
+
+    /*!
+     * The method updates the counters of the call site
+     *
+     * \return \c true if the log record made at the call site should pass, \c false if it should be suppressed
+     */
+    BOOST_LOG_API bool check(call_site const& site);
+
+    //  Copying and assignment prohibited
+    BOOST_LOG_DELETED_FUNCTION(call_site_limiter(call_site_limiter const&))
+    BOOST_LOG_DELETED_FUNCTION(call_site_limiter& operator= (call_site_limiter const&))
+};
+
+/*!
+ * The function registers the \c current_call_site attribute with the specified name in the global attribute set
+ * of the logging core, unless an attribute with this name is already registered.
+ */
+BOOST_LOG_API void register_call_site_attribute(attribute_name const& name);
+
+} // namespace aux
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_DETAIL_CALL_SITE_LIMITER_HPP_INCLUDED_
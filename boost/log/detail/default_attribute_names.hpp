@@ -39,6 +39,10 @@ BOOST_LOG_API attribute_name line_id();
 BOOST_LOG_API attribute_name timestamp();
 BOOST_LOG_API attribute_name process_id();
 BOOST_LOG_API attribute_name thread_id();
+BOOST_LOG_API attribute_name call_site();
+BOOST_LOG_API attribute_name repeat_count();
+BOOST_LOG_API attribute_name first_timestamp();
+BOOST_LOG_API attribute_name last_timestamp();
 
 } // namespace default_attribute_names
 
@@ -40,6 +40,7 @@
 #   define BOOST_LOG_EVENT_USE_BOOST_CONDITION
 #endif
 
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <boost/log/detail/header.hpp>
 
 namespace boost {
@@ -64,6 +65,8 @@ public:
 
     //! Waits for the object to become signalled
     BOOST_LOG_API void wait();
+    //! Waits for the object to become signalled until the deadline (in UTC). Returns \c false if the deadline is reached.
+    BOOST_LOG_API bool timed_wait(posix_time::ptime const& deadline);
     //! Sets the object to a signalled state
     BOOST_LOG_API void set_signalled();
 
@@ -91,6 +94,8 @@ public:
 
     //! Waits for the object to become signalled
     BOOST_LOG_API void wait();
+    //! Waits for the object to become signalled until the deadline (in UTC). Returns \c false if the deadline is reached.
+    BOOST_LOG_API bool timed_wait(posix_time::ptime const& deadline);
     //! Sets the object to a signalled state
     BOOST_LOG_API void set_signalled();
 
@@ -119,6 +124,8 @@ public:
 
     //! Waits for the object to become signalled
     BOOST_LOG_API void wait();
+    //! Waits for the object to become signalled until the deadline (in UTC). Returns \c false if the deadline is reached.
+    BOOST_LOG_API bool timed_wait(posix_time::ptime const& deadline);
     //! Sets the object to a signalled state
     BOOST_LOG_API void set_signalled();
 
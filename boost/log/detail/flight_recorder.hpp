@@ -0,0 +1,93 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   flight_recorder.hpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/libs/log/doc/log.html.
+ */
+
+#ifndef BOOST_LOG_DETAIL_FLIGHT_RECORDER_HPP_INCLUDED_
+#define BOOST_LOG_DETAIL_FLIGHT_RECORDER_HPP_INCLUDED_
+
+#include <boost/log/detail/config.hpp>
+
+#ifdef BOOST_LOG_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+#ifndef BOOST_LOG_NO_THREADS
+
+#include <cstddef>
+#include <vector>
+#include <boost/log/core/record_view.hpp>
+#include <boost/log/expressions/filter.hpp>
+#include <boost/log/detail/header.hpp>
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace aux {
+
+/*!
+ * \brief Per-thread ring buffers of log records
+ *
+ * Every thread that pushes records gets its own ring buffer of the specified capacity. When the buffer
+ * is full, the oldest record is replaced. The buffers of the terminated threads are retained until their
+ * records are extracted, or reused by new threads.
+ */
+class flight_recorder
+{
+private:
+    struct implementation;
+    implementation* m_pImpl;
+
+public:
+    //! Constructor
+    BOOST_LOG_API explicit flight_recorder(std::size_t capacity);
+    //! Destructor
+    BOOST_LOG_API ~flight_recorder();
+
+    //! Returns the maximum number of records retained per thread
+    BOOST_LOG_API std::size_t capacity() const;
+    //! Sets the maximum number of records retained per thread. The buffers are resized as the threads push records.
+    BOOST_LOG_API void set_capacity(std::size_t capacity);
+
+    //! Sets the filter that selects records that trigger dumping the buffers
+    BOOST_LOG_API void set_trigger(filter const& trigger);
+    //! Resets the trigger filter, no records will trigger dumping
+    BOOST_LOG_API void reset_trigger();
+
+    /*!
+     * Puts the record into the buffer of the current thread.
+     *
+     * \return \c true if the record passed the trigger filter, \c false otherwise
+     */
+    BOOST_LOG_API bool push(record_view const& rec);
+
+    //! Extracts records from all buffers and appends them to the container in the order they were pushed
+    BOOST_LOG_API void pop_all(std::vector< record_view >& records);
+
+    //  Copying and assignment prohibited
+    BOOST_LOG_DELETED_FUNCTION(flight_recorder(flight_recorder const&))
+    BOOST_LOG_DELETED_FUNCTION(flight_recorder& operator= (flight_recorder const&))
+};
+
+} // namespace aux
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_NO_THREADS
+
+#endif // BOOST_LOG_DETAIL_FLIGHT_RECORDER_HPP_INCLUDED_
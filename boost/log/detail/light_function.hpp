@@ -13,18 +13,25 @@
  *         at http://www.boost.org/libs/log/doc/log.html.
  *
  * The file contains a lightweight alternative of Boost.Function. It does not provide all
- * features of Boost.Function but doesn't introduce dependency on Boost.Bind.
+ * features of Boost.Function but doesn't introduce dependency on Boost.Bind. Small function
+ * objects are stored in an internal buffer, without dynamic memory allocation.
  */
 
 #ifndef BOOST_LOG_DETAIL_LIGHT_FUNCTION_HPP_INCLUDED_
 #define BOOST_LOG_DETAIL_LIGHT_FUNCTION_HPP_INCLUDED_
 
+#include <new>
 #include <cstddef>
+#include <boost/cstdint.hpp>
 #include <boost/move/core.hpp>
 #include <boost/move/utility.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/utility/enable_if.hpp>
 #include <boost/log/detail/config.hpp>
 #include <boost/log/utility/explicit_operator_bool.hpp>
+#include <boost/type_traits/is_same.hpp>
 #include <boost/type_traits/remove_cv.hpp>
+#include <boost/type_traits/alignment_of.hpp>
 #if defined(BOOST_NO_VARIADIC_TEMPLATES) || defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
 #include <boost/preprocessor/iteration/iterate.hpp>
 #include <boost/preprocessor/repetition/enum_params.hpp>
@@ -33,11 +40,11 @@
 #include <boost/preprocessor/repetition/enum_trailing_binary_params.hpp>
 #endif
 #if defined(BOOST_NO_RVALUE_REFERENCES) || defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
-#include <boost/utility/enable_if.hpp>
-#include <boost/type_traits/is_same.hpp>
 #include <boost/mpl/or.hpp>
+#include <boost/type_traits/has_nothrow_copy.hpp>
 #else
 #include <boost/type_traits/remove_reference.hpp>
+#include <boost/type_traits/is_nothrow_move_constructible.hpp>
 #endif
 #if defined(BOOST_NO_NULLPTR) || defined(BOOST_NO_CXX11_NULLPTR)
 #include <boost/assert.hpp>
@@ -61,131 +68,282 @@ namespace aux {
 template< typename SignatureT >
 class light_function;
 
-#if !defined(BOOST_NO_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
-
-template< typename ResultT, typename... ArgsT >
-class light_function< ResultT (ArgsT...) >
+//! The base class of light_function, which manages the storage of the function object
+class light_function_base
 {
-    typedef light_function this_type;
-    BOOST_COPYABLE_AND_MOVABLE(this_type)
+protected:
+    //! The size of the internal buffer. The size is part of the library ABI and must not depend on user's configuration.
+    enum { buffer_size = 3 * sizeof(void*) };
 
-public:
-    typedef ResultT result_type;
+    //! Function object storage. Small function objects are stored in the buffer, others are allocated dynamically.
+    union storage
+    {
+        void* m_pObject;
+        double m_Double;
+        uintmax_t m_Integer;
+        unsigned char m_Buffer[buffer_size];
+    };
 
-private:
-    struct impl_base
+    //! Storage operations
+    enum operation
     {
-        typedef result_type (*invoke_type)(impl_base*, ArgsT...);
-        const invoke_type invoke;
+        clone_object,   //!< Copy the function object to the other storage
+        move_object,    //!< Move the function object to the other storage, the original storage is left empty
+        destroy_object  //!< Destroy the function object
+    };
 
-        typedef impl_base* (*clone_type)(const impl_base*);
-        const clone_type clone;
+    //! The type of the function that performs storage operations
+    typedef void (*manager_type)(operation op, storage& self, storage* other);
 
-        typedef void (*destroy_type)(impl_base*);
-        const destroy_type destroy;
+    //! The trait checks if the function object can be stored in the buffer
+    template< typename FunT >
+    struct is_small :
+        public mpl::bool_<
+            sizeof(FunT) <= sizeof(storage) &&
+            (alignment_of< storage >::value % alignment_of< FunT >::value) == 0 &&
+#if !defined(BOOST_NO_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+            is_nothrow_move_constructible< FunT >::value
+#else
+            has_nothrow_copy< FunT >::value
+#endif
+        >
+    {
+    };
 
-        impl_base(invoke_type inv, clone_type cl, destroy_type dstr) : invoke(inv), clone(cl), destroy(dstr)
+    //! Storage operations for the function objects stored in the buffer
+    template< typename FunT, bool = is_small< FunT >::value >
+    struct manager
+    {
+        static FunT& get(storage& s) BOOST_NOEXCEPT
         {
+            return *static_cast< FunT* >(static_cast< void* >(s.m_Buffer));
         }
-    };
 
-#if !defined(BOOST_LOG_NO_MEMBER_TEMPLATE_FRIENDS)
-    template< typename FunT >
-    class impl;
-    template< typename FunT >
-    friend class impl;
+#if !defined(BOOST_NO_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+        template< typename ArgT >
+        static void create(storage& s, ArgT&& arg)
+        {
+            new (static_cast< void* >(s.m_Buffer)) FunT(boost::forward< ArgT >(arg));
+        }
+#else
+        static void create(storage& s, FunT const& arg)
+        {
+            new (static_cast< void* >(s.m_Buffer)) FunT(arg);
+        }
 #endif
 
+        static void manage(operation op, storage& self, storage* other)
+        {
+            FunT& fun = get(self);
+            switch (op)
+            {
+            case clone_object:
+                new (static_cast< void* >(other->m_Buffer)) FunT(static_cast< FunT const& >(fun));
+                break;
+            case move_object:
+                new (static_cast< void* >(other->m_Buffer)) FunT(boost::move(fun));
+                fun.~FunT();
+                break;
+            default:
+                fun.~FunT();
+                break;
+            }
+        }
+    };
+
+    //! Storage operations for the dynamically allocated function objects
     template< typename FunT >
-    class impl :
-        public impl_base
+    struct manager< FunT, false >
     {
-        typedef impl< FunT > this_type;
-
-        FunT m_Function;
-
-    public:
-        explicit impl(FunT const& fun) :
-            impl_base(&this_type::invoke_impl, &this_type::clone_impl, &this_type::destroy_impl),
-            m_Function(fun)
+        static FunT& get(storage& s) BOOST_NOEXCEPT
         {
+            return *static_cast< FunT* >(s.m_pObject);
         }
 
 #if !defined(BOOST_NO_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
-        explicit impl(FunT&& fun) :
-            impl_base(&this_type::invoke_impl, &this_type::clone_impl, &this_type::destroy_impl),
-            m_Function(fun)
+        template< typename ArgT >
+        static void create(storage& s, ArgT&& arg)
+        {
+            s.m_pObject = new FunT(boost::forward< ArgT >(arg));
+        }
+#else
+        static void create(storage& s, FunT const& arg)
         {
+            s.m_pObject = new FunT(arg);
         }
-#endif // !defined(BOOST_NO_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+#endif
 
-        static void destroy_impl(impl_base* self)
+        static void manage(operation op, storage& self, storage* other)
         {
-            delete static_cast< impl* >(self);
+            switch (op)
+            {
+            case clone_object:
+                other->m_pObject = new FunT(static_cast< FunT const& >(get(self)));
+                break;
+            case move_object:
+                other->m_pObject = self.m_pObject;
+                break;
+            default:
+                delete static_cast< FunT* >(self.m_pObject);
+                break;
+            }
         }
-        static impl_base* clone_impl(const impl_base* self)
+    };
+
+protected:
+    //! Function object storage
+    mutable storage m_Storage;
+    //! Storage operations for the stored function object, \c NULL if the storage is empty
+    manager_type m_Manager;
+
+protected:
+    light_function_base() BOOST_NOEXCEPT : m_Manager(NULL)
+    {
+    }
+
+    //! Constructs the function object in the storage
+#if !defined(BOOST_NO_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+    template< typename FunT, typename ArgT >
+    void create(ArgT&& arg)
+    {
+        manager< FunT >::create(m_Storage, boost::forward< ArgT >(arg));
+        m_Manager = &manager< FunT >::manage;
+    }
+#else
+    template< typename FunT >
+    void create(FunT const& arg)
+    {
+        manager< FunT >::create(m_Storage, arg);
+        m_Manager = &manager< FunT >::manage;
+    }
+#endif
+
+    //! Copies the function object from another storage. The storage must be empty.
+    void copy_from(light_function_base const& that)
+    {
+        if (that.m_Manager)
         {
-            return new impl(static_cast< const impl* >(self)->m_Function);
+            that.m_Manager(clone_object, that.m_Storage, &m_Storage);
+            m_Manager = that.m_Manager;
         }
-        static result_type invoke_impl(impl_base* self, ArgsT... args)
+    }
+
+    //! Moves the function object from another storage. The storage must be empty.
+    void move_from(light_function_base& that) BOOST_NOEXCEPT
+    {
+        if (that.m_Manager)
         {
-            return static_cast< impl* >(self)->m_Function(args...);
+            that.m_Manager(move_object, that.m_Storage, &m_Storage);
+            m_Manager = that.m_Manager;
+            that.m_Manager = NULL;
         }
-    };
+    }
+
+    //! Destroys the stored function object
+    void destroy() BOOST_NOEXCEPT
+    {
+        if (m_Manager)
+        {
+            m_Manager(destroy_object, m_Storage, NULL);
+            m_Manager = NULL;
+        }
+    }
+
+    //! Swaps the stored function objects
+    void swap_storage(light_function_base& that) BOOST_NOEXCEPT
+    {
+        light_function_base tmp;
+        tmp.move_from(*this);
+        move_from(that);
+        that.move_from(tmp);
+    }
+
+    //  Copying prohibited
+    BOOST_LOG_DELETED_FUNCTION(light_function_base(light_function_base const&))
+    BOOST_LOG_DELETED_FUNCTION(light_function_base& operator= (light_function_base const&))
+};
+
+#if !defined(BOOST_NO_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+
+template< typename ResultT, typename... ArgsT >
+class light_function< ResultT (ArgsT...) > :
+    private light_function_base
+{
+    typedef light_function this_type;
+    BOOST_COPYABLE_AND_MOVABLE(this_type)
+
+public:
+    typedef ResultT result_type;
+
+private:
+    typedef result_type (*invoke_type)(storage& , ArgsT...);
+
+    template< typename FunT >
+    static result_type invoke_impl(storage& s , ArgsT... args)
+    {
+        return manager< FunT >::get(s)(args...);
+    }
 
 private:
-    impl_base* m_pImpl;
+    invoke_type m_Invoke;
 
 public:
-    BOOST_CONSTEXPR light_function() BOOST_NOEXCEPT : m_pImpl(NULL)
+    light_function() BOOST_NOEXCEPT : m_Invoke(NULL)
     {
     }
-    light_function(this_type const& that)
+    light_function(this_type const& that) : light_function_base(), m_Invoke(NULL)
     {
-        if (that.m_pImpl)
-            m_pImpl = that.m_pImpl->clone(that.m_pImpl);
-        else
-            m_pImpl = NULL;
+        copy_from(that);
+        m_Invoke = that.m_Invoke;
     }
 
-    light_function(BOOST_RV_REF(this_type) that) BOOST_NOEXCEPT
+    light_function(BOOST_RV_REF(this_type) that) BOOST_NOEXCEPT : light_function_base(), m_Invoke(that.m_Invoke)
     {
-        m_pImpl = that.m_pImpl;
-        that.m_pImpl = NULL;
+        move_from(that);
+        that.m_Invoke = NULL;
     }
 
-    light_function(BOOST_RV_REF(const this_type) that) BOOST_NOEXCEPT
+    light_function(BOOST_RV_REF(const this_type) that) BOOST_NOEXCEPT : light_function_base(), m_Invoke(that.m_Invoke)
     {
-        m_pImpl = that.m_pImpl;
-        ((this_type&)that).m_pImpl = NULL;
+        this_type& other = const_cast< this_type& >(static_cast< this_type const& >(that));
+        move_from(other);
+        other.m_Invoke = NULL;
     }
 
 #if !defined(BOOST_NO_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
     template< typename FunT >
-    light_function(FunT&& fun) :
-        m_pImpl(new impl< typename remove_cv< typename remove_reference< FunT >::type >::type >(boost::forward< FunT >(fun)))
+    light_function(FunT&& fun, typename disable_if< is_same< typename remove_cv< typename remove_reference< FunT >::type >::type, this_type >, int >::type = 0) :
+        m_Invoke(NULL)
     {
+        typedef typename remove_cv< typename remove_reference< FunT >::type >::type function_type;
+        create< function_type >(boost::forward< FunT >(fun));
+        m_Invoke = &this_type::invoke_impl< function_type >;
     }
 #else
     template< typename FunT >
     light_function(FunT const& fun, typename disable_if< mpl::or_< move_detail::is_rv< FunT >, is_same< FunT, this_type > >, int >::type = 0) :
-        m_pImpl(new impl< FunT >(fun))
+        m_Invoke(NULL)
     {
+        create< FunT >(fun);
+        m_Invoke = &this_type::invoke_impl< FunT >;
     }
     template< typename FunT >
     light_function(rv< FunT > const& fun, typename disable_if< is_same< typename remove_cv< FunT >::type, this_type >, int >::type = 0) :
-        m_pImpl(new impl< typename remove_cv< FunT >::type >(fun))
+        m_Invoke(NULL)
     {
+        typedef typename remove_cv< FunT >::type function_type;
+        create< function_type >(static_cast< FunT const& >(fun));
+        m_Invoke = &this_type::invoke_impl< function_type >;
     }
 #endif
 
     //! Constructor from NULL
 #if !defined(BOOST_NO_NULLPTR) && !defined(BOOST_NO_CXX11_NULLPTR)
-    BOOST_CONSTEXPR light_function(std::nullptr_t) BOOST_NOEXCEPT
+    light_function(std::nullptr_t) BOOST_NOEXCEPT
 #else
-    BOOST_CONSTEXPR light_function(int p) BOOST_NOEXCEPT
+    light_function(int p) BOOST_NOEXCEPT
 #endif
-        : m_pImpl(NULL)
+        : m_Invoke(NULL)
     {
 #if defined(BOOST_NO_NULLPTR) || defined(BOOST_NO_CXX11_NULLPTR)
         BOOST_ASSERT(p == 0);
@@ -193,17 +351,23 @@ public:
     }
     ~light_function()
     {
-        clear();
+        destroy();
     }
 
     light_function& operator= (BOOST_RV_REF(this_type) that) BOOST_NOEXCEPT
     {
-        this->swap(that);
+        if (this != &that)
+        {
+            destroy();
+            move_from(that);
+            m_Invoke = that.m_Invoke;
+            that.m_Invoke = NULL;
+        }
         return *this;
     }
     light_function& operator= (BOOST_COPY_ASSIGN_REF(this_type) that)
     {
-        light_function tmp(that);
+        light_function tmp(static_cast< this_type const& >(that));
         this->swap(tmp);
         return *this;
     }
@@ -222,7 +386,8 @@ public:
     }
 #if !defined(BOOST_NO_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
     template< typename FunT >
-    light_function& operator= (FunT&& fun)
+    typename disable_if< is_same< typename remove_cv< typename remove_reference< FunT >::type >::type, this_type >, this_type& >::type
+    operator= (FunT&& fun)
     {
         light_function tmp(boost::forward< FunT >(fun));
         this->swap(tmp);
@@ -241,31 +406,30 @@ public:
 
     result_type operator() (ArgsT... args) const
     {
-        return m_pImpl->invoke(m_pImpl, args...);
+        return m_Invoke(m_Storage , args...);
     }
 
     BOOST_LOG_EXPLICIT_OPERATOR_BOOL()
-    bool operator! () const BOOST_NOEXCEPT { return (m_pImpl == NULL); }
-    bool empty() const BOOST_NOEXCEPT { return (m_pImpl == NULL); }
+    bool operator! () const BOOST_NOEXCEPT { return (m_Invoke == NULL); }
+    bool empty() const BOOST_NOEXCEPT { return (m_Invoke == NULL); }
     void clear() BOOST_NOEXCEPT
     {
-        if (m_pImpl)
-        {
-            m_pImpl->destroy(m_pImpl);
-            m_pImpl = NULL;
-        }
+        destroy();
+        m_Invoke = NULL;
     }
 
     void swap(this_type& that) BOOST_NOEXCEPT
     {
-        register impl_base* p = m_pImpl;
-        m_pImpl = that.m_pImpl;
-        that.m_pImpl = p;
+        swap_storage(that);
+        invoke_type p = m_Invoke;
+        m_Invoke = that.m_Invoke;
+        that.m_Invoke = p;
     }
 };
 
 template< typename... ArgsT >
-class light_function< void (ArgsT...) >
+class light_function< void (ArgsT...) > :
+    private light_function_base
 {
     typedef light_function this_type;
     BOOST_COPYABLE_AND_MOVABLE(this_type)
@@ -274,118 +438,74 @@ public:
     typedef void result_type;
 
 private:
-    struct impl_base
-    {
-        typedef void (*invoke_type)(impl_base*, ArgsT...);
-        const invoke_type invoke;
-
-        typedef impl_base* (*clone_type)(const impl_base*);
-        const clone_type clone;
-
-        typedef void (*destroy_type)(impl_base*);
-        const destroy_type destroy;
-
-        impl_base(invoke_type inv, clone_type cl, destroy_type dstr) : invoke(inv), clone(cl), destroy(dstr)
-        {
-        }
-    };
-
-#if !defined(BOOST_LOG_NO_MEMBER_TEMPLATE_FRIENDS)
-    template< typename FunT >
-    class impl;
-    template< typename FunT >
-    friend class impl;
-#endif
+    typedef result_type (*invoke_type)(storage& , ArgsT...);
 
     template< typename FunT >
-    class impl :
-        public impl_base
+    static result_type invoke_impl(storage& s , ArgsT... args)
     {
-        typedef impl< FunT > this_type;
-
-        FunT m_Function;
-
-    public:
-        explicit impl(FunT const& fun) :
-            impl_base(&this_type::invoke_impl, &this_type::clone_impl, &this_type::destroy_impl),
-            m_Function(fun)
-        {
-        }
-
-#if !defined(BOOST_NO_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
-        explicit impl(FunT&& fun) :
-            impl_base(&this_type::invoke_impl, &this_type::clone_impl, &this_type::destroy_impl),
-            m_Function(fun)
-        {
-        }
-#endif // !defined(BOOST_NO_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
-
-        static void destroy_impl(impl_base* self)
-        {
-            delete static_cast< impl* >(self);
-        }
-        static impl_base* clone_impl(const impl_base* self)
-        {
-            return new impl(static_cast< const impl* >(self)->m_Function);
-        }
-        static result_type invoke_impl(impl_base* self, ArgsT... args)
-        {
-            static_cast< impl* >(self)->m_Function(args...);
-        }
-    };
+        manager< FunT >::get(s)(args...);
+    }
 
 private:
-    impl_base* m_pImpl;
+    invoke_type m_Invoke;
 
 public:
-    BOOST_CONSTEXPR light_function() BOOST_NOEXCEPT : m_pImpl(NULL)
+    light_function() BOOST_NOEXCEPT : m_Invoke(NULL)
     {
     }
-    light_function(this_type const& that)
+    light_function(this_type const& that) : light_function_base(), m_Invoke(NULL)
     {
-        if (that.m_pImpl)
-            m_pImpl = that.m_pImpl->clone(that.m_pImpl);
-        else
-            m_pImpl = NULL;
+        copy_from(that);
+        m_Invoke = that.m_Invoke;
     }
-    light_function(BOOST_RV_REF(this_type) that) BOOST_NOEXCEPT
+
+    light_function(BOOST_RV_REF(this_type) that) BOOST_NOEXCEPT : light_function_base(), m_Invoke(that.m_Invoke)
     {
-        m_pImpl = that.m_pImpl;
-        that.m_pImpl = NULL;
+        move_from(that);
+        that.m_Invoke = NULL;
     }
 
-    light_function(BOOST_RV_REF(const this_type) that) BOOST_NOEXCEPT
+    light_function(BOOST_RV_REF(const this_type) that) BOOST_NOEXCEPT : light_function_base(), m_Invoke(that.m_Invoke)
     {
-        m_pImpl = that.m_pImpl;
-        ((this_type&)that).m_pImpl = NULL;
+        this_type& other = const_cast< this_type& >(static_cast< this_type const& >(that));
+        move_from(other);
+        other.m_Invoke = NULL;
     }
 
 #if !defined(BOOST_NO_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
     template< typename FunT >
-    light_function(FunT&& fun) :
-        m_pImpl(new impl< typename remove_cv< typename remove_reference< FunT >::type >::type >(boost::forward< FunT >(fun)))
+    light_function(FunT&& fun, typename disable_if< is_same< typename remove_cv< typename remove_reference< FunT >::type >::type, this_type >, int >::type = 0) :
+        m_Invoke(NULL)
     {
+        typedef typename remove_cv< typename remove_reference< FunT >::type >::type function_type;
+        create< function_type >(boost::forward< FunT >(fun));
+        m_Invoke = &this_type::invoke_impl< function_type >;
     }
 #else
     template< typename FunT >
     light_function(FunT const& fun, typename disable_if< mpl::or_< move_detail::is_rv< FunT >, is_same< FunT, this_type > >, int >::type = 0) :
-        m_pImpl(new impl< FunT >(fun))
+        m_Invoke(NULL)
     {
+        create< FunT >(fun);
+        m_Invoke = &this_type::invoke_impl< FunT >;
     }
     template< typename FunT >
     light_function(rv< FunT > const& fun, typename disable_if< is_same< typename remove_cv< FunT >::type, this_type >, int >::type = 0) :
-        m_pImpl(new impl< typename remove_cv< FunT >::type >(fun))
+        m_Invoke(NULL)
     {
+        typedef typename remove_cv< FunT >::type function_type;
+        create< function_type >(static_cast< FunT const& >(fun));
+        m_Invoke = &this_type::invoke_impl< function_type >;
     }
 #endif
 
     //! Constructor from NULL
 #if !defined(BOOST_NO_NULLPTR) && !defined(BOOST_NO_CXX11_NULLPTR)
-    BOOST_CONSTEXPR light_function(std::nullptr_t) BOOST_NOEXCEPT
+    light_function(std::nullptr_t) BOOST_NOEXCEPT
 #else
-    BOOST_CONSTEXPR light_function(int p) BOOST_NOEXCEPT
+    light_function(int p) BOOST_NOEXCEPT
 #endif
-        : m_pImpl(NULL)
+        : m_Invoke(NULL)
     {
 #if defined(BOOST_NO_NULLPTR) || defined(BOOST_NO_CXX11_NULLPTR)
         BOOST_ASSERT(p == 0);
@@ -393,17 +513,23 @@ public:
     }
     ~light_function()
     {
-        clear();
+        destroy();
     }
 
     light_function& operator= (BOOST_RV_REF(this_type) that) BOOST_NOEXCEPT
     {
-        this->swap(that);
+        if (this != &that)
+        {
+            destroy();
+            move_from(that);
+            m_Invoke = that.m_Invoke;
+            that.m_Invoke = NULL;
+        }
         return *this;
     }
     light_function& operator= (BOOST_COPY_ASSIGN_REF(this_type) that)
     {
-        light_function tmp = that;
+        light_function tmp(static_cast< this_type const& >(that));
         this->swap(tmp);
         return *this;
     }
@@ -422,7 +548,8 @@ public:
     }
 #if !defined(BOOST_NO_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
     template< typename FunT >
-    light_function& operator= (FunT&& fun)
+    typename disable_if< is_same< typename remove_cv< typename remove_reference< FunT >::type >::type, this_type >, this_type& >::type
+    operator= (FunT&& fun)
     {
         light_function tmp(boost::forward< FunT >(fun));
         this->swap(tmp);
@@ -441,26 +568,24 @@ public:
 
     result_type operator() (ArgsT... args) const
     {
-        m_pImpl->invoke(m_pImpl, args...);
+        m_Invoke(m_Storage , args...);
     }
 
     BOOST_LOG_EXPLICIT_OPERATOR_BOOL()
-    bool operator! () const BOOST_NOEXCEPT { return (m_pImpl == NULL); }
-    bool empty() const BOOST_NOEXCEPT { return (m_pImpl == NULL); }
+    bool operator! () const BOOST_NOEXCEPT { return (m_Invoke == NULL); }
+    bool empty() const BOOST_NOEXCEPT { return (m_Invoke == NULL); }
     void clear() BOOST_NOEXCEPT
     {
-        if (m_pImpl)
-        {
-            m_pImpl->destroy(m_pImpl);
-            m_pImpl = NULL;
-        }
+        destroy();
+        m_Invoke = NULL;
     }
 
     void swap(this_type& that) BOOST_NOEXCEPT
     {
-        register impl_base* p = m_pImpl;
-        m_pImpl = that.m_pImpl;
-        that.m_pImpl = p;
+        swap_storage(that);
+        invoke_type p = m_Invoke;
+        m_Invoke = that.m_Invoke;
+        that.m_Invoke = p;
     }
 };
 
@@ -9,7 +9,8 @@ template<
     typename ResultT
     BOOST_PP_ENUM_TRAILING_PARAMS(BOOST_PP_ITERATION(), typename ArgT)
 >
-class light_function< ResultT (BOOST_PP_ENUM_PARAMS(BOOST_PP_ITERATION(), ArgT)) >
+class light_function< ResultT (BOOST_PP_ENUM_PARAMS(BOOST_PP_ITERATION(), ArgT)) > :
+    private light_function_base
 {
     typedef light_function this_type;
     BOOST_COPYABLE_AND_MOVABLE(this_type)
@@ -18,119 +19,74 @@ public:
     typedef ResultT result_type;
 
 private:
-    struct impl_base
-    {
-        typedef result_type (*invoke_type)(impl_base* BOOST_PP_ENUM_TRAILING_PARAMS(BOOST_PP_ITERATION(), ArgT));
-        const invoke_type invoke;
-
-        typedef impl_base* (*clone_type)(const impl_base*);
-        const clone_type clone;
-
-        typedef void (*destroy_type)(impl_base*);
-        const destroy_type destroy;
-
-        impl_base(invoke_type inv, clone_type cl, destroy_type dstr) : invoke(inv), clone(cl), destroy(dstr)
-        {
-        }
-    };
-
-#if !defined(BOOST_LOG_NO_MEMBER_TEMPLATE_FRIENDS)
-    template< typename FunT >
-    class impl;
-    template< typename FunT >
-    friend class impl;
-#endif
+    typedef result_type (*invoke_type)(storage& BOOST_PP_ENUM_TRAILING_PARAMS(BOOST_PP_ITERATION(), ArgT));
 
     template< typename FunT >
-    class impl :
-        public impl_base
+    static result_type invoke_impl(storage& s BOOST_PP_ENUM_TRAILING_BINARY_PARAMS(BOOST_PP_ITERATION(), ArgT, arg))
     {
-        typedef impl< FunT > this_type;
-
-        FunT m_Function;
-
-    public:
-        explicit impl(FunT const& fun) :
-            impl_base(&this_type::invoke_impl, &this_type::clone_impl, &this_type::destroy_impl),
-            m_Function(fun)
-        {
-        }
-
-#if !defined(BOOST_NO_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
-        explicit impl(FunT&& fun) :
-            impl_base(&this_type::invoke_impl, &this_type::clone_impl, &this_type::destroy_impl),
-            m_Function(fun)
-        {
-        }
-#endif // !defined(BOOST_NO_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
-
-        static void destroy_impl(impl_base* self)
-        {
-            delete static_cast< impl* >(self);
-        }
-        static impl_base* clone_impl(const impl_base* self)
-        {
-            return new impl(static_cast< const impl* >(self)->m_Function);
-        }
-        static result_type invoke_impl(impl_base* self BOOST_PP_ENUM_TRAILING_BINARY_PARAMS(BOOST_PP_ITERATION(), ArgT, arg))
-        {
-            return static_cast< impl* >(self)->m_Function(BOOST_PP_ENUM_PARAMS(BOOST_PP_ITERATION(), arg));
-        }
-    };
+        return manager< FunT >::get(s)(BOOST_PP_ENUM_PARAMS(BOOST_PP_ITERATION(), arg));
+    }
 
 private:
-    impl_base* m_pImpl;
+    invoke_type m_Invoke;
 
 public:
-    BOOST_CONSTEXPR light_function() BOOST_NOEXCEPT : m_pImpl(NULL)
+    light_function() BOOST_NOEXCEPT : m_Invoke(NULL)
     {
     }
-    light_function(this_type const& that)
+    light_function(this_type const& that) : light_function_base(), m_Invoke(NULL)
     {
-        if (that.m_pImpl)
-            m_pImpl = that.m_pImpl->clone(that.m_pImpl);
-        else
-            m_pImpl = NULL;
+        copy_from(that);
+        m_Invoke = that.m_Invoke;
     }
 
-    light_function(BOOST_RV_REF(this_type) that) BOOST_NOEXCEPT
+    light_function(BOOST_RV_REF(this_type) that) BOOST_NOEXCEPT : light_function_base(), m_Invoke(that.m_Invoke)
     {
-        m_pImpl = that.m_pImpl;
-        that.m_pImpl = NULL;
+        move_from(that);
+        that.m_Invoke = NULL;
     }
 
-    light_function(BOOST_RV_REF(const this_type) that) BOOST_NOEXCEPT
+    light_function(BOOST_RV_REF(const this_type) that) BOOST_NOEXCEPT : light_function_base(), m_Invoke(that.m_Invoke)
     {
-        m_pImpl = that.m_pImpl;
-        ((this_type&)that).m_pImpl = NULL;
+        this_type& other = const_cast< this_type& >(static_cast< this_type const& >(that));
+        move_from(other);
+        other.m_Invoke = NULL;
     }
 
 #if !defined(BOOST_NO_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
     template< typename FunT >
-    light_function(FunT&& fun) :
-        m_pImpl(new impl< typename remove_cv< typename remove_reference< FunT >::type >::type >(boost::forward< FunT >(fun)))
+    light_function(FunT&& fun, typename disable_if< is_same< typename remove_cv< typename remove_reference< FunT >::type >::type, this_type >, int >::type = 0) :
+        m_Invoke(NULL)
     {
+        typedef typename remove_cv< typename remove_reference< FunT >::type >::type function_type;
+        create< function_type >(boost::forward< FunT >(fun));
+        m_Invoke = &this_type::invoke_impl< function_type >;
     }
 #else
     template< typename FunT >
     light_function(FunT const& fun, typename disable_if< mpl::or_< move_detail::is_rv< FunT >, is_same< FunT, this_type > >, int >::type = 0) :
-        m_pImpl(new impl< FunT >(fun))
+        m_Invoke(NULL)
     {
+        create< FunT >(fun);
+        m_Invoke = &this_type::invoke_impl< FunT >;
     }
     template< typename FunT >
     light_function(rv< FunT > const& fun, typename disable_if< is_same< typename remove_cv< FunT >::type, this_type >, int >::type = 0) :
-        m_pImpl(new impl< typename remove_cv< FunT >::type >(fun))
+        m_Invoke(NULL)
     {
+        typedef typename remove_cv< FunT >::type function_type;
+        create< function_type >(static_cast< FunT const& >(fun));
+        m_Invoke = &this_type::invoke_impl< function_type >;
     }
 #endif
 
     //! Constructor from NULL
 #if !defined(BOOST_NO_NULLPTR) && !defined(BOOST_NO_CXX11_NULLPTR)
-    BOOST_CONSTEXPR light_function(std::nullptr_t) BOOST_NOEXCEPT
+    light_function(std::nullptr_t) BOOST_NOEXCEPT
 #else
-    BOOST_CONSTEXPR light_function(int p) BOOST_NOEXCEPT
+    light_function(int p) BOOST_NOEXCEPT
 #endif
-        : m_pImpl(NULL)
+        : m_Invoke(NULL)
     {
 #if defined(BOOST_NO_NULLPTR) || defined(BOOST_NO_CXX11_NULLPTR)
         BOOST_ASSERT(p == 0);
@@ -138,17 +94,23 @@ public:
     }
     ~light_function()
     {
-        clear();
+        destroy();
     }
 
     light_function& operator= (BOOST_RV_REF(this_type) that) BOOST_NOEXCEPT
     {
-        this->swap(that);
+        if (this != &that)
+        {
+            destroy();
+            move_from(that);
+            m_Invoke = that.m_Invoke;
+            that.m_Invoke = NULL;
+        }
         return *this;
     }
     light_function& operator= (BOOST_COPY_ASSIGN_REF(this_type) that)
     {
-        light_function tmp = that;
+        light_function tmp(static_cast< this_type const& >(that));
         this->swap(tmp);
         return *this;
     }
@@ -167,7 +129,8 @@ public:
     }
 #if !defined(BOOST_NO_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
     template< typename FunT >
-    light_function& operator= (FunT&& fun)
+    typename disable_if< is_same< typename remove_cv< typename remove_reference< FunT >::type >::type, this_type >, this_type& >::type
+    operator= (FunT&& fun)
     {
         light_function tmp(boost::forward< FunT >(fun));
         this->swap(tmp);
@@ -186,33 +149,32 @@ public:
 
     result_type operator() (BOOST_PP_ENUM_BINARY_PARAMS(BOOST_PP_ITERATION(), ArgT, arg)) const
     {
-        return m_pImpl->invoke(m_pImpl BOOST_PP_ENUM_TRAILING_PARAMS(BOOST_PP_ITERATION(), arg));
+        return m_Invoke(m_Storage BOOST_PP_ENUM_TRAILING_PARAMS(BOOST_PP_ITERATION(), arg));
     }
 
     BOOST_LOG_EXPLICIT_OPERATOR_BOOL()
-    bool operator! () const BOOST_NOEXCEPT { return (m_pImpl == NULL); }
-    bool empty() const BOOST_NOEXCEPT { return (m_pImpl == NULL); }
+    bool operator! () const BOOST_NOEXCEPT { return (m_Invoke == NULL); }
+    bool empty() const BOOST_NOEXCEPT { return (m_Invoke == NULL); }
     void clear() BOOST_NOEXCEPT
     {
-        if (m_pImpl)
-        {
-            m_pImpl->destroy(m_pImpl);
-            m_pImpl = NULL;
-        }
+        destroy();
+        m_Invoke = NULL;
     }
 
     void swap(this_type& that) BOOST_NOEXCEPT
     {
-        register impl_base* p = m_pImpl;
-        m_pImpl = that.m_pImpl;
-        that.m_pImpl = p;
+        swap_storage(that);
+        invoke_type p = m_Invoke;
+        m_Invoke = that.m_Invoke;
+        that.m_Invoke = p;
     }
 };
 
 template<
     BOOST_PP_ENUM_PARAMS(BOOST_PP_ITERATION(), typename ArgT)
 >
-class light_function< void (BOOST_PP_ENUM_PARAMS(BOOST_PP_ITERATION(), ArgT)) >
+class light_function< void (BOOST_PP_ENUM_PARAMS(BOOST_PP_ITERATION(), ArgT)) > :
+    private light_function_base
 {
     typedef light_function this_type;
     BOOST_COPYABLE_AND_MOVABLE(this_type)
@@ -221,118 +183,74 @@ public:
     typedef void result_type;
 
 private:
-    struct impl_base
-    {
-        typedef void (*invoke_type)(impl_base* BOOST_PP_ENUM_TRAILING_PARAMS(BOOST_PP_ITERATION(), ArgT));
-        const invoke_type invoke;
-
-        typedef impl_base* (*clone_type)(const impl_base*);
-        const clone_type clone;
-
-        typedef void (*destroy_type)(impl_base*);
-        const destroy_type destroy;
-
-        impl_base(invoke_type inv, clone_type cl, destroy_type dstr) : invoke(inv), clone(cl), destroy(dstr)
-        {
-        }
-    };
-
-#if !defined(BOOST_LOG_NO_MEMBER_TEMPLATE_FRIENDS)
-    template< typename FunT >
-    class impl;
-    template< typename FunT >
-    friend class impl;
-#endif
+    typedef result_type (*invoke_type)(storage& BOOST_PP_ENUM_TRAILING_PARAMS(BOOST_PP_ITERATION(), ArgT));
 
     template< typename FunT >
-    class impl :
-        public impl_base
+    static result_type invoke_impl(storage& s BOOST_PP_ENUM_TRAILING_BINARY_PARAMS(BOOST_PP_ITERATION(), ArgT, arg))
     {
-        typedef impl< FunT > this_type;
-
-        FunT m_Function;
-
-    public:
-        explicit impl(FunT const& fun) :
-            impl_base(&this_type::invoke_impl, &this_type::clone_impl, &this_type::destroy_impl),
-            m_Function(fun)
-        {
-        }
-
-#if !defined(BOOST_NO_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
-        explicit impl(FunT&& fun) :
-            impl_base(&this_type::invoke_impl, &this_type::clone_impl, &this_type::destroy_impl),
-            m_Function(fun)
-        {
-        }
-#endif // !defined(BOOST_NO_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
-
-        static void destroy_impl(impl_base* self)
-        {
-            delete static_cast< impl* >(self);
-        }
-        static impl_base* clone_impl(const impl_base* self)
-        {
-            return new impl(static_cast< const impl* >(self)->m_Function);
-        }
-        static result_type invoke_impl(impl_base* self BOOST_PP_ENUM_TRAILING_BINARY_PARAMS(BOOST_PP_ITERATION(), ArgT, arg))
-        {
-            static_cast< impl* >(self)->m_Function(BOOST_PP_ENUM_PARAMS(BOOST_PP_ITERATION(), arg));
-        }
-    };
+        manager< FunT >::get(s)(BOOST_PP_ENUM_PARAMS(BOOST_PP_ITERATION(), arg));
+    }
 
 private:
-    impl_base* m_pImpl;
+    invoke_type m_Invoke;
 
 public:
-    BOOST_CONSTEXPR light_function() BOOST_NOEXCEPT : m_pImpl(NULL)
+    light_function() BOOST_NOEXCEPT : m_Invoke(NULL)
     {
     }
-    light_function(this_type const& that)
+    light_function(this_type const& that) : light_function_base(), m_Invoke(NULL)
     {
-        if (that.m_pImpl)
-            m_pImpl = that.m_pImpl->clone(that.m_pImpl);
-        else
-            m_pImpl = NULL;
+        copy_from(that);
+        m_Invoke = that.m_Invoke;
     }
-    light_function(BOOST_RV_REF(this_type) that) BOOST_NOEXCEPT
+
+    light_function(BOOST_RV_REF(this_type) that) BOOST_NOEXCEPT : light_function_base(), m_Invoke(that.m_Invoke)
     {
-        m_pImpl = that.m_pImpl;
-        that.m_pImpl = NULL;
+        move_from(that);
+        that.m_Invoke = NULL;
     }
 
-    light_function(BOOST_RV_REF(const this_type) that) BOOST_NOEXCEPT
+    light_function(BOOST_RV_REF(const this_type) that) BOOST_NOEXCEPT : light_function_base(), m_Invoke(that.m_Invoke)
     {
-        m_pImpl = that.m_pImpl;
-        ((this_type&)that).m_pImpl = NULL;
+        this_type& other = const_cast< this_type& >(static_cast< this_type const& >(that));
+        move_from(other);
+        other.m_Invoke = NULL;
     }
 
 #if !defined(BOOST_NO_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
     template< typename FunT >
-    light_function(FunT&& fun) :
-        m_pImpl(new impl< typename remove_cv< typename remove_reference< FunT >::type >::type >(boost::forward< FunT >(fun)))
+    light_function(FunT&& fun, typename disable_if< is_same< typename remove_cv< typename remove_reference< FunT >::type >::type, this_type >, int >::type = 0) :
+        m_Invoke(NULL)
     {
+        typedef typename remove_cv< typename remove_reference< FunT >::type >::type function_type;
+        create< function_type >(boost::forward< FunT >(fun));
+        m_Invoke = &this_type::invoke_impl< function_type >;
     }
 #else
     template< typename FunT >
     light_function(FunT const& fun, typename disable_if< mpl::or_< move_detail::is_rv< FunT >, is_same< FunT, this_type > >, int >::type = 0) :
-        m_pImpl(new impl< FunT >(fun))
+        m_Invoke(NULL)
     {
+        create< FunT >(fun);
+        m_Invoke = &this_type::invoke_impl< FunT >;
     }
     template< typename FunT >
     light_function(rv< FunT > const& fun, typename disable_if< is_same< typename remove_cv< FunT >::type, this_type >, int >::type = 0) :
-        m_pImpl(new impl< typename remove_cv< FunT >::type >(fun))
+        m_Invoke(NULL)
     {
+        typedef typename remove_cv< FunT >::type function_type;
+        create< function_type >(static_cast< FunT const& >(fun));
+        m_Invoke = &this_type::invoke_impl< function_type >;
     }
 #endif
 
     //! Constructor from NULL
 #if !defined(BOOST_NO_NULLPTR) && !defined(BOOST_NO_CXX11_NULLPTR)
-    BOOST_CONSTEXPR light_function(std::nullptr_t) BOOST_NOEXCEPT
+    light_function(std::nullptr_t) BOOST_NOEXCEPT
 #else
-    BOOST_CONSTEXPR light_function(int p) BOOST_NOEXCEPT
+    light_function(int p) BOOST_NOEXCEPT
 #endif
-        : m_pImpl(NULL)
+        : m_Invoke(NULL)
     {
 #if defined(BOOST_NO_NULLPTR) || defined(BOOST_NO_CXX11_NULLPTR)
         BOOST_ASSERT(p == 0);
@@ -340,17 +258,23 @@ public:
     }
     ~light_function()
     {
-        clear();
+        destroy();
     }
 
     light_function& operator= (BOOST_RV_REF(this_type) that) BOOST_NOEXCEPT
     {
-        this->swap(that);
+        if (this != &that)
+        {
+            destroy();
+            move_from(that);
+            m_Invoke = that.m_Invoke;
+            that.m_Invoke = NULL;
+        }
         return *this;
     }
     light_function& operator= (BOOST_COPY_ASSIGN_REF(this_type) that)
     {
-        light_function tmp = that;
+        light_function tmp(static_cast< this_type const& >(that));
         this->swap(tmp);
         return *this;
     }
@@ -369,7 +293,8 @@ public:
     }
 #if !defined(BOOST_NO_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
     template< typename FunT >
-    light_function& operator= (FunT&& fun)
+    typename disable_if< is_same< typename remove_cv< typename remove_reference< FunT >::type >::type, this_type >, this_type& >::type
+    operator= (FunT&& fun)
     {
         light_function tmp(boost::forward< FunT >(fun));
         this->swap(tmp);
@@ -388,25 +313,23 @@ public:
 
     result_type operator() (BOOST_PP_ENUM_BINARY_PARAMS(BOOST_PP_ITERATION(), ArgT, arg)) const
     {
-        m_pImpl->invoke(m_pImpl BOOST_PP_ENUM_TRAILING_PARAMS(BOOST_PP_ITERATION(), arg));
+        m_Invoke(m_Storage BOOST_PP_ENUM_TRAILING_PARAMS(BOOST_PP_ITERATION(), arg));
     }
 
     BOOST_LOG_EXPLICIT_OPERATOR_BOOL()
-    bool operator! () const BOOST_NOEXCEPT { return (m_pImpl == NULL); }
-    bool empty() const BOOST_NOEXCEPT { return (m_pImpl == NULL); }
+    bool operator! () const BOOST_NOEXCEPT { return (m_Invoke == NULL); }
+    bool empty() const BOOST_NOEXCEPT { return (m_Invoke == NULL); }
     void clear() BOOST_NOEXCEPT
     {
-        if (m_pImpl)
-        {
-            m_pImpl->destroy(m_pImpl);
-            m_pImpl = NULL;
-        }
+        destroy();
+        m_Invoke = NULL;
     }
 
     void swap(this_type& that) BOOST_NOEXCEPT
     {
-        register impl_base* p = m_pImpl;
-        m_pImpl = that.m_pImpl;
-        that.m_pImpl = p;
+        swap_storage(that);
+        invoke_type p = m_Invoke;
+        m_Invoke = that.m_Invoke;
+        that.m_Invoke = p;
     }
 };
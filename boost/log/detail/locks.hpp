@@ -71,11 +71,15 @@ struct is_exclusively_lockable
     typedef char true_type;
     struct false_type { char t[2]; };
 
+    template< typename T, void (T::*)() >
+    struct member_check {};
+
+    template< typename T >
+    static true_type check(member_check< T, &T::lock >*, member_check< T, &T::unlock >*);
     template< typename T >
-    static true_type check(T*, void (T::*)() = &T::lock, void (T::*)() = &T::unlock);
-    static false_type check(void*);
+    static false_type check(...);
 
-    enum value_t { value = sizeof(check((MutexT*)NULL)) == sizeof(true_type) };
+    enum value_t { value = sizeof(check< MutexT >(NULL, NULL)) == sizeof(true_type) };
 };
 
 //! A trait to detect if the mutex supports shared locking
@@ -85,11 +89,15 @@ struct is_shared_lockable
     typedef char true_type;
     struct false_type { char t[2]; };
 
+    template< typename T, void (T::*)() >
+    struct member_check {};
+
+    template< typename T >
+    static true_type check(member_check< T, &T::lock_shared >*, member_check< T, &T::unlock_shared >*);
     template< typename T >
-    static true_type check(T*, void (T::*)() = &T::lock_shared, void (T::*)() = &T::unlock_shared);
-    static false_type check(void*);
+    static false_type check(...);
 
-    enum value_t { value = sizeof(check((MutexT*)NULL)) == sizeof(true_type) };
+    enum value_t { value = sizeof(check< MutexT >(NULL, NULL)) == sizeof(true_type) };
 };
 
 //! An analogue to the minimalistic \c lock_guard template. Defined here to avoid including Boost.Thread.
@@ -0,0 +1,88 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   ordering_key.hpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/libs/log/doc/log.html.
+ */
+
+#ifndef BOOST_LOG_DETAIL_ORDERING_KEY_HPP_INCLUDED_
+#define BOOST_LOG_DETAIL_ORDERING_KEY_HPP_INCLUDED_
+
+#include <boost/mpl/has_xxx.hpp>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/core/record_view.hpp>
+#include <boost/log/detail/header.hpp>
+
+#ifdef BOOST_LOG_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace aux {
+
+/*!
+ * The trait detects ordering predicates that support precomputed ordering keys. Such predicates define
+ * the \c ordering_key_type type, the <tt>get_ordering_key(record_view const&)</tt> method that extracts
+ * the key from a record and the <tt>compare_ordering_keys(ordering_key_type const&, ordering_key_type const&)</tt>
+ * method that orders the keys the same way the records are ordered.
+ */
+BOOST_MPL_HAS_XXX_TRAIT_NAMED_DEF(has_ordering_key, ordering_key_type, false)
+
+/*!
+ * The class holds the ordering key of a record stored in an ordering queue. This general implementation
+ * is used with the predicates that do not support precomputed keys, the records are compared directly.
+ */
+template< typename OrderT, bool HasKeyV = has_ordering_key< OrderT >::value >
+class ordering_key_holder
+{
+public:
+    ordering_key_holder(OrderT const&, record_view const&) {}
+
+    //! Orders records
+    static bool less(OrderT const& order, ordering_key_holder const&, record_view const& left, ordering_key_holder const&, record_view const& right)
+    {
+        return order(left, right);
+    }
+};
+
+/*!
+ * The class holds the ordering key of a record stored in an ordering queue. The key is extracted
+ * once when the record is enqueued, the records are ordered by comparing the keys.
+ */
+template< typename OrderT >
+class ordering_key_holder< OrderT, true >
+{
+private:
+    //! Ordering key
+    typename OrderT::ordering_key_type m_OrderingKey;
+
+public:
+    ordering_key_holder(OrderT const& order, record_view const& rec) : m_OrderingKey(order.get_ordering_key(rec)) {}
+
+    //! Orders records
+    static bool less(OrderT const& order, ordering_key_holder const& left_key, record_view const&, ordering_key_holder const& right_key, record_view const&)
+    {
+        return order.compare_ordering_keys(left_key.m_OrderingKey, right_key.m_OrderingKey);
+    }
+};
+
+} // namespace aux
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_DETAIL_ORDERING_KEY_HPP_INCLUDED_
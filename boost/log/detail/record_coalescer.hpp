@@ -0,0 +1,82 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   record_coalescer.hpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/libs/log/doc/log.html.
+ */
+
+#ifndef BOOST_LOG_DETAIL_RECORD_COALESCER_HPP_INCLUDED_
+#define BOOST_LOG_DETAIL_RECORD_COALESCER_HPP_INCLUDED_
+
+#include <boost/cstdint.hpp>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/core/record_view.hpp>
+#include <boost/log/detail/header.hpp>
+
+#ifdef BOOST_LOG_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace aux {
+
+/*!
+ * \brief The stage of merging repeated log records
+ *
+ * Records with equal severity level, channel and message are considered repeated. The first record
+ * of a kind passes the stage immediately and opens a time window. The repeated records that come
+ * within the window are merged into a single record, which is released when the window closes.
+ * The merged record is a copy of the first repeated record with additional attribute values: the number
+ * of the merged records, and the time stamps of the first and the last merged records.
+ *
+ * The stage keeps a small fixed-size table of the recently seen records. When the table is full,
+ * the oldest entries are evicted and their merged records are released early. The stage is not thread-safe.
+ */
+class record_coalescer
+{
+private:
+    struct implementation;
+    implementation* m_pImpl;
+
+public:
+    //! Constructor. The window is specified in milliseconds.
+    BOOST_LOG_API explicit record_coalescer(uint64_t window);
+    //! Destructor
+    BOOST_LOG_API ~record_coalescer();
+
+    //! Passes the record through the stage. The record is either released or merged with the previous records.
+    BOOST_LOG_API void push(record_view const& rec);
+    //! Releases the merged records whose windows are closed, or all merged records if \a all is \c true
+    BOOST_LOG_API void expire(bool all);
+    //! Extracts the next released record. Returns \c false if there are no released records.
+    BOOST_LOG_API bool pop(record_view& rec);
+    //! Returns \c true if there are merged records that are not released yet
+    BOOST_LOG_API bool has_merged_records() const;
+    //! Returns the number of milliseconds until the first merged record is due to be released
+    BOOST_LOG_API uint64_t time_to_expiration() const;
+
+    //  Copying and assignment prohibited
+    BOOST_LOG_DELETED_FUNCTION(record_coalescer(record_coalescer const&))
+    BOOST_LOG_DELETED_FUNCTION(record_coalescer& operator= (record_coalescer const&))
+};
+
+} // namespace aux
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_DETAIL_RECORD_COALESCER_HPP_INCLUDED_
@@ -0,0 +1,86 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   type_index.hpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/libs/log/doc/log.html. In this file
+ *         type indices for type dispatching are implemented.
+ */
+
+#ifndef BOOST_LOG_DETAIL_TYPE_INDEX_HPP_INCLUDED_
+#define BOOST_LOG_DETAIL_TYPE_INDEX_HPP_INCLUDED_
+
+#include <typeinfo>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/detail/visible_type.hpp>
+#include <boost/log/utility/once_block.hpp>
+#include <boost/log/detail/header.hpp>
+
+#ifdef BOOST_LOG_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace aux {
+
+/*!
+ * Type index. Type indices are small integers that are assigned to types on the first request and
+ * are unique within the process. The indices are allocated sequentially, starting from 1. The zero
+ * index is never assigned to a type and can be used as an empty value.
+ */
+typedef unsigned int type_index;
+
+/*!
+ * The function returns the index of the type described by the type info. The index is assigned on
+ * the first call for the type. The types are compared by their type info, so that the index of the
+ * type is the same in all modules of the application.
+ */
+BOOST_LOG_API type_index register_type_index(std::type_info const& type);
+
+//! The holder of the type index for the type \c T in the current module
+template< typename T >
+struct type_index_holder
+{
+    static type_index value;
+
+    static type_index get()
+    {
+        BOOST_LOG_ONCE_BLOCK()
+        {
+            value = register_type_index(typeid(visible_type< T >));
+        }
+        return value;
+    }
+};
+
+template< typename T >
+type_index type_index_holder< T >::value = 0;
+
+/*!
+ * The function returns the index of the type \c T
+ */
+template< typename T >
+BOOST_LOG_FORCEINLINE type_index get_type_index()
+{
+    return type_index_holder< T >::get();
+}
+
+} // namespace aux
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_DETAIL_TYPE_INDEX_HPP_INCLUDED_
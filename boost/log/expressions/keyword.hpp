@@ -31,6 +31,7 @@
 #include <boost/log/attributes/attribute_name.hpp>
 #include <boost/log/attributes/value_extraction.hpp>
 #include <boost/log/attributes/fallback_policy.hpp>
+#include <boost/log/utility/once_block.hpp>
 #include <boost/log/detail/header.hpp>
 
 #ifdef BOOST_LOG_HAS_PRAGMA_ONCE
@@ -193,7 +194,15 @@ struct protoify< boost::reference_wrapper< const boost::log::expressions::attrib
             public ::boost::log::expressions::keyword_descriptor\
         {\
             typedef value_type_ value_type;\
-            static ::boost::log::attribute_name get_name() { return ::boost::log::attribute_name(name_); }\
+            static ::boost::log::attribute_name get_name()\
+            {\
+                static ::boost::log::attribute_name name;\
+                BOOST_LOG_ONCE_BLOCK()\
+                {\
+                    name = ::boost::log::attribute_name(name_);\
+                }\
+                return name;\
+            }\
         };\
     }\
     typedef ::boost::log::expressions::attribute_keyword< tag_ns_::keyword_ > BOOST_PP_CAT(keyword_, _type);
@@ -23,6 +23,7 @@
 #include <boost/log/expressions/predicates/contains.hpp>
 #include <boost/log/expressions/predicates/matches.hpp>
 #include <boost/log/expressions/predicates/is_in_range.hpp>
+#include <boost/log/expressions/predicates/rate_limit.hpp>
 
 #include <boost/log/expressions/predicates/is_debugger_present.hpp>
 #include <boost/log/expressions/predicates/channel_severity_filter.hpp>
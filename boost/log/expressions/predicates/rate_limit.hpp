@@ -0,0 +1,193 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   rate_limit.hpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * The header contains implementation of filters that limit the number of log records made at every call site.
+ */
+
+#ifndef BOOST_LOG_EXPRESSIONS_PREDICATES_RATE_LIMIT_HPP_INCLUDED_
+#define BOOST_LOG_EXPRESSIONS_PREDICATES_RATE_LIMIT_HPP_INCLUDED_
+
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/phoenix/core/actor.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/core/record_view.hpp>
+#include <boost/log/attributes/call_site.hpp>
+#include <boost/log/attributes/attribute_name.hpp>
+#include <boost/log/attributes/attribute_value_set.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
+#include <boost/log/detail/call_site_limiter.hpp>
+#include <boost/log/detail/unary_function_terminal.hpp>
+#include <boost/log/detail/header.hpp>
+
+#ifdef BOOST_LOG_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace expressions {
+
+/*!
+ * The predicate limits the number of log records that pass per period of time at every call site.
+ * The predicate registers the \c current_call_site attribute in the global attribute set of the logging core,
+ * unless an attribute with the specified name is already registered. Log records without the call site
+ * attribute value always pass. The state of the predicate is shared between its copies.
+ */
+class rate_limiter
+{
+public:
+    //! Function result_type
+    typedef bool result_type;
+
+private:
+    //! Call site attribute name
+    attribute_name m_name;
+    //! Call site counters
+    shared_ptr< boost::log::aux::call_site_limiter > m_limiter;
+
+public:
+    /*!
+     * Initializing constructor
+     *
+     * \param name Call site attribute name
+     * \param count The number of log records that pass per period at every call site
+     * \param period The period of time
+     */
+    rate_limiter(attribute_name const& name, uintmax_t count, posix_time::time_duration const& period) :
+        m_name(name),
+        m_limiter(boost::make_shared< boost::log::aux::call_site_limiter >(
+            boost::log::aux::call_site_limiter::token_bucket, count, static_cast< uint64_t >(period.total_milliseconds())))
+    {
+        boost::log::aux::register_call_site_attribute(name);
+    }
+
+    /*!
+     * Checking operator
+     *
+     * \param attrs A set of attribute values
+     * \return \c true if the log record should pass, \c false if it should be suppressed
+     */
+    result_type operator() (attribute_value_set const& attrs) const
+    {
+        value_ref< call_site > site = boost::log::extract< call_site >(m_name, attrs);
+        return !site || m_limiter->check(site.get());
+    }
+
+    /*!
+     * Checking operator
+     *
+     * \param rec A log record
+     * \return \c true if the log record should pass, \c false if it should be suppressed
+     */
+    result_type operator() (boost::log::record_view const& rec) const
+    {
+        return operator()(rec.attribute_values());
+    }
+};
+
+/*!
+ * The predicate passes one of every N log records made at every call site. The predicate registers
+ * the \c current_call_site attribute in the global attribute set of the logging core, unless an attribute
+ * with the specified name is already registered. Log records without the call site attribute value always pass.
+ * The state of the predicate is shared between its copies.
+ */
+class sampler
+{
+public:
+    //! Function result_type
+    typedef bool result_type;
+
+private:
+    //! Call site attribute name
+    attribute_name m_name;
+    //! Call site counters
+    shared_ptr< boost::log::aux::call_site_limiter > m_limiter;
+
+public:
+    /*!
+     * Initializing constructor
+     *
+     * \param name Call site attribute name
+     * \param ratio One of \a ratio log records passes at every call site
+     * \param report_interval The minimum interval between reports of the suppressed log records at every call site
+     */
+    sampler(attribute_name const& name, uintmax_t ratio, posix_time::time_duration const& report_interval) :
+        m_name(name),
+        m_limiter(boost::make_shared< boost::log::aux::call_site_limiter >(
+            boost::log::aux::call_site_limiter::sampling, ratio, static_cast< uint64_t >(report_interval.total_milliseconds())))
+    {
+        boost::log::aux::register_call_site_attribute(name);
+    }
+
+    /*!
+     * Checking operator
+     *
+     * \param attrs A set of attribute values
+     * \return \c true if the log record should pass, \c false if it should be suppressed
+     */
+    result_type operator() (attribute_value_set const& attrs) const
+    {
+        value_ref< call_site > site = boost::log::extract< call_site >(m_name, attrs);
+        return !site || m_limiter->check(site.get());
+    }
+
+    /*!
+     * Checking operator
+     *
+     * \param rec A log record
+     * \return \c true if the log record should pass, \c false if it should be suppressed
+     */
+    result_type operator() (boost::log::record_view const& rec) const
+    {
+        return operator()(rec.attribute_values());
+    }
+};
+
+/*!
+ * The function generates a terminal node in a template expression. The node will pass at most \a count
+ * log records per \a period at every call site. The call site is identified by the value of the specified attribute.
+ * When a log record passes after some records at the same call site were suppressed, the logging macro
+ * makes an additional record that reports the number of suppressed records, no more than once per \a period.
+ */
+inline phoenix::actor< aux::unary_function_terminal< rate_limiter > > rate_limit(attribute_name const& name, uintmax_t count, posix_time::time_duration const& period)
+{
+    typedef aux::unary_function_terminal< rate_limiter > terminal_type;
+    phoenix::actor< terminal_type > act = {{ terminal_type(name, count, period) }};
+    return act;
+}
+
+/*!
+ * The function generates a terminal node in a template expression. The node will pass one of every \a ratio
+ * log records at every call site. The call site is identified by the value of the specified attribute.
+ * When a log record passes after some records at the same call site were suppressed, the logging macro
+ * makes an additional record that reports the number of suppressed records, no more than once per \a report_interval.
+ */
+inline phoenix::actor< aux::unary_function_terminal< sampler > > sample(attribute_name const& name, uintmax_t ratio, posix_time::time_duration const& report_interval = posix_time::seconds(1))
+{
+    typedef aux::unary_function_terminal< sampler > terminal_type;
+    phoenix::actor< terminal_type > act = {{ terminal_type(name, ratio, report_interval) }};
+    return act;
+}
+
+} // namespace expressions
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_EXPRESSIONS_PREDICATES_RATE_LIMIT_HPP_INCLUDED_
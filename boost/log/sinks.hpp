@@ -23,6 +23,7 @@
 #if !defined(BOOST_LOG_NO_THREADS)
 #include <boost/log/sinks/sync_frontend.hpp>
 #include <boost/log/sinks/async_frontend.hpp>
+#include <boost/log/sinks/flight_recorder_frontend.hpp>
 #include <boost/log/sinks/unbounded_fifo_queue.hpp>
 #include <boost/log/sinks/unbounded_ordering_queue.hpp>
 #include <boost/log/sinks/bounded_fifo_queue.hpp>
@@ -31,6 +32,7 @@
 #include <boost/log/sinks/block_on_overflow.hpp>
 #endif // !defined(BOOST_LOG_NO_THREADS)
 
+#include <boost/log/sinks/binary_ostream_backend.hpp>
 #include <boost/log/sinks/syslog_backend.hpp>
 #include <boost/log/sinks/text_file_backend.hpp>
 #include <boost/log/sinks/text_multifile_backend.hpp>
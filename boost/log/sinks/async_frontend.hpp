@@ -15,7 +15,11 @@
 #ifndef BOOST_LOG_SINKS_ASYNC_FRONTEND_HPP_INCLUDED_
 #define BOOST_LOG_SINKS_ASYNC_FRONTEND_HPP_INCLUDED_
 
+#include <cstddef>
+#include <vector>
+#include <boost/cstdint.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/scoped_ptr.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/static_assert.hpp>
 #include <boost/log/detail/config.hpp>
@@ -29,18 +33,25 @@
 #endif
 
 #include <boost/bind.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/exception_ptr.hpp>
 #include <boost/thread/locks.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/thread.hpp>
+#include <boost/thread/thread_time.hpp>
 #include <boost/thread/condition_variable.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <boost/log/exceptions.hpp>
 #include <boost/log/detail/locking_ptr.hpp>
 #include <boost/log/detail/parameter_tools.hpp>
+#include <boost/log/detail/record_coalescer.hpp>
 #include <boost/log/core/record_view.hpp>
 #include <boost/log/sinks/basic_sink_frontend.hpp>
 #include <boost/log/sinks/frontend_requirements.hpp>
 #include <boost/log/sinks/unbounded_fifo_queue.hpp>
 #include <boost/log/keywords/start_thread.hpp>
+#include <boost/log/keywords/formatting_threads.hpp>
+#include <boost/log/keywords/coalescing_window.hpp>
 #include <boost/log/detail/header.hpp>
 
 namespace boost {
@@ -51,6 +62,36 @@ namespace sinks {
 
 #ifndef BOOST_LOG_DOXYGEN_PASS
 
+namespace aux {
+
+//! A trait to detect if the queueing strategy supports dequeueing records with a deadline
+template< typename QueueT >
+struct has_timed_dequeue_ready
+{
+    typedef char true_type;
+    struct false_type { char t[2]; };
+
+    //! The structure makes the protected queue methods accessible
+    template< typename T >
+    struct queue_access :
+        public T
+    {
+        using T::try_dequeue_ready;
+    };
+
+    template< typename T, bool (T::*)(record_view&, posix_time::ptime const&) >
+    struct member_check {};
+
+    template< typename T >
+    static true_type check(member_check< T, &queue_access< T >::try_dequeue_ready >*);
+    template< typename T >
+    static false_type check(...);
+
+    enum value_t { value = sizeof(check< QueueT >(NULL)) == sizeof(true_type) };
+};
+
+} // namespace aux
+
 #define BOOST_LOG_SINK_CTOR_FORWARD_INTERNAL(z, n, types)\
     template< BOOST_PP_ENUM_PARAMS(n, typename T) >\
     explicit asynchronous_sink(BOOST_PP_ENUM_BINARY_PARAMS(n, T, const& arg)) :\
@@ -58,7 +99,9 @@ namespace sinks {
         queue_base_type((BOOST_PP_ENUM_PARAMS(n, arg))),\
         m_pBackend(boost::make_shared< sink_backend_type >(BOOST_PP_ENUM_PARAMS(n, arg))),\
         m_StopRequested(false),\
-        m_FlushRequested(false)\
+        m_FlushRequested(false),\
+        m_FormattingThreads((BOOST_PP_ENUM_PARAMS(n, arg))[keywords::formatting_threads | 0u]),\
+        m_pCoalescer(create_coalescer((BOOST_PP_ENUM_PARAMS(n, arg))[keywords::coalescing_window | posix_time::time_duration()]))\
     {\
         if ((BOOST_PP_ENUM_PARAMS(n, arg))[keywords::start_thread | true])\
             start_feeding_thread();\
@@ -69,7 +112,9 @@ namespace sinks {
         queue_base_type((BOOST_PP_ENUM_PARAMS(n, arg))),\
         m_pBackend(backend),\
         m_StopRequested(false),\
-        m_FlushRequested(false)\
+        m_FlushRequested(false),\
+        m_FormattingThreads((BOOST_PP_ENUM_PARAMS(n, arg))[keywords::formatting_threads | 0u]),\
+        m_pCoalescer(create_coalescer((BOOST_PP_ENUM_PARAMS(n, arg))[keywords::coalescing_window | posix_time::time_duration()]))\
     {\
         if ((BOOST_PP_ENUM_PARAMS(n, arg))[keywords::start_thread | true])\
             start_feeding_thread();\
@@ -82,6 +127,23 @@ namespace sinks {
  *
  * The frontend starts a separate thread on construction. All logging records are passed
  * to the backend in this dedicated thread only.
+ *
+ * If the backend requires formatting, the frontend can be configured to format records in
+ * a pool of threads with the \c formatting_threads named parameter. The formatting threads
+ * are started when the record feeding loop starts and stopped when it exits. The formatted
+ * records are still passed to the backend in the feeding thread, in the order they are
+ * dequeued according to the queueing strategy.
+ *
+ * The frontend can also be configured to merge repeated log records with the \c coalescing_window
+ * named parameter. Records with equal severity level, channel and message that are dequeued within
+ * the window after the first such record are merged into a single record, which is passed to
+ * the backend when the window closes. The merged record has additional attribute values "RepeatCount",
+ * "FirstTimeStamp" and "LastTimeStamp". Records are merged before they are formatted. Severity levels
+ * and channel names must be of integral or string types or \c trivial::severity_level; records with
+ * values of other types, such as user-defined severity level enums, are passed to the backend unmerged. While there are
+ * merged records, the feeding thread blocks in the \c try_dequeue_ready method of the queueing strategy
+ * that accepts a deadline. Custom queueing strategies are not required to provide this method; if it is
+ * missing, the feeding thread polls the queue while the windows of the merged records are open.
  */
 template< typename SinkBackendT, typename QueueingStrategyT = unbounded_fifo_queue >
 class asynchronous_sink :
@@ -177,6 +239,235 @@ private:
         scoped_flag& operator= (scoped_flag const&);
     };
 
+    //! Records that are being formatted in parallel before passing to the backend
+    template< typename StringT >
+    class formatting_pipeline
+    {
+    private:
+        //! The number of record slots per formatting thread
+        enum { slots_per_thread = 32 };
+        //! The maximum number of records a formatting thread takes at once
+        enum { max_chunk_size = 8 };
+
+        //! Log record slot
+        struct slot
+        {
+            //! Log record
+            record_view m_Record;
+            //! Formatted record
+            StringT m_FormattedRecord;
+            //! The exception thrown by the formatter
+            boost::exception_ptr m_Exception;
+            //! The flag indicates that the record has been formatted
+            bool m_Formatted;
+
+            slot() : m_Formatted(false) {}
+        };
+
+    private:
+        //! The sink frontend
+        asynchronous_sink& m_Sink;
+        //! Synchronization mutex
+        mutex m_Mutex;
+        //! The condition is signalled when there are new records to format
+        condition_variable m_FormatCond;
+        //! The condition is signalled when the records have been formatted
+        condition_variable m_FeedCond;
+        //! Record slots
+        std::vector< slot > m_Slots;
+        //! Sequence number of the next record to be fed to the backend. Only accessed by the feeding thread.
+        std::size_t m_Head;
+        //! Sequence number of the next record to be put to the pipeline. Only accessed by the feeding thread.
+        std::size_t m_Tail;
+        //! Sequence number past the last record that is available to the formatting threads
+        std::size_t m_Published;
+        //! Sequence number of the next record to be formatted
+        std::size_t m_NextToFormat;
+        //! The number of formatting threads waiting for records
+        unsigned int m_IdleThreads;
+        //! The flag indicates that the feeding thread waits for records to be formatted
+        bool m_FeederWaiting;
+        //! The flag indicates that the formatting threads have to stop
+        bool m_StopRequested;
+        //! Formatting threads
+        thread_group m_Threads;
+
+    public:
+        //! Constructor. Starts the formatting threads.
+        formatting_pipeline(asynchronous_sink& sink, unsigned int thread_count) :
+            m_Sink(sink),
+            m_Slots(static_cast< std::size_t >(thread_count) * slots_per_thread),
+            m_Head(0),
+            m_Tail(0),
+            m_Published(0),
+            m_NextToFormat(0),
+            m_IdleThreads(0),
+            m_FeederWaiting(false),
+            m_StopRequested(false)
+        {
+            try
+            {
+                for (unsigned int i = 0; i < thread_count; ++i)
+                    m_Threads.create_thread(boost::bind(&formatting_pipeline::format_records, this));
+            }
+            catch (...)
+            {
+                stop();
+                throw;
+            }
+        }
+        //! Destructor. Stops the formatting threads.
+        ~formatting_pipeline()
+        {
+            try
+            {
+                stop();
+            }
+            catch (...)
+            {
+            }
+        }
+
+        //! Checks if there are no records in the pipeline
+        bool empty() const { return m_Head == m_Tail; }
+        //! Checks if there are no free slots in the pipeline
+        bool full() const { return m_Tail - m_Head == m_Slots.size(); }
+
+        //! Puts the record to the pipeline. The record is not available for formatting until \c publish is called.
+        void push(record_view& rec)
+        {
+            slot& s = m_Slots[m_Tail % m_Slots.size()];
+            s.m_Record.swap(rec);
+            ++m_Tail;
+        }
+
+        //! Makes the pushed records available to the formatting threads
+        void publish()
+        {
+            lock_guard< mutex > lock(m_Mutex);
+            if (m_Published != m_Tail)
+            {
+                m_Published = m_Tail;
+                if (m_IdleThreads > 0)
+                    m_FormatCond.notify_all();
+            }
+        }
+
+        //! Passes the formatted records to the backend in order. Optionally waits for at least one record to be formatted.
+        void feed_records(bool wait)
+        {
+            std::size_t count = 0;
+            {
+                unique_lock< mutex > lock(m_Mutex);
+                if (wait)
+                {
+                    m_FeederWaiting = true;
+                    while (!m_Slots[m_Head % m_Slots.size()].m_Formatted)
+                        m_FeedCond.wait(lock);
+                    m_FeederWaiting = false;
+                }
+
+                while (m_Head + count != m_Tail && m_Slots[(m_Head + count) % m_Slots.size()].m_Formatted)
+                    ++count;
+            }
+
+            for (; count > 0; --count)
+            {
+                slot& s = m_Slots[m_Head % m_Slots.size()];
+                ++m_Head;
+                s.m_Formatted = false;
+
+                record_view rec;
+                rec.swap(s.m_Record);
+                if (!s.m_Exception)
+                {
+                    m_Sink.feed_formatted_record(rec, s.m_FormattedRecord, m_Sink.m_BackendMutex, *m_Sink.m_pBackend);
+                    s.m_FormattedRecord.clear();
+                }
+                else
+                {
+                    boost::exception_ptr ex = s.m_Exception;
+                    s.m_Exception = boost::exception_ptr();
+                    try
+                    {
+                        boost::rethrow_exception(ex);
+                    }
+                    catch (...)
+                    {
+                        boost::log::aux::shared_lock_guard< frontend_mutex_type > lock(m_Sink.frontend_mutex());
+                        if (m_Sink.exception_handler().empty())
+                            throw;
+                        m_Sink.exception_handler()();
+                    }
+                }
+            }
+        }
+
+    private:
+        //! Stops the formatting threads
+        void stop()
+        {
+            {
+                lock_guard< mutex > lock(m_Mutex);
+                m_StopRequested = true;
+                m_FormatCond.notify_all();
+            }
+            m_Threads.join_all();
+        }
+
+        //! Formatting thread function
+        void format_records()
+        {
+            const std::size_t thread_count = m_Slots.size() / slots_per_thread;
+            unique_lock< mutex > lock(m_Mutex);
+            while (true)
+            {
+                if (m_NextToFormat != m_Published)
+                {
+                    // Take a fair share of the pending records
+                    const std::size_t begin = m_NextToFormat;
+                    std::size_t count = (m_Published - begin + thread_count - 1u) / thread_count;
+                    if (count > static_cast< std::size_t >(max_chunk_size))
+                        count = max_chunk_size;
+                    const std::size_t end = begin + count;
+                    m_NextToFormat = end;
+                    lock.unlock();
+
+                    for (std::size_t seq = begin; seq != end; ++seq)
+                    {
+                        slot& s = m_Slots[seq % m_Slots.size()];
+                        try
+                        {
+                            m_Sink.format_record(s.m_Record, s.m_FormattedRecord);
+                        }
+                        catch (...)
+                        {
+                            s.m_Exception = boost::current_exception();
+                        }
+                    }
+
+                    lock.lock();
+                    for (std::size_t seq = begin; seq != end; ++seq)
+                        m_Slots[seq % m_Slots.size()].m_Formatted = true;
+                    if (m_FeederWaiting)
+                        m_FeedCond.notify_one();
+                }
+                else if (m_StopRequested)
+                    break;
+                else
+                {
+                    ++m_IdleThreads;
+                    m_FormatCond.wait(lock);
+                    --m_IdleThreads;
+                }
+            }
+        }
+
+        //  Copying prohibited
+        formatting_pipeline(formatting_pipeline const&);
+        formatting_pipeline& operator= (formatting_pipeline const&);
+    };
+
 public:
     //! Sink implementation type
     typedef SinkBackendT sink_backend_type;
@@ -214,6 +505,11 @@ private:
     //! The flag indicates that queue flush has been requested
     volatile bool m_FlushRequested; // TODO: make it a real atomic
 
+    //! The number of threads to format records in parallel
+    const unsigned int m_FormattingThreads;
+    //! The stage of merging repeated records. Only accessed by the feeding thread.
+    const scoped_ptr< boost::log::aux::record_coalescer > m_pCoalescer;
+
 public:
     /*!
      * Default constructor. Constructs the sink backend instance.
@@ -228,7 +524,8 @@ public:
         base_type(true),
         m_pBackend(boost::make_shared< sink_backend_type >()),
         m_StopRequested(false),
-        m_FlushRequested(false)
+        m_FlushRequested(false),
+        m_FormattingThreads(0)
     {
         if (start_thread)
             start_feeding_thread();
@@ -248,7 +545,8 @@ public:
         base_type(true),
         m_pBackend(backend),
         m_StopRequested(false),
-        m_FlushRequested(false)
+        m_FlushRequested(false),
+        m_FormattingThreads(0)
     {
         if (start_thread)
             start_feeding_thread();
@@ -319,19 +617,11 @@ public:
         scoped_thread_id guard(base_type::frontend_mutex(), m_BlockCond, m_FeedingThreadID, m_StopRequested);
 
         // Now start the feeding loop
-        while (true)
-        {
-            do_feed_records();
-            if (!m_StopRequested)
-            {
-                // Block until new record is available
-                record_view rec;
-                if (queue_base_type::dequeue_ready(rec))
-                    base_type::feed_record(rec, m_BackendMutex, *m_pBackend);
-            }
-            else
-                break;
-        }
+        typedef typename has_requirement< typename sink_backend_type::frontend_requirements, formatted_records >::type is_formatting;
+        if (is_formatting::value && m_FormattingThreads > 0)
+            run_parallel(is_formatting());
+        else
+            run_sequential();
     }
 
     /*!
@@ -419,30 +709,105 @@ public:
 
 private:
 #ifndef BOOST_LOG_DOXYGEN_PASS
+    //! The maximum time to wait for new records while there are merged records, if the queue does not support waiting with a deadline, in milliseconds
+    enum { coalescing_poll_interval = 10 };
+
     //! The method spawns record feeding thread
     void start_feeding_thread()
     {
         boost::thread(boost::bind(&asynchronous_sink::run, this)).swap(m_DedicatedFeedingThread);
     }
 
+    //! The method creates the stage of merging repeated records, if it is enabled
+    static boost::log::aux::record_coalescer* create_coalescer(posix_time::time_duration const& window)
+    {
+        if (window.is_special() || window.total_milliseconds() <= 0)
+            return NULL;
+        return new boost::log::aux::record_coalescer(static_cast< uint64_t >(window.total_milliseconds()));
+    }
+
     // locking_ptr_counter_base methods
     void lock() { m_BackendMutex.lock(); }
     bool try_lock() { return m_BackendMutex.try_lock(); }
     void unlock() { m_BackendMutex.unlock(); }
 
+    //! The record feeding loop that formats records in the feeding thread
+    void run_sequential()
+    {
+        while (true)
+        {
+            do_feed_records();
+            if (!m_StopRequested)
+            {
+                if (m_pCoalescer && m_pCoalescer->has_merged_records())
+                {
+                    wait_coalescing_window();
+                    continue;
+                }
+
+                // Block until new record is available
+                record_view rec;
+                if (queue_base_type::dequeue_ready(rec))
+                {
+                    if (!m_pCoalescer)
+                        base_type::feed_record(rec, m_BackendMutex, *m_pBackend);
+                    else
+                        m_pCoalescer->push(rec);
+                }
+            }
+            else
+                break;
+        }
+
+        release_coalesced_records();
+    }
+
+    //! The record feeding loop that formats records in the formatting threads
+    void run_parallel(mpl::true_)
+    {
+        formatting_pipeline< typename base_type::string_type > pipeline(*this, m_FormattingThreads);
+        while (true)
+        {
+            do_feed_records(pipeline);
+            if (!m_StopRequested)
+            {
+                if (m_pCoalescer && m_pCoalescer->has_merged_records())
+                {
+                    wait_coalescing_window();
+                    continue;
+                }
+
+                // Block until new record is available
+                record_view rec;
+                if (queue_base_type::dequeue_ready(rec))
+                {
+                    if (!m_pCoalescer)
+                    {
+                        pipeline.push(rec);
+                        pipeline.publish();
+                    }
+                    else
+                        m_pCoalescer->push(rec);
+                }
+            }
+            else
+                break;
+        }
+
+        release_coalesced_records();
+    }
+    //! A stub for backends that do not require formatting
+    void run_parallel(mpl::false_)
+    {
+    }
+
     //! The record feeding loop
     void do_feed_records()
     {
         while (!m_StopRequested)
         {
             record_view rec;
-            register bool dequeued = false;
-            if (!m_FlushRequested)
-                dequeued = queue_base_type::try_dequeue_ready(rec);
-            else
-                dequeued = queue_base_type::try_dequeue(rec);
-
-            if (dequeued)
+            if (try_dequeue_next(rec))
                 base_type::feed_record(rec, m_BackendMutex, *m_pBackend);
             else
                 break;
@@ -454,6 +819,110 @@ private:
             base_type::flush_backend(m_BackendMutex, *m_pBackend);
         }
     }
+
+    //! The record feeding loop that formats records in the formatting threads
+    template< typename StringT >
+    void do_feed_records(formatting_pipeline< StringT >& pipeline)
+    {
+        while (!m_StopRequested)
+        {
+            // Fill the pipeline with the records from the queue
+            bool dequeued = false;
+            while (!pipeline.full())
+            {
+                record_view rec;
+                if (try_dequeue_next(rec))
+                {
+                    pipeline.push(rec);
+                    dequeued = true;
+                }
+                else
+                    break;
+            }
+
+            if (pipeline.empty())
+                break;
+
+            pipeline.publish();
+
+            // Block until some records are formatted, unless there may be more records in the queue
+            pipeline.feed_records(!dequeued || pipeline.full());
+        }
+
+        // Pass the records that have already been dequeued to the backend
+        while (!pipeline.empty())
+            pipeline.feed_records(true);
+
+        if (m_FlushRequested)
+        {
+            scoped_flag guard(base_type::frontend_mutex(), m_BlockCond, m_FlushRequested);
+            base_type::flush_backend(m_BackendMutex, *m_pBackend);
+        }
+    }
+
+    //! The method dequeues the next record to be passed to the backend. The records are passed through the merging stage, if it is enabled.
+    bool try_dequeue_next(record_view& rec)
+    {
+        if (!m_pCoalescer)
+            return !m_FlushRequested ? queue_base_type::try_dequeue_ready(rec) : queue_base_type::try_dequeue(rec);
+
+        while (!m_pCoalescer->pop(rec))
+        {
+            record_view queued;
+            if (!m_FlushRequested ? queue_base_type::try_dequeue_ready(queued) : queue_base_type::try_dequeue(queued))
+                m_pCoalescer->push(queued);
+            else
+            {
+                // The queue is empty. Release the merged records whose windows are closed, or all of them on flush.
+                m_pCoalescer->expire(m_FlushRequested);
+                return m_pCoalescer->pop(rec);
+            }
+        }
+
+        return true;
+    }
+
+    //! The method waits until the first window of the merged records closes or a new record arrives
+    void wait_coalescing_window()
+    {
+        const uint64_t timeout = m_pCoalescer->time_to_expiration();
+        if (timeout > 0u)
+            wait_coalescing_window(timeout, mpl::bool_< aux::has_timed_dequeue_ready< queue_base_type >::value >());
+        else
+            m_pCoalescer->expire(false);
+    }
+    //! The method blocks on the queue until a new record is available, the window closes or the feeding loop is interrupted
+    void wait_coalescing_window(uint64_t timeout, mpl::true_)
+    {
+        record_view rec;
+        if (queue_base_type::try_dequeue_ready(rec, boost::get_system_time() + posix_time::milliseconds(static_cast< long >(timeout))))
+            m_pCoalescer->push(rec);
+    }
+    //! The method polls the queue for the queueing strategies that do not support waiting with a deadline
+    void wait_coalescing_window(uint64_t timeout, mpl::false_)
+    {
+        record_view rec;
+        if (queue_base_type::try_dequeue_ready(rec))
+            m_pCoalescer->push(rec);
+        else
+        {
+            if (timeout > static_cast< uint64_t >(coalescing_poll_interval))
+                timeout = coalescing_poll_interval;
+            boost::this_thread::sleep(posix_time::milliseconds(static_cast< long >(timeout)));
+        }
+    }
+
+    //! The method passes all merged records to the backend when the feeding loop stops
+    void release_coalesced_records()
+    {
+        if (m_pCoalescer)
+        {
+            m_pCoalescer->expire(true);
+            record_view rec;
+            while (m_pCoalescer->pop(rec))
+                base_type::feed_record(rec, m_BackendMutex, *m_pBackend);
+        }
+    }
 #endif // BOOST_LOG_DOXYGEN_PASS
 };
 
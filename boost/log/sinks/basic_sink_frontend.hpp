@@ -27,6 +27,9 @@
 #include <boost/log/expressions/filter.hpp>
 #include <boost/log/expressions/formatter.hpp>
 #if !defined(BOOST_LOG_NO_THREADS)
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/atomic/atomic.hpp>
 #include <boost/thread/exceptions.hpp>
 #include <boost/thread/tss.hpp>
 #include <boost/thread/locks.hpp>
@@ -46,6 +49,17 @@ BOOST_LOG_OPEN_NAMESPACE
 
 namespace sinks {
 
+#if !defined(BOOST_LOG_NO_THREADS)
+
+namespace aux {
+
+//! Generates a sink frontend state version, which is unique across all frontends in the process
+BOOST_LOG_API unsigned int generate_frontend_version();
+
+} // namespace aux
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
+
 //! A base class for a logging sink frontend
 class BOOST_LOG_NO_VTABLE basic_sink_frontend :
     public sink
@@ -62,14 +76,41 @@ protected:
     //! Mutex type
     typedef boost::log::aux::light_rw_mutex mutex_type;
 
+private:
+    //! Per-thread reference to the filter
+    struct filtering_context
+    {
+        //! Frontend state version the context corresponds to
+        const unsigned int m_Version;
+        //! Filter, shared by all threads. Null if no filter is set.
+        const shared_ptr< const filter > m_pFilter;
+
+        filtering_context(unsigned int version, shared_ptr< const filter > const& filt) :
+            m_Version(version),
+            m_pFilter(filt)
+        {
+        }
+    };
+
 private:
     //! Synchronization mutex
     mutable mutex_type m_Mutex;
+    /*!
+     * Frontend state version, updated on every modification of the filter, formatter or other settings.
+     * Versions are unique across frontends, so that a per-thread context left behind by a destroyed
+     * frontend is not mistaken for a valid one by a frontend created at the same address.
+     */
+    boost::atomic< unsigned int > m_Version;
+    //! Filtering context of the current thread
+    thread_specific_ptr< filtering_context > m_pFilteringContext;
+    //! Filter. Null if no filter is set.
+    shared_ptr< const filter > m_pFilter;
+#else
+    //! Filter
+    filter m_Filter;
 #endif
 
 private:
-    //! Filter
-    filter m_Filter;
     //! Exception handler
     exception_handler_type m_ExceptionHandler;
 
@@ -80,25 +121,43 @@ public:
      * \param cross_thread The flag indicates whether the sink passes log records between different threads
      */
     explicit basic_sink_frontend(bool cross_thread) : sink(cross_thread)
+#if !defined(BOOST_LOG_NO_THREADS)
+        , m_Version(aux::generate_frontend_version())
+#endif
     {
     }
 
     /*!
      * The method sets sink-specific filter functional object
+     *
+     * \note The filter is copied once and the copy is shared by all threads that pass records through
+     *       the frontend. It may be called concurrently from these threads.
      */
     template< typename FunT >
     void set_filter(FunT const& filter)
     {
-        BOOST_LOG_EXPR_IF_MT(boost::log::aux::exclusive_lock_guard< mutex_type > lock(m_Mutex);)
+#if !defined(BOOST_LOG_NO_THREADS)
+        shared_ptr< const boost::log::filter > p = boost::make_shared< boost::log::filter >(filter);
+        boost::log::aux::exclusive_lock_guard< mutex_type > lock(m_Mutex);
+        m_pFilter.swap(p);
+        increment_version();
+#else
         m_Filter = filter;
+#endif
     }
     /*!
      * The method resets the filter
      */
     void reset_filter()
     {
-        BOOST_LOG_EXPR_IF_MT(boost::log::aux::exclusive_lock_guard< mutex_type > lock(m_Mutex);)
+#if !defined(BOOST_LOG_NO_THREADS)
+        shared_ptr< const filter > p;
+        boost::log::aux::exclusive_lock_guard< mutex_type > lock(m_Mutex);
+        m_pFilter.swap(p);
+        increment_version();
+#else
         m_Filter.reset();
+#endif
     }
 
     /*!
@@ -127,10 +186,21 @@ public:
      */
     bool will_consume(attribute_value_set const& attrs)
     {
-        BOOST_LOG_EXPR_IF_MT(boost::log::aux::shared_lock_guard< mutex_type > lock(m_Mutex);)
+#if !defined(BOOST_LOG_NO_THREADS)
+        // Use the thread-specific reference to the filter, so that no locking is needed unless the filter has changed
+        filtering_context* context = m_pFilteringContext.get();
+        if (!context || context->m_Version != m_Version.load(boost::memory_order_acquire))
+            context = update_filtering_context();
+#endif
+
         try
         {
+#if !defined(BOOST_LOG_NO_THREADS)
+            filter const* filt = context->m_pFilter.get();
+            return !filt || (*filt)(attrs);
+#else
             return m_Filter(attrs);
+#endif
         }
 #if !defined(BOOST_LOG_NO_THREADS)
         catch (thread_interrupted&)
@@ -140,6 +210,7 @@ public:
 #endif
         catch (...)
         {
+            BOOST_LOG_EXPR_IF_MT(boost::log::aux::shared_lock_guard< mutex_type > lock(m_Mutex);)
             if (m_ExceptionHandler.empty())
                 throw;
             m_ExceptionHandler();
@@ -151,6 +222,11 @@ protected:
 #if !defined(BOOST_LOG_NO_THREADS)
     //! Returns reference to the frontend mutex
     mutex_type& frontend_mutex() const { return m_Mutex; }
+
+    //! Returns the current frontend state version
+    unsigned int version() const { return m_Version.load(boost::memory_order_acquire); }
+    //! Marks the frontend state as modified. Must be called with the frontend mutex locked exclusively.
+    void increment_version() { m_Version.store(aux::generate_frontend_version(), boost::memory_order_release); }
 #endif
 
     //! Returns reference to the exception handler
@@ -251,6 +327,20 @@ private:
     void flush_backend_impl(BackendMutexT&, BackendT&, mpl::false_)
     {
     }
+
+#if !defined(BOOST_LOG_NO_THREADS)
+    //! Updates the filtering context of the current thread
+    filtering_context* update_filtering_context()
+    {
+        filtering_context* context;
+        {
+            boost::log::aux::shared_lock_guard< mutex_type > lock(m_Mutex);
+            context = new filtering_context(m_Version.load(boost::memory_order_relaxed), m_pFilter);
+        }
+        m_pFilteringContext.reset(context);
+        return context;
+    }
+#endif
 };
 
 //! A base class for a logging sink frontend with formatting support
@@ -314,9 +404,6 @@ private:
 private:
 #if !defined(BOOST_LOG_NO_THREADS)
 
-    //! State version
-    volatile unsigned int m_Version;
-
     //! Formatter functor
     formatter_type m_Formatter;
     //! Locale to perform formatting
@@ -340,14 +427,14 @@ public:
      */
     explicit basic_formatting_sink_frontend(bool cross_thread) :
         basic_sink_frontend(cross_thread)
-#if !defined(BOOST_LOG_NO_THREADS)
-        , m_Version(0)
-#endif
     {
     }
 
     /*!
      * The method sets sink-specific formatter function object
+     *
+     * \note In multithreaded builds every thread that formats records keeps its own copy of the formatter,
+     *       so any state the formatter keeps by value is not shared between threads.
      */
     template< typename FunT >
     void set_formatter(FunT const& formatter)
@@ -355,7 +442,7 @@ public:
 #if !defined(BOOST_LOG_NO_THREADS)
         boost::log::aux::exclusive_lock_guard< mutex_type > lock(this->frontend_mutex());
         m_Formatter = formatter;
-        ++m_Version;
+        this->increment_version();
 #else
         m_Context.m_Formatter = formatter;
 #endif
@@ -368,7 +455,7 @@ public:
 #if !defined(BOOST_LOG_NO_THREADS)
         boost::log::aux::exclusive_lock_guard< mutex_type > lock(this->frontend_mutex());
         m_Formatter.reset();
-        ++m_Version;
+        this->increment_version();
 #else
         m_Context.m_Formatter.reset();
 #endif
@@ -394,7 +481,7 @@ public:
 #if !defined(BOOST_LOG_NO_THREADS)
         boost::log::aux::exclusive_lock_guard< mutex_type > lock(this->frontend_mutex());
         m_Locale = loc;
-        ++m_Version;
+        this->increment_version();
 #else
         m_Context.m_FormattingStream.imbue(loc);
 #endif
@@ -415,34 +502,62 @@ protected:
     template< typename BackendMutexT, typename BackendT >
     void feed_record(record_view const& rec, BackendMutexT& backend_mutex, BackendT& backend)
     {
-        formatting_context* context;
+        formatting_context* context = get_formatting_context();
 
+        boost::log::aux::cleanup_guard< stream_type > cleanup1(context->m_FormattingStream);
+        boost::log::aux::cleanup_guard< string_type > cleanup2(context->m_FormattedRecord);
+
+        try
+        {
+            // Perform the formatting
+            context->m_Formatter(rec, context->m_FormattingStream);
+            context->m_FormattingStream.flush();
+
+            // Feed the record. The backend may take the formatted string contents and leave
+            // an empty string with preallocated storage in exchange, see text_file_backend.
+            BOOST_LOG_EXPR_IF_MT(boost::log::aux::exclusive_lock_guard< BackendMutexT > lock(backend_mutex);)
+            consume_formatted_record(rec, context->m_FormattedRecord, backend);
+        }
 #if !defined(BOOST_LOG_NO_THREADS)
-        context = m_pContext.get();
-        if (!context || context->m_Version != m_Version)
+        catch (thread_interrupted&)
         {
-            {
-                boost::log::aux::shared_lock_guard< mutex_type > lock(this->frontend_mutex());
-                context = new formatting_context(m_Version, m_Locale, m_Formatter);
-            }
-            m_pContext.reset(context);
+            throw;
         }
-#else
-        context = &m_Context;
 #endif
+        catch (...)
+        {
+            BOOST_LOG_EXPR_IF_MT(boost::log::aux::shared_lock_guard< mutex_type > lock(this->frontend_mutex());)
+            if (this->exception_handler().empty())
+                throw;
+            this->exception_handler()();
+        }
+    }
+
+    /*!
+     * Formats log record into the string. The previous contents of \a formatted_record are discarded,
+     * but the storage may be reused by the following calls in the current thread. The method does not
+     * invoke the exception handler, exceptions are propagated to the caller.
+     */
+    void format_record(record_view const& rec, string_type& formatted_record)
+    {
+        formatting_context* context = get_formatting_context();
 
         boost::log::aux::cleanup_guard< stream_type > cleanup1(context->m_FormattingStream);
         boost::log::aux::cleanup_guard< string_type > cleanup2(context->m_FormattedRecord);
 
+        context->m_Formatter(rec, context->m_FormattingStream);
+        context->m_FormattingStream.flush();
+        context->m_FormattedRecord.swap(formatted_record);
+    }
+
+    //! Feeds log record that has been formatted with \c format_record to the backend
+    template< typename BackendMutexT, typename BackendT >
+    void feed_formatted_record(record_view const& rec, string_type& formatted_record, BackendMutexT& backend_mutex, BackendT& backend)
+    {
         try
         {
-            // Perform the formatting
-            context->m_Formatter(rec, context->m_FormattingStream);
-            context->m_FormattingStream.flush();
-
-            // Feed the record
             BOOST_LOG_EXPR_IF_MT(boost::log::aux::exclusive_lock_guard< BackendMutexT > lock(backend_mutex);)
-            backend.consume(rec, context->m_FormattedRecord);
+            consume_formatted_record(rec, formatted_record, backend);
         }
 #if !defined(BOOST_LOG_NO_THREADS)
         catch (thread_interrupted&)
@@ -489,6 +604,47 @@ protected:
         feed_record(rec, m, backend);
         return true;
     }
+
+private:
+    //! Passes the formatted record to the backend, lets the backend take the string if it supports that
+    template< typename BackendT >
+    static void consume_formatted_record(record_view const& rec, string_type& formatted_record, BackendT& backend)
+    {
+        typedef typename BackendT::frontend_requirements frontend_requirements;
+        consume_formatted_record_impl(rec, formatted_record, backend,
+            typename has_requirement< frontend_requirements, formatted_record_taking >::type());
+    }
+    //! Passes the formatted record to the backend that takes the string contents
+    template< typename BackendT >
+    static void consume_formatted_record_impl(record_view const& rec, string_type& formatted_record, BackendT& backend, mpl::true_)
+    {
+        backend.consume_and_take(rec, formatted_record);
+    }
+    //! Passes the formatted record to the backend
+    template< typename BackendT >
+    static void consume_formatted_record_impl(record_view const& rec, string_type const& formatted_record, BackendT& backend, mpl::false_)
+    {
+        backend.consume(rec, formatted_record);
+    }
+
+    //! Returns the formatting context of the current thread, updates it if the frontend settings have changed
+    formatting_context* get_formatting_context()
+    {
+#if !defined(BOOST_LOG_NO_THREADS)
+        formatting_context* context = m_pContext.get();
+        if (!context || context->m_Version != this->version())
+        {
+            {
+                boost::log::aux::shared_lock_guard< mutex_type > lock(this->frontend_mutex());
+                context = new formatting_context(this->version(), m_Locale, m_Formatter);
+            }
+            m_pContext.reset(context);
+        }
+        return context;
+#else
+        return &m_Context;
+#endif
+    }
 };
 
 namespace aux {
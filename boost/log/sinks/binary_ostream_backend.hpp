@@ -0,0 +1,149 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   binary_ostream_backend.hpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * The header contains implementation of a sink backend that writes log records to a stream
+ * in a compact binary format.
+ */
+
+#ifndef BOOST_LOG_SINKS_BINARY_OSTREAM_BACKEND_HPP_INCLUDED_
+#define BOOST_LOG_SINKS_BINARY_OSTREAM_BACKEND_HPP_INCLUDED_
+
+#include <string>
+#include <ostream>
+#include <boost/shared_ptr.hpp>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/core/record_view.hpp>
+#include <boost/log/attributes/attribute_value.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
+#include <boost/log/utility/type_info_wrapper.hpp>
+#include <boost/log/utility/formatting_ostream.hpp>
+#include <boost/log/sinks/basic_sink_backend.hpp>
+#include <boost/log/sinks/frontend_requirements.hpp>
+#include <boost/log/detail/header.hpp>
+
+#ifdef BOOST_LOG_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace sinks {
+
+/*!
+ * \brief An implementation of a binary output stream logging sink backend
+ *
+ * The sink backend writes attribute values of log records to a stream in a compact binary format,
+ * without formatting them into text. Attribute names and value types are written to the stream
+ * only once, when the attribute is first encountered, and are referred to by short numeric keys
+ * afterwards. Numbers are written in variable-length encoding, timestamps are written as the difference
+ * from the previous timestamp of the same attribute.
+ *
+ * The backend supports attribute values of the types listed in \c default_attribute_types, as well as
+ * <tt>posix_time::ptime</tt>, <tt>posix_time::time_duration</tt>, thread and process identifiers and
+ * the \c trivial::severity_level enum. Wide strings are converted to narrow strings according to
+ * the global locale. Values of other types, such as user-defined severity level enums, can be written
+ * in their textual representation, if the type is registered with \c register_formatted_type.
+ * For values of types that are neither supported nor registered only the name of the type is written,
+ * so that the reader is able to tell that the attribute was present.
+ *
+ * The written logs can be read with \c binary_log::reader.
+ */
+class binary_ostream_backend :
+    public basic_sink_backend<
+        combine_requirements< synchronized_feeding, flushing >::type
+    >
+{
+private:
+    //! \cond
+
+    struct implementation;
+    implementation* m_pImpl;
+
+    //! The type of the function that formats attribute values of a registered type
+    typedef void (*value_formatter)(attribute_value const& value, std::string& str);
+
+    //! \endcond
+
+public:
+    /*!
+     * Constructor. No stream attached to the constructed backend, auto flush feature disabled.
+     */
+    BOOST_LOG_API binary_ostream_backend();
+    /*!
+     * Destructor
+     */
+    BOOST_LOG_API ~binary_ostream_backend();
+
+    /*!
+     * The method attaches the stream to the sink. The previously attached stream, if any, is detached.
+     * The file header is written to the stream, and the attribute names and types will be written again
+     * as they are encountered, so that every stream contains a self-contained log. This allows to rotate
+     * log files by attaching new streams to the backend.
+     *
+     * \param strm Pointer to the stream. The stream must be opened in binary mode. If NULL,
+     *             the backend will discard log records.
+     */
+    BOOST_LOG_API void set_stream(shared_ptr< std::ostream > const& strm);
+
+    /*!
+     * Sets the flag to automatically flush buffers of the attached stream after each log record
+     */
+    BOOST_LOG_API void auto_flush(bool f = true);
+
+    /*!
+     * The method registers the type of attribute values that will be written in their textual
+     * representation. The values are formatted with <tt>operator<<</tt>, which must be defined for
+     * \c basic_formatting_ostream and the type. The formatted values are read as \c binary_log::formatted_type.
+     * Registering types that are natively supported by the backend has no effect.
+     */
+    template< typename T >
+    void register_formatted_type()
+    {
+        register_formatted_type(type_info_wrapper(typeid(T)), &binary_ostream_backend::format_value< T >);
+    }
+
+    /*!
+     * The method writes the record to the sink
+     */
+    BOOST_LOG_API void consume(record_view const& rec);
+
+    /*!
+     * The method flushes the attached stream
+     */
+    BOOST_LOG_API void flush();
+
+private:
+#ifndef BOOST_LOG_DOXYGEN_PASS
+    //! The method registers the formatting function for the type
+    BOOST_LOG_API void register_formatted_type(type_info_wrapper const& type, value_formatter formatter);
+
+    //! Formats the attribute value of the registered type
+    template< typename T >
+    static void format_value(attribute_value const& value, std::string& str)
+    {
+        basic_formatting_ostream< char > strm(str);
+        strm << value.extract< T >().get();
+        strm.flush();
+    }
+#endif // BOOST_LOG_DOXYGEN_PASS
+};
+
+} // namespace sinks
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_SINKS_BINARY_OSTREAM_BACKEND_HPP_INCLUDED_
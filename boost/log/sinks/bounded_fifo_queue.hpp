@@ -31,6 +31,7 @@
 #include <boost/thread/locks.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/condition_variable.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <boost/log/core/record_view.hpp>
 #include <boost/log/detail/header.hpp>
 
@@ -173,6 +174,32 @@ protected:
         return false;
     }
 
+    //! Dequeues log record from the queue, blocks if the queue is empty until the deadline (in UTC) is reached
+    bool try_dequeue_ready(record_view& rec, posix_time::ptime const& deadline)
+    {
+        unique_lock< mutex_type > lock(m_mutex);
+
+        while (!m_interruption_requested)
+        {
+            const std::size_t size = m_queue.size();
+            if (size > 0)
+            {
+                rec.swap(m_queue.front());
+                m_queue.pop();
+                if (size == MaxQueueSizeV)
+                    overflow_strategy::on_queue_space_available();
+                return true;
+            }
+            else if (!m_cond.timed_wait(lock, deadline))
+            {
+                return false;
+            }
+        }
+        m_interruption_requested = false;
+
+        return false;
+    }
+
     //! Wakes a thread possibly blocked in the \c dequeue method
     void interrupt_dequeue()
     {
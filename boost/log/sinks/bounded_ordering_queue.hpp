@@ -38,6 +38,7 @@
 #include <boost/thread/thread_time.hpp>
 #include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <boost/log/detail/timestamp.hpp>
+#include <boost/log/detail/ordering_key.hpp>
 #include <boost/log/keywords/order.hpp>
 #include <boost/log/keywords/ordering_window.hpp>
 #include <boost/log/core/record_view.hpp>
@@ -76,8 +77,12 @@ private:
     typedef OverflowStrategyT overflow_strategy;
     typedef boost::mutex mutex_type;
 
+    //! Ordering key of an enqueued record
+    typedef boost::log::aux::ordering_key_holder< OrderT > ordering_key_holder_type;
+
     //! Log record with enqueueing timestamp
-    class enqueued_record
+    class enqueued_record :
+        public ordering_key_holder_type
     {
         BOOST_COPYABLE_AND_MOVABLE(enqueued_record)
 
@@ -95,34 +100,41 @@ private:
             result_type operator() (enqueued_record const& left, enqueued_record const& right) const
             {
                 // std::priority_queue requires ordering with semantics of std::greater, so we swap arguments
-                return OrderT::operator() (right.m_record, left.m_record);
+                return ordering_key_holder_type::less(static_cast< OrderT const& >(*this), right, right.m_record, left, left.m_record);
             }
         };
 
         boost::log::aux::timestamp m_timestamp;
         record_view m_record;
 
-        enqueued_record(enqueued_record const& that) : m_timestamp(that.m_timestamp), m_record(that.m_record)
+        enqueued_record(enqueued_record const& that) :
+            ordering_key_holder_type(static_cast< ordering_key_holder_type const& >(that)),
+            m_timestamp(that.m_timestamp),
+            m_record(that.m_record)
         {
         }
         enqueued_record(BOOST_RV_REF(enqueued_record) that) :
+            ordering_key_holder_type(static_cast< ordering_key_holder_type const& >(that)),
             m_timestamp(that.m_timestamp),
             m_record(boost::move(that.m_record))
         {
         }
-        explicit enqueued_record(record_view const& rec) :
+        enqueued_record(record_view const& rec, ordering_key_holder_type const& key) :
+            ordering_key_holder_type(key),
             m_timestamp(boost::log::aux::get_timestamp()),
             m_record(rec)
         {
         }
         enqueued_record& operator= (BOOST_COPY_ASSIGN_REF(enqueued_record) that)
         {
+            static_cast< ordering_key_holder_type& >(*this) = static_cast< ordering_key_holder_type const& >(that);
             m_timestamp = that.m_timestamp;
             m_record = that.m_record;
             return *this;
         }
         enqueued_record& operator= (BOOST_RV_REF(enqueued_record) that)
         {
+            static_cast< ordering_key_holder_type& >(*this) = static_cast< ordering_key_holder_type const& >(that);
             m_timestamp = that.m_timestamp;
             m_record = boost::move(that.m_record);
             return *this;
@@ -138,6 +150,8 @@ private:
 private:
     //! Ordering window duration, in milliseconds
     const uint64_t m_ordering_window;
+    //! Ordering predicate, used to extract ordering keys of the enqueued records
+    const OrderT m_order;
     //! Synchronization primitive
     mutex_type m_mutex;
     //! Condition to block the consuming thread on
@@ -177,7 +191,8 @@ protected:
     template< typename ArgsT >
     explicit bounded_ordering_queue(ArgsT const& args) :
         m_ordering_window(args[keywords::ordering_window || &bounded_ordering_queue::get_default_ordering_window].total_milliseconds()),
-        m_queue(args[keywords::order]),
+        m_order(args[keywords::order]),
+        m_queue(m_order),
         m_interruption_requested(false)
     {
     }
@@ -185,6 +200,7 @@ protected:
     //! Enqueues log record to the queue
     void enqueue(record_view const& rec)
     {
+        const ordering_key_holder_type key(m_order, rec);
         unique_lock< mutex_type > lock(m_mutex);
         std::size_t size = m_queue.size();
         for (; size >= MaxQueueSizeV; size = m_queue.size())
@@ -193,7 +209,7 @@ protected:
                 return;
         }
 
-        m_queue.push(enqueued_record(rec));
+        m_queue.push(enqueued_record(rec, key));
         if (size == 0)
             m_cond.notify_one();
     }
@@ -201,6 +217,7 @@ protected:
     //! Attempts to enqueue log record to the queue
     bool try_enqueue(record_view const& rec)
     {
+        const ordering_key_holder_type key(m_order, rec);
         unique_lock< mutex_type > lock(m_mutex, try_to_lock);
         if (lock.owns_lock())
         {
@@ -209,7 +226,7 @@ protected:
             // Do not invoke the bounding strategy in case of overflow as it may block
             if (size < MaxQueueSizeV)
             {
-                m_queue.push(enqueued_record(rec));
+                m_queue.push(enqueued_record(rec, key));
                 if (size == 0)
                     m_cond.notify_one();
                 return true;
@@ -297,6 +314,47 @@ protected:
         return false;
     }
 
+    //! Dequeues log record from the queue, blocks if no log records are ready to be processed until the deadline (in UTC) is reached
+    bool try_dequeue_ready(record_view& rec, posix_time::ptime const& deadline)
+    {
+        unique_lock< mutex_type > lock(m_mutex);
+
+        while (!m_interruption_requested)
+        {
+            const std::size_t size = m_queue.size();
+            if (size > 0)
+            {
+                const boost::log::aux::timestamp now = boost::log::aux::get_timestamp();
+                enqueued_record const& elem = m_queue.top();
+                const uint64_t difference = (now - elem.m_timestamp).milliseconds();
+                if (difference >= m_ordering_window)
+                {
+                    rec = elem.m_record;
+                    m_queue.pop();
+                    if (size == MaxQueueSizeV)
+                        overflow_strategy::on_queue_space_available();
+                    return true;
+                }
+                else
+                {
+                    // Wait until the element becomes ready to be processed or the deadline is reached
+                    const posix_time::ptime ready_time = boost::get_system_time() + posix_time::milliseconds(m_ordering_window - difference);
+                    if (ready_time < deadline)
+                        m_cond.timed_wait(lock, ready_time);
+                    else if (!m_cond.timed_wait(lock, deadline))
+                        return false;
+                }
+            }
+            else if (!m_cond.timed_wait(lock, deadline))
+            {
+                return false;
+            }
+        }
+        m_interruption_requested = false;
+
+        return false;
+    }
+
     //! Wakes a thread possibly blocked in the \c dequeue method
     void interrupt_dequeue()
     {
@@ -0,0 +1,311 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   flight_recorder_frontend.hpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * The header contains implementation of the flight recorder sink frontend.
+ */
+
+#ifndef BOOST_LOG_SINKS_FLIGHT_RECORDER_FRONTEND_HPP_INCLUDED_
+#define BOOST_LOG_SINKS_FLIGHT_RECORDER_FRONTEND_HPP_INCLUDED_
+
+#include <boost/log/detail/config.hpp>
+
+#ifdef BOOST_LOG_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+#if defined(BOOST_LOG_NO_THREADS)
+#error Boost.Log: Flight recorder sink frontend is only supported in multithreaded environment
+#endif
+
+#include <cstddef>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/exceptions.hpp>
+#include <boost/log/detail/locking_ptr.hpp>
+#include <boost/log/detail/parameter_tools.hpp>
+#include <boost/log/keywords/capacity.hpp>
+#include <boost/log/detail/flight_recorder.hpp>
+#include <boost/log/detail/locks.hpp>
+#include <boost/log/core/record_view.hpp>
+#include <boost/log/expressions/filter.hpp>
+#include <boost/log/sinks/basic_sink_frontend.hpp>
+#include <boost/log/sinks/frontend_requirements.hpp>
+#include <boost/log/detail/header.hpp>
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace sinks {
+
+#ifndef BOOST_LOG_DOXYGEN_PASS
+
+#define BOOST_LOG_SINK_CTOR_FORWARD_INTERNAL(z, n, types)\
+    template< BOOST_PP_ENUM_PARAMS(n, typename T) >\
+    explicit flight_recorder_sink(BOOST_PP_ENUM_BINARY_PARAMS(n, T, const& arg)) :\
+        base_type(true),\
+        m_pBackend(boost::make_shared< sink_backend_type >(BOOST_PP_ENUM_PARAMS(n, arg))),\
+        m_Recorder((BOOST_PP_ENUM_PARAMS(n, arg))[keywords::capacity | static_cast< std::size_t >(default_capacity)]),\
+        m_fDumpOnDestruction(true)\
+    {\
+    }\
+    template< BOOST_PP_ENUM_PARAMS(n, typename T) >\
+    explicit flight_recorder_sink(shared_ptr< sink_backend_type > const& backend, BOOST_PP_ENUM_BINARY_PARAMS(n, T, const& arg)) :\
+        base_type(true),\
+        m_pBackend(backend),\
+        m_Recorder((BOOST_PP_ENUM_PARAMS(n, arg))[keywords::capacity | static_cast< std::size_t >(default_capacity)]),\
+        m_fDumpOnDestruction(true)\
+    {\
+    }
+
+#endif // BOOST_LOG_DOXYGEN_PASS
+
+/*!
+ * \brief Flight recorder sink frontend
+ *
+ * The sink frontend keeps the most recent log records of every thread in memory and passes them to the backend
+ * only when dumping is triggered. This allows to retain detailed logs for incident analysis without the cost
+ * of formatting and writing every log record. Putting a record into the buffer costs a copy of the record view
+ * and is not blocked by other threads logging or by the backend.
+ *
+ * Dumping is triggered when a record passing the trigger filter is logged (e.g. a record with a high severity level),
+ * when the \c dump method is called or when the frontend is destroyed. Records from all threads are passed
+ * to the backend in the order they were logged. The filter and formatter of the frontend are applied as usual:
+ * records are filtered before they are buffered, and formatted when they are dumped.
+ */
+template< typename SinkBackendT >
+class flight_recorder_sink :
+    public aux::make_sink_frontend_base< SinkBackendT >::type,
+    private boost::log::aux::locking_ptr_counter_base
+{
+    typedef typename aux::make_sink_frontend_base< SinkBackendT >::type base_type;
+
+private:
+    //! Synchronization mutex type
+    typedef boost::mutex backend_mutex_type;
+
+public:
+    //! Sink implementation type
+    typedef SinkBackendT sink_backend_type;
+    //! \cond
+    BOOST_STATIC_ASSERT_MSG((has_requirement< typename sink_backend_type::frontend_requirements, synchronized_feeding >::value), "Flight recorder sink frontend is incompatible with the specified backend: thread synchronization requirements are not met");
+    //! \endcond
+
+    //! The default number of records retained per thread
+    enum { default_capacity = 1024u };
+
+#ifndef BOOST_LOG_DOXYGEN_PASS
+
+    //! A pointer type that locks the backend until it's destroyed
+    typedef boost::log::aux::locking_ptr< sink_backend_type > locked_backend_ptr;
+
+#else // BOOST_LOG_DOXYGEN_PASS
+
+    //! A pointer type that locks the backend until it's destroyed
+    typedef implementation_defined locked_backend_ptr;
+
+#endif // BOOST_LOG_DOXYGEN_PASS
+
+private:
+    //! Synchronization mutex
+    backend_mutex_type m_BackendMutex;
+    //! Pointer to the backend
+    const shared_ptr< sink_backend_type > m_pBackend;
+    //! Per-thread record buffers
+    boost::log::aux::flight_recorder m_Recorder;
+    //! The mutex serializes dumping
+    boost::mutex m_DumpMutex;
+    //! Indicates that the buffered records have to be dumped on destruction
+    bool m_fDumpOnDestruction;
+
+public:
+    /*!
+     * Default constructor. Constructs the sink backend instance.
+     * Requires the backend to be default-constructible.
+     */
+    flight_recorder_sink() :
+        base_type(true),
+        m_pBackend(boost::make_shared< sink_backend_type >()),
+        m_Recorder(default_capacity),
+        m_fDumpOnDestruction(true)
+    {
+    }
+    /*!
+     * Constructor attaches user-constructed backend instance
+     *
+     * \param backend Pointer to the backend instance
+     *
+     * \pre \a backend is not \c NULL.
+     */
+    explicit flight_recorder_sink(shared_ptr< sink_backend_type > const& backend) :
+        base_type(true),
+        m_pBackend(backend),
+        m_Recorder(default_capacity),
+        m_fDumpOnDestruction(true)
+    {
+    }
+
+    // Constructors that pass arbitrary parameters to the backend constructor. The frontend supports the \c capacity
+    // named parameter, which specifies the maximum number of records retained per thread.
+    BOOST_LOG_PARAMETRIZED_CONSTRUCTORS_GEN(BOOST_LOG_SINK_CTOR_FORWARD_INTERNAL, ~)
+
+    /*!
+     * Destructor. Dumps the buffered records, unless disabled with \c dump_on_destruction.
+     */
+    ~flight_recorder_sink()
+    {
+        if (m_fDumpOnDestruction)
+        {
+            try
+            {
+                dump();
+            }
+            catch (...)
+            {
+            }
+        }
+    }
+
+    /*!
+     * Locking accessor to the attached backend
+     */
+    locked_backend_ptr locked_backend()
+    {
+        return locked_backend_ptr(
+            m_pBackend,
+            static_cast< boost::log::aux::locking_ptr_counter_base& >(*this));
+    }
+
+    /*!
+     * \returns The maximum number of records retained per thread
+     */
+    std::size_t capacity() const
+    {
+        return m_Recorder.capacity();
+    }
+    /*!
+     * Sets the maximum number of records retained per thread. The buffers are resized when the threads log the next record.
+     */
+    void set_capacity(std::size_t capacity)
+    {
+        m_Recorder.set_capacity(capacity);
+    }
+
+    /*!
+     * The method sets the trigger filter. Logging a record that passes the trigger filter causes dumping the buffered records.
+     */
+    template< typename FunT >
+    void set_trigger(FunT const& trigger)
+    {
+        m_Recorder.set_trigger(filter(trigger));
+    }
+    /*!
+     * The method resets the trigger filter. Buffered records will only be dumped by calling \c dump or on destruction.
+     */
+    void reset_trigger()
+    {
+        m_Recorder.reset_trigger();
+    }
+
+    /*!
+     * Sets the flag to dump the buffered records when the frontend is destroyed. The flag is set by default.
+     */
+    void dump_on_destruction(bool f = true)
+    {
+        m_fDumpOnDestruction = f;
+    }
+
+    /*!
+     * Puts the log record into the buffer of the current thread. If the record passes the trigger filter,
+     * dumps the buffered records.
+     */
+    void consume(record_view const& rec)
+    {
+        bool triggered = false;
+        try
+        {
+            triggered = m_Recorder.push(rec);
+        }
+        catch (thread_interrupted&)
+        {
+            throw;
+        }
+        catch (...)
+        {
+            boost::log::aux::shared_lock_guard< typename base_type::mutex_type > lock(this->frontend_mutex());
+            if (this->exception_handler().empty())
+                throw;
+            this->exception_handler()();
+        }
+
+        if (triggered)
+            dump();
+    }
+
+    /*!
+     * The method puts the log record into the buffer of the current thread. Buffering does not block,
+     * so the method is equivalent to \c consume.
+     */
+    bool try_consume(record_view const& rec)
+    {
+        consume(rec);
+        return true;
+    }
+
+    /*!
+     * The method passes all buffered records to the backend and flushes the backend.
+     */
+    void dump()
+    {
+        boost::lock_guard< boost::mutex > lock(m_DumpMutex);
+
+        std::vector< record_view > records;
+        m_Recorder.pop_all(records);
+        for (typename std::vector< record_view >::const_iterator it = records.begin(), end = records.end(); it != end; ++it)
+        {
+            base_type::feed_record(*it, m_BackendMutex, *m_pBackend);
+        }
+
+        base_type::flush_backend(m_BackendMutex, *m_pBackend);
+    }
+
+    /*!
+     * The method flushes the backend. The buffered records are not dumped.
+     */
+    void flush()
+    {
+        base_type::flush_backend(m_BackendMutex, *m_pBackend);
+    }
+
+private:
+#ifndef BOOST_LOG_DOXYGEN_PASS
+    // locking_ptr_counter_base methods
+    void lock() { m_BackendMutex.lock(); }
+    bool try_lock() { return m_BackendMutex.try_lock(); }
+    void unlock() { m_BackendMutex.unlock(); }
+#endif // BOOST_LOG_DOXYGEN_PASS
+};
+
+#undef BOOST_LOG_SINK_CTOR_FORWARD_INTERNAL
+
+} // namespace sinks
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_SINKS_FLIGHT_RECORDER_FRONTEND_HPP_INCLUDED_
@@ -75,6 +75,12 @@ struct formatted_records {};
  */
 struct flushing {};
 
+/*!
+ * The sink backend can take the contents of the formatted record strings instead of copying them.
+ * The frontend passes the strings it owns to the \c consume_and_take method of such backends.
+ */
+struct formatted_record_taking {};
+
 #ifdef BOOST_LOG_DOXYGEN_PASS
 
 /*!
@@ -0,0 +1,95 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   gzip_compressor.hpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * The header contains implementation of a gzip compressor of the stored log files.
+ * The compressor is based on Boost.Iostreams, the application that uses it must be linked
+ * with Boost.Iostreams and zlib.
+ */
+
+#ifndef BOOST_LOG_SINKS_GZIP_COMPRESSOR_HPP_INCLUDED_
+#define BOOST_LOG_SINKS_GZIP_COMPRESSOR_HPP_INCLUDED_
+
+#include <istream>
+#include <ostream>
+#include <boost/filesystem/path.hpp>
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/sinks/text_file_backend.hpp>
+#include <boost/log/detail/header.hpp>
+
+#ifdef BOOST_LOG_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace sinks {
+
+namespace file {
+
+/*!
+ * \brief The compressor produces gzip files
+ *
+ * The compressor appends the ".gz" suffix to the names of the compressed files.
+ */
+class gzip_compressor :
+    public compressor
+{
+private:
+    //! Compression level
+    int m_Level;
+
+public:
+    /*!
+     * Constructor. Creates the compressor with the specified compression level.
+     *
+     * \param level Compression level, from \c iostreams::gzip::no_compression to \c iostreams::gzip::best_compression
+     */
+    explicit gzip_compressor(int level = iostreams::gzip::default_compression) : m_Level(level)
+    {
+    }
+
+    /*!
+     * \returns The ".gz" suffix
+     */
+    filesystem::path file_name_suffix() const
+    {
+        return filesystem::path(".gz");
+    }
+
+    /*!
+     * The function compresses the data read from the input stream and writes the compressed data
+     * to the output stream.
+     */
+    void compress(std::istream& input, std::ostream& output)
+    {
+        iostreams::filtering_ostream strm;
+        strm.push(iostreams::gzip_compressor(iostreams::gzip_params(m_Level)));
+        strm.push(output);
+        iostreams::copy(input, strm);
+    }
+};
+
+} // namespace file
+
+} // namespace sinks
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_SINKS_GZIP_COMPRESSOR_HPP_INCLUDED_
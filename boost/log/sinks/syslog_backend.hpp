@@ -24,11 +24,13 @@
 #ifndef BOOST_LOG_WITHOUT_SYSLOG
 
 #include <string>
+#include <cstddef>
 #include <boost/shared_ptr.hpp>
 #include <boost/log/detail/asio_fwd.hpp>
 #include <boost/log/detail/light_function.hpp>
 #include <boost/log/detail/parameter_tools.hpp>
 #include <boost/log/sinks/basic_sink_backend.hpp>
+#include <boost/log/sinks/frontend_requirements.hpp>
 #include <boost/log/sinks/syslog_constants.hpp>
 #include <boost/log/sinks/attribute_mapping.hpp>
 #include <boost/log/attributes/attribute_value_set.hpp>
@@ -63,7 +65,9 @@ namespace syslog {
 #endif
 #endif
 #ifndef BOOST_LOG_NO_ASIO
-        udp_socket_based = 1        //!< Use UDP sockets, according to RFC3164
+        udp_socket_based = 1,       //!< Use UDP sockets, according to RFC3164
+        tcp_socket_based = 2,       //!< Use TCP stream sockets with octet-counting framing, according to RFC6587
+        local_socket_based = 3      //!< Use local (\c AF_UNIX) stream sockets with octet-counting framing, according to RFC6587
 #endif
     };
 
@@ -147,12 +151,34 @@ namespace syslog {
  * Obviously, the \c set_local_address and \c set_target_address
  * methods have no effect for native backends. Using <tt>use_impl = native</tt>
  * on platforms with no native support for POSIX syslog API will have no effect.
+ *
+ * The backend can also deliver records over a connection-oriented transport:
+ * either TCP (<tt>use_impl = tcp_socket_based</tt>) or a local stream socket
+ * (<tt>use_impl = local_socket_based</tt>). In this case messages are framed
+ * according to the octet-counting method described in RFC6587 and are not
+ * truncated to 1024 bytes. Records are accumulated in a buffer and written
+ * to the socket with a single gather operation once the buffer exceeds
+ * the threshold set with \c set_write_threshold, or when the backend is flushed.
+ * The socket operations are performed by a separate thread, so the logging threads are not blocked
+ * by a slow syslog server; connecting and writing are aborted if they take longer than a few seconds.
+ * If the connection breaks, the backend will reconnect on subsequent writes.
+ * Records that could not be sent are kept in a backlog, the size of which is limited
+ * by \c set_max_backlog_size; the oldest records are dropped when the limit is exceeded.
+ * Connection and write errors are reported by throwing \c boost::system::system_error from
+ * the following calls to \c consume or \c flush, so that the sink frontend passes them
+ * to its exception handler.
  */
 class syslog_backend :
-    public basic_formatted_sink_backend< char >
+    public basic_formatted_sink_backend<
+        char,
+        combine_requirements< synchronized_feeding, flushing >::type
+    >
 {
     //! Base type
-    typedef basic_formatted_sink_backend< char > base_type;
+    typedef basic_formatted_sink_backend<
+        char,
+        combine_requirements< synchronized_feeding, flushing >::type
+    > base_type;
     //! Implementation type
     struct implementation;
 
@@ -185,7 +211,13 @@ public:
      *                                   is available, it is equivalent to \c udp_socket_based.
      *                   \li \c udp_socket_based - Use the UDP socket-based implementation, conforming to
      *                                             RFC3164 protocol specification. This is the default.
-     * \li \c ip_version - Specifies IP protocol version to use, in case if socket-based implementation
+     *                   \li \c tcp_socket_based - Use the TCP socket-based implementation with
+     *                                             RFC6587 octet-counting framing.
+     *                   \li \c local_socket_based - Use the local stream socket-based implementation with
+     *                                               RFC6587 octet-counting framing. The socket path must be
+     *                                               set with \c set_target_socket. Only supported on
+     *                                               platforms with \c AF_UNIX sockets.
+     * \li \c ip_version - Specifies IP protocol version to use, in case if UDP or TCP socket-based implementation
      *                     is used. Can be either \c v4 (the default one) or \c v6.
      * \li \c ident - Process identification string. This parameter is only supported by native syslog implementation.
      */
@@ -248,6 +280,37 @@ public:
      */
     BOOST_LOG_API void set_target_address(boost::asio::ip::address const& addr, unsigned short port = 514);
 
+    /*!
+     * The method sets the path of the local stream socket where log records will be sent to.
+     *
+     * \note Only has effect if the backend was constructed to use local stream sockets
+     *
+     * \param path The socket path in the file system
+     */
+    BOOST_LOG_API void set_target_socket(std::string const& path);
+
+    /*!
+     * The method sets the amount of buffered data, in bytes, that is allowed to accumulate
+     * before the backend writes the buffered records to the socket. By default the threshold
+     * is zero, which means that every record is written as soon as it is consumed.
+     *
+     * \note Only has effect if the backend was constructed to use stream sockets
+     *
+     * \param size The threshold, in bytes
+     */
+    BOOST_LOG_API void set_write_threshold(std::size_t size);
+
+    /*!
+     * The method sets the maximum amount of data, in bytes, that is kept in the backlog
+     * while the connection to the syslog server is not available. When the limit is exceeded,
+     * the oldest records are discarded. The default limit is 1 MiB.
+     *
+     * \note Only has effect if the backend was constructed to use stream sockets
+     *
+     * \param size The maximum backlog size, in bytes
+     */
+    BOOST_LOG_API void set_max_backlog_size(std::size_t size);
+
 #endif // !defined(BOOST_LOG_NO_ASIO)
 
     /*!
@@ -255,6 +318,14 @@ public:
      */
     BOOST_LOG_API void consume(record_view const& rec, string_type const& formatted_message);
 
+    /*!
+     * The method writes any buffered records to the syslog server and waits for the write to complete.
+     * Has no effect unless the backend was constructed to use stream sockets.
+     *
+     * \throw boost::system::system_error If connecting to the server or writing records has failed
+     */
+    BOOST_LOG_API void flush();
+
 private:
 #ifndef BOOST_LOG_DOXYGEN_PASS
     //! The method creates the backend implementation
@@ -16,7 +16,9 @@
 #define BOOST_LOG_SINKS_TEXT_FILE_BACKEND_HPP_INCLUDED_
 
 #include <ios>
+#include <cstddef>
 #include <string>
+#include <istream>
 #include <ostream>
 #include <boost/limits.hpp>
 #include <boost/cstdint.hpp>
@@ -29,6 +31,7 @@
 #include <boost/log/keywords/max_size.hpp>
 #include <boost/log/keywords/min_free_space.hpp>
 #include <boost/log/keywords/target.hpp>
+#include <boost/log/keywords/compressor.hpp>
 #include <boost/log/keywords/file_name.hpp>
 #include <boost/log/keywords/open_mode.hpp>
 #include <boost/log/keywords/auto_flush.hpp>
@@ -37,6 +40,7 @@
 #include <boost/log/detail/config.hpp>
 #include <boost/log/detail/light_function.hpp>
 #include <boost/log/detail/parameter_tools.hpp>
+#include <boost/log/detail/timestamp.hpp>
 #include <boost/log/sinks/basic_sink_backend.hpp>
 #include <boost/log/sinks/frontend_requirements.hpp>
 #include <boost/log/detail/header.hpp>
@@ -61,6 +65,39 @@ enum scan_method
     scan_all        //!< Scan for all files in the directory
 };
 
+//! The enumeration of the policies of synchronizing the written files with the storage device
+enum sync_policy
+{
+    no_sync,        //!< Don't synchronize the files, leave it to the operating system
+    periodic_sync,  //!< Synchronize the files in a background thread, after the specified time interval or amount of written data
+    batch_sync,     //!< Synchronize the files every time the accumulated records are written
+    record_sync     //!< Synchronize the files after every record
+};
+
+//! File synchronization statistics
+struct sync_statistics
+{
+    //! The number of performed synchronizations
+    uintmax_t sync_count;
+    //! The number of failed synchronizations
+    uintmax_t failure_count;
+    //! The total time spent in synchronization
+    posix_time::time_duration total_sync_time;
+    //! The longest synchronization time
+    posix_time::time_duration max_sync_time;
+    //! The amount of data, in bytes, written to the file since the last synchronization
+    uintmax_t pending_size;
+
+    sync_statistics() :
+        sync_count(0),
+        failure_count(0),
+        total_sync_time(0, 0, 0),
+        max_sync_time(0, 0, 0),
+        pending_size(0)
+    {
+    }
+};
+
 /*!
  * \brief Base class for file collectors
  *
@@ -102,6 +139,9 @@ struct BOOST_LOG_NO_VTABLE collector
      *
      * All other placeholders are not supported.
      *
+     * If the collector compresses the stored files, temporary files left in the directory by
+     * interrupted compressions of the matching files are removed.
+     *
      * \param method The method of scanning. If \c no_scan is specified, the call has no effect.
      * \param pattern The file name pattern if \a method is \c scan_matching. Otherwise the parameter
      *                is not used.
@@ -123,6 +163,44 @@ struct BOOST_LOG_NO_VTABLE collector
     BOOST_LOG_DELETED_FUNCTION(collector& operator= (collector const&))
 };
 
+/*!
+ * \brief Base class for compressors of stored files
+ *
+ * A compressor can be passed to the file collector in order to compress log files
+ * as they are stored. The compressor must be thread-safe, as it may be used to compress
+ * several files concurrently.
+ */
+struct BOOST_LOG_NO_VTABLE compressor
+{
+    /*!
+     * Default constructor
+     */
+    BOOST_LOG_DEFAULTED_FUNCTION(compressor(), {})
+
+    /*!
+     * Virtual destructor
+     */
+    virtual ~compressor() {}
+
+    /*!
+     * \returns The suffix that is appended to the names of the compressed files, e.g. ".gz".
+     *          The suffix must not be empty.
+     */
+    virtual filesystem::path file_name_suffix() const = 0;
+
+    /*!
+     * The function compresses the data read from the input stream and writes the compressed data
+     * to the output stream. The function should throw an exception in case of failure.
+     *
+     * \param input The stream to read the file contents from
+     * \param output The stream to write the compressed data to
+     */
+    virtual void compress(std::istream& input, std::ostream& output) = 0;
+
+    BOOST_LOG_DELETED_FUNCTION(compressor(compressor const&))
+    BOOST_LOG_DELETED_FUNCTION(compressor& operator= (compressor const&))
+};
+
 namespace aux {
 
     //! Creates and returns a file collector with the specified parameters
@@ -131,13 +209,21 @@ namespace aux {
         uintmax_t max_size,
         uintmax_t min_free_space
     );
+    //! Creates and returns a file collector with the specified parameters
+    BOOST_LOG_API shared_ptr< collector > make_collector(
+        filesystem::path const& target_dir,
+        uintmax_t max_size,
+        uintmax_t min_free_space,
+        shared_ptr< compressor > const& comp
+    );
     template< typename ArgsT >
     inline shared_ptr< collector > make_collector(ArgsT const& args)
     {
         return aux::make_collector(
             filesystem::path(args[keywords::target]),
             args[keywords::max_size | (std::numeric_limits< uintmax_t >::max)()],
-            args[keywords::min_free_space | static_cast< uintmax_t >(0)]);
+            args[keywords::min_free_space | static_cast< uintmax_t >(0)],
+            args[keywords::compressor | shared_ptr< compressor >()]);
     }
 
 } // namespace aux
@@ -159,6 +245,11 @@ inline shared_ptr< collector > make_collector(T1 const& a1, T2 const& a2, T3 con
 {
     return aux::make_collector((a1, a2, a3));
 }
+template< typename T1, typename T2, typename T3, typename T4 >
+inline shared_ptr< collector > make_collector(T1 const& a1, T2 const& a2, T3 const& a3, T4 const& a4)
+{
+    return aux::make_collector((a1, a2, a3, a4));
+}
 
 #else
 
@@ -190,6 +281,9 @@ inline shared_ptr< collector > make_collector(T1 const& a1, T2 const& a2, T3 con
  *                         the collector tries to maintain. If the threshold is exceeded, the oldest
  *                         file(s) is deleted to free space. The threshold is not maintained, if not
  *                         specified.
+ * \li \c compressor - Specifies a pointer to the \c compressor that is used to compress the stored files.
+ *                     The size thresholds are applied to the compressed file sizes. The files are not
+ *                     compressed, if not specified.
  *
  * \return The file collector.
  */
@@ -207,6 +301,10 @@ shared_ptr< collector > make_collector(ArgsT... const& args);
  * \li rotation takes place on the specified day of every month, at the specified time
  *
  * The time points are considered to be local time.
+ *
+ * The predicate computes the next rotation time when it is first called and after every rotation.
+ * In between, it only consults a monotonic timer and reads the system clock no more often than
+ * once a second, so that calling the predicate for every log record is cheap.
  */
 class rotation_at_time_point
 {
@@ -226,6 +324,9 @@ private:
     unsigned char m_Hour, m_Minute, m_Second;
 
     mutable posix_time::ptime m_Previous;
+    mutable posix_time::ptime m_Next;
+    mutable boost::log::aux::timestamp m_LastCheck;
+    mutable int64_t m_CheckDelay;
 
 public:
     /*!
@@ -269,11 +370,17 @@ public:
      * Checks if it's time to rotate the file
      */
     BOOST_LOG_API bool operator() () const;
+
+private:
+    //! Computes the rotation time that follows the previous rotation
+    posix_time::ptime next_rotation_time() const;
 };
 
 /*!
  * The class represents the time interval of log file rotation. The log file will be rotated
  * after the specified time interval has passed.
+ *
+ * Like \c rotation_at_time_point, the predicate reads the system clock no more often than once a second.
  */
 class rotation_at_time_interval
 {
@@ -283,6 +390,8 @@ public:
 private:
     posix_time::time_duration m_Interval;
     mutable posix_time::ptime m_Previous;
+    mutable boost::log::aux::timestamp m_LastCheck;
+    mutable int64_t m_CheckDelay;
 
 public:
     /*!
@@ -291,7 +400,8 @@ public:
      * \param interval The interval of the rotation, should be no less than 1 second
      */
     explicit rotation_at_time_interval(posix_time::time_duration const& interval) :
-        m_Interval(interval)
+        m_Interval(interval),
+        m_CheckDelay(0)
     {
         BOOST_ASSERT(!interval.is_special());
         BOOST_ASSERT(interval.total_seconds() > 0);
@@ -316,13 +426,13 @@ public:
 class text_file_backend :
     public basic_formatted_sink_backend<
         char,
-        combine_requirements< synchronized_feeding, flushing >::type
+        combine_requirements< synchronized_feeding, flushing, formatted_record_taking >::type
     >
 {
     //! Base type
     typedef basic_formatted_sink_backend<
         char,
-        combine_requirements< synchronized_feeding, flushing >::type
+        combine_requirements< synchronized_feeding, flushing, formatted_record_taking >::type
     > base_type;
 
 public:
@@ -455,6 +565,8 @@ public:
      * \note The rotation always occurs on writing a log record, so the rotation is
      *       not strictly bound to the specified condition.
      *
+     * \note The predicate is called for every log record written to the file.
+     *
      * \param predicate The predicate that defines the time-based condition for file rotation.
      *                  If empty, no time-based rotation will take place.
      */
@@ -487,11 +599,108 @@ public:
     BOOST_LOG_API uintmax_t scan_for_files(
         file::scan_method method = file::scan_matching, bool update_counter = true);
 
+    /*!
+     * Sets the maximum number of rotated files that may wait for being passed to the file collector.
+     * If the value is not zero, rotated files are passed to the file collector in a background thread,
+     * so that moving the files and deleting the old ones does not block logging. If the number of files
+     * waiting for collection reaches the limit, file rotation blocks until one of the files is collected.
+     * A zero value makes the backend pass rotated files to the collector immediately, in the thread
+     * that performs rotation. If the value is not set, rotated files are passed to the file collector
+     * immediately, unless the collector compresses the files. In the latter case files are collected
+     * in background with a small backlog, so that compression does not block logging.
+     *
+     * \note Flushing the backend blocks until all pending files are collected. Errors that occur
+     *       while collecting files in background are reported by the next rotation or flush.
+     *
+     * \note In single-threaded builds rotated files are always collected immediately.
+     */
+    BOOST_LOG_API void set_collection_backlog_size(std::size_t size);
+
+    /*!
+     * Sets the number of formatted records the backend accumulates before writing them to the file.
+     * The accumulated records are written with a single gather operation, where supported by the system.
+     * A zero value, which is the default, disables accumulation and every record is written to the
+     * file stream as it arrives.
+     *
+     * \note The accumulated records are also written when the backend is flushed, when auto-flush
+     *       is enabled and before the file is rotated.
+     */
+    BOOST_LOG_API void set_write_batch_size(std::size_t size);
+
+    /*!
+     * Enables writing to the files through memory mapping. If the size is not zero, the file is extended
+     * by regions of the specified size (rounded up to the memory page size), which are mapped to memory,
+     * and the records are copied directly to the mapped memory. When the file is closed, it is truncated
+     * to the size of the written data. A zero value, which is the default, makes the backend write
+     * the files through a buffer.
+     *
+     * The setting takes effect when the next file is opened.
+     *
+     * \note While the file is open, its size includes the allocated space beyond the written data, which is
+     *       filled with zeros. If the application terminates abnormally, the file is not truncated.
+     *
+     * \note Memory mapping is only supported on POSIX systems. On other systems the setting is ignored.
+     */
+    BOOST_LOG_API void set_mapped_extent_size(std::size_t size);
+
+    /*!
+     * Sets the policy of synchronizing the written data with the storage device. By default
+     * the backend does not synchronize the files (\c file::no_sync), so the data that has been
+     * written but not yet stored by the operating system may be lost if the system crashes.
+     *
+     * \li With \c file::periodic_sync the data is synchronized in a background thread. When a record
+     *     is written after the time interval set with \c set_sync_interval has elapsed or after the amount
+     *     of data set with \c set_sync_size has been written, the file buffer is written and
+     *     the background thread is requested to synchronize the file. If no records are written
+     *     after that, the background thread synchronizes the data written to the file when the interval
+     *     elapses. The data that is still buffered in the file stream (e.g. if auto-flush is disabled)
+     *     is not synchronized until the next request or \c flush.
+     * \li With \c file::batch_sync the file is synchronized every time the accumulated records are
+     *     written, see \c set_write_batch_size. If accumulation is disabled, the file is synchronized
+     *     after every record.
+     * \li With \c file::record_sync the file is synchronized after every record.
+     *
+     * With any policy other than \c file::no_sync the file is also synchronized when the backend
+     * is flushed and before the file is closed on rotation.
+     *
+     * \note In single-threaded builds \c file::periodic_sync synchronizes the file in the thread
+     *       that writes the record which exceeds the interval or the data size.
+     */
+    BOOST_LOG_API void set_sync_policy(file::sync_policy policy);
+
+    /*!
+     * Sets the time interval for the \c file::periodic_sync policy. The default is one second.
+     */
+    BOOST_LOG_API void set_sync_interval(posix_time::time_duration const& interval);
+
+    /*!
+     * Sets the amount of written data, in bytes, after which the file is synchronized with
+     * the \c file::periodic_sync policy. By default the amount is not limited and the file
+     * is synchronized only after the time interval elapses.
+     */
+    BOOST_LOG_API void set_sync_size(uintmax_t size);
+
+    /*!
+     * \returns The statistics of the file synchronizations performed since the backend construction.
+     */
+    BOOST_LOG_API file::sync_statistics get_sync_statistics() const;
+
     /*!
      * The method writes the message to the sink
      */
     BOOST_LOG_API void consume(record_view const& rec, string_type const& formatted_message);
 
+    /*!
+     * The method writes the message to the sink. If accumulation of records is enabled, the backend
+     * takes the contents of \a formatted_message instead of copying it. The string is left empty
+     * upon return, but it may have capacity reserved by a previously written record, so that it
+     * can be reused for formatting subsequent records without allocating memory. If accumulation
+     * is disabled, the method is equivalent to \c consume and leaves the string intact.
+     *
+     * \note The sink frontends call this method instead of \c consume to pass the string they own.
+     */
+    BOOST_LOG_API void consume_and_take(record_view const& rec, string_type& formatted_message);
+
     /*!
      * The method flushes the currently open log file
      */
@@ -525,6 +734,9 @@ private:
 
     //! The method sets file name mask
     BOOST_LOG_API void set_file_name_pattern_internal(filesystem::path const& pattern);
+
+    //! The method rotates the file if needed and opens a new one before writing a record of the specified size
+    void prepare_file(std::size_t size);
 #endif // BOOST_LOG_DOXYGEN_PASS
 };
 
@@ -26,6 +26,7 @@
 #error Boost.Log: This header content is only supported in multithreaded environment
 #endif
 
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <boost/log/detail/event.hpp>
 #include <boost/log/detail/threadsafe_queue.hpp>
 #include <boost/log/core/record_view.hpp>
@@ -123,6 +124,27 @@ protected:
         }
     }
 
+    //! Dequeues log record from the queue, blocks if the queue is empty until the deadline (in UTC) is reached
+    bool try_dequeue_ready(record_view& rec, posix_time::ptime const& deadline)
+    {
+        // Try the fast way first
+        if (m_queue.try_pop(rec))
+            return true;
+
+        while (m_event.timed_wait(deadline))
+        {
+            if (m_interruption_requested)
+            {
+                m_interruption_requested = false;
+                return false;
+            }
+            if (m_queue.try_pop(rec))
+                return true;
+        }
+
+        return false;
+    }
+
     //! Wakes a thread possibly blocked in the \c dequeue method
     void interrupt_dequeue()
     {
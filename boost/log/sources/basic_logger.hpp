@@ -30,15 +30,22 @@
 #include <boost/preprocessor/repetition/enum_binary_params.hpp>
 #include <boost/preprocessor/repetition/repeat_from_to.hpp>
 #include <boost/preprocessor/seq/enum.hpp>
+#include <boost/intrusive_ptr.hpp>
+#include <boost/mpl/if.hpp>
 #include <boost/log/detail/config.hpp>
 #include <boost/log/detail/parameter_tools.hpp>
 #include <boost/log/attributes/attribute_set.hpp>
 #include <boost/log/attributes/attribute_name.hpp>
 #include <boost/log/attributes/attribute.hpp>
+#include <boost/log/attributes/attribute_value_set.hpp>
+#include <boost/log/utility/intrusive_ref_counter.hpp>
 #include <boost/log/core/core.hpp>
 #include <boost/log/core/record.hpp>
 #include <boost/log/sources/features.hpp>
 #include <boost/log/sources/threading_models.hpp>
+#if !defined(BOOST_LOG_NO_THREADS)
+#include <boost/log/detail/atomic_intrusive_ptr.hpp>
+#endif
 #include <boost/log/detail/header.hpp>
 
 #ifdef BOOST_LOG_HAS_PRAGMA_ONCE
@@ -51,6 +58,136 @@ BOOST_LOG_OPEN_NAMESPACE
 
 namespace sources {
 
+namespace aux {
+
+/*!
+ * The wrapper of the named arguments of the record being opened. Logger features use it to pass a record-specific
+ * attribute value down to the basic logger, which attaches the value to the record. The named arguments are accessible
+ * through the wrapper as usual.
+ */
+template< typename ArgsT >
+class args_with_source_value :
+    public ArgsT
+{
+private:
+    //! The record-specific attribute value
+    attribute_value_set::value_type const& m_SourceValue;
+
+public:
+    args_with_source_value(ArgsT const& args, attribute_value_set::value_type const& value) : ArgsT(args), m_SourceValue(value)
+    {
+    }
+
+    attribute_value_set::value_type const& source_value() const { return m_SourceValue; }
+};
+
+//! The function attaches a record-specific attribute value to the named arguments of the record being opened
+template< typename ArgsT >
+inline args_with_source_value< ArgsT > add_source_value(ArgsT const& args, attribute_value_set::value_type const& value)
+{
+    return args_with_source_value< ArgsT >(args, value);
+}
+
+//! The function opens a record with the logger attributes
+template< typename ArgsT >
+inline record open_record_with_attributes(core_ptr const& core, attribute_set const& attrs, ArgsT const&)
+{
+    return core->open_record(attrs);
+}
+
+//! The function opens a record with the logger attributes and the record-specific attribute value
+template< typename ArgsT >
+inline record open_record_with_attributes(core_ptr const& core, attribute_set const& attrs, args_with_source_value< ArgsT > const& args)
+{
+    attribute_value_set::value_type const& value = args.source_value();
+    return core->open_record(attrs, value.first, value.second);
+}
+
+/*!
+ * The class publishes the logger attributes for opening records. Loggers with locking threading models
+ * open records with the logger attributes directly.
+ */
+template< typename ThreadingModelT, bool LockFreeV = is_lock_free_thread_model< ThreadingModelT >::value >
+class published_attributes
+{
+public:
+    explicit published_attributes(attribute_set const&) {}
+
+    //! The method publishes the modified attributes
+    void publish(attribute_set const&) {}
+    //! The method returns the copy of the published attributes
+    attribute_set get(attribute_set const& attrs) const { return attrs; }
+    //! The method opens a record with the published attributes
+    template< typename ArgsT >
+    record open_record(core_ptr const& core, attribute_set const& attrs, ArgsT const& args) const
+    {
+        return aux::open_record_with_attributes(core, attrs, args);
+    }
+};
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+//! Immutable snapshot of the logger attributes
+class attribute_snapshot :
+    public intrusive_ref_counter
+{
+private:
+    //! The attributes
+    const attribute_set m_Attributes;
+
+public:
+    explicit attribute_snapshot(attribute_set const& attrs) : m_Attributes(attrs)
+    {
+    }
+
+    attribute_set const& attributes() const { return m_Attributes; }
+};
+
+/*!
+ * The class publishes the logger attributes as immutable snapshots. Records are opened with the current snapshot without locking,
+ * every modification of the attributes replaces the snapshot. Scoped attributes are copied into the snapshot,
+ * so the attribute values never refer to the scope guards.
+ */
+template< typename ThreadingModelT >
+class published_attributes< ThreadingModelT, true >
+{
+private:
+    //! Snapshot pointer type
+    typedef boost::log::aux::atomic_intrusive_ptr< attribute_snapshot > snapshot_ptr;
+
+private:
+    //! The current snapshot
+    snapshot_ptr m_Snapshot;
+
+public:
+    explicit published_attributes(attribute_set const& attrs) : m_Snapshot(new attribute_snapshot(attrs))
+    {
+    }
+
+    //! The method publishes the modified attributes
+    void publish(attribute_set const& attrs)
+    {
+        m_Snapshot.store(new attribute_snapshot(attrs));
+    }
+    //! The method returns the copy of the published attributes
+    attribute_set get(attribute_set const&) const
+    {
+        snapshot_ptr::read_guard snapshot(m_Snapshot);
+        return snapshot->attributes();
+    }
+    //! The method opens a record with the published attributes
+    template< typename ArgsT >
+    record open_record(core_ptr const& core, attribute_set const&, ArgsT const& args) const
+    {
+        snapshot_ptr::read_guard snapshot(m_Snapshot);
+        return aux::open_record_with_attributes(core, snapshot->attributes(), args);
+    }
+};
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
+
+} // namespace aux
+
 /*!
  * \brief Basic logger class
  *
@@ -68,8 +205,8 @@ namespace sources {
  *     The \c basic_logger class itself requires methods of the
  *     SharedLockable concept. The threading model policy must also be
  *     default and copy-constructible and support member function \c swap.
- *     There are currently two policies provided: \c single_thread_model
- *     and \c multi_thread_model.
+ *     There are currently three policies provided: \c single_thread_model,
+ *     \c multi_thread_model and \c lock_free_thread_model.
  *
  * The logger implements fundamental facilities of loggers, such as storing
  * source-specific attribute set and formatting log record messages. The basic
@@ -101,9 +238,17 @@ public:
     //! Lock requirement for the remove_all_attributes_unlocked method
     typedef boost::log::aux::exclusive_lock_guard< threading_model > remove_all_attributes_lock;
     //! Lock requirement for the get_attributes method
-    typedef boost::log::aux::shared_lock_guard< threading_model > get_attributes_lock;
+    typedef typename mpl::if_<
+        aux::is_lock_free_thread_model< threading_model >,
+        no_lock< const threading_model >,
+        boost::log::aux::shared_lock_guard< const threading_model >
+    >::type get_attributes_lock;
     //! Lock requirement for the open_record_unlocked method
-    typedef boost::log::aux::shared_lock_guard< threading_model > open_record_lock;
+    typedef typename mpl::if_<
+        aux::is_lock_free_thread_model< threading_model >,
+        no_lock< threading_model >,
+        boost::log::aux::shared_lock_guard< threading_model >
+    >::type open_record_lock;
     //! Lock requirement for the set_attributes method
     typedef boost::log::aux::exclusive_lock_guard< threading_model > set_attributes_lock;
 #else
@@ -125,6 +270,8 @@ private:
 
     //! Logger-specific attribute set
     attribute_set m_Attributes;
+    //! Logger-specific attributes used to open records
+    aux::published_attributes< threading_model > m_PublishedAttributes;
 
 public:
     /*!
@@ -133,7 +280,8 @@ public:
      */
     basic_logger() :
         threading_model(),
-        m_pCore(core::get())
+        m_pCore(core::get()),
+        m_PublishedAttributes(m_Attributes)
     {
     }
     /*!
@@ -146,7 +294,8 @@ public:
     basic_logger(basic_logger const& that) :
         threading_model(static_cast< threading_model const& >(that)),
         m_pCore(core::get()),
-        m_Attributes(that.m_Attributes)
+        m_Attributes(that.m_Attributes),
+        m_PublishedAttributes(m_Attributes)
     {
     }
     /*!
@@ -157,10 +306,13 @@ public:
      * \param that Source logger
      */
     basic_logger(BOOST_RV_REF(basic_logger) that) :
-        threading_model(boost::move(static_cast< threading_model& >(that)))
+        threading_model(boost::move(static_cast< threading_model& >(that))),
+        m_PublishedAttributes(m_Attributes)
     {
         m_pCore.swap(that.m_pCore);
         m_Attributes.swap(that.m_Attributes);
+        m_PublishedAttributes.publish(m_Attributes);
+        that.m_PublishedAttributes.publish(that.m_Attributes);
     }
     /*!
      * Constructor with named arguments. The constructor ignores all arguments. The result of
@@ -169,7 +321,8 @@ public:
     template< typename ArgsT >
     explicit basic_logger(ArgsT const&) :
         threading_model(),
-        m_pCore(core::get())
+        m_pCore(core::get()),
+        m_PublishedAttributes(m_Attributes)
     {
     }
 
@@ -180,6 +333,9 @@ protected:
     core_ptr const& core() const { return m_pCore; }
     /*!
      * An accessor to the logger attributes
+     *
+     * \note With \c lock_free_thread_model, modifications made through this accessor take effect
+     *       after \c publish_attributes_unlocked is called.
      */
     attribute_set& attributes() { return m_Attributes; }
     /*!
@@ -218,6 +374,17 @@ protected:
     {
         get_threading_model().swap(that.get_threading_model());
         m_Attributes.swap(that.m_Attributes);
+        m_PublishedAttributes.publish(m_Attributes);
+        that.m_PublishedAttributes.publish(that.m_Attributes);
+    }
+
+    /*!
+     * Publishes the logger attributes for opening records. Only needed after modifying the attributes
+     * through the \c attributes accessor.
+     */
+    void publish_attributes_unlocked()
+    {
+        m_PublishedAttributes.publish(m_Attributes);
     }
 
     /*!
@@ -225,7 +392,10 @@ protected:
      */
     std::pair< attribute_set::iterator, bool > add_attribute_unlocked(attribute_name const& name, attribute const& attr)
     {
-        return m_Attributes.insert(name, attr);
+        std::pair< attribute_set::iterator, bool > res = m_Attributes.insert(name, attr);
+        if (res.second)
+            m_PublishedAttributes.publish(m_Attributes);
+        return res;
     }
 
     /*!
@@ -234,14 +404,38 @@ protected:
     void remove_attribute_unlocked(attribute_set::iterator it)
     {
         m_Attributes.erase(it);
+        m_PublishedAttributes.publish(m_Attributes);
+    }
+
+#ifndef BOOST_LOG_DOXYGEN_PASS
+    /*!
+     * Unlocked \c add_scoped_attribute
+     */
+    std::pair< attribute_set::iterator, bool > add_scoped_attribute_unlocked(attribute_set::external_node& n)
+    {
+        std::pair< attribute_set::iterator, bool > res = m_Attributes.insert_external(n);
+        if (res.second)
+            m_PublishedAttributes.publish(m_Attributes);
+        return res;
     }
 
+    /*!
+     * Unlocked \c remove_scoped_attribute
+     */
+    void remove_scoped_attribute_unlocked(attribute_set::external_node& n)
+    {
+        m_Attributes.erase_external(n);
+        m_PublishedAttributes.publish(m_Attributes);
+    }
+#endif // BOOST_LOG_DOXYGEN_PASS
+
     /*!
      * Unlocked \c remove_all_attributes
      */
     void remove_all_attributes_unlocked()
     {
         m_Attributes.clear();
+        m_PublishedAttributes.publish(m_Attributes);
     }
 
     /*!
@@ -249,15 +443,15 @@ protected:
      */
     record open_record_unlocked()
     {
-        return m_pCore->open_record(m_Attributes);
+        return m_PublishedAttributes.open_record(m_pCore, m_Attributes, boost::log::aux::empty_arg_list());
     }
     /*!
-     * Unlocked \c open_record
+     * Unlocked \c open_record. If \a args carry a record-specific attribute value, the value is attached to the record.
      */
     template< typename ArgsT >
-    record open_record_unlocked(ArgsT const&)
+    record open_record_unlocked(ArgsT const& args)
     {
-        return m_pCore->open_record(m_Attributes);
+        return m_PublishedAttributes.open_record(m_pCore, m_Attributes, args);
     }
 
     /*!
@@ -273,7 +467,7 @@ protected:
      */
     attribute_set get_attributes_unlocked() const
     {
-        return m_Attributes;
+        return m_PublishedAttributes.get(m_Attributes);
     }
 
     /*!
@@ -282,6 +476,7 @@ protected:
     void set_attributes_unlocked(attribute_set const& attrs)
     {
         m_Attributes = attrs;
+        m_PublishedAttributes.publish(m_Attributes);
     }
 
     //! Assignment is closed (should be implemented through copy and swap in the final class)
@@ -339,7 +534,11 @@ public:
     /*!
      * Default constructor (default-constructs all features)
      */
-    basic_composite_logger() {}
+    basic_composite_logger()
+    {
+        // Features may have modified the attributes directly
+        base_type::publish_attributes_unlocked();
+    }
     /*!
      * Copy constructor
      */
@@ -350,6 +549,7 @@ public:
             static_cast< base_type const& >(that)
         ))
     {
+        base_type::publish_attributes_unlocked();
     }
     /*!
      * Move constructor
@@ -357,6 +557,7 @@ public:
     basic_composite_logger(BOOST_RV_REF(logger_base) that) :
         base_type(boost::move(static_cast< base_type& >(that)))
     {
+        base_type::publish_attributes_unlocked();
     }
     /*!
      * Constructor with named parameters
@@ -364,6 +565,7 @@ public:
     template< typename ArgsT >
     explicit basic_composite_logger(ArgsT const& args) : base_type(args)
     {
+        base_type::publish_attributes_unlocked();
     }
 
     /*!
@@ -395,6 +597,27 @@ public:
         base_type::remove_attribute_unlocked(it);
     }
 
+#ifndef BOOST_LOG_DOXYGEN_PASS
+    /*!
+     * The method links the node owned by a scoped attribute guard into the source-specific attribute set.
+     * For internal use by scoped attributes.
+     */
+    std::pair< attribute_set::iterator, bool > add_scoped_attribute(attribute_set::external_node& n)
+    {
+        typename base_type::add_attribute_lock lock(base_type::get_threading_model());
+        return base_type::add_scoped_attribute_unlocked(n);
+    }
+    /*!
+     * The method unlinks the node owned by a scoped attribute guard from the source-specific attribute set.
+     * For internal use by scoped attributes.
+     */
+    void remove_scoped_attribute(attribute_set::external_node& n)
+    {
+        typename base_type::remove_attribute_lock lock(base_type::get_threading_model());
+        base_type::remove_scoped_attribute_unlocked(n);
+    }
+#endif // BOOST_LOG_DOXYGEN_PASS
+
     /*!
      * The method removes all attributes from the logger. All iterators and references to the removed attributes are invalidated.
      */
@@ -548,6 +771,14 @@ public:
     {
         base_type::remove_attribute_unlocked(it);
     }
+    std::pair< attribute_set::iterator, bool > add_scoped_attribute(attribute_set::external_node& n)
+    {
+        return base_type::add_scoped_attribute_unlocked(n);
+    }
+    void remove_scoped_attribute(attribute_set::external_node& n)
+    {
+        base_type::remove_scoped_attribute_unlocked(n);
+    }
     void remove_all_attributes()
     {
         base_type::remove_all_attributes_unlocked();
@@ -22,7 +22,9 @@
 #include <boost/log/detail/locks.hpp>
 #include <boost/log/detail/default_attribute_names.hpp>
 #include <boost/log/keywords/channel.hpp>
+#include <boost/log/attributes/attribute_value.hpp>
 #include <boost/log/attributes/mutable_constant.hpp>
+#include <boost/log/sources/threading_models.hpp>
 #include <boost/log/utility/strictest_lock.hpp>
 #include <boost/log/core/record.hpp>
 #include <boost/log/detail/header.hpp>
@@ -37,6 +39,163 @@ BOOST_LOG_OPEN_NAMESPACE
 
 namespace sources {
 
+namespace aux {
+
+    //! Channel attribute for loggers that are not thread-safe
+    template< typename ChannelT >
+    class unlocked_channel_attribute :
+        public attributes::mutable_constant< ChannelT >
+    {
+        //! Base type
+        typedef attributes::mutable_constant< ChannelT > base_type;
+
+    public:
+        //! Channel type
+        typedef ChannelT value_type;
+
+        //! The guard sets the channel name of the record being opened
+        class record_channel_guard
+        {
+        public:
+            record_channel_guard(unlocked_channel_attribute& attr, value_type const& ch)
+            {
+                attr.set(ch);
+            }
+
+            //  Copying prohibited
+            BOOST_LOG_DELETED_FUNCTION(record_channel_guard(record_channel_guard const&))
+            BOOST_LOG_DELETED_FUNCTION(record_channel_guard& operator= (record_channel_guard const&))
+        };
+
+    public:
+        //! Initializing constructor
+        explicit unlocked_channel_attribute(value_type const& value) : base_type(value)
+        {
+        }
+    };
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+    //! The structure holds the channel name of the record being opened in the current thread
+    struct channel_override
+    {
+        //! The channel attribute implementation the channel name is set for
+        const void* m_pOwner;
+        //! The channel name
+        attribute_value m_Value;
+        //! The previous channel override of the current thread, if records are opened recursively
+        channel_override* m_pPrevious;
+    };
+
+    //! The function returns the channel override of the record being opened in the current thread
+    BOOST_LOG_API channel_override* get_channel_override();
+    //! The function sets the channel override of the record being opened in the current thread
+    BOOST_LOG_API void set_channel_override(channel_override* p);
+
+    /*!
+     * Channel attribute for thread-safe loggers. The channel name is updated without locking. The channel name
+     * specified for a particular record is passed to the record through the thread-specific channel override,
+     * so that concurrent records with other channel names do not affect it. The channel name is only stored
+     * in the logger if it differs from the current one, so records opened with the same channel name do not
+     * modify the logger.
+     */
+    template< typename ChannelT >
+    class lock_free_channel_attribute :
+        public attributes::mutable_constant< ChannelT, attributes::lock_free_update >
+    {
+        //! Base type
+        typedef attributes::mutable_constant< ChannelT, attributes::lock_free_update > base_type;
+
+    public:
+        //! Channel type
+        typedef ChannelT value_type;
+
+    protected:
+        //! Factory implementation
+        class BOOST_LOG_VISIBLE impl :
+            public base_type::impl
+        {
+            //! Base type
+            typedef typename base_type::impl base_impl;
+
+        public:
+            //! Initializing constructor
+            explicit impl(value_type const& value) : base_impl(value)
+            {
+            }
+
+            //! The method returns the channel name of the record being opened in the current thread, or the current channel name
+            attribute_value get_value()
+            {
+                for (channel_override* p = get_channel_override(); p; p = p->m_pPrevious)
+                {
+                    if (p->m_pOwner == this)
+                        return p->m_Value;
+                }
+                return base_impl::get_value();
+            }
+        };
+
+    public:
+        //! The guard sets the channel name of the record being opened
+        class record_channel_guard
+        {
+        private:
+            //! The channel override of the record
+            channel_override m_Override;
+
+        public:
+            record_channel_guard(lock_free_channel_attribute& attr, value_type const& ch)
+            {
+                impl* p = static_cast< impl* >(attr.get_impl());
+                m_Override.m_pOwner = p;
+                m_Override.m_Value = p->update(ch);
+                m_Override.m_pPrevious = get_channel_override();
+                set_channel_override(&m_Override);
+            }
+            ~record_channel_guard()
+            {
+                set_channel_override(m_Override.m_pPrevious);
+            }
+
+            //  Copying prohibited
+            BOOST_LOG_DELETED_FUNCTION(record_channel_guard(record_channel_guard const&))
+            BOOST_LOG_DELETED_FUNCTION(record_channel_guard& operator= (record_channel_guard const&))
+        };
+
+    public:
+        //! Initializing constructor
+        explicit lock_free_channel_attribute(value_type const& value) : base_type(new impl(value))
+        {
+        }
+    };
+
+    //! The metafunction selects the channel attribute type for the logger threading model
+    template< typename ChannelT, typename ThreadingModelT >
+    struct make_channel_attribute
+    {
+        typedef lock_free_channel_attribute< ChannelT > type;
+    };
+
+    template< typename ChannelT >
+    struct make_channel_attribute< ChannelT, single_thread_model >
+    {
+        typedef unlocked_channel_attribute< ChannelT > type;
+    };
+
+#else // !defined(BOOST_LOG_NO_THREADS)
+
+    //! The metafunction selects the channel attribute type for the logger threading model
+    template< typename ChannelT, typename ThreadingModelT >
+    struct make_channel_attribute
+    {
+        typedef unlocked_channel_attribute< ChannelT > type;
+    };
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
+
+} // namespace aux
+
 /*!
  * \brief Channel feature implementation
  */
@@ -60,17 +219,15 @@ public:
     //! Channel type
     typedef ChannelT channel_type;
     //! Channel attribute type
-    typedef attributes::mutable_constant< channel_type > channel_attribute;
+    typedef typename aux::make_channel_attribute< channel_type, threading_model >::type channel_attribute;
 
+#if defined(BOOST_LOG_DOXYGEN_PASS)
     //! Lock requirement for the \c open_record_unlocked method
     typedef typename strictest_lock<
         typename base_type::open_record_lock,
-#ifndef BOOST_LOG_NO_THREADS
-        boost::log::aux::exclusive_lock_guard< threading_model >
-#else
         no_lock< threading_model >
-#endif // !defined(BOOST_LOG_NO_THREADS)
     >::type open_record_lock;
+#endif // defined(BOOST_LOG_DOXYGEN_PASS)
 
     //! Lock requirement for the \c swap_unlocked method
     typedef typename strictest_lock<
@@ -152,7 +309,7 @@ public:
      */
     void channel(channel_type const& ch)
     {
-        BOOST_LOG_EXPR_IF_MT(boost::log::aux::exclusive_lock_guard< threading_model > lock(this->get_threading_model());)
+        BOOST_LOG_EXPR_IF_MT(boost::log::aux::shared_lock_guard< threading_model > lock(this->get_threading_model());)
         m_ChannelAttr.set(ch);
     }
 
@@ -185,7 +342,7 @@ private:
     template< typename ArgsT, typename T >
     record open_record_with_channel_unlocked(ArgsT const& args, T const& ch)
     {
-        m_ChannelAttr.set(ch);
+        typename channel_attribute::record_channel_guard guard(m_ChannelAttr, ch);
         return base_type::open_record_unlocked(args);
     }
     //! The \c open_record implementation for the case when the channel is not specified in log statement
@@ -0,0 +1,419 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   deferred_format.hpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * This header contains macros that compose the record message from a format string and a number of arguments.
+ * Unlike the streaming macros, the message text is not formatted at the point of writing the record. The arguments
+ * are captured into the record, and the message is formatted when it is first requested, typically by a sink formatter.
+ */
+
+#ifndef BOOST_LOG_SOURCES_DEFERRED_FORMAT_HPP_INCLUDED_
+#define BOOST_LOG_SOURCES_DEFERRED_FORMAT_HPP_INCLUDED_
+
+#include <new>
+#include <string>
+#include <cstddef>
+#include <cstring>
+#include <typeinfo>
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/move/core.hpp>
+#include <boost/move/utility.hpp>
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+#include <boost/utility/addressof.hpp>
+#include <boost/type_traits/is_void.hpp>
+#include <boost/type_traits/is_pointer.hpp>
+#include <boost/type_traits/remove_pointer.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/has_trivial_copy.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/detail/unhandled_exception_count.hpp>
+#if !defined(BOOST_LOG_NO_THREADS)
+#include <boost/log/detail/locks.hpp>
+#include <boost/log/detail/spin_mutex.hpp>
+#endif
+#include <boost/log/core/record.hpp>
+#include <boost/log/attributes/attribute_value.hpp>
+#include <boost/log/attributes/attribute_value_set.hpp>
+#include <boost/log/sources/record_ostream.hpp>
+#include <boost/log/expressions/message.hpp>
+#include <boost/log/utility/type_info_wrapper.hpp>
+#include <boost/log/utility/type_dispatch/type_dispatcher.hpp>
+#include <boost/log/utility/unique_identifier_name.hpp>
+#include <boost/log/utility/formatting_ostream.hpp>
+#include <boost/log/detail/header.hpp>
+
+#ifdef BOOST_LOG_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+#ifndef BOOST_LOG_DEFERRED_MESSAGE_BUFFER_SIZE
+//! The size of the internal buffer of the deferred message for captured arguments, in bytes
+#define BOOST_LOG_DEFERRED_MESSAGE_BUFFER_SIZE 128
+#endif
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace aux {
+
+template< typename CharT >
+struct format_description;
+
+/*!
+ * \brief Deferred message attribute value
+ *
+ * The attribute value holds a format string and the captured arguments. The message text is composed
+ * on the first request of the value, which is normally done by a formatter in the sink.
+ *
+ * The format string must have static storage duration, e.g. be a string literal. Parsed format strings are
+ * cached by their addresses. The arguments are captured by copying their binary representation, so the argument
+ * types must be trivially copyable. Strings are copied as well.
+ */
+template< typename CharT >
+class deferred_message_impl :
+    public attribute_value::impl
+{
+public:
+    //! Character type
+    typedef CharT char_type;
+    //! String type
+    typedef std::basic_string< char_type > string_type;
+    //! Stream type
+    typedef basic_formatting_ostream< char_type > stream_type;
+    //! The function that puts a captured argument into the stream
+    typedef void (*output_function)(stream_type& strm, const void* data, std::size_t size);
+
+private:
+    //! Captured argument header. The argument data follows the header.
+    struct argument_header
+    {
+        //! The function that puts the argument into the stream
+        output_function output;
+        //! The argument data size, in bytes
+        std::size_t size;
+    };
+
+    //! Alignment of the captured arguments
+    enum { argument_alignment = alignment_of< argument_header >::value };
+    //! The size of the internal buffer
+    enum { buffer_size = (BOOST_LOG_DEFERRED_MESSAGE_BUFFER_SIZE + argument_alignment - 1) & ~(argument_alignment - 1) };
+
+    //! Internal buffer type
+    typedef typename aligned_storage< buffer_size, argument_alignment >::type buffer_type;
+
+private:
+    //! Format string
+    const char_type* const m_pFormat;
+    //! The captured arguments. Points either to the internal buffer or to a dynamically allocated storage.
+    unsigned char* m_pArgs;
+    //! The size of the captured arguments
+    std::size_t m_ArgsSize;
+    //! The capacity of the storage of the captured arguments
+    std::size_t m_ArgsCapacity;
+#if !defined(BOOST_LOG_NO_THREADS)
+    //! Protects the composed message
+    spin_mutex m_Mutex;
+#endif
+    //! The flag indicates that the message has been composed
+    bool m_Composed;
+    //! The composed message
+    string_type m_Message;
+    //! Internal buffer for the captured arguments
+    buffer_type m_Buffer;
+
+public:
+    /*!
+     * Initializing constructor
+     *
+     * \param fmt Format string. Must have static storage duration.
+     */
+    explicit deferred_message_impl(const char_type* fmt) :
+        m_pFormat(fmt),
+        m_pArgs(reinterpret_cast< unsigned char* >(&m_Buffer)),
+        m_ArgsSize(0),
+        m_ArgsCapacity(buffer_size),
+        m_Composed(false)
+    {
+    }
+
+    //! Destructor
+    ~deferred_message_impl()
+    {
+        if (m_pArgs != reinterpret_cast< unsigned char* >(&m_Buffer))
+            ::operator delete(m_pArgs);
+    }
+
+    //! Captures an argument. The argument type must be trivially copyable.
+    template< typename T >
+    void capture(T const& arg)
+    {
+        BOOST_STATIC_ASSERT_MSG(has_trivial_copy< T >::value && has_trivial_destructor< T >::value,
+            "Boost.Log: Deferred formatting requires trivially copyable arguments");
+        BOOST_STATIC_ASSERT_MSG(!is_pointer< T >::value || is_void< typename remove_pointer< T >::type >::value,
+            "Boost.Log: Deferred formatting does not support pointers other than strings and pointers to void");
+        append_argument(&output_value< T >, boost::addressof(arg), sizeof(T));
+    }
+
+    //! Captures a string argument. The string is copied.
+    void capture(const char_type* str)
+    {
+        append_argument(&output_string, str, std::char_traits< char_type >::length(str) * sizeof(char_type));
+    }
+
+    //! Captures a string argument. The string is copied.
+    void capture(char_type* str)
+    {
+        capture(static_cast< const char_type* >(str));
+    }
+
+    //! Captures a string argument. The string is copied.
+    template< typename TraitsT, typename AllocatorT >
+    void capture(std::basic_string< char_type, TraitsT, AllocatorT > const& str)
+    {
+        append_argument(&output_string, str.data(), str.size() * sizeof(char_type));
+    }
+
+    /*!
+     * Attribute value dispatching method. Composes the message, if it has not been composed yet.
+     *
+     * \param dispatcher The dispatcher that receives the stored value
+     *
+     * \return \c true if the value has been dispatched, \c false otherwise
+     */
+    bool dispatch(type_dispatcher& dispatcher)
+    {
+        type_dispatcher::callback< string_type > callback = dispatcher.get_callback< string_type >();
+        if (callback)
+        {
+            callback(get());
+            return true;
+        }
+        else
+            return false;
+    }
+
+    /*!
+     * \return The attribute value type
+     */
+    type_info_wrapper get_type() const { return type_info_wrapper(typeid(string_type)); }
+
+    /*!
+     * \return Reference to the composed message. The message is composed on the first call.
+     */
+    string_type const& get()
+    {
+        {
+            BOOST_LOG_EXPR_IF_MT(exclusive_lock_guard< spin_mutex > lock(m_Mutex);)
+            if (m_Composed)
+                return m_Message;
+        }
+
+        // The lock is not held while composing since the arguments are output by user's code, which may take arbitrary
+        // time or write logs itself. If several sinks compose the message concurrently, the first composed message is used.
+        string_type message;
+        compose(message);
+
+        BOOST_LOG_EXPR_IF_MT(exclusive_lock_guard< spin_mutex > lock(m_Mutex);)
+        if (!m_Composed)
+        {
+            m_Message.swap(message);
+            m_Composed = true;
+        }
+        return m_Message;
+    }
+
+private:
+    //! Composes the message from the format string and the captured arguments
+    BOOST_LOG_API void compose(string_type& message) const;
+    //! Composes the message in the specified stream
+    BOOST_LOG_API void compose(format_description< char_type > const& descr, stream_type& strm) const;
+    //! Extends the storage of the captured arguments
+    BOOST_LOG_API void reserve(std::size_t size);
+
+    //! Appends an argument to the captured arguments
+    void append_argument(output_function output, const void* data, std::size_t size)
+    {
+        const std::size_t entry_size = sizeof(argument_header) + ((size + argument_alignment - 1u) & ~static_cast< std::size_t >(argument_alignment - 1u));
+        if (m_ArgsCapacity - m_ArgsSize < entry_size)
+            reserve(m_ArgsSize + entry_size);
+
+        argument_header* const header = reinterpret_cast< argument_header* >(m_pArgs + m_ArgsSize);
+        header->output = output;
+        header->size = size;
+        std::memcpy(header + 1, data, size);
+        m_ArgsSize += entry_size;
+    }
+
+    //! Puts a captured value into the stream
+    template< typename T >
+    static void output_value(stream_type& strm, const void* data, std::size_t)
+    {
+        // The captured data may be not sufficiently aligned for T
+        typename aligned_storage< sizeof(T), alignment_of< T >::value >::type storage;
+        std::memcpy(&storage, data, sizeof(T));
+        strm << *reinterpret_cast< const T* >(&storage);
+    }
+
+    //! Puts a captured string into the stream
+    static void output_string(stream_type& strm, const void* data, std::size_t size)
+    {
+        strm.write(static_cast< const char_type* >(data), static_cast< std::streamsize >(size / sizeof(char_type)));
+    }
+};
+
+/*!
+ * \brief Logging record pump for deferred formatting
+ *
+ * The pump captures the arguments of the format string and pushes the record to the logging core
+ * on destruction. The pump is constructed on each attempt to write a log record and destroyed afterwards.
+ *
+ * The pump class template is instantiated on the logger type.
+ */
+template< typename LoggerT >
+class deferred_record_pump
+{
+    BOOST_MOVABLE_BUT_NOT_COPYABLE(deferred_record_pump)
+
+private:
+    //! Logger type
+    typedef LoggerT logger_type;
+    //! Character type
+    typedef typename logger_type::char_type char_type;
+    //! Message attribute value type
+    typedef deferred_message_impl< char_type > message_impl_type;
+
+private:
+    //! A reference to the logger
+    logger_type* m_pLogger;
+    //! A reference to the record
+    record* m_pRecord;
+    //! Message attribute value
+    intrusive_ptr< message_impl_type > m_pMessage;
+    //! Exception state
+    const unsigned int m_ExceptionCount;
+
+public:
+    //! Constructor
+    deferred_record_pump(logger_type& lg, record& rec, const char_type* fmt) :
+        m_pLogger(boost::addressof(lg)),
+        m_pRecord(boost::addressof(rec)),
+        m_pMessage(new message_impl_type(fmt)),
+        m_ExceptionCount(unhandled_exception_count())
+    {
+    }
+    //! Move constructor
+    deferred_record_pump(BOOST_RV_REF(deferred_record_pump) that) BOOST_NOEXCEPT :
+        m_pLogger(that.m_pLogger),
+        m_pRecord(that.m_pRecord),
+        m_ExceptionCount(that.m_ExceptionCount)
+    {
+        m_pMessage.swap(that.m_pMessage);
+        that.m_pLogger = 0;
+        that.m_pRecord = 0;
+    }
+    //! Destructor. Pushes the record with the captured message to log.
+    ~deferred_record_pump() BOOST_NOEXCEPT_IF(false)
+    {
+        // Only push the record if no exception has been thrown while capturing arguments (if possible)
+        if (m_pLogger && m_ExceptionCount >= unhandled_exception_count())
+        {
+            attribute_value value(m_pMessage);
+
+            // This may fail if the record already has Message attribute
+            std::pair< attribute_value_set::const_iterator, bool > res =
+                m_pRecord->attribute_values().insert(expressions::tag::message::get_name(), value);
+            if (!res.second)
+                const_cast< attribute_value& >(res.first->second).swap(value);
+
+            m_pLogger->push_record(boost::move(*m_pRecord));
+        }
+    }
+
+    //! Captures the next argument of the format string
+    template< typename T >
+    deferred_record_pump& operator% (T const& arg)
+    {
+        m_pMessage->capture(arg);
+        return *this;
+    }
+};
+
+/*!
+ * The function creates the record pump. The format string is accepted as a reference to a constant character array,
+ * which is normally a string literal, so that pointers to strings composed in run time are rejected at compile time.
+ * The parsed format strings are cached by their addresses, so the format string must not change and must
+ * have static storage duration.
+ */
+template< typename LoggerT, std::size_t N >
+BOOST_LOG_FORCEINLINE deferred_record_pump< LoggerT > make_deferred_record_pump(LoggerT& lg, record& rec, const typename LoggerT::char_type (&fmt)[N])
+{
+    return deferred_record_pump< LoggerT >(lg, rec, fmt);
+}
+
+//! The overload rejects non-constant character arrays, which may change after the format string has been cached
+template< typename LoggerT, std::size_t N >
+inline deferred_record_pump< LoggerT > make_deferred_record_pump(LoggerT& lg, record& rec, typename LoggerT::char_type (&fmt)[N])
+{
+    BOOST_STATIC_ASSERT_MSG(N == 0u && N != 0u, "Boost.Log: deferred format string must be a string literal");
+    return deferred_record_pump< LoggerT >(lg, rec, fmt);
+}
+
+} // namespace aux
+
+#ifndef BOOST_LOG_DOXYGEN_PASS
+
+#define BOOST_LOG_DEFERRED_FORMAT_INTERNAL(logger, rec_var, fmt)\
+    for (::boost::log::record rec_var = ::boost::log::aux::open_record_at((logger), BOOST_LOG_CURRENT_CALL_SITE()); !!rec_var;)\
+        ::boost::log::aux::make_deferred_record_pump((logger), rec_var, (fmt))
+
+#define BOOST_LOG_DEFERRED_FORMAT_WITH_PARAMS_INTERNAL(logger, rec_var, params_seq, fmt)\
+    for (::boost::log::record rec_var = ::boost::log::aux::open_record_at((logger), BOOST_LOG_CURRENT_CALL_SITE(), (BOOST_PP_SEQ_ENUM(params_seq))); !!rec_var;)\
+        ::boost::log::aux::make_deferred_record_pump((logger), rec_var, (fmt))
+
+#endif // BOOST_LOG_DOXYGEN_PASS
+
+/*!
+ * The macro writes a record to the log. The record message is composed from the format string
+ * and the arguments that follow the macro, separated with \c operator%, as in Boost.Format.
+ * The message is composed when it is first requested, e.g. by a formatter of an asynchronous sink.
+ * The format string must be a string literal. Pointers to strings, e.g. composed in run time, are not accepted.
+ */
+#define BOOST_LOG_DEFERRED_FORMAT(logger, fmt)\
+    BOOST_LOG_DEFERRED_FORMAT_INTERNAL(logger, BOOST_LOG_UNIQUE_IDENTIFIER_NAME(_boost_log_record_), fmt)
+
+//! The macro writes a record with a deferred formatted message to the log and allows to pass additional named arguments to the logger
+#define BOOST_LOG_DEFERRED_FORMAT_WITH_PARAMS(logger, params_seq, fmt)\
+    BOOST_LOG_DEFERRED_FORMAT_WITH_PARAMS_INTERNAL(logger, BOOST_LOG_UNIQUE_IDENTIFIER_NAME(_boost_log_record_), params_seq, fmt)
+
+//! The macro writes a record with a deferred formatted message and a specific severity level to the log
+#define BOOST_LOG_DEFERRED_FORMAT_SEV(logger, lvl, fmt)\
+    BOOST_LOG_DEFERRED_FORMAT_WITH_PARAMS((logger), (::boost::log::keywords::severity = (lvl)), fmt)
+
+#ifndef BOOST_LOG_NO_SHORTHAND_NAMES
+
+//! An equivalent to BOOST_LOG_DEFERRED_FORMAT(logger, fmt)
+#define BOOST_LOG_FMT(logger, fmt) BOOST_LOG_DEFERRED_FORMAT(logger, fmt)
+
+//! An equivalent to BOOST_LOG_DEFERRED_FORMAT_SEV(logger, lvl, fmt)
+#define BOOST_LOG_SEV_FMT(logger, lvl, fmt) BOOST_LOG_DEFERRED_FORMAT_SEV(logger, lvl, fmt)
+
+#endif // BOOST_LOG_NO_SHORTHAND_NAMES
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_SOURCES_DEFERRED_FORMAT_HPP_INCLUDED_
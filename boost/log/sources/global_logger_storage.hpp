@@ -23,6 +23,9 @@
 #include <boost/log/detail/config.hpp>
 #include <boost/log/detail/singleton.hpp>
 #include <boost/log/detail/visible_type.hpp>
+#if defined(BOOST_LOG_EAGER_GLOBAL_LOGGERS)
+#include <boost/log/utility/unique_identifier_name.hpp>
+#endif
 #include <boost/log/detail/header.hpp>
 
 #ifdef BOOST_LOG_HAS_PRAGMA_ONCE
@@ -142,8 +145,39 @@ private:
     }
 };
 
+#if defined(BOOST_LOG_EAGER_GLOBAL_LOGGERS)
+
+//! The class initializes the global logger on namespace scope initialization stage
+template< typename TagT >
+struct logger_registrar
+{
+    logger_registrar()
+    {
+        logger_singleton< TagT >::get();
+    }
+};
+
+#endif // defined(BOOST_LOG_EAGER_GLOBAL_LOGGERS)
+
 } // namespace aux
 
+#if defined(BOOST_LOG_EAGER_GLOBAL_LOGGERS)
+
+//! The macro defines an object that initializes the global logger on namespace scope initialization stage
+#define BOOST_LOG_GLOBAL_LOGGER_EAGER_INIT(tag_name)\
+    static const ::boost::log::sources::aux::logger_registrar< tag_name >\
+        BOOST_LOG_UNIQUE_IDENTIFIER_NAME(_boost_log_global_logger_registrar_);
+
+#else // defined(BOOST_LOG_EAGER_GLOBAL_LOGGERS)
+
+#define BOOST_LOG_GLOBAL_LOGGER_EAGER_INIT(tag_name)
+
+#endif // defined(BOOST_LOG_EAGER_GLOBAL_LOGGERS)
+
+//! The macro defines the signature of the global logger initialization routine
+#define BOOST_LOG_GLOBAL_LOGGER_INIT_FUNCTION(tag_name, logger)\
+    tag_name::logger_type tag_name::construct_logger()
+
 //! The macro forward-declares a global logger with a custom initialization
 #define BOOST_LOG_GLOBAL_LOGGER(tag_name, logger)\
     struct tag_name\
@@ -158,9 +192,13 @@ private:
         }\
     };
 
-//! The macro defines a global logger initialization routine
+/*!
+ * The macro defines a global logger initialization routine. If \c BOOST_LOG_EAGER_GLOBAL_LOGGERS
+ * is defined, the logger is also constructed on namespace scope initialization stage.
+ */
 #define BOOST_LOG_GLOBAL_LOGGER_INIT(tag_name, logger)\
-    tag_name::logger_type tag_name::construct_logger()
+    BOOST_LOG_GLOBAL_LOGGER_EAGER_INIT(tag_name)\
+    BOOST_LOG_GLOBAL_LOGGER_INIT_FUNCTION(tag_name, logger)
 
 //! The macro defines a global logger initializer that will default-construct the logger
 #define BOOST_LOG_GLOBAL_LOGGER_DEFAULT(tag_name, logger)\
@@ -179,7 +217,8 @@ private:
 //! The macro declares a global logger with a custom initialization
 #define BOOST_LOG_INLINE_GLOBAL_LOGGER_INIT(tag_name, logger)\
     BOOST_LOG_GLOBAL_LOGGER(tag_name, logger)\
-    inline BOOST_LOG_GLOBAL_LOGGER_INIT(tag_name, logger)
+    BOOST_LOG_GLOBAL_LOGGER_EAGER_INIT(tag_name)\
+    inline BOOST_LOG_GLOBAL_LOGGER_INIT_FUNCTION(tag_name, logger)
 
 //! The macro declares a global logger that will be default-constructed
 #define BOOST_LOG_INLINE_GLOBAL_LOGGER_DEFAULT(tag_name, logger)\
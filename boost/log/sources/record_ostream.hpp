@@ -26,6 +26,7 @@
 #include <boost/log/detail/native_typeof.hpp>
 #include <boost/log/detail/unhandled_exception_count.hpp>
 #include <boost/log/core/record.hpp>
+#include <boost/log/attributes/call_site.hpp>
 #include <boost/log/utility/unique_identifier_name.hpp>
 #include <boost/log/utility/explicit_operator_bool.hpp>
 #include <boost/log/utility/formatting_ostream.hpp>
@@ -294,16 +295,128 @@ BOOST_LOG_FORCEINLINE record_pump< LoggerT > make_record_pump(LoggerT& lg, recor
     return record_pump< LoggerT >(lg, rec);
 }
 
+//! The function composes the message of the log record that reports the number of log records suppressed by filters
+template< typename CharT >
+void compose_suppressed_records_summary(record& rec, uintmax_t count)
+{
+    basic_record_ostream< CharT > strm(rec);
+    strm << "Suppressed " << count << " log records";
+    strm.flush();
+}
+
+/*!
+ * The function makes a log record that reports the number of log records suppressed by filters at a call site.
+ * The record is made at the same call site and with the same named arguments as the log record that was opened
+ * at the call site. Filters that limit the number of log records do not apply to the report.
+ */
+template< typename LoggerT, typename ArgsT >
+void push_suppressed_records_summary(LoggerT& lg, ArgsT const& args, call_site_context& context)
+{
+    const call_site site(context.m_pSuppressedFileName, context.m_SuppressedLine);
+    const uintmax_t count = context.m_SuppressedCount;
+    context.m_SuppressedCount = 0u;
+
+    record rec;
+    {
+        call_site_sentry sentry(site, true);
+        rec = lg.open_record(args);
+    }
+
+    if (!!rec)
+    {
+        aux::compose_suppressed_records_summary< typename LoggerT::char_type >(rec, count);
+        lg.push_record(boost::move(rec));
+    }
+}
+
+//! The function makes a log record that reports the number of log records suppressed by filters at a call site
+template< typename LoggerT >
+void push_suppressed_records_summary(LoggerT& lg, call_site_context& context)
+{
+    const call_site site(context.m_pSuppressedFileName, context.m_SuppressedLine);
+    const uintmax_t count = context.m_SuppressedCount;
+    context.m_SuppressedCount = 0u;
+
+    record rec;
+    {
+        call_site_sentry sentry(site, true);
+        rec = lg.open_record();
+    }
+
+    if (!!rec)
+    {
+        aux::compose_suppressed_records_summary< typename LoggerT::char_type >(rec, count);
+        lg.push_record(boost::move(rec));
+    }
+}
+
+//! The function opens a log record at the specified call site and makes the call site current while the record is being opened
+template< typename LoggerT >
+record open_tracked_record_at(LoggerT& lg, call_site const& site)
+{
+    record rec;
+    call_site_context* context;
+    {
+        call_site_sentry sentry(site);
+        context = &sentry.context();
+        rec = lg.open_record();
+    }
+
+    // If filters suppressed log records at this call site, report them before the record is pushed
+    if (context->m_SuppressedCount != 0u)
+        aux::push_suppressed_records_summary(lg, *context);
+
+    return boost::move(rec);
+}
+
+//! The function opens a log record at the specified call site with the named arguments and makes the call site current while the record is being opened
+template< typename LoggerT, typename ArgsT >
+record open_tracked_record_at(LoggerT& lg, call_site const& site, ArgsT const& args)
+{
+    record rec;
+    call_site_context* context;
+    {
+        call_site_sentry sentry(site);
+        context = &sentry.context();
+        rec = lg.open_record(args);
+    }
+
+    // If filters suppressed log records at this call site, report them before the record is pushed
+    if (context->m_SuppressedCount != 0u)
+        aux::push_suppressed_records_summary(lg, args, *context);
+
+    return boost::move(rec);
+}
+
+//! The function opens a log record at the specified call site
+template< typename LoggerT >
+BOOST_LOG_FORCEINLINE record open_record_at(LoggerT& lg, call_site const& site)
+{
+    // The thread-specific call site context is only accessed if there are call site attributes or limiters
+    if (!aux::is_call_site_tracking_enabled())
+        return lg.open_record();
+    return aux::open_tracked_record_at(lg, site);
+}
+
+//! The function opens a log record at the specified call site with the named arguments
+template< typename LoggerT, typename ArgsT >
+BOOST_LOG_FORCEINLINE record open_record_at(LoggerT& lg, call_site const& site, ArgsT const& args)
+{
+    if (!aux::is_call_site_tracking_enabled())
+        return lg.open_record(args);
+    return aux::open_tracked_record_at(lg, site, args);
+}
+
 } // namespace aux
 
 #ifndef BOOST_LOG_DOXYGEN_PASS
 
 #define BOOST_LOG_STREAM_INTERNAL(logger, rec_var)\
-    for (::boost::log::record rec_var = (logger).open_record(); !!rec_var;)\
+    for (::boost::log::record rec_var = ::boost::log::aux::open_record_at((logger), BOOST_LOG_CURRENT_CALL_SITE()); !!rec_var;)\
         ::boost::log::aux::make_record_pump((logger), rec_var).stream()
 
 #define BOOST_LOG_STREAM_WITH_PARAMS_INTERNAL(logger, rec_var, params_seq)\
-    for (::boost::log::record rec_var = (logger).open_record((BOOST_PP_SEQ_ENUM(params_seq))); !!rec_var;)\
+    for (::boost::log::record rec_var = ::boost::log::aux::open_record_at((logger), BOOST_LOG_CURRENT_CALL_SITE(), (BOOST_PP_SEQ_ENUM(params_seq))); !!rec_var;)\
         ::boost::log::aux::make_record_pump((logger), rec_var).stream()
 
 #endif // BOOST_LOG_DOXYGEN_PASS
@@ -15,9 +15,12 @@
 #ifndef BOOST_LOG_SOURCES_SEVERITY_FEATURE_HPP_INCLUDED_
 #define BOOST_LOG_SOURCES_SEVERITY_FEATURE_HPP_INCLUDED_
 
+#include <cstring>
 #include <boost/cstdint.hpp>
 #include <boost/intrusive_ptr.hpp>
 #include <boost/static_assert.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/mpl/bool.hpp>
 #include <boost/move/core.hpp>
 #include <boost/move/utility.hpp>
 #include <boost/log/detail/config.hpp>
@@ -25,11 +28,18 @@
 #include <boost/log/detail/default_attribute_names.hpp>
 #include <boost/log/attributes/attribute.hpp>
 #include <boost/log/attributes/attribute_cast.hpp>
+#include <boost/log/attributes/attribute_value.hpp>
+#include <boost/log/attributes/attribute_value_set.hpp>
 #include <boost/log/attributes/attribute_value_impl.hpp>
+#include <boost/log/sources/basic_logger.hpp>
+#include <boost/log/sources/threading_models.hpp>
 #include <boost/log/utility/strictest_lock.hpp>
 #include <boost/log/utility/type_dispatch/type_dispatcher.hpp>
 #include <boost/log/keywords/severity.hpp>
 #include <boost/log/core/record.hpp>
+#if !defined(BOOST_LOG_NO_THREADS)
+#include <boost/atomic/atomic.hpp>
+#endif
 #include <boost/log/detail/header.hpp>
 
 #ifdef BOOST_LOG_HAS_PRAGMA_ONCE
@@ -136,6 +146,110 @@ namespace aux {
         }
     };
 
+    //! Severity level value cache for loggers that do not pass severity levels as attribute values
+    struct no_severity_value_cache
+    {
+    };
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+    /*!
+     * The cache of immutable severity level attribute values. The values are shared between all records of the logger
+     * with the same severity level, so opening a record does not involve creating a value. Only the levels whose
+     * representation is less than \c capacity are cached, other levels are attached to records as new values.
+     */
+    template< typename LevelT >
+    class severity_value_cache
+    {
+    public:
+        //! Severity level type
+        typedef LevelT value_type;
+
+    private:
+        //! The number of cached levels
+        enum { capacity = 16 };
+
+        //! Attribute value implementation type
+        typedef attributes::attribute_value_impl< value_type > value_impl;
+
+    private:
+        //! The cached values, lazily created
+        mutable boost::atomic< value_impl* > m_Values[capacity];
+
+    public:
+        severity_value_cache()
+        {
+            init();
+        }
+        //! Copy constructor. The cache contents are not copied.
+        severity_value_cache(severity_value_cache const&)
+        {
+            init();
+        }
+        ~severity_value_cache()
+        {
+            for (unsigned int i = 0; i < capacity; ++i)
+            {
+                value_impl* p = m_Values[i].load(boost::memory_order_relaxed);
+                if (p)
+                    intrusive_ptr_release(p);
+            }
+        }
+
+        //! The method returns the attribute value for the severity level
+        attribute_value get(value_type level) const
+        {
+            // The cache is indexed by the level representation, which is consistent with how the levels are stored in the thread-specific storage
+            uintmax_t index = 0;
+            std::memcpy(&index, &level, sizeof(level));
+            if (index >= static_cast< uintmax_t >(capacity))
+                return attribute_value(new value_impl(level));
+
+            boost::atomic< value_impl* >& cached = m_Values[index];
+            value_impl* p = cached.load(boost::memory_order_acquire);
+            if (!p)
+            {
+                intrusive_ptr< value_impl > value = new value_impl(level);
+                value_impl* expected = NULL;
+                if (cached.compare_exchange_strong(expected, value.get(), boost::memory_order_acq_rel, boost::memory_order_acquire))
+                {
+                    // The cache holds a reference to the value
+                    intrusive_ptr_add_ref(value.get());
+                    return attribute_value(value);
+                }
+                p = expected;
+            }
+            return attribute_value(p);
+        }
+
+    private:
+        void init()
+        {
+            for (unsigned int i = 0; i < capacity; ++i)
+                m_Values[i].store(static_cast< value_impl* >(NULL), boost::memory_order_relaxed);
+        }
+
+        //  Assignment prohibited
+        BOOST_LOG_DELETED_FUNCTION(severity_value_cache& operator= (severity_value_cache const&))
+    };
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
+
+    //! The metafunction selects the severity level value cache for the logger threading model
+    template< typename LevelT, typename ThreadingModelT >
+    struct make_severity_value_cache
+    {
+#if !defined(BOOST_LOG_NO_THREADS)
+        typedef typename mpl::if_<
+            is_lock_free_thread_model< ThreadingModelT >,
+            severity_value_cache< LevelT >,
+            no_severity_value_cache
+        >::type type;
+#else
+        typedef no_severity_value_cache type;
+#endif
+    };
+
 } // namespace aux
 
 /*!
@@ -163,6 +277,14 @@ public:
     //! Severity attribute type
     typedef aux::severity_level< severity_level > severity_attribute;
 
+private:
+    //! The flag indicates that severity levels are passed to records as record-specific attribute values instead of the severity attribute
+    typedef typename aux::is_lock_free_thread_model< threading_model >::type pass_severity_values;
+    //! Severity level value cache type
+    typedef typename aux::make_severity_value_cache< severity_level, threading_model >::type severity_value_cache;
+
+public:
+
 #if defined(BOOST_LOG_DOXYGEN_PASS)
     //! Lock requirement for the \c open_record_unlocked method
     typedef typename strictest_lock<
@@ -186,6 +308,8 @@ private:
     severity_level m_DefaultSeverity;
     //! Severity attribute
     severity_attribute m_SeverityAttr;
+    //! Severity level values, if severity levels are passed to records as attribute values
+    severity_value_cache m_SeverityValues;
 
 public:
     /*!
@@ -196,7 +320,7 @@ public:
         base_type(),
         m_DefaultSeverity(static_cast< severity_level >(0))
     {
-        base_type::add_attribute_unlocked(boost::log::aux::default_attribute_names::severity(), m_SeverityAttr);
+        add_severity_attribute_unlocked(pass_severity_values());
     }
     /*!
      * Copy constructor
@@ -206,7 +330,7 @@ public:
         m_DefaultSeverity(that.m_DefaultSeverity),
         m_SeverityAttr(that.m_SeverityAttr)
     {
-        base_type::attributes()[boost::log::aux::default_attribute_names::severity()] = m_SeverityAttr;
+        update_severity_attribute_unlocked(pass_severity_values());
     }
     /*!
      * Move constructor
@@ -216,7 +340,7 @@ public:
         m_DefaultSeverity(boost::move(that.m_DefaultSeverity)),
         m_SeverityAttr(boost::move(that.m_SeverityAttr))
     {
-        base_type::attributes()[boost::log::aux::default_attribute_names::severity()] = m_SeverityAttr;
+        update_severity_attribute_unlocked(pass_severity_values());
     }
     /*!
      * Constructor with named arguments. Allows to setup the default level for log records.
@@ -229,7 +353,7 @@ public:
         base_type(args),
         m_DefaultSeverity(args[keywords::severity | severity_level()])
     {
-        base_type::add_attribute_unlocked(boost::log::aux::default_attribute_names::severity(), m_SeverityAttr);
+        add_severity_attribute_unlocked(pass_severity_values());
     }
 
     /*!
@@ -249,8 +373,7 @@ protected:
     template< typename ArgsT >
     record open_record_unlocked(ArgsT const& args)
     {
-        m_SeverityAttr.set_value(args[keywords::severity | m_DefaultSeverity]);
-        return base_type::open_record_unlocked(args);
+        return open_record_with_severity_unlocked(args, args[keywords::severity | m_DefaultSeverity], pass_severity_values());
     }
 
     //! Unlocked \c swap
@@ -262,6 +385,44 @@ protected:
         that.m_DefaultSeverity = t;
         m_SeverityAttr.swap(that.m_SeverityAttr);
     }
+
+private:
+#ifndef BOOST_LOG_DOXYGEN_PASS
+    //! Registers the severity attribute
+    void add_severity_attribute_unlocked(mpl::false_)
+    {
+        base_type::add_attribute_unlocked(boost::log::aux::default_attribute_names::severity(), m_SeverityAttr);
+    }
+    //! The severity attribute is not registered if severity levels are passed as attribute values
+    void add_severity_attribute_unlocked(mpl::true_)
+    {
+    }
+
+    //! Replaces the severity attribute copied from another logger
+    void update_severity_attribute_unlocked(mpl::false_)
+    {
+        base_type::attributes()[boost::log::aux::default_attribute_names::severity()] = m_SeverityAttr;
+    }
+    //! The severity attribute is not registered if severity levels are passed as attribute values
+    void update_severity_attribute_unlocked(mpl::true_)
+    {
+    }
+
+    //! The \c open_record implementation that passes the severity level through the severity attribute
+    template< typename ArgsT >
+    record open_record_with_severity_unlocked(ArgsT const& args, severity_level level, mpl::false_)
+    {
+        m_SeverityAttr.set_value(level);
+        return base_type::open_record_unlocked(args);
+    }
+    //! The \c open_record implementation that passes the severity level as a record-specific attribute value
+    template< typename ArgsT >
+    record open_record_with_severity_unlocked(ArgsT const& args, severity_level level, mpl::true_)
+    {
+        const attribute_value_set::value_type value(boost::log::aux::default_attribute_names::severity(), m_SeverityValues.get(level));
+        return base_type::open_record_unlocked(aux::add_source_value(args, value));
+    }
+#endif // BOOST_LOG_DOXYGEN_PASS
 };
 
 /*!
@@ -271,6 +432,8 @@ protected:
  * This attribute will provide severity level for each log record being made through the logger.
  * The severity level can be omitted on logging record construction, in which case the default
  * level will be used. The default level can also be customized by passing it to the logger constructor.
+ * Loggers with \c lock_free_thread_model do not register the attribute. Instead, the severity level
+ * is attached to every record as an attribute value.
  *
  * The type of the severity level attribute can be specified as a template parameter for the feature
  * template. By default, \c int will be used.
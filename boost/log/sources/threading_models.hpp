@@ -18,10 +18,8 @@
 #define BOOST_LOG_SOURCES_THREADING_MODELS_HPP_INCLUDED_
 
 #include <boost/log/detail/config.hpp>
-#include <boost/log/detail/locks.hpp> // is_mutex_type
-#if !defined(BOOST_LOG_NO_THREADS)
 #include <boost/mpl/bool.hpp>
-#endif
+#include <boost/log/detail/locks.hpp> // is_mutex_type
 #include <boost/log/detail/header.hpp>
 
 #ifdef BOOST_LOG_HAS_PRAGMA_ONCE
@@ -98,8 +96,42 @@ private:
     mutable MutexT m_Mutex;
 };
 
+/*!
+ * \brief Multi-thread locking model with lock-free record opening
+ *
+ * The model provides the same locking capabilities as \c multi_thread_model. Loggers with this model publish their attributes
+ * as immutable snapshots and open records without locking. Modifications of the logger are serialized with the mutex
+ * and are expected to be rare, since every attribute modification creates a new snapshot.
+ */
+template< typename MutexT >
+struct lock_free_thread_model :
+    public multi_thread_model< MutexT >
+{
+};
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
+
+namespace aux {
+
+//! The metafunction detects threading models that allow opening records without locking
+template< typename ThreadingModelT >
+struct is_lock_free_thread_model :
+    public mpl::false_
+{
+};
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+template< typename MutexT >
+struct is_lock_free_thread_model< lock_free_thread_model< MutexT > > :
+    public mpl::true_
+{
+};
+
 #endif // !defined(BOOST_LOG_NO_THREADS)
 
+} // namespace aux
+
 } // namespace sources
 
 BOOST_LOG_CLOSE_NAMESPACE // namespace log
@@ -116,6 +148,11 @@ struct is_mutex_type< boost::log::sources::multi_thread_model< T > > : mpl::true
 {
 };
 
+template< typename T >
+struct is_mutex_type< boost::log::sources::lock_free_thread_model< T > > : mpl::true_
+{
+};
+
 #endif // !defined(BOOST_LOG_NO_THREADS)
 
 } // namespace boost
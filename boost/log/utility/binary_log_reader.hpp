@@ -0,0 +1,139 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   binary_log_reader.hpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * The header contains the decoder of the log files written by the binary sink backend.
+ */
+
+#ifndef BOOST_LOG_UTILITY_BINARY_LOG_READER_HPP_INCLUDED_
+#define BOOST_LOG_UTILITY_BINARY_LOG_READER_HPP_INCLUDED_
+
+#include <string>
+#include <vector>
+#include <istream>
+#include <ostream>
+#include <boost/cstdint.hpp>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/detail/header.hpp>
+
+#ifdef BOOST_LOG_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace binary_log {
+
+//! Types of attribute values stored in binary log files
+enum value_type
+{
+    boolean_type = 1,           //!< Boolean value, stored in \c uint_value
+    signed_integer_type,        //!< Signed integer, stored in \c int_value
+    unsigned_integer_type,      //!< Unsigned integer, stored in \c uint_value
+    floating_point_type,        //!< Floating point number, stored in \c float_value
+    string_type,                //!< Narrow string, stored in \c string_value
+    timestamp_type,             //!< Time point, stored in \c int_value as the number of microseconds since 1970-01-01 00:00:00
+    duration_type,              //!< Time duration, stored in \c int_value as the number of microseconds
+    thread_id_type,             //!< Thread identifier, stored in \c uint_value
+    process_id_type,            //!< Process identifier, stored in \c uint_value
+    severity_type,              //!< Severity level of the trivial logger, stored in \c uint_value
+    formatted_type,             //!< Textual representation of a value of a type registered with the sink backend, stored in \c string_value
+    unsupported_type            //!< Value of a type not supported by the sink backend, \c string_value contains the name of the type
+};
+
+/*!
+ * \brief A decoded attribute value
+ *
+ * Only one of the value members is used, depending on the value type.
+ */
+struct field
+{
+    //! Attribute name
+    std::string name;
+    //! Value type
+    value_type type;
+    //! Signed integer value
+    intmax_t int_value;
+    //! Unsigned integer value
+    uintmax_t uint_value;
+    //! Floating point value
+    double float_value;
+    //! String value
+    std::string string_value;
+
+    field() : type(boolean_type), int_value(0), uint_value(0u), float_value(0.0) {}
+};
+
+//! A sequence of decoded attribute values of a log record
+typedef std::vector< field > field_list;
+
+/*!
+ * The operator puts the textual representation of the attribute value into the stream. Timestamps,
+ * durations, thread and process identifiers and severity levels are formatted the same way
+ * the library formats them by default.
+ */
+BOOST_LOG_API std::ostream& operator<< (std::ostream& strm, field const& f);
+
+/*!
+ * \brief Binary log reader
+ *
+ * The reader decodes the log records written by \c sinks::binary_ostream_backend from a stream. The reader
+ * tolerates the last record being incomplete, which may happen if the application terminated while
+ * the record was being written. Several concatenated log files can be read from a single stream.
+ */
+class reader
+{
+private:
+    struct implementation;
+    implementation* m_pImpl;
+
+public:
+    /*!
+     * Constructor. Reads the file header from the stream.
+     *
+     * \param strm The stream to read log records from. The stream must be opened in binary mode
+     *             and must outlive the reader.
+     *
+     * \b Throws: \c parse_error if the stream does not contain a binary log or the log format version
+     *            is not supported.
+     */
+    BOOST_LOG_API explicit reader(std::istream& strm);
+    /*!
+     * Destructor
+     */
+    BOOST_LOG_API ~reader();
+
+    /*!
+     * The method reads the next log record from the stream.
+     *
+     * \param fields The container that receives the attribute values of the record. The previous contents
+     *               of the container are discarded.
+     * \return \c true if a record was read, \c false if the end of the stream was reached.
+     *
+     * \b Throws: \c parse_error if the log is corrupted.
+     */
+    BOOST_LOG_API bool read(field_list& fields);
+
+    //  Copying and assignment prohibited
+    BOOST_LOG_DELETED_FUNCTION(reader(reader const&))
+    BOOST_LOG_DELETED_FUNCTION(reader& operator= (reader const&))
+};
+
+} // namespace binary_log
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_UTILITY_BINARY_LOG_READER_HPP_INCLUDED_
@@ -15,12 +15,15 @@
 #ifndef BOOST_LOG_UTILITY_MANIPULATORS_ADD_VALUE_HPP_INCLUDED_
 #define BOOST_LOG_UTILITY_MANIPULATORS_ADD_VALUE_HPP_INCLUDED_
 
+#include <cstddef>
+#include <string>
 #include <boost/type_traits/remove_cv.hpp>
 #include <boost/type_traits/remove_reference.hpp>
 #include <boost/log/detail/config.hpp>
 #include <boost/log/detail/embedded_string_type.hpp>
 #include <boost/log/attributes/attribute_name.hpp>
 #include <boost/log/attributes/attribute_value_impl.hpp>
+#include <boost/log/attributes/string_view_value.hpp>
 #include <boost/log/expressions/keyword_fwd.hpp>
 #include <boost/log/sources/record_ostream.hpp>
 #include <boost/log/detail/header.hpp>
@@ -128,6 +131,64 @@ add_value(expressions::attribute_keyword< DescriptorT, ActorT > const&, typename
 
 #endif // !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
 
+/*!
+ * \brief Attribute value manipulator that refers to a string
+ *
+ * The manipulator is created by the \c add_value_ref function. The attached attribute value refers to the caller's string.
+ */
+class add_value_ref_manip
+{
+private:
+    //! Attribute value
+    attribute_value m_value;
+    //! Attribute name
+    attribute_name m_name;
+
+public:
+    //! Initializing constructor
+    add_value_ref_manip(attribute_name const& name, attribute_value const& value) : m_value(value), m_name(name)
+    {
+    }
+
+    //! Returns attribute name
+    attribute_name get_name() const { return m_name; }
+    //! Returns attribute value
+    attribute_value const& get_value() const { return m_value; }
+};
+
+//! The operator attaches an attribute value that refers to a string to the log record
+template< typename CharT >
+inline basic_record_ostream< CharT >& operator<< (basic_record_ostream< CharT >& strm, add_value_ref_manip const& manip)
+{
+    strm.get_record().attribute_values().insert(manip.get_name(), manip.get_value());
+    return strm;
+}
+
+/*!
+ * The function creates a manipulator that attaches an attribute value to a log record. Unlike \c add_value,
+ * the attribute value is not a copy of the string but refers to its characters, until the log record is passed
+ * to another thread. The string must not be modified or destroyed while the log record is processed, and sinks
+ * that keep log records after processing must be fed by an asynchronous frontend.
+ */
+template< typename CharT, typename AllocatorT >
+inline add_value_ref_manip add_value_ref(attribute_name const& name, std::basic_string< CharT, std::char_traits< CharT >, AllocatorT > const& value)
+{
+    return add_value_ref_manip(name, attributes::make_string_view_value(value));
+}
+
+//! \overload
+template< typename CharT, std::size_t SizeV >
+inline add_value_ref_manip add_value_ref(attribute_name const& name, CharT (&value)[SizeV])
+{
+    return add_value_ref_manip(name, attributes::make_string_view_value(value));
+}
+
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_DELETED_FUNCTIONS)
+//  Temporary strings are destroyed before the log record is pushed
+template< typename CharT, typename AllocatorT >
+add_value_ref_manip add_value_ref(attribute_name const& name, std::basic_string< CharT, std::char_traits< CharT >, AllocatorT >&& value) = delete;
+#endif
+
 BOOST_LOG_CLOSE_NAMESPACE // namespace log
 
 } // namespace boost
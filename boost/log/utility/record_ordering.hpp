@@ -15,8 +15,15 @@
 #ifndef BOOST_LOG_UTILITY_RECORD_ORDERING_HPP_INCLUDED_
 #define BOOST_LOG_UTILITY_RECORD_ORDERING_HPP_INCLUDED_
 
+#include <new>
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/is_sequence.hpp>
 #include <boost/utility/enable_if.hpp>
 #include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/has_trivial_copy.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
 #include <boost/log/detail/config.hpp>
 #include <boost/log/detail/function_traits.hpp>
 #include <boost/log/core/record_view.hpp>
@@ -35,6 +42,49 @@ namespace boost {
 
 BOOST_LOG_OPEN_NAMESPACE
 
+namespace aux {
+
+//! The trait checks if attribute values of the specified type can be cached by ordering queues
+template< typename ValueT, bool IsSequenceV = mpl::is_sequence< ValueT >::value >
+struct is_ordering_key_cacheable :
+    public mpl::bool_< has_trivial_copy< ValueT >::value && has_trivial_destructor< ValueT >::value >
+{
+};
+
+template< typename ValueT >
+struct is_ordering_key_cacheable< ValueT, true > :
+    public mpl::false_
+{
+};
+
+//! Ordering key that holds a copy of the attribute value
+template< typename ValueT >
+struct attribute_value_ordering_key
+{
+    //! Storage for the attribute value
+    typename aligned_storage< sizeof(ValueT), alignment_of< ValueT >::value >::type m_Storage;
+    //! The flag indicates that the record has the attribute value
+    bool m_Present;
+
+    //! Returns the stored attribute value
+    ValueT const& get() const { return *reinterpret_cast< const ValueT* >(&m_Storage); }
+};
+
+//! The base class defines the ordering key type if the attribute values can be cached by ordering queues
+template< typename ValueT, bool CacheableV = is_ordering_key_cacheable< ValueT >::value >
+struct attribute_value_ordering_key_base
+{
+};
+
+template< typename ValueT >
+struct attribute_value_ordering_key_base< ValueT, true >
+{
+    //! Ordering key type
+    typedef attribute_value_ordering_key< ValueT > ordering_key_type;
+};
+
+} // namespace aux
+
 /*!
  * \brief Ordering predicate, based on opaque pointers to the record view implementation data
  *
@@ -91,10 +141,15 @@ public:
  * attribute value of the specified type to be able to be ordered properly. As a special case,
  * if neither of the records have the value, these records are considered equivalent. Otherwise,
  * the ordering results are unspecified.
+ *
+ * If \c ValueT is a single trivially copyable type, such as an integer or a time point, the predicate
+ * also supports precomputed ordering keys. The ordering queues of the asynchronous sink frontend extract
+ * the attribute value once when a record is enqueued and order the records by comparing the stored values.
  */
 template< typename ValueT, typename FunT = less >
 class attribute_value_ordering :
-    private FunT
+    private FunT,
+    public aux::attribute_value_ordering_key_base< ValueT >
 {
 public:
     //! Result type
@@ -148,6 +203,25 @@ private:
         bool& m_result;
     };
 
+    //! The visitor stores the attribute value in the ordering key
+    struct key_visitor
+    {
+        typedef void result_type;
+
+        explicit key_visitor(aux::attribute_value_ordering_key< value_type >& key) : m_key(key)
+        {
+        }
+
+        result_type operator() (value_type const& value) const
+        {
+            new (&m_key.m_Storage) value_type(value);
+            m_key.m_Present = true;
+        }
+
+    private:
+        aux::attribute_value_ordering_key< value_type >& m_key;
+    };
+
 private:
     //! Attribute value name
     const attribute_name m_name;
@@ -177,6 +251,28 @@ public:
         }
         return result;
     }
+
+    /*!
+     * Extracts the ordering key from the record. Only supported if \c ValueT is a single trivially copyable type.
+     */
+    aux::attribute_value_ordering_key< value_type > get_ordering_key(record_view const& rec) const
+    {
+        aux::attribute_value_ordering_key< value_type > key;
+        key.m_Present = false;
+        boost::log::visit< value_type >(m_name, rec, key_visitor(key));
+        return key;
+    }
+
+    /*!
+     * Ordering operator for the keys extracted with \c get_ordering_key. The keys are ordered
+     * the same way as the records they are extracted from.
+     */
+    result_type compare_ordering_keys(aux::attribute_value_ordering_key< value_type > const& left, aux::attribute_value_ordering_key< value_type > const& right) const
+    {
+        if (left.m_Present)
+            return right.m_Present && static_cast< FunT const& >(*this)(left.get(), right.get());
+        return !right.m_Present;
+    }
 };
 
 /*!
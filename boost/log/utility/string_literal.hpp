@@ -36,6 +36,15 @@ namespace boost {
 
 BOOST_LOG_OPEN_NAMESPACE
 
+#ifndef BOOST_LOG_DOXYGEN_PASS
+namespace attributes {
+
+template< typename CharT >
+class basic_string_view_value;
+
+} // namespace attributes
+#endif // BOOST_LOG_DOXYGEN_PASS
+
 /*!
  * \brief String literal wrapper
  *
@@ -493,6 +502,12 @@ public:
 
 private:
 #ifndef BOOST_LOG_DOXYGEN_PASS
+    template< typename >
+    friend class attributes::basic_string_view_value;
+
+    //! Constructor from a zero-terminated string of the specified length
+    basic_string_literal(const_pointer p, size_type len) : m_pStart(p), m_Len(len) {}
+
     //! Internal comparison implementation
     static int compare_internal(const_pointer pLeft, size_type LeftLen, const_pointer pRight, size_type RightLen)
     {
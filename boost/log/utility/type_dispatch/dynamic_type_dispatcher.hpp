@@ -17,13 +17,14 @@
 
 #include <new>
 #include <memory>
-#include <map>
+#include <vector>
+#include <cstddef>
+#include <utility>
 #include <boost/ref.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/log/detail/config.hpp>
-#include <boost/log/detail/visible_type.hpp>
-#include <boost/log/utility/type_info_wrapper.hpp>
+#include <boost/log/detail/type_index.hpp>
 #include <boost/log/utility/type_dispatch/type_dispatcher.hpp>
 #include <boost/log/detail/header.hpp>
 
@@ -77,15 +78,21 @@ private:
     };
 #endif // BOOST_LOG_DOXYGEN_PASS
 
-    //! The dispatching map
-    typedef std::map< type_info_wrapper, shared_ptr< callback_base > > dispatching_map;
+    /*!
+     * The dispatching map. This is a hash table with open addressing and linear probing. Since type indices
+     * are small integers allocated sequentially, they are used as hash values directly. The table is kept
+     * at most half full. Vacant slots have zero type index.
+     */
+    typedef std::vector< std::pair< aux::type_index, shared_ptr< callback_base > > > dispatching_map;
     dispatching_map m_DispatchingMap;
+    //! The number of registered types
+    std::size_t m_TypeCount;
 
 public:
     /*!
      * Default constructor
      */
-    dynamic_type_dispatcher() : type_dispatcher(&dynamic_type_dispatcher::get_callback)
+    dynamic_type_dispatcher() : type_dispatcher(&dynamic_type_dispatcher::get_callback), m_TypeCount(0)
     {
     }
 
@@ -94,7 +101,8 @@ public:
      */
     dynamic_type_dispatcher(dynamic_type_dispatcher const& that) :
         type_dispatcher(static_cast< type_dispatcher const& >(that)),
-        m_DispatchingMap(that.m_DispatchingMap)
+        m_DispatchingMap(that.m_DispatchingMap),
+        m_TypeCount(that.m_TypeCount)
     {
     }
 
@@ -104,6 +112,7 @@ public:
     dynamic_type_dispatcher& operator= (dynamic_type_dispatcher const& that)
     {
         m_DispatchingMap = that.m_DispatchingMap;
+        m_TypeCount = that.m_TypeCount;
         return *this;
     }
 
@@ -118,29 +127,70 @@ public:
         boost::shared_ptr< callback_base > p(
             boost::make_shared< callback_impl< T, VisitorT > >(boost::cref(visitor)));
 
-        type_info_wrapper wrapper(typeid(aux::visible_type< T >));
-        m_DispatchingMap[wrapper].swap(p);
+        const aux::type_index type = aux::get_type_index< T >();
+        if (m_DispatchingMap.empty())
+            m_DispatchingMap.resize(8u);
+
+        dispatching_map::value_type* entry = &find_slot(m_DispatchingMap, type);
+        if (entry->first == 0)
+        {
+            if ((m_TypeCount + 1u) * 2u > m_DispatchingMap.size())
+            {
+                rehash(m_DispatchingMap.size() * 2u);
+                entry = &find_slot(m_DispatchingMap, type);
+            }
+            entry->first = type;
+            ++m_TypeCount;
+        }
+        entry->second.swap(p);
     }
 
     /*!
      * The method returns the number of registered types
      */
-    dispatching_map::size_type registered_types_count() const
+    std::size_t registered_types_count() const
     {
-        return m_DispatchingMap.size();
+        return m_TypeCount;
     }
 
 private:
 #ifndef BOOST_LOG_DOXYGEN_PASS
-    static callback_base get_callback(type_dispatcher* p, std::type_info const& type)
+    //! The method returns the slot that contains the type or the vacant slot where the type can be inserted
+    static dispatching_map::value_type& find_slot(dispatching_map& map, aux::type_index type)
+    {
+        const std::size_t mask = map.size() - 1u;
+        std::size_t pos = type & mask;
+        while (map[pos].first != type && map[pos].first != 0)
+            pos = (pos + 1u) & mask;
+        return map[pos];
+    }
+
+    //! The method resizes the dispatching map
+    void rehash(std::size_t size)
+    {
+        dispatching_map map(size);
+        for (dispatching_map::iterator it = m_DispatchingMap.begin(), end = m_DispatchingMap.end(); it != end; ++it)
+        {
+            if (it->first != 0)
+            {
+                dispatching_map::value_type& entry = find_slot(map, it->first);
+                entry.first = it->first;
+                entry.second.swap(it->second);
+            }
+        }
+        m_DispatchingMap.swap(map);
+    }
+
+    static callback_base get_callback(type_dispatcher* p, aux::type_index type)
     {
         dynamic_type_dispatcher* const self = static_cast< dynamic_type_dispatcher* >(p);
-        type_info_wrapper wrapper(type);
-        dispatching_map::iterator it = self->m_DispatchingMap.find(wrapper);
-        if (it != self->m_DispatchingMap.end())
-            return *it->second;
-        else
-            return callback_base();
+        if (!self->m_DispatchingMap.empty())
+        {
+            dispatching_map::value_type const& entry = find_slot(self->m_DispatchingMap, type);
+            if (entry.first != 0)
+                return *entry.second;
+        }
+        return callback_base();
     }
 #endif // BOOST_LOG_DOXYGEN_PASS
 };
@@ -17,8 +17,6 @@
 
 #include <cstddef>
 #include <utility>
-#include <iterator>
-#include <algorithm>
 #include <boost/array.hpp>
 #include <boost/static_assert.hpp>
 #include <boost/mpl/if.hpp>
@@ -30,9 +28,9 @@
 #include <boost/mpl/is_sequence.hpp>
 #include <boost/utility/addressof.hpp>
 #include <boost/log/detail/config.hpp>
+#include <boost/log/detail/type_index.hpp>
 #include <boost/log/detail/visible_type.hpp>
 #include <boost/log/utility/once_block.hpp>
-#include <boost/log/utility/type_info_wrapper.hpp>
 #include <boost/log/utility/type_dispatch/type_dispatcher.hpp>
 #include <boost/log/detail/header.hpp>
 
@@ -46,42 +44,42 @@ BOOST_LOG_OPEN_NAMESPACE
 
 namespace aux {
 
-//! Ordering predicate for type dispatching map
-struct dispatching_map_order
+//! The metafunction computes the size of the dispatching map for the given number of types
+template< std::size_t TypeCountV, std::size_t SizeV = 2u, bool = (SizeV >= TypeCountV * 2u) >
+struct dispatching_map_size
 {
-    typedef bool result_type;
-    typedef std::pair< type_info_wrapper, void* > first_argument_type, second_argument_type;
-    result_type operator() (first_argument_type const& left, second_argument_type const& right) const
-    {
-        return (left.first < right.first);
-    }
+    BOOST_STATIC_CONSTANT(std::size_t, value = (dispatching_map_size< TypeCountV, SizeV * 2u >::value));
+};
+
+template< std::size_t TypeCountV, std::size_t SizeV >
+struct dispatching_map_size< TypeCountV, SizeV, true >
+{
+    BOOST_STATIC_CONSTANT(std::size_t, value = SizeV);
 };
 
 //! Dispatching map filler
-template< typename VisitorT >
+template< typename VisitorT, std::size_t SizeV >
 struct dispatching_map_initializer
 {
     template< typename IteratorT >
-    static BOOST_LOG_FORCEINLINE void init(IteratorT*, IteratorT*, std::pair< type_info_wrapper, void* >*)
+    static BOOST_LOG_FORCEINLINE void init(IteratorT*, IteratorT*, std::pair< type_index, void* >*)
     {
     }
 
     template< typename BeginIteratorT, typename EndIteratorT >
-    static BOOST_LOG_FORCEINLINE void init(BeginIteratorT*, EndIteratorT* end, std::pair< type_info_wrapper, void* >* p)
+    static BOOST_LOG_FORCEINLINE void init(BeginIteratorT*, EndIteratorT* end, std::pair< type_index, void* >* p)
     {
         typedef typename mpl::deref< BeginIteratorT >::type type;
         do_init(static_cast< visible_type< type >* >(0), p);
 
         typedef typename mpl::next< BeginIteratorT >::type next_iterator_type;
-        init(static_cast< next_iterator_type* >(0), end, p + 1);
+        init(static_cast< next_iterator_type* >(0), end, p);
     }
 
 private:
     template< typename T >
-    static BOOST_LOG_FORCEINLINE void do_init(visible_type< T >*, std::pair< type_info_wrapper, void* >* p)
+    static BOOST_LOG_FORCEINLINE void do_init(visible_type< T >*, std::pair< type_index, void* >* p)
     {
-        p->first = typeid(visible_type< T >);
-
         typedef void (*trampoline_t)(void*, T const&);
         BOOST_STATIC_ASSERT_MSG(sizeof(trampoline_t) == sizeof(void*), "Boost.Log: Unsupported platform, the size of a function pointer differs from the size of a pointer");
         union
@@ -91,7 +89,19 @@ private:
         }
         caster;
         caster.as_trampoline = &type_dispatcher::callback_base::trampoline< VisitorT, T >;
-        p->second = caster.as_pvoid;
+
+        // Find the first vacant slot, starting from the slot designated by the type index
+        const type_index index = get_type_index< T >();
+        std::size_t pos = index & (SizeV - 1u);
+        while (p[pos].first != 0)
+        {
+            if (p[pos].first == index)
+                return; // the type is mentioned in the sequence more than once
+            pos = (pos + 1u) & (SizeV - 1u);
+        }
+
+        p[pos].first = index;
+        p[pos].second = caster.as_pvoid;
     }
 };
 
@@ -105,11 +115,15 @@ public:
     typedef TypeSequenceT supported_types;
 
 private:
-    //! The dispatching map
-    typedef array<
-        std::pair< type_info_wrapper, void* >,
-        mpl::size< supported_types >::value
-    > dispatching_map;
+    //! The size of the dispatching map
+    enum { map_size = dispatching_map_size< mpl::size< supported_types >::value >::value };
+
+    /*!
+     * The dispatching map. This is a hash table with open addressing and linear probing. Since type indices
+     * are small integers allocated sequentially, they are used as hash values directly. The table is at most
+     * half full, so most lookups end up in the first probed slot. Vacant slots have zero type index.
+     */
+    typedef array< std::pair< type_index, void* >, map_size > dispatching_map;
 
 private:
     //! Pointer to the receiver function
@@ -131,24 +145,20 @@ public:
 
 private:
     //! The get_callback method implementation
-    static callback_base get_callback(type_dispatcher* p, std::type_info const& type)
+    static callback_base get_callback(type_dispatcher* p, type_index type)
     {
         type_sequence_dispatcher* const self = static_cast< type_sequence_dispatcher* >(p);
-        type_info_wrapper wrapper(type);
-        typename dispatching_map::value_type const* begin = &*self->m_DispatchingMap.begin();
-        typename dispatching_map::value_type const* end = begin + dispatching_map::static_size;
-        typename dispatching_map::value_type const* it =
-            std::lower_bound(
-                begin,
-                end,
-                std::make_pair(wrapper, (void*)0),
-                dispatching_map_order()
-            );
-
-        if (it != end && it->first == wrapper)
-            return callback_base(self->m_pVisitor, it->second);
-        else
-            return callback_base();
+        typename dispatching_map::value_type const* const map = &*self->m_DispatchingMap.begin();
+        std::size_t pos = type & (map_size - 1u);
+        while (true)
+        {
+            typename dispatching_map::value_type const& entry = map[pos];
+            if (entry.first == type)
+                return callback_base(self->m_pVisitor, entry.second);
+            else if (entry.first == 0)
+                return callback_base();
+            pos = (pos + 1u) & (map_size - 1u);
+        }
     }
 
     //! The method returns the dispatching map instance
@@ -161,14 +171,17 @@ private:
         {
             static dispatching_map instance;
             typename dispatching_map::value_type* p = &*instance.begin();
+            for (std::size_t i = 0; i < map_size; ++i)
+            {
+                p[i].first = 0;
+                p[i].second = NULL;
+            }
 
             typedef typename mpl::begin< supported_types >::type begin_iterator_type;
             typedef typename mpl::end< supported_types >::type end_iterator_type;
-            typedef dispatching_map_initializer< VisitorT > initializer;
+            typedef dispatching_map_initializer< VisitorT, map_size > initializer;
             initializer::init(static_cast< begin_iterator_type* >(0), static_cast< end_iterator_type* >(0), p);
 
-            std::sort(instance.begin(), instance.end(), dispatching_map_order());
-
             pinstance = &instance;
         }
 
@@ -201,9 +214,9 @@ public:
     {
     }
     //! The get_callback method implementation
-    static callback_base get_callback(type_dispatcher* p, std::type_info const& type)
+    static callback_base get_callback(type_dispatcher* p, type_index type)
     {
-        if (type == typeid(visible_type< T >))
+        if (type == get_type_index< T >())
         {
             single_type_dispatcher* const self = static_cast< single_type_dispatcher* >(p);
             return self->m_Callback;
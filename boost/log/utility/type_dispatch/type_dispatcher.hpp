@@ -15,10 +15,9 @@
 #ifndef BOOST_LOG_TYPE_DISPATCHER_HPP_INCLUDED_
 #define BOOST_LOG_TYPE_DISPATCHER_HPP_INCLUDED_
 
-#include <typeinfo>
 #include <boost/static_assert.hpp>
 #include <boost/log/detail/config.hpp>
-#include <boost/log/detail/visible_type.hpp>
+#include <boost/log/detail/type_index.hpp>
 #include <boost/log/utility/explicit_operator_bool.hpp>
 #include <boost/log/detail/header.hpp>
 
@@ -147,8 +146,8 @@ public:
 #endif // BOOST_LOG_DOXYGEN_PASS
 
 protected:
-    //! Pointer to the callback acquisition method
-    typedef callback_base (*get_callback_impl_type)(type_dispatcher*, std::type_info const&);
+    //! Pointer to the callback acquisition method. The method receives the index of the requested type.
+    typedef callback_base (*get_callback_impl_type)(type_dispatcher*, boost::log::aux::type_index);
 
 private:
     //! Pointer to the callback acquisition method
@@ -175,7 +174,7 @@ public:
     template< typename T >
     callback< T > get_callback()
     {
-        return callback< T >((this->m_get_callback_impl)(this, typeid(boost::log::aux::visible_type< T >)));
+        return callback< T >((this->m_get_callback_impl)(this, boost::log::aux::get_type_index< T >()));
     }
 };
 
@@ -0,0 +1,134 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   main.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  A tool that converts binary log files to text, optionally filtering log records.
+ *
+ * Usage: binary_log_dump [-f Name=Value]... [-h Name]... [file]...
+ *
+ * The tool reads the log files written by the binary_ostream_backend sink backend (or the standard input,
+ * if no files are specified) and prints every log record as a single line of Name=Value pairs.
+ * The -f option leaves only the records having the attribute with the specified value, and the -h
+ * option leaves only the records having the attribute with the specified name.
+ */
+
+// #define BOOST_LOG_DYN_LINK 1
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include <utility>
+#include <fstream>
+#include <iostream>
+#include <exception>
+#include <boost/lexical_cast.hpp>
+#include <boost/log/utility/binary_log_reader.hpp>
+
+namespace binary_log = boost::log::binary_log;
+
+// Filtering conditions. If the value is not specified, the condition only requires the attribute to be present.
+typedef std::vector< std::pair< std::string, std::pair< bool, std::string > > > conditions;
+
+bool matches(binary_log::field_list const& fields, conditions const& conds)
+{
+    for (conditions::const_iterator cond = conds.begin(), cond_end = conds.end(); cond != cond_end; ++cond)
+    {
+        bool found = false;
+        for (binary_log::field_list::const_iterator it = fields.begin(), end = fields.end(); it != end && !found; ++it)
+        {
+            if (it->name == cond->first)
+                found = !cond->second.first || boost::lexical_cast< std::string >(*it) == cond->second.second;
+        }
+
+        if (!found)
+            return false;
+    }
+
+    return true;
+}
+
+void dump(std::istream& strm, conditions const& conds)
+{
+    binary_log::reader reader(strm);
+    binary_log::field_list fields;
+    while (reader.read(fields))
+    {
+        if (!matches(fields, conds))
+            continue;
+
+        for (binary_log::field_list::const_iterator it = fields.begin(), end = fields.end(); it != end; ++it)
+        {
+            if (it != fields.begin())
+                std::cout << ' ';
+            std::cout << it->name << '=' << *it;
+        }
+        std::cout << '\n';
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        conditions conds;
+        std::vector< std::string > files;
+        for (int i = 1; i < argc; ++i)
+        {
+            if ((std::strcmp(argv[i], "-f") == 0 || std::strcmp(argv[i], "-h") == 0) && i + 1 < argc)
+            {
+                std::string arg = argv[i + 1];
+                if (argv[i][1] == 'f')
+                {
+                    std::string::size_type pos = arg.find('=');
+                    if (pos == std::string::npos)
+                    {
+                        std::cerr << "Invalid filter: " << arg << std::endl;
+                        return 1;
+                    }
+                    conds.push_back(std::make_pair(arg.substr(0, pos), std::make_pair(true, arg.substr(pos + 1))));
+                }
+                else
+                {
+                    conds.push_back(std::make_pair(arg, std::make_pair(false, std::string())));
+                }
+                ++i;
+            }
+            else
+            {
+                files.push_back(argv[i]);
+            }
+        }
+
+        if (files.empty())
+        {
+            dump(std::cin, conds);
+        }
+        else
+        {
+            for (std::vector< std::string >::const_iterator it = files.begin(), end = files.end(); it != end; ++it)
+            {
+                std::ifstream file(it->c_str(), std::ios_base::in | std::ios_base::binary);
+                if (!file.is_open())
+                {
+                    std::cerr << "Failed to open file: " << *it << std::endl;
+                    return 1;
+                }
+                dump(file, conds);
+            }
+        }
+
+        return 0;
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << "FAILURE: " << e.what() << std::endl;
+        return 1;
+    }
+}
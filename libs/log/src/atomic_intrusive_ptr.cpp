@@ -0,0 +1,208 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   atomic_intrusive_ptr.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/libs/log/doc/log.html.
+ */
+
+#include <boost/log/detail/config.hpp>
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/atomic/atomic.hpp>
+#include <boost/thread/thread.hpp> // at_thread_exit
+#include <boost/log/detail/singleton.hpp>
+#include <boost/log/detail/atomic_intrusive_ptr.hpp>
+#if !defined(BOOST_LOG_USE_COMPILER_TLS)
+#include <boost/log/detail/thread_specific.hpp>
+#endif
+#include <boost/log/detail/header.hpp>
+
+#ifndef BOOST_LOG_CPU_CACHE_LINE_SIZE
+//! The macro defines the CPU cache line size for the target architecture. This is mostly used for optimization.
+#define BOOST_LOG_CPU_CACHE_LINE_SIZE 64
+#endif
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace aux {
+
+namespace {
+
+//! Hazard pointer record. Records are never deallocated, records of the terminated threads are reused.
+struct hazard_record :
+    public hazard_slot
+{
+    //! The flag indicates that the record is owned by a thread
+    boost::atomic< bool > m_fAcquired;
+    //! The next record in the list. Not modified after the record is published.
+    hazard_record* m_pNext;
+    //! Padding to place the hazard pointers of different threads in different cache lines
+    char m_Padding[BOOST_LOG_CPU_CACHE_LINE_SIZE];
+
+    hazard_record() : m_fAcquired(true), m_pNext(NULL)
+    {
+        m_pObject.store(NULL, boost::memory_order_relaxed);
+        m_fBusy = false;
+    }
+};
+
+//! The list of all hazard pointer records
+struct hazard_record_list
+{
+    boost::atomic< hazard_record* > m_pHead;
+
+    hazard_record_list() : m_pHead(NULL) {}
+};
+
+//! Hazard pointer record list storage class
+class hazard_records :
+    public lazy_singleton< hazard_records, hazard_record_list >
+{
+};
+
+//! Hazard pointer records of a thread
+struct hazard_thread_data
+{
+    std::vector< hazard_record* > m_Records;
+
+    ~hazard_thread_data()
+    {
+        for (std::vector< hazard_record* >::const_iterator it = m_Records.begin(), end = m_Records.end(); it != end; ++it)
+        {
+            (*it)->m_pObject.store(NULL, boost::memory_order_relaxed);
+            (*it)->m_fAcquired.store(false, boost::memory_order_release);
+        }
+    }
+};
+
+//! The function acquires a record that is not owned by any thread or creates a new one
+hazard_record* allocate_hazard_record()
+{
+    boost::atomic< hazard_record* >& head = hazard_records::get().m_pHead;
+    for (hazard_record* p = head.load(boost::memory_order_acquire); p; p = p->m_pNext)
+    {
+        if (!p->m_fAcquired.load(boost::memory_order_relaxed) && !p->m_fAcquired.exchange(true, boost::memory_order_acquire))
+            return p;
+    }
+
+    hazard_record* p = new hazard_record();
+    hazard_record* next = head.load(boost::memory_order_relaxed);
+    do
+    {
+        p->m_pNext = next;
+    }
+    while (!head.compare_exchange_weak(next, p, boost::memory_order_release, boost::memory_order_relaxed));
+
+    return p;
+}
+
+#if defined(BOOST_LOG_USE_COMPILER_TLS)
+
+static BOOST_LOG_TLS hazard_thread_data* g_pHazardThreadData = NULL;
+
+//! The function releases the hazard pointer records of the terminating thread
+void destroy_hazard_thread_data(hazard_thread_data* p)
+{
+    g_pHazardThreadData = NULL;
+    delete p;
+}
+
+#else // defined(BOOST_LOG_USE_COMPILER_TLS)
+
+//! Hazard pointer records storage class
+class hazard_thread_data_holder :
+    public lazy_singleton< hazard_thread_data_holder, thread_specific< hazard_thread_data* > >
+{
+};
+
+//! The function releases the hazard pointer records of the terminating thread
+void destroy_hazard_thread_data(hazard_thread_data* p)
+{
+    hazard_thread_data_holder::get().set(NULL);
+    delete p;
+}
+
+#endif // defined(BOOST_LOG_USE_COMPILER_TLS)
+
+//! The function returns the hazard pointer records of the current thread
+hazard_thread_data& get_hazard_thread_data()
+{
+#if defined(BOOST_LOG_USE_COMPILER_TLS)
+    hazard_thread_data* p = g_pHazardThreadData;
+#else
+    thread_specific< hazard_thread_data* >& tss = hazard_thread_data_holder::get();
+    hazard_thread_data* p = tss.get();
+#endif
+    if (!p)
+    {
+        std::auto_ptr< hazard_thread_data > ptr(new hazard_thread_data());
+        boost::this_thread::at_thread_exit(boost::bind(&destroy_hazard_thread_data, ptr.get()));
+        p = ptr.release();
+#if defined(BOOST_LOG_USE_COMPILER_TLS)
+        g_pHazardThreadData = p;
+#else
+        tss.set(p);
+#endif
+    }
+    return *p;
+}
+
+} // namespace
+
+//! The function returns a hazard pointer of the current thread that is not in use and marks it as used
+BOOST_LOG_API hazard_slot* acquire_hazard_slot()
+{
+    hazard_thread_data& data = get_hazard_thread_data();
+    for (std::vector< hazard_record* >::const_iterator it = data.m_Records.begin(), end = data.m_Records.end(); it != end; ++it)
+    {
+        if (!(*it)->m_fBusy)
+        {
+            (*it)->m_fBusy = true;
+            return *it;
+        }
+    }
+
+    // All hazard pointers of the thread are used by nested reads
+    data.m_Records.reserve(data.m_Records.size() + 1u);
+    hazard_record* p = allocate_hazard_record();
+    p->m_fBusy = true;
+    data.m_Records.push_back(p);
+    return p;
+}
+
+//! The function returns \c true if a hazard pointer of any thread refers to the object
+BOOST_LOG_API bool is_hazardous(const void* p)
+{
+    for (hazard_record* rec = hazard_records::get().m_pHead.load(boost::memory_order_acquire); rec; rec = rec->m_pNext)
+    {
+        if (rec->m_pObject.load(boost::memory_order_seq_cst) == p)
+            return true;
+    }
+
+    return false;
+}
+
+} // namespace aux
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
@@ -0,0 +1,362 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   attribute_index.hpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/libs/log/doc/log.html.
+ */
+
+#ifndef BOOST_LOG_ATTRIBUTE_INDEX_HPP_INCLUDED_
+#define BOOST_LOG_ATTRIBUTE_INDEX_HPP_INCLUDED_
+
+#include <cstddef>
+#include <algorithm>
+#include <boost/assert.hpp>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/attributes/attribute_name.hpp>
+#include "stateless_allocator.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BOOST_LOG_ATTRIBUTE_INDEX_USE_SSE2
+#endif
+
+#include <boost/log/detail/header.hpp>
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace aux {
+
+/*!
+ * \brief A hash index of attribute container elements by attribute name ids
+ *
+ * The index is a hash table with open addressing. The slots of the table are arranged in groups of
+ * four. The attribute name ids and the pointers to the elements are stored in two separate contiguous
+ * arrays, so that the ids of a group can be compared with the looked up id at once, using SIMD
+ * instructions, where available. The element is looked up in the group selected by the hash of the id
+ * first, and then in the subsequent groups, until the group with a vacant slot is found.
+ *
+ * The table grows as the number of elements increases and is kept at most 3/4 full. The erased
+ * elements leave tombstones, unless the group has a vacant slot. The storage for the table can be
+ * provided by the user on construction; in this case the storage is not freed by the index.
+ */
+template< typename NodeT >
+class attribute_index
+{
+public:
+    //! Element type
+    typedef NodeT node_type;
+    //! Attribute name id type
+    typedef attribute_name::id_type id_type;
+
+    //! The number of slots in a group
+    enum { group_size = 4u };
+    //! The minimum capacity of a non-empty table
+    enum { min_capacity = 16u };
+
+private:
+    //! Stateless allocator
+    typedef stateless_allocator< char > allocator;
+
+    //! The id of a vacant slot
+    static BOOST_LOG_FORCEINLINE id_type empty_id() { return static_cast< id_type >(0xFFFFFFFFu); }
+    //! The id of a slot of an erased element
+    static BOOST_LOG_FORCEINLINE id_type deleted_id() { return static_cast< id_type >(0xFFFFFFFEu); }
+
+private:
+    //! Pointers to the elements
+    node_type** m_pNodes;
+    //! Attribute name ids
+    id_type* m_pIds;
+    //! The number of slots
+    std::size_t m_Capacity;
+    //! The mask to apply to the group index
+    std::size_t m_GroupMask;
+    //! The number of elements
+    std::size_t m_Size;
+    //! The number of tombstones
+    std::size_t m_Deleted;
+    //! Indicates that the storage was allocated by the index
+    bool m_OwnsStorage;
+
+public:
+    /*!
+     * Creates an empty index. The index does not allocate memory until the first element is inserted.
+     */
+    attribute_index() :
+        m_pNodes(NULL),
+        m_pIds(get_empty_group()),
+        m_Capacity(0),
+        m_GroupMask(0),
+        m_Size(0),
+        m_Deleted(0),
+        m_OwnsStorage(false)
+    {
+    }
+
+    /*!
+     * Creates an empty index in the provided storage. The storage size must be at least <tt>storage_size(capacity)</tt>,
+     * and the capacity must be one returned by \c capacity_for.
+     */
+    attribute_index(void* storage, std::size_t capacity) :
+        m_Size(0),
+        m_Deleted(0),
+        m_OwnsStorage(false)
+    {
+        attach(storage, capacity);
+    }
+
+    ~attribute_index()
+    {
+        release();
+    }
+
+    //! Returns the storage size needed for a table with the specified capacity
+    static std::size_t storage_size(std::size_t capacity)
+    {
+        return capacity * (sizeof(node_type*) + sizeof(id_type));
+    }
+
+    //! Returns the table capacity suitable for the specified number of elements
+    static std::size_t capacity_for(std::size_t count)
+    {
+        std::size_t capacity = min_capacity;
+        while (capacity < count * 2u)
+            capacity *= 2u;
+        return capacity;
+    }
+
+    //! Returns the number of elements in the index
+    std::size_t size() const { return m_Size; }
+
+    //! Looks up the element with the specified id. Returns \c NULL if the element is not found.
+    node_type* find(id_type id) const
+    {
+        std::size_t group = get_home_group(id);
+        while (true)
+        {
+            id_type const* const ids = m_pIds + group * group_size;
+            const unsigned int matched = match(ids, id);
+            if (matched)
+                return m_pNodes[group * group_size + get_first_bit(matched)];
+            if (match(ids, empty_id()))
+                return NULL;
+            group = (group + 1u) & m_GroupMask;
+        }
+    }
+
+    /*!
+     * Looks up the element with the specified id. If the element is not found, inserts a new slot for the id.
+     * Returns a reference to the element pointer in the slot, which is \c NULL if the slot was inserted.
+     * The caller is expected to store the pointer to the new element into the slot. Slots with \c NULL
+     * pointers are considered to not contain elements.
+     */
+    node_type*& find_or_insert(id_type id)
+    {
+        BOOST_ASSERT(id != empty_id() && id != deleted_id());
+
+        if ((m_Size + m_Deleted + 1u) * 4u > m_Capacity * 3u)
+            rehash(capacity_for(m_Size + 1u));
+
+        std::size_t group = get_home_group(id);
+        while (true)
+        {
+            id_type* const ids = m_pIds + group * group_size;
+            const unsigned int matched = match(ids, id);
+            if (matched)
+                return m_pNodes[group * group_size + get_first_bit(matched)];
+
+            const unsigned int empty = match(ids, empty_id());
+            if (empty)
+            {
+                // Without tombstones, the first vacant slot in the probe sequence is in this group
+                std::size_t pos = group * group_size + get_first_bit(empty);
+                if (m_Deleted > 0)
+                {
+                    pos = find_vacant(id);
+                    if (m_pIds[pos] == deleted_id())
+                        --m_Deleted;
+                }
+                m_pIds[pos] = id;
+                m_pNodes[pos] = NULL;
+                ++m_Size;
+                return m_pNodes[pos];
+            }
+
+            group = (group + 1u) & m_GroupMask;
+        }
+    }
+
+    //! Inserts the element. The element with the same id must not be present in the index.
+    void insert(id_type id, node_type* p)
+    {
+        BOOST_ASSERT(id != empty_id() && id != deleted_id());
+
+        if ((m_Size + m_Deleted + 1u) * 4u > m_Capacity * 3u)
+            rehash(capacity_for(m_Size + 1u));
+
+        const std::size_t pos = find_vacant(id);
+        if (m_pIds[pos] == deleted_id())
+            --m_Deleted;
+        m_pIds[pos] = id;
+        m_pNodes[pos] = p;
+        ++m_Size;
+    }
+
+    //! Removes the element with the specified id from the index
+    void erase(id_type id)
+    {
+        std::size_t group = get_home_group(id);
+        while (true)
+        {
+            id_type* const ids = m_pIds + group * group_size;
+            const unsigned int matched = match(ids, id);
+            if (matched)
+            {
+                // If the group has a vacant slot, no lookup will proceed to the next group,
+                // so the slot can be made vacant as well. Otherwise leave a tombstone.
+                const std::size_t pos = group * group_size + get_first_bit(matched);
+                if (match(ids, empty_id()))
+                {
+                    m_pIds[pos] = empty_id();
+                }
+                else
+                {
+                    m_pIds[pos] = deleted_id();
+                    ++m_Deleted;
+                }
+                --m_Size;
+                return;
+            }
+            BOOST_ASSERT(match(ids, empty_id()) == 0u);
+            group = (group + 1u) & m_GroupMask;
+        }
+    }
+
+    //! Removes all elements from the index
+    void clear()
+    {
+        if (m_Capacity > 0)
+            std::fill_n(m_pIds, m_Capacity, empty_id());
+        m_Size = 0;
+        m_Deleted = 0;
+    }
+
+private:
+    //  Copying and assignment prohibited
+    attribute_index(attribute_index const&);
+    attribute_index& operator= (attribute_index const&);
+
+    //! Returns a group of vacant slots that is used by the empty index
+    static id_type* get_empty_group()
+    {
+        static const id_type ids[group_size] = { 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu };
+        return const_cast< id_type* >(ids);
+    }
+
+    //! Returns the index of the first group to look for the element in
+    std::size_t get_home_group(id_type id) const
+    {
+        // Fibonacci hashing. Attribute name ids are allocated sequentially, the multiplication spreads them evenly.
+        return static_cast< std::size_t >(static_cast< uint32_t >(id * 2654435769u) >> 16) & m_GroupMask;
+    }
+
+    //! Returns the position of the first vacant or deleted slot in the probe sequence of the id
+    std::size_t find_vacant(id_type id) const
+    {
+        std::size_t group = get_home_group(id);
+        while (true)
+        {
+            id_type const* const ids = m_pIds + group * group_size;
+            const unsigned int vacant = match(ids, empty_id()) | match(ids, deleted_id());
+            if (vacant)
+                return group * group_size + get_first_bit(vacant);
+            group = (group + 1u) & m_GroupMask;
+        }
+    }
+
+    //! Returns a bit mask of slots in the group that contain the id
+    static BOOST_LOG_FORCEINLINE unsigned int match(id_type const* ids, id_type id)
+    {
+#if defined(BOOST_LOG_ATTRIBUTE_INDEX_USE_SSE2)
+        const __m128i group = _mm_loadu_si128(reinterpret_cast< const __m128i* >(ids));
+        const __m128i mm_id = _mm_set1_epi32(static_cast< int >(id));
+        return static_cast< unsigned int >(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(group, mm_id))));
+#else
+        return static_cast< unsigned int >(ids[0] == id) |
+            (static_cast< unsigned int >(ids[1] == id) << 1) |
+            (static_cast< unsigned int >(ids[2] == id) << 2) |
+            (static_cast< unsigned int >(ids[3] == id) << 3);
+#endif
+    }
+
+    //! Returns the index of the least significant non-zero bit in the group mask
+    static BOOST_LOG_FORCEINLINE unsigned int get_first_bit(unsigned int mask)
+    {
+        // The lookup table avoids branches, the position of the vacant slot is not predictable
+        static const unsigned char first_bits[16] = { 0u, 0u, 1u, 0u, 2u, 0u, 1u, 0u, 3u, 0u, 1u, 0u, 2u, 0u, 1u, 0u };
+        return first_bits[mask];
+    }
+
+    //! Sets up the table in the storage
+    void attach(void* storage, std::size_t capacity)
+    {
+        m_pNodes = static_cast< node_type** >(storage);
+        m_pIds = reinterpret_cast< id_type* >(m_pNodes + capacity);
+        m_Capacity = capacity;
+        m_GroupMask = capacity / group_size - 1u;
+        std::fill_n(m_pIds, capacity, empty_id());
+    }
+
+    //! Releases the storage, if it was allocated by the index
+    void release()
+    {
+        if (m_OwnsStorage)
+            allocator::deallocate(reinterpret_cast< allocator::pointer >(m_pNodes), storage_size(m_Capacity));
+    }
+
+    //! Moves all elements to a new table of the specified capacity
+    void rehash(std::size_t capacity)
+    {
+        void* const storage = allocator::allocate(storage_size(capacity));
+
+        node_type** const old_nodes = m_pNodes;
+        id_type* const old_ids = m_pIds;
+        const std::size_t old_capacity = m_Capacity;
+        const bool old_owns_storage = m_OwnsStorage;
+
+        attach(storage, capacity);
+        m_OwnsStorage = true;
+        m_Size = 0;
+        m_Deleted = 0;
+
+        for (std::size_t i = 0; i < old_capacity; ++i)
+        {
+            const id_type id = old_ids[i];
+            if (id != empty_id() && id != deleted_id())
+                insert(id, old_nodes[i]);
+        }
+
+        if (old_owns_storage)
+            allocator::deallocate(reinterpret_cast< allocator::pointer >(old_nodes), storage_size(old_capacity));
+    }
+};
+
+} // namespace aux
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_ATTRIBUTE_INDEX_HPP_INCLUDED_
@@ -139,6 +139,29 @@ private:
     node_set m_NodeSet;
 
 public:
+    /*!
+     * Constructor. Registers the well-known attribute names used by the library, so that they
+     * are assigned the smallest ids. Attribute value sets store values of attributes with small
+     * ids in dedicated slots, which makes lookup of these attributes faster.
+     */
+    repository()
+    {
+        static const char* const well_known_names[] =
+        {
+            "Severity",
+            "Channel",
+            "Message",
+            "LineID",
+            "TimeStamp",
+            "ProcessID",
+            "ThreadID",
+            "CallSite"
+        };
+
+        for (unsigned int i = 0; i < sizeof(well_known_names) / sizeof(*well_known_names); ++i)
+            get_id_from_string(well_known_names[i]);
+    }
+
     //! Converts attribute name string to id
     id_type get_id_from_string(const char* name)
     {
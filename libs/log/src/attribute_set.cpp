@@ -47,10 +47,27 @@ inline attribute_set::node_base::node_base() :
 
 inline attribute_set::node::node(key_type const& key, mapped_type const& data) :
     node_base(),
-    m_Value(key, data)
+    m_Value(key, data),
+    m_fExternal(false)
 {
 }
 
+//! Constructor
+BOOST_LOG_API attribute_set::external_node::external_node(key_type const& key, mapped_type const& data, detach_function detach) :
+    node(key, data),
+    m_pDetach(detach)
+{
+    this->m_fExternal = true;
+}
+
+//! Copying constructor
+BOOST_LOG_API attribute_set::external_node::external_node(external_node const& that) :
+    node(that.m_Value.first, that.m_Value.second),
+    m_pDetach(that.m_pDetach)
+{
+    this->m_fExternal = true;
+}
+
 //! Default constructor
 BOOST_LOG_API attribute_set::attribute_set() :
     m_pImpl(new implementation())
@@ -140,6 +157,24 @@ BOOST_LOG_API attribute_set::iterator attribute_set::find(key_type key) BOOST_NO
     return m_pImpl->find(key);
 }
 
+//! The method links the node owned by a scoped attribute guard into the container
+BOOST_LOG_API std::pair< attribute_set::iterator, bool > attribute_set::insert_external(external_node& n)
+{
+    return m_pImpl->insert_external(n);
+}
+
+//! The method unlinks the node owned by a scoped attribute guard from the container
+BOOST_LOG_API void attribute_set::erase_external(external_node& n) BOOST_NOEXCEPT
+{
+    m_pImpl->erase_external(n);
+}
+
+//! The method checks if the container has attributes that refer to the storage of scoped attribute guards
+BOOST_LOG_API bool attribute_set::has_scoped_values() const BOOST_NOEXCEPT
+{
+    return m_pImpl->has_scoped_values();
+}
+
 BOOST_LOG_CLOSE_NAMESPACE // namespace log
 
 } // namespace boost
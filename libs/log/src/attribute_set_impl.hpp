@@ -29,13 +29,9 @@
 #include <boost/intrusive/link_mode.hpp>
 #include <boost/intrusive/derivation_value_traits.hpp>
 #include <boost/log/attributes/attribute_set.hpp>
+#include "attribute_index.hpp"
 #include <boost/log/detail/header.hpp>
 
-#ifndef BOOST_LOG_HASH_TABLE_SIZE_LOG
-// Hash table size will be 2 ^ this value
-#define BOOST_LOG_HASH_TABLE_SIZE_LOG 4
-#endif
-
 #ifndef BOOST_LOG_ATTRIBUTE_SET_MAX_POOL_SIZE
 // Maximum pool size that each attribute set maintains
 #define BOOST_LOG_ATTRIBUTE_SET_MAX_POOL_SIZE 8
@@ -182,19 +178,8 @@ public:
         intrusive::constant_time_size< true >
     > node_list;
 
-    //! A hash table bucket
-    struct bucket
-    {
-        //! Points to the first element in the bucket
-        node* first;
-        //! Points to the last element in the bucket (not the one after the last!)
-        node* last;
-
-        bucket() : first(NULL), last(NULL) {}
-    };
-
-    //! A list of buckets
-    typedef boost::array< bucket, 1U << BOOST_LOG_HASH_TABLE_SIZE_LOG > buckets;
+    //! Hash index of the elements
+    typedef aux::attribute_index< node > index;
 
     //! Cleanup function object used to erase elements from the container
     struct disposer
@@ -206,8 +191,16 @@ public:
         }
         void operator() (node* p) const
         {
-            p->~node();
-            m_Allocator.deallocate(p, 1);
+            if (!p->m_fExternal)
+            {
+                p->~node();
+                m_Allocator.deallocate(p, 1);
+            }
+            else
+            {
+                // The node is owned by a scoped attribute guard, only mark it unlinked
+                p->m_pPrev = p->m_pNext = NULL;
+            }
         }
 
     private:
@@ -219,28 +212,43 @@ private:
     node_list m_Nodes;
     //! Node allocator
     node_allocator m_Allocator;
-    //! Hash table buckets
-    buckets m_Buckets;
+    //! Hash index of the nodes
+    index m_Index;
+    //! The number of linked external nodes with attributes that refer to the storage of scoped attribute guards
+    size_type m_ScopedValueCount;
 
 public:
-    implementation()
+    implementation() : m_ScopedValueCount(0)
     {
     }
 
-    implementation(implementation const& that) : m_Allocator(that.m_Allocator)
+    implementation(implementation const& that) : m_Allocator(that.m_Allocator), m_ScopedValueCount(0)
     {
         node_list::const_iterator it = that.m_Nodes.begin(), end = that.m_Nodes.end();
         for (; it != end; ++it)
         {
             node* const n = m_Allocator.allocate(1, NULL);
-            new (n) node(it->m_Value.first, it->m_Value.second);
-            m_Nodes.push_back(*n);
-
-            bucket& b = get_bucket(it->m_Value.first.id());
-            if (b.first == NULL)
-                b.first = b.last = n;
+            if (!it->m_fExternal || !static_cast< external_node const& >(*it).m_pDetach)
+            {
+                new (n) node(it->m_Value.first, it->m_Value.second);
+            }
             else
-                b.last = n;
+            {
+                // The copy must not refer to the scoped attribute guard
+                try
+                {
+                    external_node const& en = static_cast< external_node const& >(*it);
+                    new (n) node(en.m_Value.first, en.m_pDetach(en));
+                }
+                catch (...)
+                {
+                    m_Allocator.deallocate(n, 1);
+                    m_Nodes.clear_and_dispose(disposer(m_Allocator));
+                    throw;
+                }
+            }
+            m_Nodes.push_back(*n);
+            m_Index.insert(it->m_Value.first.id(), n);
         }
     }
 
@@ -250,127 +258,83 @@ public:
     }
 
     size_type size() const { return m_Nodes.size(); }
+    bool has_scoped_values() const { return m_ScopedValueCount > 0; }
     iterator begin() { return iterator(m_Nodes.begin().pointed_node()); }
     iterator end() { return iterator(m_Nodes.end().pointed_node()); }
 
     void clear()
     {
         m_Nodes.clear_and_dispose(disposer(m_Allocator));
-        std::fill_n(m_Buckets.begin(), m_Buckets.size(), bucket());
+        m_Index.clear();
+        m_ScopedValueCount = 0;
     }
 
     std::pair< iterator, bool > insert(key_type key, mapped_type const& data)
     {
         BOOST_ASSERT(!!key);
 
-        bucket& b = get_bucket(key.id());
-        register node* p = b.first;
+        node*& p = m_Index.find_or_insert(key.id());
         if (p)
-        {
-            // The bucket is not empty, search among the elements
-            p = find_in_bucket(key, b);
-            if (p->m_Value.first == key)
-                return std::make_pair(iterator(p), false);
-        }
-
-        node* const n = m_Allocator.allocate(1, NULL);
-        new (n) node(key, data);
+            return std::make_pair(iterator(p), false);
 
-        if (b.first == NULL)
-        {
-            // The bucket is empty
-            b.first = b.last = n;
-            m_Nodes.push_back(*n);
-        }
-        else if (p == b.last && key.id() > p->m_Value.first.id())
+        try
         {
-            // The new element should become the last element of the bucket
-            node_list::iterator it = m_Nodes.iterator_to(*p);
-            ++it;
-            m_Nodes.insert(it, *n);
-            b.last = n;
+            node* const n = m_Allocator.allocate(1, NULL);
+            new (n) node(key, data);
+            p = n;
         }
-        else
+        catch (...)
         {
-            // The new element should be within the bucket
-            node_list::iterator it = m_Nodes.iterator_to(*p);
-            m_Nodes.insert(it, *n);
+            m_Index.erase(key.id());
+            throw;
         }
+        m_Nodes.push_back(*p);
 
-        return std::make_pair(iterator(n), true);
+        return std::make_pair(iterator(p), true);
     }
 
     void erase(iterator it)
     {
-        typedef node_list::node_traits node_traits;
-        typedef node_list::value_traits value_traits;
-
         node* p = static_cast< node* >(it.base());
+        if (p->m_fExternal && static_cast< external_node* >(p)->m_pDetach)
+            --m_ScopedValueCount;
+        m_Index.erase(it->first.id());
+        m_Nodes.erase_and_dispose(m_Nodes.iterator_to(*p), disposer(m_Allocator));
+    }
 
-        // Adjust bucket boundaries, if needed
-        bucket& b = get_bucket(it->first.id());
-        unsigned int choice = (static_cast< unsigned int >(p == b.first) << 1) |
-            static_cast< unsigned int >(p == b.last);
-        switch (choice)
-        {
-        case 1: // The erased element is the last one in the bucket
-            b.last = value_traits::to_value_ptr(node_traits::get_previous(b.last));
-            break;
+    std::pair< iterator, bool > insert_external(external_node& n)
+    {
+        BOOST_ASSERT(!n.is_linked());
 
-        case 2: // The erased element is the first one in the bucket
-            b.first = value_traits::to_value_ptr(node_traits::get_next(b.first));
-            break;
+        node*& p = m_Index.find_or_insert(n.m_Value.first.id());
+        if (p)
+            return std::make_pair(iterator(p), false);
 
-        case 3: // The erased element is the only one in the bucket
-            b.first = b.last = NULL;
-            break;
+        p = &n;
+        m_Nodes.push_back(n);
+        if (n.m_pDetach)
+            ++m_ScopedValueCount;
 
-        default: // The erased element is somewhere in the middle of the bucket
-            break;
-        }
+        return std::make_pair(iterator(p), true);
+    }
 
-        m_Nodes.erase_and_dispose(m_Nodes.iterator_to(*p), disposer(m_Allocator));
+    void erase_external(external_node& n)
+    {
+        if (n.is_linked())
+            erase(iterator(&n));
     }
 
     iterator find(key_type key)
     {
-        bucket& b = get_bucket(key.id());
-        register node* p = b.first;
+        node* p = m_Index.find(key.id());
         if (p)
-        {
-            // The bucket is not empty, search among the elements
-            p = find_in_bucket(key, b);
-            if (p->m_Value.first == key)
-                return iterator(p);
-        }
+            return iterator(p);
 
         return end();
     }
 
 private:
     implementation& operator= (implementation const&);
-
-    //! The function returns a bucket for the specified element
-    bucket& get_bucket(id_type id)
-    {
-        return m_Buckets[id & (buckets::static_size - 1)];
-    }
-
-    //! Attempts to find an element with the specified key in the bucket
-    node* find_in_bucket(key_type key, bucket const& b)
-    {
-        typedef node_list::node_traits node_traits;
-        typedef node_list::value_traits value_traits;
-
-        // All elements within the bucket are sorted to speedup the search.
-        register node* p = b.first;
-        while (p != b.last && p->m_Value.first.id() < key.id())
-        {
-            p = value_traits::to_value_ptr(node_traits::get_next(p));
-        }
-
-        return p;
-    }
 };
 
 BOOST_LOG_CLOSE_NAMESPACE // namespace log
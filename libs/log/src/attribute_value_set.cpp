@@ -25,9 +25,15 @@
 #include <boost/log/attributes/attribute_value_set.hpp>
 #include "alignment_gap_between.hpp"
 #include "attribute_set_impl.hpp"
+#include "attribute_index.hpp"
 #include "stateless_allocator.hpp"
 #include <boost/log/detail/header.hpp>
 
+#ifndef BOOST_LOG_ATTRIBUTE_VALUE_SET_SLOT_COUNT
+// The number of attribute ids that have dedicated slots in attribute value sets
+#define BOOST_LOG_ATTRIBUTE_VALUE_SET_SLOT_COUNT 16
+#endif
+
 namespace boost {
 
 BOOST_LOG_OPEN_NAMESPACE
@@ -82,19 +88,16 @@ private:
         intrusive::constant_time_size< false >
     > node_list;
 
-    //! A hash table bucket
-    struct bucket
-    {
-        //! Points to the first element in the bucket
-        node* first;
-        //! Points to the last element in the bucket (not the one after the last!)
-        node* last;
+    //! Hash index of the elements
+    typedef aux::attribute_index< node > index;
 
-        bucket() : first(NULL), last(NULL) {}
-    };
-
-    //! A list of buckets
-    typedef boost::array< bucket, 1U << BOOST_LOG_HASH_TABLE_SIZE_LOG > buckets;
+    /*!
+     * A list of slots. Attributes with ids less than the number of slots are indexed by the slots
+     * instead of the hash index, which allows to look them up with a single memory read. Since attribute ids
+     * are allocated sequentially, the slots are occupied by the well-known attribute names and
+     * the names that were registered first, which are typically the most frequently used ones.
+     */
+    typedef boost::array< node*, BOOST_LOG_ATTRIBUTE_VALUE_SET_SLOT_COUNT > slots;
 
     //! Element disposer
     struct disposer
@@ -125,15 +128,23 @@ private:
     node* m_pEnd;
     //! The pointer to the end of storage
     node* m_pEOS;
+    //! The number of elements that did not fit into the storage and were allocated dynamically
+    size_type m_DynamicCount;
 
-    //! Hash table buckets
-    buckets m_Buckets;
+    //! The size of the buffer that contains the object, the elements and the initial index table
+    size_type m_BufferSize;
+    //! Hash index of the elements that are not in slots
+    index m_Index;
+    //! Slots for the attributes with small ids
+    slots m_Slots;
 
 private:
     //! Constructor
     implementation(
         node* storage,
         node* eos,
+        size_type buffer_size,
+        size_type index_capacity,
         attribute_set_impl_type* source_attrs,
         attribute_set_impl_type* thread_attrs,
         attribute_set_impl_type* global_attrs
@@ -143,8 +154,12 @@ private:
         m_pGlobalAttributes(global_attrs),
         m_pStorage(storage),
         m_pEnd(storage),
-        m_pEOS(eos)
+        m_pEOS(eos),
+        m_DynamicCount(0),
+        m_BufferSize(buffer_size),
+        m_Index(eos, index_capacity)
     {
+        m_Slots.assign(NULL);
     }
 
     //! Destructor
@@ -160,14 +175,15 @@ private:
         attribute_set_impl_type* thread_attrs,
         attribute_set_impl_type* global_attrs)
     {
-        // Calculate the buffer size
+        // Calculate the buffer size. The buffer also contains the initial index table, placed after the elements.
         const size_type header_size = sizeof(implementation) +
             aux::alignment_gap_between< implementation, node >::value;
-        const size_type buffer_size = header_size + element_count * sizeof(node);
+        const size_type index_capacity = index::capacity_for(element_count);
+        const size_type buffer_size = header_size + element_count * sizeof(node) + index::storage_size(index_capacity);
 
         implementation* p = reinterpret_cast< implementation* >(stateless_allocator().allocate(buffer_size));
         node* const storage = reinterpret_cast< node* >(reinterpret_cast< char* >(p) + header_size);
-        new (p) implementation(storage, storage + element_count, source_attrs, thread_attrs, global_attrs);
+        new (p) implementation(storage, storage + element_count, buffer_size, index_capacity, source_attrs, thread_attrs, global_attrs);
 
         return p;
     }
@@ -238,7 +254,7 @@ public:
     //! Destroys the object and releases the memory
     static void destroy(implementation* p)
     {
-        const size_type buffer_size = reinterpret_cast< char* >(p->m_pEOS) - reinterpret_cast< char* >(p);
+        const size_type buffer_size = p->m_BufferSize;
         p->~implementation();
         stateless_allocator().deallocate(reinterpret_cast< stateless_allocator::pointer >(p), buffer_size);
     }
@@ -259,25 +275,32 @@ public:
     size_type size()
     {
         freeze();
-        return (m_pEnd - m_pStorage);
+        return static_cast< size_type >(m_pEnd - m_pStorage) + m_DynamicCount;
     }
 
     //! Looks for the element with an equivalent key
     node_base* find(key_type key)
     {
-        // First try to find an acquired element
-        bucket& b = get_bucket(key.id());
-        register node* p = b.first;
-        if (p)
+        const id_type id = key.id();
+        if (id < slots::static_size)
+        {
+            // The attribute has a dedicated slot
+            node* p = m_Slots[id];
+            if (p)
+                return p;
+            else if (!m_pSourceAttributes && !m_pThreadAttributes && !m_pGlobalAttributes)
+                return m_Nodes.end().pointed_node();
+        }
+        else
         {
-            // The bucket is not empty, search among the elements
-            p = find_in_bucket(key, b);
-            if (p->m_Value.first == key)
+            // First try to find an acquired element
+            node* p = m_Index.find(id);
+            if (p)
                 return p;
         }
 
         // Element not found, try to acquire the value from attribute sets
-        return freeze_node(key, b, p);
+        return freeze_node(key);
     }
 
     //! Freezes all elements of the container
@@ -303,11 +326,10 @@ public:
     //! Inserts an element
     std::pair< node*, bool > insert(key_type key, mapped_type const& mapped)
     {
-        bucket& b = get_bucket(key.id());
-        node* p = find_in_bucket(key, b);
-        if (!p || p->m_Value.first != key)
+        node*& p = find_or_insert(key.id());
+        if (!p)
         {
-            p = insert_node(key, b, p, mapped);
+            p = make_node(key, mapped);
             return std::pair< node*, bool >(p, true);
         }
         else
@@ -317,30 +339,8 @@ public:
     }
 
 private:
-    //! The function returns a bucket for the specified element
-    bucket& get_bucket(id_type id)
-    {
-        return m_Buckets[id & (buckets::static_size - 1)];
-    }
-
-    //! Attempts to find an element with the specified key in the bucket
-    node* find_in_bucket(key_type key, bucket const& b)
-    {
-        typedef node_list::node_traits node_traits;
-        typedef node_list::value_traits value_traits;
-
-        // All elements within the bucket are sorted to speedup the search.
-        register node* p = b.first;
-        while (p != b.last && p->m_Value.first.id() < key.id())
-        {
-            p = value_traits::to_value_ptr(node_traits::get_next(p));
-        }
-
-        return p;
-    }
-
     //! Acquires the attribute value from the attribute sets
-    node_base* freeze_node(key_type key, bucket& b, node* where)
+    node_base* freeze_node(key_type key)
     {
         attribute_set::iterator it;
         if (m_pSourceAttributes)
@@ -349,7 +349,7 @@ private:
             if (it != m_pSourceAttributes->end())
             {
                 // The attribute is found, acquiring the value
-                return insert_node(key, b, where, it->second.get_value());
+                return insert_node(key, it->second.get_value());
             }
         }
 
@@ -359,7 +359,7 @@ private:
             if (it != m_pThreadAttributes->end())
             {
                 // The attribute is found, acquiring the value
-                return insert_node(key, b, where, it->second.get_value());
+                return insert_node(key, it->second.get_value());
             }
         }
 
@@ -369,7 +369,7 @@ private:
             if (it != m_pGlobalAttributes->end())
             {
                 // The attribute is found, acquiring the value
-                return insert_node(key, b, where, it->second.get_value());
+                return insert_node(key, it->second.get_value());
             }
         }
 
@@ -378,7 +378,28 @@ private:
     }
 
     //! The function inserts a node into the container
-    node* insert_node(key_type key, bucket& b, node* where, mapped_type data)
+    node* insert_node(key_type key, mapped_type const& data)
+    {
+        node*& p = find_or_insert(key.id());
+        BOOST_ASSERT(p == NULL);
+        p = make_node(key, data);
+        return p;
+    }
+
+    /*!
+     * Looks up the slot or the hash index entry for the element. If the element is not found, a new entry is inserted
+     * into the index. The returned pointer is \c NULL if the element was not found.
+     */
+    node*& find_or_insert(id_type id)
+    {
+        if (id < slots::static_size)
+            return m_Slots[id];
+        else
+            return m_Index.find_or_insert(id);
+    }
+
+    //! The function creates a node and adds it to the list of nodes. The node is not added to the slots or the index.
+    node* make_node(key_type key, mapped_type data)
     {
         node* p;
         if (m_pEnd != m_pEOS)
@@ -389,28 +410,10 @@ private:
         else
         {
             p = new node(key, data, true);
+            ++m_DynamicCount;
         }
 
-        if (b.first == NULL)
-        {
-            // The bucket is empty
-            b.first = b.last = p;
-            m_Nodes.push_back(*p);
-        }
-        else if (where == b.last && key.id() > where->m_Value.first.id())
-        {
-            // The new element should become the last element of the bucket
-            node_list::iterator it = m_Nodes.iterator_to(*where);
-            ++it;
-            m_Nodes.insert(it, *p);
-            b.last = p;
-        }
-        else
-        {
-            // The new element should be within the bucket
-            node_list::iterator it = m_Nodes.iterator_to(*where);
-            m_Nodes.insert(it, *p);
-        }
+        m_Nodes.push_back(*p);
 
         return p;
     }
@@ -422,16 +425,9 @@ private:
         for (; it != end; ++it)
         {
             key_type key = it->first;
-            bucket& b = get_bucket(key.id());
-            register node* p = b.first;
-            if (p)
-            {
-                p = find_in_bucket(key, b);
-                if (p->m_Value.first == key)
-                    continue; // the element is already frozen
-            }
-
-            insert_node(key, b, p, it->second.get_value());
+            node*& p = find_or_insert(key.id());
+            if (!p)
+                p = make_node(key, it->second.get_value());
         }
     }
 
@@ -447,12 +443,11 @@ private:
             new (n) node(it->m_Value.first, data, false);
             m_Nodes.push_back(*n);
 
-            // Since nodes within buckets are ordered, we can simply append the node to the end of the bucket
-            bucket& b = get_bucket(n->m_Value.first.id());
-            if (b.first == NULL)
-                b.first = b.last = n;
+            const id_type id = n->m_Value.first.id();
+            if (id < slots::static_size)
+                m_Slots[id] = n;
             else
-                b.last = n;
+                m_Index.insert(id, n);
         }
     }
 };
@@ -0,0 +1,54 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   basic_sink_frontend.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/libs/log/doc/log.html.
+ */
+
+#include <boost/log/sinks/basic_sink_frontend.hpp>
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+#include <boost/atomic/atomic.hpp>
+#include <boost/log/detail/header.hpp>
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace sinks {
+
+namespace aux {
+
+BOOST_LOG_ANONYMOUS_NAMESPACE {
+
+    //! The last generated frontend state version
+    boost::atomic< unsigned int > g_LastFrontendVersion(0u);
+
+} // namespace
+
+//! Generates a sink frontend state version, which is unique across all frontends in the process
+BOOST_LOG_API unsigned int generate_frontend_version()
+{
+    return g_LastFrontendVersion.fetch_add(1u, boost::memory_order_relaxed) + 1u;
+}
+
+} // namespace aux
+
+} // namespace sinks
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
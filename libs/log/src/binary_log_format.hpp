@@ -0,0 +1,137 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   binary_log_format.hpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/libs/log/doc/log.html.
+ */
+
+#ifndef BOOST_LOG_BINARY_LOG_FORMAT_HPP_INCLUDED_
+#define BOOST_LOG_BINARY_LOG_FORMAT_HPP_INCLUDED_
+
+#include <cstring>
+#include <string>
+#include <boost/cstdint.hpp>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/utility/binary_log_reader.hpp>
+#include <boost/log/detail/header.hpp>
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace aux {
+
+namespace binary_log_format {
+
+/*
+ * The binary log file starts with the header, which consists of the signature and the format version byte.
+ * The header is followed by a sequence of frames. Every frame starts with the frame kind byte, followed by
+ * the varint-encoded size of the frame payload and the payload itself.
+ *
+ * The dictionary frame payload is a sequence of entries, each consisting of the varint-encoded key,
+ * the value type byte, the varint-encoded attribute name length and the name characters. Dictionary entries
+ * are written before the first record that uses the key.
+ *
+ * The record frame payload is a sequence of attribute values, each consisting of the varint-encoded key
+ * followed by the encoded value:
+ *
+ * - booleans are encoded as a single byte;
+ * - unsigned integers, thread and process identifiers and severity levels are varint-encoded;
+ * - signed integers and durations are zigzag- and varint-encoded;
+ * - timestamps are encoded as the zigzag- and varint-encoded difference from the previous timestamp with the same key;
+ * - floating point numbers are encoded as 8 bytes of the IEEE 754 double precision number, least significant byte first;
+ * - strings, formatted values and the type names of unsupported values are encoded as the varint-encoded length
+ *   followed by the characters.
+ */
+
+//! Binary log file signature
+const char signature[4] = { 'B', 'L', 'O', 'G' };
+
+//! Format version
+enum { format_version = 1u };
+
+//! Frame kinds
+enum frame_kind
+{
+    dictionary_frame = 1u,
+    record_frame = 2u
+};
+
+//! Appends a varint-encoded integer to the buffer
+inline void put_varint(std::string& buf, uintmax_t n)
+{
+    while (n >= 0x80u)
+    {
+        buf.push_back(static_cast< char >((n & 0x7Fu) | 0x80u));
+        n >>= 7;
+    }
+    buf.push_back(static_cast< char >(n));
+}
+
+//! Decodes a varint-encoded integer. Returns \c false if the input ends before the integer does.
+inline bool get_varint(const unsigned char*& p, const unsigned char* end, uintmax_t& n)
+{
+    n = 0u;
+    for (unsigned int shift = 0u; p != end && shift < sizeof(uintmax_t) * 8u; shift += 7u)
+    {
+        const unsigned char c = *p++;
+        n |= static_cast< uintmax_t >(c & 0x7Fu) << shift;
+        if ((c & 0x80u) == 0u)
+            return true;
+    }
+    return false;
+}
+
+//! Maps signed integers to unsigned so that numbers with small absolute values have short varint encoding
+inline uintmax_t zigzag_encode(intmax_t n)
+{
+    return (static_cast< uintmax_t >(n) << 1) ^ static_cast< uintmax_t >(n >> (sizeof(intmax_t) * 8u - 1u));
+}
+
+//! Reverses \c zigzag_encode
+inline intmax_t zigzag_decode(uintmax_t n)
+{
+    return static_cast< intmax_t >(n >> 1) ^ -static_cast< intmax_t >(n & 1u);
+}
+
+//! Appends a floating point number to the buffer
+inline void put_double(std::string& buf, double value)
+{
+    uint64_t n;
+    std::memcpy(&n, &value, sizeof(n));
+    for (unsigned int i = 0u; i < sizeof(n); ++i, n >>= 8)
+        buf.push_back(static_cast< char >(n & 0xFFu));
+}
+
+//! Decodes a floating point number. Returns \c false if the input ends before the number does.
+inline bool get_double(const unsigned char*& p, const unsigned char* end, double& value)
+{
+    if (static_cast< std::size_t >(end - p) < sizeof(uint64_t))
+        return false;
+    uint64_t n = 0u;
+    for (unsigned int i = 0u; i < sizeof(n); ++i)
+        n |= static_cast< uint64_t >(p[i]) << (i * 8u);
+    p += sizeof(n);
+    std::memcpy(&value, &n, sizeof(n));
+    return true;
+}
+
+} // namespace binary_log_format
+
+} // namespace aux
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_BINARY_LOG_FORMAT_HPP_INCLUDED_
@@ -0,0 +1,389 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   binary_log_reader.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/libs/log/doc/log.html.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <boost/cstdint.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/date_time/gregorian/gregorian_types.hpp>
+#include <boost/log/exceptions.hpp>
+#include <boost/log/utility/binary_log_reader.hpp>
+#include <boost/log/detail/process_id.hpp>
+#if !defined(BOOST_LOG_NO_THREADS)
+#include <boost/log/detail/thread_id.hpp>
+#endif
+#include <boost/log/trivial.hpp>
+#include "binary_log_format.hpp"
+#include <boost/log/detail/header.hpp>
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace binary_log {
+
+namespace bin_format = boost::log::aux::binary_log_format;
+
+namespace {
+
+//! The function puts the number of microseconds in the form of HH:MM:SS.ffffff into the stream
+void put_time_of_day(std::ostream& strm, uintmax_t us)
+{
+    char buf[64];
+    std::sprintf(buf, "%02u:%02u:%02u.%06u",
+        static_cast< unsigned int >(us / 3600000000u),
+        static_cast< unsigned int >((us / 60000000u) % 60u),
+        static_cast< unsigned int >((us / 1000000u) % 60u),
+        static_cast< unsigned int >(us % 1000000u));
+    strm << buf;
+}
+
+//! The function puts the timestamp into the stream in the same format as the library uses by default
+void put_timestamp(std::ostream& strm, intmax_t timestamp)
+{
+    // Split the timestamp into days and the time of day, rounding towards the past
+    const intmax_t us_per_day = static_cast< intmax_t >(86400) * 1000000;
+    intmax_t days = timestamp / us_per_day, us = timestamp % us_per_day;
+    if (us < 0)
+    {
+        --days;
+        us += us_per_day;
+    }
+
+    const gregorian::date date = gregorian::date(1970, 1, 1) + gregorian::date_duration(static_cast< long >(days));
+    const gregorian::date::ymd_type ymd = date.year_month_day();
+    char buf[32];
+    std::sprintf(buf, "%04u-%02u-%02u ",
+        static_cast< unsigned int >(ymd.year),
+        static_cast< unsigned int >(ymd.month.as_number()),
+        static_cast< unsigned int >(ymd.day));
+    strm << buf;
+    put_time_of_day(strm, static_cast< uintmax_t >(us));
+}
+
+} // namespace
+
+//! The operator puts the attribute value into the stream
+BOOST_LOG_API std::ostream& operator<< (std::ostream& strm, field const& f)
+{
+    switch (f.type)
+    {
+    case boolean_type:
+    case unsigned_integer_type:
+        strm << f.uint_value;
+        break;
+
+    case signed_integer_type:
+        strm << f.int_value;
+        break;
+
+    case floating_point_type:
+        strm << f.float_value;
+        break;
+
+    case string_type:
+    case formatted_type:
+        strm << f.string_value;
+        break;
+
+    case unsupported_type:
+        strm << "[unsupported type: " << f.string_value << ']';
+        break;
+
+    case timestamp_type:
+        put_timestamp(strm, f.int_value);
+        break;
+
+    case duration_type:
+        if (f.int_value < 0)
+        {
+            strm << '-';
+            put_time_of_day(strm, static_cast< uintmax_t >(-f.int_value));
+        }
+        else
+        {
+            put_time_of_day(strm, static_cast< uintmax_t >(f.int_value));
+        }
+        break;
+
+    case thread_id_type:
+#if !defined(BOOST_LOG_NO_THREADS)
+        strm << boost::log::aux::thread::id(static_cast< boost::log::aux::thread::id::native_type >(f.uint_value));
+#else
+        strm << std::hex << std::showbase << f.uint_value << std::dec << std::noshowbase;
+#endif
+        break;
+
+    case process_id_type:
+        strm << boost::log::aux::process::id(static_cast< boost::log::aux::process::id::native_type >(f.uint_value));
+        break;
+
+    case severity_type:
+        if (f.uint_value <= static_cast< uintmax_t >(trivial::fatal))
+            strm << static_cast< trivial::severity_level >(f.uint_value);
+        else
+            strm << f.uint_value;
+        break;
+    }
+
+    return strm;
+}
+
+//! Reader implementation
+struct reader::implementation
+{
+    //! Dictionary entry
+    struct key_info
+    {
+        //! Attribute name
+        std::string m_Name;
+        //! Value type
+        value_type m_Type;
+        //! The last read timestamp, in microseconds
+        intmax_t m_LastTimestamp;
+        //! Indicates that the key was defined in the stream
+        bool m_Defined;
+
+        key_info() : m_Type(boolean_type), m_LastTimestamp(0), m_Defined(false) {}
+    };
+    //! The dictionary of the stream, indexed by keys
+    typedef std::vector< key_info > dictionary;
+
+    //! Input stream
+    std::istream& m_Stream;
+    //! Attribute keys
+    dictionary m_Dictionary;
+    //! Frame payload buffer
+    std::vector< unsigned char > m_Frame;
+
+    explicit implementation(std::istream& strm) : m_Stream(strm)
+    {
+    }
+
+    //! Reads the remaining part of the file header, after the first character of the signature
+    void read_header()
+    {
+        char buf[sizeof(bin_format::signature)];
+        m_Stream.read(buf, sizeof(buf) - 1u);
+        if (m_Stream.gcount() != static_cast< std::streamsize >(sizeof(buf) - 1u) || std::memcmp(buf, bin_format::signature + 1, sizeof(buf) - 1u) != 0)
+            BOOST_LOG_THROW_DESCR(parse_error, "The stream does not contain a binary log");
+
+        const int version = m_Stream.get();
+        if (version != static_cast< int >(bin_format::format_version))
+            BOOST_LOG_THROW_DESCR(parse_error, "Unsupported binary log format version");
+
+        m_Dictionary.clear();
+    }
+
+    //! Reads the next frame payload. Returns \c false if the stream ends before the frame does.
+    bool read_frame()
+    {
+        uintmax_t size = 0u;
+        for (unsigned int shift = 0u; true; shift += 7u)
+        {
+            const int c = m_Stream.get();
+            if (c == std::istream::traits_type::eof())
+                return false;
+            if (shift >= sizeof(uintmax_t) * 8u)
+                BOOST_LOG_THROW_DESCR(parse_error, "Invalid binary log frame size");
+            size |= static_cast< uintmax_t >(c & 0x7F) << shift;
+            if ((c & 0x80) == 0)
+                break;
+        }
+
+        if (size > static_cast< uintmax_t >(m_Frame.max_size()))
+            BOOST_LOG_THROW_DESCR(parse_error, "Invalid binary log frame size");
+
+        m_Frame.resize(static_cast< std::size_t >(size));
+        if (size > 0u)
+        {
+            m_Stream.read(reinterpret_cast< char* >(&m_Frame[0]), static_cast< std::streamsize >(size));
+            if (m_Stream.gcount() != static_cast< std::streamsize >(size))
+                return false;
+        }
+
+        return true;
+    }
+
+    //! Parses the dictionary frame
+    void parse_dictionary()
+    {
+        const unsigned char* p = m_Frame.empty() ? NULL : &m_Frame[0];
+        const unsigned char* const end = p + m_Frame.size();
+        while (p != end)
+        {
+            uintmax_t key = 0u, size = 0u;
+            if (!bin_format::get_varint(p, end, key) || p == end)
+                throw_corrupted();
+            const unsigned int type = *p++;
+            if (type < boolean_type || type > unsupported_type)
+                BOOST_LOG_THROW_DESCR(parse_error, "Unsupported attribute value type in binary log");
+            if (!bin_format::get_varint(p, end, size) || size > static_cast< uintmax_t >(end - p))
+                throw_corrupted();
+            // Keys are allocated sequentially, so the size of the dictionary cannot exceed the size of the file
+            if (key > m_Dictionary.size() + m_Frame.size())
+                throw_corrupted();
+
+            if (key >= m_Dictionary.size())
+                m_Dictionary.resize(static_cast< std::size_t >(key) + 1u);
+            key_info& info = m_Dictionary[static_cast< std::size_t >(key)];
+            info.m_Name.assign(reinterpret_cast< const char* >(p), static_cast< std::size_t >(size));
+            info.m_Type = static_cast< value_type >(type);
+            info.m_LastTimestamp = 0;
+            info.m_Defined = true;
+            p += size;
+        }
+    }
+
+    //! Parses the record frame
+    void parse_record(field_list& fields)
+    {
+        fields.clear();
+
+        const unsigned char* p = m_Frame.empty() ? NULL : &m_Frame[0];
+        const unsigned char* const end = p + m_Frame.size();
+        while (p != end)
+        {
+            uintmax_t key = 0u;
+            if (!bin_format::get_varint(p, end, key) || key >= m_Dictionary.size())
+                throw_corrupted();
+            key_info& info = m_Dictionary[static_cast< std::size_t >(key)];
+            if (!info.m_Defined)
+                throw_corrupted();
+
+            fields.push_back(field());
+            field& f = fields.back();
+            f.name = info.m_Name;
+            f.type = info.m_Type;
+
+            uintmax_t n = 0u;
+            switch (info.m_Type)
+            {
+            case boolean_type:
+                if (p == end)
+                    throw_corrupted();
+                f.uint_value = *p++ != 0u;
+                break;
+
+            case unsigned_integer_type:
+            case thread_id_type:
+            case process_id_type:
+            case severity_type:
+                if (!bin_format::get_varint(p, end, f.uint_value))
+                    throw_corrupted();
+                break;
+
+            case signed_integer_type:
+            case duration_type:
+                if (!bin_format::get_varint(p, end, n))
+                    throw_corrupted();
+                f.int_value = bin_format::zigzag_decode(n);
+                break;
+
+            case timestamp_type:
+                if (!bin_format::get_varint(p, end, n))
+                    throw_corrupted();
+                info.m_LastTimestamp += bin_format::zigzag_decode(n);
+                f.int_value = info.m_LastTimestamp;
+                break;
+
+            case floating_point_type:
+                if (!bin_format::get_double(p, end, f.float_value))
+                    throw_corrupted();
+                break;
+
+            case string_type:
+            case formatted_type:
+            case unsupported_type:
+                if (!bin_format::get_varint(p, end, n) || n > static_cast< uintmax_t >(end - p))
+                    throw_corrupted();
+                f.string_value.assign(reinterpret_cast< const char* >(p), static_cast< std::size_t >(n));
+                p += n;
+                break;
+            }
+        }
+    }
+
+    static void throw_corrupted()
+    {
+        BOOST_LOG_THROW_DESCR(parse_error, "The binary log is corrupted");
+    }
+};
+
+//! Constructor
+BOOST_LOG_API reader::reader(std::istream& strm) : m_pImpl(new implementation(strm))
+{
+    try
+    {
+        if (strm.get() != static_cast< int >(bin_format::signature[0]))
+            BOOST_LOG_THROW_DESCR(parse_error, "The stream does not contain a binary log");
+        m_pImpl->read_header();
+    }
+    catch (...)
+    {
+        delete m_pImpl;
+        throw;
+    }
+}
+
+//! Destructor
+BOOST_LOG_API reader::~reader()
+{
+    delete m_pImpl;
+}
+
+//! The method reads the next log record
+BOOST_LOG_API bool reader::read(field_list& fields)
+{
+    implementation* const impl = m_pImpl;
+    while (true)
+    {
+        const int kind = impl->m_Stream.get();
+        if (kind == std::istream::traits_type::eof())
+            return false;
+
+        switch (kind)
+        {
+        case bin_format::dictionary_frame:
+            if (!impl->read_frame())
+                return false;
+            impl->parse_dictionary();
+            break;
+
+        case bin_format::record_frame:
+            if (!impl->read_frame())
+                return false;
+            impl->parse_record(fields);
+            return true;
+
+        default:
+            // The header of the next log file, if several files were concatenated
+            if (kind != static_cast< int >(bin_format::signature[0]))
+                implementation::throw_corrupted();
+            impl->read_header();
+            break;
+        }
+    }
+}
+
+} // namespace binary_log
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
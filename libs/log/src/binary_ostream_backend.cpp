@@ -0,0 +1,392 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   binary_ostream_backend.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/libs/log/doc/log.html.
+ */
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <boost/cstdint.hpp>
+#include <boost/mpl/vector.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <boost/type_traits/is_signed.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/date_time/gregorian/gregorian_types.hpp>
+#include <boost/log/sinks/binary_ostream_backend.hpp>
+#include <boost/log/attributes/attribute_name.hpp>
+#include <boost/log/attributes/attribute_value.hpp>
+#include <boost/log/attributes/attribute_value_set.hpp>
+#include <boost/log/utility/string_literal.hpp>
+#include <boost/log/utility/type_dispatch/standard_types.hpp>
+#include <boost/log/utility/type_dispatch/static_type_dispatcher.hpp>
+#include <boost/log/detail/code_conversion.hpp>
+#include <boost/log/detail/process_id.hpp>
+#if !defined(BOOST_LOG_NO_THREADS)
+#include <boost/log/detail/thread_id.hpp>
+#endif
+#include <boost/log/trivial.hpp>
+#include "binary_log_format.hpp"
+#include <boost/log/detail/header.hpp>
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace sinks {
+
+namespace bin_format = aux::binary_log_format;
+
+//! Sink implementation
+struct binary_ostream_backend::implementation
+{
+    //! Dictionary entry
+    struct key_info
+    {
+        //! Value type
+        binary_log::value_type m_Type;
+        //! The key of the attribute name and value type in the stream
+        uint32_t m_Key;
+        //! The last written timestamp, in microseconds
+        intmax_t m_LastTimestamp;
+    };
+    //! Keys of the attribute name. There is usually only one, unless values of different types are logged with the same name.
+    typedef std::vector< key_info > key_list;
+    //! The dictionary of the stream, indexed by attribute name ids
+    typedef std::vector< key_list > dictionary;
+
+    //! Additional types supported by the backend
+    typedef mpl::vector<
+        posix_time::ptime,
+        posix_time::time_duration,
+        aux::process::id,
+#if !defined(BOOST_LOG_NO_THREADS)
+        aux::thread::id,
+#endif
+        trivial::severity_level
+    > extra_types;
+
+    //! The function object that encodes attribute values
+    struct encoder
+    {
+        typedef void result_type;
+
+        implementation& m_Impl;
+        attribute_name m_Name;
+
+        explicit encoder(implementation& impl) : m_Impl(impl) {}
+
+        void operator() (bool value) const
+        {
+            begin(binary_log::boolean_type);
+            m_Impl.m_Record.push_back(static_cast< char >(value));
+        }
+
+        template< typename T >
+        typename enable_if_c< is_integral< T >::value && is_signed< T >::value >::type operator() (T value) const
+        {
+            begin(binary_log::signed_integer_type);
+            bin_format::put_varint(m_Impl.m_Record, bin_format::zigzag_encode(static_cast< intmax_t >(value)));
+        }
+
+        template< typename T >
+        typename enable_if_c< is_integral< T >::value && !is_signed< T >::value >::type operator() (T value) const
+        {
+            begin(binary_log::unsigned_integer_type);
+            bin_format::put_varint(m_Impl.m_Record, static_cast< uintmax_t >(value));
+        }
+
+        void operator() (float value) const
+        {
+            put_double(static_cast< double >(value));
+        }
+        void operator() (double value) const
+        {
+            put_double(value);
+        }
+        void operator() (long double value) const
+        {
+            put_double(static_cast< double >(value));
+        }
+
+        void operator() (std::string const& value) const
+        {
+            put_string(value.data(), value.size());
+        }
+        void operator() (basic_string_literal< char > const& value) const
+        {
+            put_string(value.c_str(), value.size());
+        }
+        void operator() (std::wstring const& value) const
+        {
+            put_wstring(value.data(), value.size());
+        }
+        void operator() (basic_string_literal< wchar_t > const& value) const
+        {
+            put_wstring(value.c_str(), value.size());
+        }
+
+        void operator() (posix_time::ptime const& value) const
+        {
+            if (value.is_special())
+                return;
+
+            const intmax_t timestamp = static_cast< intmax_t >((value - posix_time::ptime(gregorian::date(1970, 1, 1))).total_microseconds());
+            key_info& info = begin(binary_log::timestamp_type);
+            bin_format::put_varint(m_Impl.m_Record, bin_format::zigzag_encode(timestamp - info.m_LastTimestamp));
+            info.m_LastTimestamp = timestamp;
+        }
+        void operator() (posix_time::time_duration const& value) const
+        {
+            if (value.is_special())
+                return;
+
+            begin(binary_log::duration_type);
+            bin_format::put_varint(m_Impl.m_Record, bin_format::zigzag_encode(static_cast< intmax_t >(value.total_microseconds())));
+        }
+
+        void operator() (aux::process::id const& value) const
+        {
+            begin(binary_log::process_id_type);
+            bin_format::put_varint(m_Impl.m_Record, static_cast< uintmax_t >(value.native_id()));
+        }
+#if !defined(BOOST_LOG_NO_THREADS)
+        void operator() (aux::thread::id const& value) const
+        {
+            begin(binary_log::thread_id_type);
+            bin_format::put_varint(m_Impl.m_Record, static_cast< uintmax_t >(value.native_id()));
+        }
+#endif
+        void operator() (trivial::severity_level value) const
+        {
+            begin(binary_log::severity_type);
+            bin_format::put_varint(m_Impl.m_Record, static_cast< uintmax_t >(value));
+        }
+
+    private:
+        //! Writes the key of the attribute value
+        key_info& begin(binary_log::value_type type) const
+        {
+            key_info& info = m_Impl.get_key(m_Name, type);
+            bin_format::put_varint(m_Impl.m_Record, info.m_Key);
+            return info;
+        }
+        void put_double(double value) const
+        {
+            begin(binary_log::floating_point_type);
+            bin_format::put_double(m_Impl.m_Record, value);
+        }
+        void put_string(const char* p, std::size_t size) const
+        {
+            begin(binary_log::string_type);
+            bin_format::put_varint(m_Impl.m_Record, size);
+            m_Impl.m_Record.append(p, size);
+        }
+        void put_wstring(const wchar_t* p, std::size_t size) const
+        {
+            std::string& str = m_Impl.m_ConversionBuffer;
+            str.clear();
+            aux::code_convert(p, size, str);
+            put_string(str.data(), str.size());
+        }
+    };
+
+    //! Output stream
+    shared_ptr< std::ostream > m_Stream;
+    //! Auto-flush flag
+    bool m_fAutoFlush;
+    //! Attribute keys
+    dictionary m_Dictionary;
+    //! The next key to be allocated
+    uint32_t m_NextKey;
+    //! Formatting functions of the registered types
+    std::vector< std::pair< type_info_wrapper, value_formatter > > m_FormattedTypes;
+    //! Dictionary entries of the keys allocated while encoding the current record
+    std::string m_NewKeys;
+    //! Encoded attribute values of the current record
+    std::string m_Record;
+    //! Output buffer
+    std::string m_Output;
+    //! Buffer for wide string conversion
+    std::string m_ConversionBuffer;
+
+    implementation() : m_fAutoFlush(false), m_NextKey(0u)
+    {
+    }
+
+    //! Returns the key for the attribute name and value type, allocates the key if needed
+    key_info& get_key(attribute_name const& name, binary_log::value_type type)
+    {
+        const attribute_name::id_type id = name.id();
+        if (id >= m_Dictionary.size())
+            m_Dictionary.resize(id + 1u);
+
+        key_list& keys = m_Dictionary[id];
+        for (key_list::iterator it = keys.begin(), end = keys.end(); it != end; ++it)
+        {
+            if (it->m_Type == type)
+                return *it;
+        }
+
+        key_info info = { type, m_NextKey++, 0 };
+        keys.push_back(info);
+
+        bin_format::put_varint(m_NewKeys, info.m_Key);
+        m_NewKeys.push_back(static_cast< char >(type));
+        std::string const& str = name.string();
+        bin_format::put_varint(m_NewKeys, str.size());
+        m_NewKeys.append(str);
+
+        return keys.back();
+    }
+
+    //! Writes the value of a type that is not supported by the encoder
+    void put_other_value(attribute_name const& name, attribute_value const& value)
+    {
+        const type_info_wrapper type = value.get_type();
+        for (std::size_t i = 0u, n = m_FormattedTypes.size(); i < n; ++i)
+        {
+            if (m_FormattedTypes[i].first == type)
+            {
+                std::string& str = m_ConversionBuffer;
+                str.clear();
+                m_FormattedTypes[i].second(value, str);
+                put_string(name, binary_log::formatted_type, str);
+                return;
+            }
+        }
+
+        put_string(name, binary_log::unsupported_type, type.pretty_name());
+    }
+
+    //! Writes the string with the specified value type
+    void put_string(attribute_name const& name, binary_log::value_type type, std::string const& str)
+    {
+        bin_format::put_varint(m_Record, get_key(name, type).m_Key);
+        bin_format::put_varint(m_Record, str.size());
+        m_Record.append(str);
+    }
+
+    //! Appends the frame to the output buffer
+    void put_frame(bin_format::frame_kind kind, std::string const& payload)
+    {
+        m_Output.push_back(static_cast< char >(kind));
+        bin_format::put_varint(m_Output, payload.size());
+        m_Output.append(payload);
+    }
+};
+
+
+//! Constructor
+BOOST_LOG_API binary_ostream_backend::binary_ostream_backend() : m_pImpl(new implementation())
+{
+}
+
+//! Destructor (just to make it link from the shared library)
+BOOST_LOG_API binary_ostream_backend::~binary_ostream_backend()
+{
+    delete m_pImpl;
+}
+
+//! The method attaches the stream to the sink
+BOOST_LOG_API void binary_ostream_backend::set_stream(shared_ptr< std::ostream > const& strm)
+{
+    m_pImpl->m_Stream = strm;
+    m_pImpl->m_Dictionary.clear();
+    m_pImpl->m_NextKey = 0u;
+
+    if (strm)
+    {
+        strm->write(bin_format::signature, sizeof(bin_format::signature));
+        strm->put(static_cast< char >(bin_format::format_version));
+    }
+}
+
+//! Sets the flag to automatically flush buffers after each logged record
+BOOST_LOG_API void binary_ostream_backend::auto_flush(bool f)
+{
+    m_pImpl->m_fAutoFlush = f;
+}
+
+//! The method writes the record to the sink
+BOOST_LOG_API void binary_ostream_backend::consume(record_view const& rec)
+{
+    implementation* const impl = m_pImpl;
+    if (!impl->m_Stream)
+        return;
+
+    impl->m_NewKeys.clear();
+    impl->m_Record.clear();
+    impl->m_Output.clear();
+
+    implementation::encoder enc(*impl);
+    static_type_dispatcher< default_attribute_types > default_disp(enc);
+    static_type_dispatcher< implementation::extra_types > extra_disp(enc);
+
+    attribute_value_set const& values = rec.attribute_values();
+    try
+    {
+        for (attribute_value_set::const_iterator it = values.begin(), end = values.end(); it != end; ++it)
+        {
+            enc.m_Name = it->first;
+            if (!it->second.dispatch(default_disp) && !it->second.dispatch(extra_disp))
+                impl->put_other_value(it->first, it->second);
+        }
+    }
+    catch (...)
+    {
+        // The keys allocated for this record will not be written to the stream. Start the dictionary anew,
+        // the reader will accept the keys being redefined.
+        impl->m_Dictionary.clear();
+        impl->m_NextKey = 0u;
+        throw;
+    }
+
+    if (!impl->m_NewKeys.empty())
+        impl->put_frame(bin_format::dictionary_frame, impl->m_NewKeys);
+    impl->put_frame(bin_format::record_frame, impl->m_Record);
+
+    impl->m_Stream->write(impl->m_Output.data(), static_cast< std::streamsize >(impl->m_Output.size()));
+    if (impl->m_fAutoFlush)
+        impl->m_Stream->flush();
+}
+
+//! The method registers the formatting function for the type
+BOOST_LOG_API void binary_ostream_backend::register_formatted_type(type_info_wrapper const& type, value_formatter formatter)
+{
+    std::vector< std::pair< type_info_wrapper, value_formatter > >& types = m_pImpl->m_FormattedTypes;
+    for (std::size_t i = 0u, n = types.size(); i < n; ++i)
+    {
+        if (types[i].first == type)
+        {
+            types[i].second = formatter;
+            return;
+        }
+    }
+    types.push_back(std::make_pair(type, formatter));
+}
+
+//! The method flushes the attached stream
+BOOST_LOG_API void binary_ostream_backend::flush()
+{
+    if (m_pImpl->m_Stream)
+        m_pImpl->m_Stream->flush();
+}
+
+} // namespace sinks
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
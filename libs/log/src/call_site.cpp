@@ -0,0 +1,283 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   call_site.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/libs/log/doc/log.html.
+ */
+
+#include <utility>
+#include <algorithm>
+#include <boost/cstdint.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/core/core.hpp>
+#include <boost/log/detail/timestamp.hpp>
+#include <boost/log/detail/call_site_limiter.hpp>
+#include <boost/log/attributes/call_site.hpp>
+
+#if !defined(BOOST_LOG_NO_THREADS)
+#include <boost/log/detail/locks.hpp>
+#include <boost/log/detail/spin_mutex.hpp>
+#if !defined(BOOST_LOG_USE_COMPILER_TLS)
+#include <memory>
+#include <boost/bind.hpp>
+#include <boost/checked_delete.hpp>
+#include <boost/thread/thread.hpp> // at_thread_exit
+#include <boost/log/detail/singleton.hpp>
+#include <boost/log/detail/thread_specific.hpp>
+#endif
+#endif
+#include <boost/log/detail/header.hpp>
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace aux {
+
+//! The flag indicates that the logging macros track call sites
+BOOST_LOG_API boost::atomic< bool > call_site_tracking_enabled(false);
+
+#if defined(BOOST_LOG_NO_THREADS)
+
+static call_site_context g_CallSiteContext = { NULL, false, NULL, 0u, 0u };
+
+#elif defined(BOOST_LOG_USE_COMPILER_TLS)
+
+static BOOST_LOG_TLS call_site_context g_CallSiteContext = { NULL, false, NULL, 0u, 0u };
+
+#else
+
+//! Call site context storage class
+class call_site_context_holder :
+    public lazy_singleton< call_site_context_holder, thread_specific< call_site_context* > >
+{
+};
+
+#endif
+
+
+#if !defined(BOOST_LOG_NO_THREADS) && !defined(BOOST_LOG_USE_COMPILER_TLS)
+
+//! The function returns the call site tracking state of the current thread
+BOOST_LOG_API call_site_context& get_call_site_context()
+{
+    thread_specific< call_site_context* >& tss = call_site_context_holder::get();
+    call_site_context* p = tss.get();
+    if (!p)
+    {
+        std::auto_ptr< call_site_context > ptr(new call_site_context());
+        ptr->m_pCurrent = NULL;
+        ptr->m_fSummary = false;
+        ptr->m_pSuppressedFileName = NULL;
+        ptr->m_SuppressedLine = 0u;
+        ptr->m_SuppressedCount = 0u;
+        tss.set(ptr.get());
+        p = ptr.release();
+        boost::this_thread::at_thread_exit(boost::bind(checked_deleter< call_site_context >(), p));
+    }
+    return *p;
+}
+
+#else // !defined(BOOST_LOG_NO_THREADS) && !defined(BOOST_LOG_USE_COMPILER_TLS)
+
+//! The function returns the call site tracking state of the current thread
+BOOST_LOG_API call_site_context& get_call_site_context()
+{
+    return g_CallSiteContext;
+}
+
+#endif // !defined(BOOST_LOG_NO_THREADS) && !defined(BOOST_LOG_USE_COMPILER_TLS)
+
+//! Call site limiter implementation
+struct call_site_limiter::implementation
+{
+    //! Counters of a call site
+    struct site_state
+    {
+        //! Token bucket strategy: the number of available tokens, multiplied by the period
+        uint64_t m_Tokens;
+        //! Token bucket strategy: the time of the last token bucket refill
+        uint64_t m_LastRefill;
+        //! Sampling strategy: the number of records made at the call site
+        uintmax_t m_Counter;
+        //! The number of suppressed records that were not reported yet
+        uintmax_t m_Suppressed;
+        //! The time when the suppressed records were last reported
+        uint64_t m_LastReport;
+    };
+
+    //! Counters of call sites
+    typedef unordered_map< call_site, site_state, boost::hash< call_site > > site_map;
+
+    //! A partition of call site counters
+    struct partition
+    {
+#if !defined(BOOST_LOG_NO_THREADS)
+        //! The mutex protects the counters in the partition
+        spin_mutex m_Mutex;
+#endif
+        //! Call site counters
+        site_map m_Sites;
+    };
+
+    //! The number of partitions
+    enum { partition_count = 32u };
+
+    //! Limiting strategy
+    const strategy m_Strategy;
+    //! The number of records per period or the sampling ratio
+    const uintmax_t m_Count;
+    //! The period, in milliseconds
+    const uint64_t m_Period;
+    //! The time point the limiter was created at
+    const timestamp m_Start;
+    //! Call site counter partitions
+    partition m_Partitions[partition_count];
+
+    implementation(strategy strat, uintmax_t count, uint64_t period) :
+        m_Strategy(strat),
+        m_Count(count > 0u ? count : 1u),
+        m_Period(period > 0u ? period : 1u),
+        m_Start(get_timestamp())
+    {
+    }
+
+    //! Returns the partition of the call site
+    partition& get_partition(call_site const& site)
+    {
+        return m_Partitions[hash_value(site) % partition_count];
+    }
+
+    //! Returns the number of milliseconds since the limiter was created
+    uint64_t now() const
+    {
+        return static_cast< uint64_t >((get_timestamp() - m_Start).milliseconds());
+    }
+
+    //! Updates the token bucket of the call site
+    bool consume_token(site_state& state, uint64_t time)
+    {
+        // Every millisecond adds m_Count tokens to the bucket, and every record takes m_Period tokens.
+        // The bucket holds no more than m_Count records.
+        const uint64_t elapsed = time - state.m_LastRefill;
+        const uint64_t capacity = static_cast< uint64_t >(m_Count) * m_Period;
+        if (elapsed >= m_Period)
+            state.m_Tokens = capacity;
+        else
+            state.m_Tokens = (std::min)(capacity, state.m_Tokens + elapsed * m_Count);
+        state.m_LastRefill = time;
+
+        if (state.m_Tokens >= m_Period)
+        {
+            state.m_Tokens -= m_Period;
+            return true;
+        }
+
+        return false;
+    }
+
+    /*!
+     * Saves the number of suppressed records to be reported by the logging macro, if the reporting period has expired.
+     * The report is made by the logging macro at the call site, with the logger and the named arguments used at the call site.
+     */
+    void report_suppressed(call_site const& site, site_state& state, uint64_t time)
+    {
+        if (state.m_Suppressed > 0u && time - state.m_LastReport >= m_Period)
+        {
+            call_site_context& context = get_call_site_context();
+            if (context.m_SuppressedCount == 0u)
+            {
+                context.m_pSuppressedFileName = site.file_name();
+                context.m_SuppressedLine = site.line();
+                context.m_SuppressedCount = state.m_Suppressed;
+                state.m_Suppressed = 0u;
+                state.m_LastReport = time;
+            }
+        }
+    }
+
+    //! Updates the counters of the call site
+    bool check_site(call_site const& site)
+    {
+        partition& part = get_partition(site);
+
+        BOOST_LOG_EXPR_IF_MT(exclusive_lock_guard< spin_mutex > lock(part.m_Mutex);)
+
+        std::pair< site_map::iterator, bool > res =
+            part.m_Sites.insert(site_map::value_type(site, site_state()));
+        site_state& state = res.first->second;
+
+        const uint64_t time = now();
+        if (res.second)
+        {
+            state.m_Tokens = static_cast< uint64_t >(m_Count) * m_Period;
+            state.m_LastRefill = time;
+            state.m_Counter = 0u;
+            state.m_Suppressed = 0u;
+            state.m_LastReport = time;
+        }
+
+        bool passed;
+        if (m_Strategy == call_site_limiter::token_bucket)
+            passed = consume_token(state, time);
+        else
+            passed = (state.m_Counter++ % m_Count) == 0u;
+
+        if (!passed)
+            ++state.m_Suppressed;
+
+        // The suppressed records are reported at the next check at the call site after the period expires, whether the record passes or not
+        report_suppressed(site, state, time);
+
+        return passed;
+    }
+};
+
+//! Constructor
+BOOST_LOG_API call_site_limiter::call_site_limiter(strategy strat, uintmax_t count, uint64_t period) :
+    m_pImpl(new implementation(strat, count, period))
+{
+    // Suppressed records are reported by the logging macros through the call site context
+    enable_call_site_tracking();
+}
+
+//! Destructor
+BOOST_LOG_API call_site_limiter::~call_site_limiter()
+{
+    delete m_pImpl;
+}
+
+//! The method updates the counters of the call site
+BOOST_LOG_API bool call_site_limiter::check(call_site const& site)
+{
+    // Reports of the suppressed records always pass
+    if (get_call_site_context().m_fSummary)
+        return true;
+
+    return m_pImpl->check_site(site);
+}
+
+//! The function registers the call site attribute in the global attribute set
+BOOST_LOG_API void register_call_site_attribute(attribute_name const& name)
+{
+    // If an attribute with this name is already registered, it is left intact
+    core::get()->add_global_attribute(name, attributes::current_call_site());
+}
+
+} // namespace aux
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
@@ -0,0 +1,83 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   channel_feature.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/libs/log/doc/log.html.
+ */
+
+#include <boost/log/detail/config.hpp>
+#include <boost/log/sources/channel_feature.hpp>
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+#if !defined(BOOST_LOG_USE_COMPILER_TLS)
+#include <boost/log/detail/singleton.hpp>
+#include <boost/log/detail/thread_specific.hpp>
+#endif
+#include <boost/log/detail/header.hpp>
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace sources {
+
+namespace aux {
+
+#if defined(BOOST_LOG_USE_COMPILER_TLS)
+
+static BOOST_LOG_TLS channel_override* g_pChannelOverride = NULL;
+
+//! The function returns the channel override of the record being opened in the current thread
+BOOST_LOG_API channel_override* get_channel_override()
+{
+    return g_pChannelOverride;
+}
+
+//! The function sets the channel override of the record being opened in the current thread
+BOOST_LOG_API void set_channel_override(channel_override* p)
+{
+    g_pChannelOverride = p;
+}
+
+#else // defined(BOOST_LOG_USE_COMPILER_TLS)
+
+//! Channel override storage class
+class channel_override_holder :
+    public boost::log::aux::lazy_singleton< channel_override_holder, boost::log::aux::thread_specific< channel_override* > >
+{
+};
+
+//! The function returns the channel override of the record being opened in the current thread
+BOOST_LOG_API channel_override* get_channel_override()
+{
+    return channel_override_holder::get().get();
+}
+
+//! The function sets the channel override of the record being opened in the current thread
+BOOST_LOG_API void set_channel_override(channel_override* p)
+{
+    channel_override_holder::get().set(p);
+}
+
+#endif // defined(BOOST_LOG_USE_COMPILER_TLS)
+
+} // namespace aux
+
+} // namespace sources
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
@@ -133,6 +133,8 @@ public:
 
     //! Returns the flag indicating whether it is needed to detach the record from the current thread
     bool is_detach_from_thread_needed() const BOOST_NOEXCEPT { return m_detach_from_thread_needed; }
+    //! Requests detaching the record from the current thread
+    void require_detach_from_thread() BOOST_NOEXCEPT { m_detach_from_thread_needed = true; }
 
     BOOST_LOG_DELETED_FUNCTION(private_data(private_data const&))
     BOOST_LOG_DELETED_FUNCTION(private_data& operator= (private_data const&))
@@ -179,6 +181,16 @@ BOOST_LOG_API record_view record::lock()
     return record_view(impl);
 }
 
+namespace aux {
+
+//! Creates a log record view with the specified attribute values. The record view is not bound to any sinks.
+BOOST_LOG_API record_view make_record_view(BOOST_RV_REF(attribute_value_set) values)
+{
+    return record_view(record_view::private_data::create(boost::move(values), 0u));
+}
+
+} // namespace aux
+
 //! Logging system implementation
 struct core::implementation :
     public log::aux::lazy_singleton<
@@ -284,9 +296,46 @@ public:
         }
     }
 
+    //! Checks if the source attributes refer to the storage of scoped attribute guards
+    static bool has_scoped_values(attribute_set const& source_attributes)
+    {
+        return source_attributes.has_scoped_values();
+    }
+    //! Checks if the source attributes refer to the storage of scoped attribute guards
+    static bool has_scoped_values(attribute_value_set const&)
+    {
+        return false;
+    }
+
+    //! The function object does not attach any record-specific values
+    struct no_source_value
+    {
+        void operator() (attribute_value_set&) const {}
+    };
+    //! The function object attaches a record-specific value
+    struct source_value
+    {
+        attribute_name const& m_Name;
+        attribute_value const& m_Value;
+
+        source_value(attribute_name const& name, attribute_value const& value) : m_Name(name), m_Value(value) {}
+        void operator() (attribute_value_set& values) const
+        {
+            // The value is inserted before any attribute values are acquired, so it takes precedence over the attributes with the same name
+            values.insert(m_Name, m_Value);
+        }
+    };
+
     //! Opens a record
     template< typename SourceAttributesT >
     BOOST_LOG_FORCEINLINE record open_record(BOOST_FWD_REF(SourceAttributesT) source_attributes)
+    {
+        return open_record(boost::forward< SourceAttributesT >(source_attributes), no_source_value());
+    }
+
+    //! Opens a record
+    template< typename SourceAttributesT, typename SourceValueT >
+    BOOST_LOG_FORCEINLINE record open_record(BOOST_FWD_REF(SourceAttributesT) source_attributes, SourceValueT const& source_value)
     {
         // Try a quick win first
         if (m_enabled) try
@@ -298,8 +347,13 @@ public:
 
             if (m_enabled)
             {
+                // The values of scoped attributes refer to the storage of the scope guards and must be detached
+                // when the record is locked, in case if the record outlives the scope
+                const bool scoped_values = has_scoped_values(source_attributes) || tsd->m_thread_attributes.has_scoped_values();
+
                 // Compose a view of attribute values (unfrozen, yet)
                 attribute_value_set attr_values(boost::forward< SourceAttributesT >(source_attributes), tsd->m_thread_attributes, m_global_attributes);
+                source_value(attr_values);
                 if (m_filter(attr_values))
                 {
                     // The global filter passed, trying the sinks
@@ -331,6 +385,9 @@ public:
                     // Some sinks have accepted the record
                     values->freeze();
 
+                    if (rec_impl && scoped_values)
+                        rec_impl->require_detach_from_thread();
+
                     return boost::move(rec);
                 }
             }
@@ -511,6 +568,21 @@ BOOST_LOG_API void core::remove_thread_attribute(attribute_set::iterator it)
     p->m_thread_attributes.erase(it);
 }
 
+//! The method links the node owned by a scoped attribute guard into the thread-specific attribute set
+BOOST_LOG_API std::pair< attribute_set::iterator, bool >
+core::add_thread_attribute(attribute_set::external_node& n)
+{
+    implementation::thread_data* p = m_impl->get_thread_data();
+    return p->m_thread_attributes.insert_external(n);
+}
+
+//! The method unlinks the node owned by a scoped attribute guard from the thread-specific attribute set
+BOOST_LOG_API void core::remove_thread_attribute(attribute_set::external_node& n)
+{
+    implementation::thread_data* p = m_impl->get_thread_data();
+    p->m_thread_attributes.erase_external(n);
+}
+
 //! The method returns the complete set of currently registered thread-specific attributes
 BOOST_LOG_API attribute_set core::get_thread_attributes() const
 {
@@ -578,6 +650,12 @@ BOOST_LOG_API record core::open_record(attribute_set const& source_attributes)
     return m_impl->open_record(source_attributes);
 }
 
+//! The method attempts to open a new record to be written
+BOOST_LOG_API record core::open_record(attribute_set const& source_attributes, attribute_name const& name, attribute_value const& value)
+{
+    return m_impl->open_record(source_attributes, implementation::source_value(name, value));
+}
+
 //! The method attempts to open a new record to be written
 BOOST_LOG_API record core::open_record(attribute_value_set const& source_attributes)
 {
@@ -48,6 +48,10 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
         const attribute_name timestamp;
         const attribute_name process_id;
         const attribute_name thread_id;
+        const attribute_name call_site;
+        const attribute_name repeat_count;
+        const attribute_name first_timestamp;
+        const attribute_name last_timestamp;
 
     private:
         names() :
@@ -57,7 +61,11 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
             line_id("LineID"),
             timestamp("TimeStamp"),
             process_id("ProcessID"),
-            thread_id("ThreadID")
+            thread_id("ThreadID"),
+            call_site("CallSite"),
+            repeat_count("RepeatCount"),
+            first_timestamp("FirstTimeStamp"),
+            last_timestamp("LastTimeStamp")
         {
         }
 
@@ -110,6 +118,26 @@ BOOST_LOG_API attribute_name thread_id()
     return names::get().thread_id;
 }
 
+BOOST_LOG_API attribute_name call_site()
+{
+    return names::get().call_site;
+}
+
+BOOST_LOG_API attribute_name repeat_count()
+{
+    return names::get().repeat_count;
+}
+
+BOOST_LOG_API attribute_name first_timestamp()
+{
+    return names::get().first_timestamp;
+}
+
+BOOST_LOG_API attribute_name last_timestamp()
+{
+    return names::get().last_timestamp;
+}
+
 } // namespace default_attribute_names
 
 } // namespace aux
@@ -14,6 +14,7 @@
  */
 
 #include <string>
+#include <boost/cstdint.hpp>
 #include <boost/move/core.hpp>
 #include <boost/move/utility.hpp>
 #include <boost/spirit/include/qi_core.hpp>
@@ -22,6 +23,7 @@
 #include <boost/log/exceptions.hpp>
 #include <boost/log/attributes/value_visitation.hpp>
 #include <boost/log/expressions/predicates/has_attr.hpp>
+#include <boost/log/expressions/predicates/rate_limit.hpp>
 #include <boost/log/utility/type_dispatch/standard_types.hpp>
 #include <boost/log/utility/string_literal.hpp>
 #include <boost/log/utility/functional/logical.hpp>
@@ -327,6 +329,48 @@ filter default_filter_factory< CharT >::on_greater_or_equal_relation(attribute_n
     return parse_argument< greater_equal >(name, arg);
 }
 
+BOOST_LOG_ANONYMOUS_NAMESPACE {
+
+//! The function parses the rate limit in form "count[/[number]unit]", where unit is one of "ms", "s", "min" or "h"
+template< typename CharT >
+void parse_rate_limit(std::basic_string< CharT > const& arg, uintmax_t& count, uint64_t& period)
+{
+    const CharT* p = arg.c_str();
+    const CharT* const end = p + arg.size();
+    bool result = qi::parse(p, end, qi::uint_parser< uintmax_t >(), count) && count > 0u;
+
+    period = 1000u;
+    if (result && p != end)
+    {
+        result = false;
+        if (*p == static_cast< CharT >('/'))
+        {
+            ++p;
+            uint64_t number = 1u;
+            qi::parse(p, end, qi::uint_parser< uint64_t >(), number);
+
+            const std::string unit = log::aux::to_narrow(std::basic_string< CharT >(p, end));
+            uint64_t multiplier = 0u;
+            if (unit == "ms")
+                multiplier = 1u;
+            else if (unit == "s")
+                multiplier = 1000u;
+            else if (unit == "min")
+                multiplier = 60u * 1000u;
+            else if (unit == "h")
+                multiplier = 60u * 60u * 1000u;
+
+            period = number * multiplier;
+            result = period > 0u;
+        }
+    }
+
+    if (!result)
+        BOOST_LOG_THROW_DESCR(parse_error, "Failed to parse the rate limit \"" + log::aux::to_narrow(arg) + "\"");
+}
+
+} // namespace
+
 //! The callback for custom relation filter
 template< typename CharT >
 filter default_filter_factory< CharT >::on_custom_relation(attribute_name const& name, string_type const& rel, string_type const& arg)
@@ -342,6 +386,22 @@ filter default_filter_factory< CharT >::on_custom_relation(attribute_name const&
         on_string_argument< contains_fun >(name, f)(arg);
     else if (rel == constants::matches_keyword())
         on_regex_argument< matches_fun >(name, f)(arg);
+    else if (rel == constants::rate_limit_keyword())
+    {
+        uintmax_t count = 0u;
+        uint64_t period = 0u;
+        parse_rate_limit(arg, count, period);
+        f = expressions::rate_limiter(name, count, posix_time::milliseconds(period));
+    }
+    else if (rel == constants::sample_keyword())
+    {
+        uintmax_t ratio = 0u;
+        const char_type* p = arg.c_str();
+        const char_type* const end = p + arg.size();
+        if (!qi::parse(p, end, qi::uint_parser< uintmax_t >() >> qi::eoi, ratio) || ratio == 0u)
+            BOOST_LOG_THROW_DESCR(parse_error, "Failed to parse the sampling ratio \"" + log::aux::to_narrow(arg) + "\"");
+        f = expressions::sampler(name, ratio, posix_time::seconds(1));
+    }
     else
     {
         BOOST_LOG_THROW_DESCR(parse_error, "The custom attribute relation \"" + log::aux::to_narrow(rel) + "\" is not supported");
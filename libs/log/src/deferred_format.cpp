@@ -0,0 +1,245 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   deferred_format.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/libs/log/doc/log.html.
+ */
+
+#include <new>
+#include <map>
+#include <memory>
+#include <cstring>
+#include <utility>
+#include <boost/log/sources/deferred_format.hpp>
+#include <boost/log/detail/format.hpp>
+#include <boost/log/detail/singleton.hpp>
+#if !defined(BOOST_LOG_NO_THREADS)
+#include <boost/log/detail/locks.hpp>
+#include <boost/log/detail/light_rw_mutex.hpp>
+#include <boost/thread/tss.hpp>
+#endif
+#include <boost/log/detail/header.hpp>
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace aux {
+
+BOOST_LOG_ANONYMOUS_NAMESPACE {
+
+/*!
+ * The cache of parsed format strings. The format strings are identified by their addresses. The deferred formatting macros
+ * only accept string literals, so the number of the cached strings is limited and the addresses are never reused.
+ */
+template< typename CharT >
+struct deferred_format_cache :
+    public lazy_singleton< deferred_format_cache< CharT > >
+{
+    //! Format description type
+    typedef format_description< CharT > format_description_type;
+    //! The type of the map of the parsed format strings
+    typedef std::map< const CharT*, format_description_type > format_map;
+
+#if !defined(BOOST_LOG_NO_THREADS)
+    //! Synchronization primitive
+    light_rw_mutex m_Mutex;
+#endif
+    //! Parsed format strings
+    format_map m_Formats;
+
+    //! Returns the parsed format string
+    format_description_type const& get_format(const CharT* fmt)
+    {
+        {
+            BOOST_LOG_EXPR_IF_MT(shared_lock_guard< light_rw_mutex > lock(m_Mutex);)
+            typename format_map::const_iterator it = m_Formats.find(fmt);
+            if (it != m_Formats.end())
+                return it->second;
+        }
+
+        // Parse the format string outside the lock. The map elements are never removed, so the reference stays valid.
+        format_description_type descr = parse_format(fmt);
+
+        BOOST_LOG_EXPR_IF_MT(exclusive_lock_guard< light_rw_mutex > lock(m_Mutex);)
+        return m_Formats.insert(typename format_map::value_type(fmt, boost::move(descr))).first->second;
+    }
+};
+
+//! The stream that is used to compose messages in the current thread
+template< typename CharT >
+struct compose_stream
+{
+    //! Stream type
+    typedef basic_formatting_ostream< CharT > stream_type;
+
+    stream_type m_Stream;
+    //! The flag indicates that the stream is being used to compose a message
+    bool m_InUse;
+
+    compose_stream() : m_InUse(false) {}
+};
+
+//! The thread-specific storage of the streams used to compose messages
+template< typename CharT >
+class compose_stream_storage :
+    public lazy_singleton<
+        compose_stream_storage< CharT >,
+#if !defined(BOOST_LOG_NO_THREADS)
+        thread_specific_ptr< compose_stream< CharT > >
+#else
+        std::auto_ptr< compose_stream< CharT > >
+#endif
+    >
+{
+    //! Self type
+    typedef compose_stream_storage< CharT > this_type;
+#if !defined(BOOST_LOG_NO_THREADS)
+    //! Thread-specific pointer type
+    typedef thread_specific_ptr< compose_stream< CharT > > tls_ptr_type;
+#else
+    //! Thread-specific pointer type
+    typedef std::auto_ptr< compose_stream< CharT > > tls_ptr_type;
+#endif
+    //! Singleton base type
+    typedef lazy_singleton< this_type, tls_ptr_type > base_type;
+
+public:
+    //! The method returns the stream for the current thread
+    static compose_stream< CharT >& get_stream()
+    {
+        tls_ptr_type& ptr = base_type::get();
+        compose_stream< CharT >* p = ptr.get();
+        if (!p)
+        {
+            std::auto_ptr< compose_stream< CharT > > pNew(new compose_stream< CharT >());
+            ptr.reset(pNew.get());
+            p = pNew.release();
+        }
+        return *p;
+    }
+};
+
+//! The guard marks the stream as being used and detaches it from the message on destruction
+template< typename CharT >
+class compose_stream_guard
+{
+    compose_stream< CharT >& m_Stream;
+
+public:
+    compose_stream_guard(compose_stream< CharT >& strm, std::basic_string< CharT >& str) : m_Stream(strm)
+    {
+        m_Stream.m_Stream.attach(str);
+        m_Stream.m_InUse = true;
+    }
+    ~compose_stream_guard()
+    {
+        m_Stream.m_Stream.detach();
+        m_Stream.m_InUse = false;
+    }
+
+private:
+    compose_stream_guard(compose_stream_guard const&);
+    compose_stream_guard& operator= (compose_stream_guard const&);
+};
+
+} // namespace
+
+//! Composes the message from the format string and the captured arguments
+template< typename CharT >
+BOOST_LOG_API void deferred_message_impl< CharT >::compose(string_type& message) const
+{
+    typedef deferred_format_cache< char_type > format_cache;
+    typename format_cache::format_description_type const& descr = format_cache::get().get_format(m_pFormat);
+
+    // Constructing a stream is expensive, so a thread-specific stream is reused. A new stream is only created
+    // if the message is composed while another message is being composed in the same thread, which may happen if
+    // an argument output operator writes logs.
+    compose_stream< char_type >& cached_strm = compose_stream_storage< char_type >::get_stream();
+    if (cached_strm.m_InUse)
+    {
+        stream_type strm(message);
+        compose(descr, strm);
+    }
+    else
+    {
+        compose_stream_guard< char_type > guard(cached_strm, message);
+        compose(descr, cached_strm.m_Stream);
+    }
+}
+
+//! Composes the message in the specified stream
+template< typename CharT >
+BOOST_LOG_API void deferred_message_impl< CharT >::compose(format_description< char_type > const& descr, stream_type& strm) const
+{
+    typename format_description< char_type >::format_element_list::const_iterator
+        it = descr.format_elements.begin(), end = descr.format_elements.end();
+    for (; it != end; ++it)
+    {
+        if (it->arg_number >= 0)
+        {
+            // This is a placeholder, find the captured argument. The placeholders without arguments produce no output.
+            const unsigned char* p = m_pArgs;
+            const unsigned char* const args_end = m_pArgs + m_ArgsSize;
+            for (int n = it->arg_number; n > 0 && p != args_end; --n)
+            {
+                const argument_header* header = reinterpret_cast< const argument_header* >(p);
+                p += sizeof(argument_header) + ((header->size + argument_alignment - 1u) & ~static_cast< std::size_t >(argument_alignment - 1u));
+            }
+
+            if (p != args_end)
+            {
+                const argument_header* header = reinterpret_cast< const argument_header* >(p);
+                header->output(strm, header + 1, header->size);
+            }
+        }
+        else
+        {
+            // This is a literal
+            strm.write(descr.literal_chars.c_str() + it->literal_start_pos, static_cast< std::streamsize >(it->literal_len));
+        }
+    }
+
+    strm.flush();
+}
+
+//! Extends the storage of the captured arguments
+template< typename CharT >
+BOOST_LOG_API void deferred_message_impl< CharT >::reserve(std::size_t size)
+{
+    std::size_t capacity = m_ArgsCapacity * 2u;
+    if (capacity < size)
+        capacity = size;
+
+    unsigned char* p = static_cast< unsigned char* >(::operator new(capacity));
+    std::memcpy(p, m_pArgs, m_ArgsSize);
+    if (m_pArgs != reinterpret_cast< unsigned char* >(&m_Buffer))
+        ::operator delete(m_pArgs);
+
+    m_pArgs = p;
+    m_ArgsCapacity = capacity;
+}
+
+//! Explicitly instantiate deferred_message_impl implementation
+#ifdef BOOST_LOG_USE_CHAR
+template class deferred_message_impl< char >;
+#endif
+#ifdef BOOST_LOG_USE_WCHAR_T
+template class deferred_message_impl< wchar_t >;
+#endif
+
+} // namespace aux
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
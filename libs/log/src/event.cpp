@@ -21,6 +21,8 @@
 #include <boost/throw_exception.hpp>
 #include <boost/system/error_code.hpp>
 #include <boost/system/system_error.hpp>
+#include <boost/date_time/gregorian/gregorian_types.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <boost/log/detail/event.hpp>
 
 #if defined(BOOST_LOG_EVENT_USE_POSIX_SEMAPHORE)
@@ -31,6 +33,7 @@
 #else
 #error Boost.Log internal error: BOOST_LOG_EVENT_USE_POSIX_SEMAPHORE must only be defined when atomic ops are available
 #endif
+#include <time.h>
 #include <errno.h>
 #include <semaphore.h>
 
@@ -39,6 +42,7 @@
 #include "windows_version.hpp"
 #include <windows.h>
 #include <boost/detail/interlocked.hpp>
+#include <boost/thread/thread_time.hpp>
 
 #else
 
@@ -91,6 +95,35 @@ BOOST_LOG_API void sem_based_event::wait()
     BOOST_LOG_EVENT_RESET(m_state);
 }
 
+//! Waits for the object to become signalled until the deadline
+BOOST_LOG_API bool sem_based_event::timed_wait(posix_time::ptime const& deadline)
+{
+    // sem_timedwait accepts the absolute time of the system clock
+    const posix_time::time_duration since_epoch = deadline - posix_time::ptime(gregorian::date(1970, 1, 1));
+    timespec abs_time;
+    abs_time.tv_sec = static_cast< time_t >(since_epoch.total_seconds());
+    abs_time.tv_nsec = static_cast< long >(since_epoch.fractional_seconds() * (1000000000 / posix_time::time_duration::ticks_per_second()));
+
+    while (true)
+    {
+        if (sem_timedwait(&m_semaphore, &abs_time) != 0)
+        {
+            const int err = errno;
+            if (err == ETIMEDOUT)
+                return false;
+            if (err != EINTR)
+            {
+                BOOST_THROW_EXCEPTION(system::system_error(
+                    err, system::system_category(), "Failed to block on the semaphore"));
+            }
+        }
+        else
+            break;
+    }
+    BOOST_LOG_EVENT_RESET(m_state);
+    return true;
+}
+
 //! Sets the object to a signalled state
 BOOST_LOG_API void sem_based_event::set_signalled()
 {
@@ -140,6 +173,26 @@ BOOST_LOG_API void winapi_based_event::wait()
     const_cast< volatile boost::uint32_t& >(m_state) = 0;
 }
 
+//! Waits for the object to become signalled until the deadline
+BOOST_LOG_API bool winapi_based_event::timed_wait(posix_time::ptime const& deadline)
+{
+    if (const_cast< volatile boost::uint32_t& >(m_state) == 0)
+    {
+        const posix_time::ptime now = boost::get_system_time();
+        const DWORD timeout = deadline > now ? static_cast< DWORD >((deadline - now).total_milliseconds()) : 0u;
+        const DWORD res = WaitForSingleObject(m_event, timeout);
+        if (res == WAIT_TIMEOUT)
+            return false;
+        else if (res != 0)
+        {
+            BOOST_THROW_EXCEPTION(system::system_error(
+                GetLastError(), system::system_category(), "Failed to block on Windows event"));
+        }
+    }
+    const_cast< volatile boost::uint32_t& >(m_state) = 0;
+    return true;
+}
+
 //! Sets the object to a signalled state
 BOOST_LOG_API void winapi_based_event::set_signalled()
 {
@@ -177,6 +230,23 @@ BOOST_LOG_API void generic_event::wait()
     m_state = false;
 }
 
+//! Waits for the object to become signalled until the deadline
+BOOST_LOG_API bool generic_event::timed_wait(posix_time::ptime const& deadline)
+{
+    boost::unique_lock< boost::mutex > lock(m_mutex);
+    while (!m_state)
+    {
+        if (!m_cond.timed_wait(lock, deadline))
+        {
+            if (!m_state)
+                return false;
+            break;
+        }
+    }
+    m_state = false;
+    return true;
+}
+
 //! Sets the object to a signalled state
 BOOST_LOG_API void generic_event::set_signalled()
 {
@@ -0,0 +1,562 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   file_stream.hpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/libs/log/doc/log.html.
+ *
+ * The header contains an output file stream that writes directly to a file descriptor. Unlike
+ * the standard file streams, the stream allows to write a sequence of buffers with a single
+ * gather operation and provides access to the underlying file descriptor. On POSIX systems
+ * the stream can also write to the file through a memory mapping.
+ */
+
+#ifndef BOOST_LOG_FILE_STREAM_HPP_INCLUDED_
+#define BOOST_LOG_FILE_STREAM_HPP_INCLUDED_
+
+#include <cstddef>
+#include <ios>
+#include <ostream>
+#include <streambuf>
+#include <boost/cstdint.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/log/detail/config.hpp>
+
+#if defined(BOOST_WINDOWS_API)
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <limits.h>
+#include <sys/uio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include <boost/log/detail/header.hpp>
+
+#ifdef BOOST_LOG_HAS_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace aux {
+
+//! Stream buffer that writes to a file descriptor
+class file_streambuf :
+    public std::streambuf
+{
+    //! Base type
+    typedef std::streambuf base_type;
+
+public:
+    //! Native file handle type
+    typedef int native_handle_type;
+
+private:
+    //! Buffer size
+    enum { buffer_size = 8192 };
+#if defined(IOV_MAX)
+    //! Maximum number of buffers written in one gather operation
+    enum { max_gather_buffers = IOV_MAX < 64 ? IOV_MAX : 64 };
+#else
+    enum { max_gather_buffers = 16 };
+#endif
+
+    //! File descriptor
+    native_handle_type m_Handle;
+    //! File position of the beginning of the buffer
+    uintmax_t m_Position;
+    //! The size of the file regions that are mapped to memory, zero if the file is not mapped
+    std::size_t m_MappedExtent;
+    //! Mapped memory region
+    char* m_pMapping;
+    //! The size of the mapped memory region
+    std::size_t m_MappingSize;
+    //! The size of the file, including the allocated space beyond the written data
+    uintmax_t m_AllocatedSize;
+    //! Buffer storage
+    char m_Buffer[buffer_size];
+
+public:
+    //! Default constructor
+    file_streambuf() : m_Handle(-1), m_Position(0), m_MappedExtent(0), m_pMapping(NULL), m_MappingSize(0), m_AllocatedSize(0)
+    {
+        base_type::setp(m_Buffer, m_Buffer + buffer_size);
+    }
+    //! Destructor
+    ~file_streambuf()
+    {
+        close();
+    }
+
+    /*!
+     * The method opens the file. If \a mapped_extent is not zero, the file is written through
+     * a memory mapping, which is advanced in steps of the specified size. The file is extended
+     * in the same steps and truncated to the written size when closed. Memory mapping is only
+     * supported on POSIX systems, on other systems the argument is ignored.
+     */
+    bool open(filesystem::path const& name, std::ios_base::openmode mode, std::size_t mapped_extent = 0)
+    {
+        if (m_Handle >= 0)
+            return false;
+
+#if defined(BOOST_WINDOWS_API)
+        (void)mapped_extent;
+        int flags = _O_WRONLY | _O_CREAT | ((mode & std::ios_base::binary) ? _O_BINARY : _O_TEXT);
+        flags |= (mode & std::ios_base::app) ? _O_APPEND : _O_TRUNC;
+        m_Handle = ::_wopen(name.c_str(), flags, _S_IREAD | _S_IWRITE);
+        if (m_Handle < 0)
+            return false;
+        m_Position = (mode & std::ios_base::app) ? static_cast< uintmax_t >(::_lseeki64(m_Handle, 0, SEEK_END)) : 0u;
+#else
+        int flags = O_CREAT;
+        if (mapped_extent > 0)
+        {
+            // The mapping requires the file to be opened for reading as well
+            flags |= O_RDWR;
+            if (!(mode & std::ios_base::app))
+                flags |= O_TRUNC;
+        }
+        else
+        {
+            flags |= O_WRONLY;
+            flags |= (mode & std::ios_base::app) ? O_APPEND : O_TRUNC;
+        }
+#if defined(O_CLOEXEC)
+        flags |= O_CLOEXEC;
+#endif
+        do
+        {
+            m_Handle = ::open(name.c_str(), flags, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
+        }
+        while (m_Handle < 0 && errno == EINTR);
+        if (m_Handle < 0)
+            return false;
+        m_Position = (mode & std::ios_base::app) ? static_cast< uintmax_t >(::lseek(m_Handle, 0, SEEK_END)) : 0u;
+
+        if (mapped_extent > 0)
+        {
+            // Round the extent up to the page size, the mapping is established on the first write
+            const std::size_t page_size = static_cast< std::size_t >(::sysconf(_SC_PAGESIZE));
+            m_MappedExtent = (mapped_extent + page_size - 1u) / page_size * page_size;
+            m_AllocatedSize = m_Position;
+            base_type::setp(NULL, NULL);
+        }
+#endif
+
+        return true;
+    }
+
+    //! The method checks if the file is open
+    bool is_open() const { return m_Handle >= 0; }
+
+    //! The method writes the buffered data and closes the file
+    bool close()
+    {
+        if (m_Handle < 0)
+            return true;
+
+        bool result = flush_buffer();
+#if defined(BOOST_WINDOWS_API)
+        result &= (::_close(m_Handle) == 0);
+#else
+        if (m_MappedExtent > 0)
+        {
+            // Cut off the allocated space that was not written to
+            const uintmax_t size = position();
+            unmap();
+            if (m_AllocatedSize > size)
+                result &= (::ftruncate(m_Handle, static_cast< off_t >(size)) == 0);
+            m_MappedExtent = 0;
+            m_AllocatedSize = 0;
+            base_type::setp(m_Buffer, m_Buffer + buffer_size);
+        }
+        result &= (::close(m_Handle) == 0);
+#endif
+        m_Handle = -1;
+        m_Position = 0;
+        return result;
+    }
+
+    //! Returns the file descriptor
+    native_handle_type native_handle() const { return m_Handle; }
+
+    //! Returns the current write position in the file, including the buffered data
+    uintmax_t position() const
+    {
+        return m_Position + static_cast< uintmax_t >(base_type::pptr() - base_type::pbase());
+    }
+
+    /*!
+     * The method writes the buffered data, followed by the data of the strings in the range,
+     * to the file. On POSIX systems the data is written with gather operations, without
+     * copying the strings to the internal buffer.
+     */
+    template< typename IteratorT >
+    bool write_strings(IteratorT begin, IteratorT end)
+    {
+        if (m_Handle < 0)
+            return false;
+
+#if defined(BOOST_WINDOWS_API)
+
+        if (!flush_buffer())
+            return false;
+        for (; begin != end; ++begin)
+        {
+            if (!write_all(begin->data(), begin->size()))
+                return false;
+        }
+        return true;
+
+#else
+
+        if (m_MappedExtent > 0)
+        {
+            for (; begin != end; ++begin)
+            {
+                if (!write_mapped(begin->data(), begin->size()))
+                    return false;
+            }
+            return true;
+        }
+
+        struct iovec iov[max_gather_buffers];
+        std::size_t count = 0;
+
+        // The first buffer is the internal one
+        const std::size_t buffered = static_cast< std::size_t >(base_type::pptr() - base_type::pbase());
+        if (buffered > 0)
+        {
+            iov[0].iov_base = base_type::pbase();
+            iov[0].iov_len = buffered;
+            count = 1;
+        }
+        base_type::setp(m_Buffer, m_Buffer + buffer_size);
+
+        while (true)
+        {
+            for (; begin != end && count < static_cast< std::size_t >(max_gather_buffers); ++begin)
+            {
+                if (!begin->empty())
+                {
+                    iov[count].iov_base = const_cast< char* >(begin->data());
+                    iov[count].iov_len = begin->size();
+                    ++count;
+                }
+            }
+
+            if (count == 0)
+                return true;
+            if (!write_all(iov, count))
+                return false;
+            count = 0;
+        }
+
+#endif
+    }
+
+    //! The method synchronizes the file data with the storage device
+    bool sync_data()
+    {
+        if (!flush_buffer())
+            return false;
+#if !defined(BOOST_WINDOWS_API)
+        if (m_pMapping && ::msync(m_pMapping, m_MappingSize, MS_SYNC) != 0)
+            return false;
+#endif
+        return sync_handle(m_Handle);
+    }
+
+    /*!
+     * The function synchronizes the data of the file with the storage device. Unlike \c sync_data,
+     * the function does not write the buffered data, so it can be called from a different thread.
+     */
+    static bool sync_handle(native_handle_type handle)
+    {
+#if defined(BOOST_WINDOWS_API)
+        return ::_commit(handle) == 0;
+#elif defined(_POSIX_SYNCHRONIZED_IO) && _POSIX_SYNCHRONIZED_IO > 0
+        return ::fdatasync(handle) == 0;
+#else
+        return ::fsync(handle) == 0;
+#endif
+    }
+
+protected:
+    //! Puts a character to the buffer, writing the buffer to the file if it's full
+    int_type overflow(int_type c)
+    {
+#if !defined(BOOST_WINDOWS_API)
+        if (m_MappedExtent > 0 && !advance_mapping())
+            return traits_type::eof();
+#endif
+        if (!flush_buffer())
+            return traits_type::eof();
+        if (!traits_type::eq_int_type(c, traits_type::eof()))
+        {
+            *base_type::pptr() = traits_type::to_char_type(c);
+            base_type::pbump(1);
+            return c;
+        }
+        return traits_type::not_eof(c);
+    }
+
+    //! Puts a character sequence to the buffer, or writes it directly to the file if it's large
+    std::streamsize xsputn(const char_type* s, std::streamsize n)
+    {
+        const std::size_t size = static_cast< std::size_t >(n);
+#if !defined(BOOST_WINDOWS_API)
+        if (m_MappedExtent > 0)
+            return write_mapped(s, size) ? n : 0;
+#endif
+        const std::size_t left = static_cast< std::size_t >(base_type::epptr() - base_type::pptr());
+        if (size <= left)
+        {
+            traits_type::copy(base_type::pptr(), s, size);
+            base_type::pbump(static_cast< int >(n));
+            return n;
+        }
+
+        if (!flush_buffer())
+            return 0;
+
+        if (size < static_cast< std::size_t >(buffer_size))
+        {
+            traits_type::copy(base_type::pptr(), s, size);
+            base_type::pbump(static_cast< int >(n));
+            return n;
+        }
+
+        return write_all(s, size) ? n : 0;
+    }
+
+    //! Writes the buffered data to the file
+    int sync()
+    {
+        return flush_buffer() ? 0 : -1;
+    }
+
+    //! Returns the current position. Only querying the position is supported.
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+    {
+        if (off == 0 && dir == std::ios_base::cur && (which & std::ios_base::out) && m_Handle >= 0)
+            return pos_type(static_cast< off_type >(position()));
+        return pos_type(off_type(-1));
+    }
+
+private:
+    //! Writes the buffered data to the file
+    bool flush_buffer()
+    {
+        // The data written to the mapped memory needs no flushing
+        if (m_MappedExtent > 0)
+            return true;
+        const std::size_t buffered = static_cast< std::size_t >(base_type::pptr() - base_type::pbase());
+        if (buffered == 0)
+            return true;
+        if (m_Handle < 0)
+            return false;
+        base_type::setp(m_Buffer, m_Buffer + buffer_size);
+        return write_all(m_Buffer, buffered);
+    }
+
+    //! Writes the data to the file
+    bool write_all(const char* p, std::size_t size)
+    {
+        while (size > 0)
+        {
+#if defined(BOOST_WINDOWS_API)
+            const unsigned int chunk = size > 0x40000000u ? 0x40000000u : static_cast< unsigned int >(size);
+            const int written = ::_write(m_Handle, p, chunk);
+            if (written < 0)
+                return false;
+#else
+            const ssize_t written = ::write(m_Handle, p, size);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                return false;
+            }
+#endif
+            p += written;
+            size -= static_cast< std::size_t >(written);
+            m_Position += static_cast< uintmax_t >(written);
+        }
+        return true;
+    }
+
+#if !defined(BOOST_WINDOWS_API)
+    //! Copies the data to the mapped memory, advancing the mapping as needed
+    bool write_mapped(const char* p, std::size_t size)
+    {
+        while (size > 0)
+        {
+            std::size_t left = static_cast< std::size_t >(base_type::epptr() - base_type::pptr());
+            if (left == 0)
+            {
+                if (!advance_mapping())
+                    return false;
+                left = static_cast< std::size_t >(base_type::epptr() - base_type::pptr());
+            }
+
+            const std::size_t chunk = size < left ? size : left;
+            traits_type::copy(base_type::pptr(), p, chunk);
+            base_type::pbump(static_cast< int >(chunk));
+            p += chunk;
+            size -= chunk;
+        }
+        return true;
+    }
+
+    //! Maps the file region that starts at the current position, extending the file if needed
+    bool advance_mapping()
+    {
+        const uintmax_t pos = position();
+        unmap();
+        m_Position = pos;
+
+        const uintmax_t offset = pos - pos % static_cast< uintmax_t >(::sysconf(_SC_PAGESIZE));
+        const uintmax_t end = offset + m_MappedExtent;
+        if (end > m_AllocatedSize)
+        {
+            // Allocate the storage in advance so that writing to the mapped memory does not fail when the disk is full
+            const int err = ::posix_fallocate(m_Handle, static_cast< off_t >(m_AllocatedSize), static_cast< off_t >(end - m_AllocatedSize));
+            if (err != 0)
+            {
+                if (err != EINVAL && err != EOPNOTSUPP)
+                    return false;
+                // The file system does not support allocation, just extend the file
+                if (::ftruncate(m_Handle, static_cast< off_t >(end)) != 0)
+                    return false;
+            }
+            m_AllocatedSize = end;
+        }
+
+        void* p = ::mmap(NULL, m_MappedExtent, PROT_READ | PROT_WRITE, MAP_SHARED, m_Handle, static_cast< off_t >(offset));
+        if (p == MAP_FAILED)
+            return false;
+
+        m_pMapping = static_cast< char* >(p);
+        m_MappingSize = m_MappedExtent;
+        base_type::setp(m_pMapping + static_cast< std::size_t >(pos - offset), m_pMapping + m_MappingSize);
+        return true;
+    }
+
+    //! Unmaps the mapped memory region
+    void unmap()
+    {
+        if (m_pMapping)
+        {
+            m_Position = position();
+            ::munmap(m_pMapping, m_MappingSize);
+            m_pMapping = NULL;
+            m_MappingSize = 0;
+            base_type::setp(NULL, NULL);
+        }
+    }
+
+    //! Writes the buffers to the file
+    bool write_all(struct iovec* iov, std::size_t count)
+    {
+        while (count > 0)
+        {
+            ssize_t written = ::writev(m_Handle, iov, static_cast< int >(count));
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                return false;
+            }
+
+            m_Position += static_cast< uintmax_t >(written);
+
+            // Skip the buffers that have been written completely
+            while (count > 0 && static_cast< std::size_t >(written) >= iov->iov_len)
+            {
+                written -= static_cast< ssize_t >(iov->iov_len);
+                ++iov;
+                --count;
+            }
+            if (count > 0)
+            {
+                iov->iov_base = static_cast< char* >(iov->iov_base) + written;
+                iov->iov_len -= static_cast< std::size_t >(written);
+            }
+        }
+        return true;
+    }
+#endif
+
+    //  Copying prohibited
+    BOOST_LOG_DELETED_FUNCTION(file_streambuf(file_streambuf const&))
+    BOOST_LOG_DELETED_FUNCTION(file_streambuf& operator= (file_streambuf const&))
+};
+
+//! Output file stream that writes to a file descriptor
+class file_ostream :
+    public std::ostream
+{
+    //! Base type
+    typedef std::ostream base_type;
+
+private:
+    //! Stream buffer
+    file_streambuf m_StreamBuf;
+
+public:
+    //! Default constructor
+    file_ostream() : base_type(NULL)
+    {
+        base_type::rdbuf(&m_StreamBuf);
+    }
+
+    //! The method opens the file
+    void open(filesystem::path const& name, std::ios_base::openmode mode, std::size_t mapped_extent = 0)
+    {
+        if (m_StreamBuf.open(name, mode, mapped_extent))
+            base_type::clear();
+        else
+            base_type::setstate(std::ios_base::failbit);
+    }
+    //! The method checks if the file is open
+    bool is_open() const { return m_StreamBuf.is_open(); }
+    //! The method closes the file
+    void close()
+    {
+        if (!m_StreamBuf.close())
+            base_type::setstate(std::ios_base::failbit);
+    }
+
+    //! Returns the stream buffer
+    file_streambuf* rdbuf() const { return const_cast< file_streambuf* >(&m_StreamBuf); }
+
+    //  Copying prohibited
+    BOOST_LOG_DELETED_FUNCTION(file_ostream(file_ostream const&))
+    BOOST_LOG_DELETED_FUNCTION(file_ostream& operator= (file_ostream const&))
+};
+
+} // namespace aux
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_FILE_STREAM_HPP_INCLUDED_
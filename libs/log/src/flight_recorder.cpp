@@ -0,0 +1,406 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   flight_recorder.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/libs/log/doc/log.html.
+ */
+
+#include <boost/log/detail/config.hpp>
+
+#ifndef BOOST_LOG_NO_THREADS
+
+#include <cstddef>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/atomic/atomic.hpp>
+#include <boost/thread/tss.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/log/detail/flight_recorder.hpp>
+#include <boost/log/detail/locks.hpp>
+#include <boost/log/detail/spin_mutex.hpp>
+#include <boost/log/detail/light_rw_mutex.hpp>
+#include <boost/log/detail/header.hpp>
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace aux {
+
+//! Flight recorder implementation
+struct flight_recorder::implementation
+{
+    //! Buffered record with its sequence number
+    typedef std::pair< uint64_t, record_view > entry;
+    //! Sequence of buffered records
+    typedef std::vector< entry > entry_list;
+
+    //! Orders entries by their sequence numbers
+    struct entry_order
+    {
+        typedef bool result_type;
+
+        bool operator() (entry const& left, entry const& right) const
+        {
+            return left.first < right.first;
+        }
+    };
+
+    //! Ring buffer of a single thread
+    struct ring
+    {
+        //! The mutex protects the buffer from being extracted while the owning thread pushes records.
+        //! The mutex is normally only locked by the owning thread, so it is not contended.
+        spin_mutex m_Mutex;
+        //! Buffered records
+        entry_list m_Entries;
+        //! The position to put the next record at
+        std::size_t m_Head;
+        //! The number of buffered records
+        std::size_t m_Size;
+        //! Indicates that the owning thread has terminated
+        bool m_Detached;
+
+        ring() : m_Head(0), m_Size(0), m_Detached(false) {}
+
+        //! Changes the buffer capacity, retaining the most recent records
+        void resize(std::size_t capacity)
+        {
+            entry_list entries;
+            entries.reserve(capacity);
+            const std::size_t count = (std::min)(m_Size, capacity);
+            std::size_t pos = (m_Head + m_Entries.size() - count) % (m_Entries.empty() ? 1u : m_Entries.size());
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                entries.push_back(m_Entries[pos]);
+                if (++pos == m_Entries.size())
+                    pos = 0;
+            }
+            entries.resize(capacity);
+            m_Entries.swap(entries);
+            m_Size = count;
+            m_Head = count % capacity;
+        }
+
+        //! Releases the buffered records
+        void clear()
+        {
+            entry_list().swap(m_Entries);
+            m_Head = 0;
+            m_Size = 0;
+        }
+
+        //! Moves the buffered records to the container
+        void pop_all(entry_list& entries)
+        {
+            if (m_Size == 0)
+                return;
+
+            std::size_t pos = (m_Head + m_Entries.size() - m_Size) % m_Entries.size();
+            for (; m_Size > 0; --m_Size)
+            {
+                entries.push_back(entry(m_Entries[pos].first, record_view()));
+                entries.back().second.swap(m_Entries[pos].second);
+                if (++pos == m_Entries.size())
+                    pos = 0;
+            }
+        }
+    };
+
+    //! The list of ring buffers of all threads. The list is shared with the thread-specific data, which may outlive the recorder.
+    struct ring_list
+    {
+        //! The mutex protects the list
+        boost::mutex m_Mutex;
+        //! Ring buffers
+        std::vector< ring* > m_Rings;
+
+        ~ring_list()
+        {
+            for (std::vector< ring* >::iterator it = m_Rings.begin(), end = m_Rings.end(); it != end; ++it)
+                delete *it;
+        }
+    };
+
+    //! Thread-specific data
+    struct thread_context
+    {
+        //! The list of buffers. The list also identifies the recorder the context belongs to.
+        const shared_ptr< ring_list > m_pRings;
+        //! The buffer of the current thread
+        ring* const m_pRing;
+        //! Trigger version the snapshot corresponds to
+        unsigned int m_Version;
+        //! Trigger filter snapshot
+        filter m_Trigger;
+        //! Indicates that the trigger is set
+        bool m_fTrigger;
+
+        thread_context(shared_ptr< ring_list > const& rings, ring* r) :
+            m_pRings(rings),
+            m_pRing(r),
+            m_Version(0u),
+            m_fTrigger(false)
+        {
+        }
+
+        ~thread_context()
+        {
+            // Leave the buffered records to be extracted
+            boost::lock_guard< boost::mutex > lock(m_pRings->m_Mutex);
+            m_pRing->m_Detached = true;
+        }
+    };
+
+    //! The list of buffers
+    const shared_ptr< ring_list > m_pRings;
+    //! Buffer capacity
+    boost::atomic< std::size_t > m_Capacity;
+    //! Record sequence counter
+    boost::atomic< uint64_t > m_Sequence;
+
+    //! The mutex protects the trigger
+    light_rw_mutex m_TriggerMutex;
+    //! Trigger version, incremented on every modification of the trigger
+    boost::atomic< unsigned int > m_Version;
+    //! Trigger filter
+    filter m_Trigger;
+    //! Indicates that the trigger is set
+    bool m_fTrigger;
+
+    //! Thread-specific data
+    thread_specific_ptr< thread_context > m_pContext;
+
+    explicit implementation(std::size_t capacity) :
+        m_pRings(boost::make_shared< ring_list >()),
+        m_Capacity(capacity > 0u ? capacity : 1u),
+        m_Sequence(0u),
+        m_Version(1u),
+        m_fTrigger(false)
+    {
+    }
+
+    ~implementation()
+    {
+        // Other threads may still have contexts referring to the buffers, the contexts are destroyed when the threads
+        // terminate. Release the buffered records and the buffers of the terminated threads now.
+        boost::lock_guard< boost::mutex > lock(m_pRings->m_Mutex);
+        std::vector< ring* >& rings = m_pRings->m_Rings;
+        for (std::vector< ring* >::iterator it = rings.begin(); it != rings.end();)
+        {
+            ring* const r = *it;
+            if (!r->m_Detached)
+            {
+                exclusive_lock_guard< spin_mutex > ring_lock(r->m_Mutex);
+                r->clear();
+                ++it;
+            }
+            else
+            {
+                delete r;
+                it = rings.erase(it);
+            }
+        }
+    }
+
+    //! Returns the thread-specific data of the current thread
+    thread_context* get_context()
+    {
+        thread_context* context = m_pContext.get();
+        // The thread-specific pointer is identified by its address, so the context may be left by a destroyed
+        // recorder that was constructed at the same address. The buffer list of the destroyed recorder is kept
+        // alive by the context, so it cannot be confused with the buffer list of this recorder.
+        if (!context || context->m_pRings != m_pRings)
+            context = create_context();
+        return context;
+    }
+
+    //! Creates the thread-specific data for the current thread
+    thread_context* create_context()
+    {
+        ring* r = NULL;
+        {
+            boost::lock_guard< boost::mutex > lock(m_pRings->m_Mutex);
+
+            // Reuse the buffer of a terminated thread, if there is one
+            std::vector< ring* >& rings = m_pRings->m_Rings;
+            for (std::vector< ring* >::iterator it = rings.begin(), end = rings.end(); it != end; ++it)
+            {
+                if ((*it)->m_Detached)
+                {
+                    r = *it;
+                    r->m_Detached = false;
+                    break;
+                }
+            }
+
+            if (!r)
+            {
+                rings.reserve(rings.size() + 1u);
+                r = new ring();
+                rings.push_back(r);
+            }
+        }
+
+        thread_context* context;
+        try
+        {
+            context = new thread_context(m_pRings, r);
+        }
+        catch (...)
+        {
+            boost::lock_guard< boost::mutex > lock(m_pRings->m_Mutex);
+            r->m_Detached = true;
+            throw;
+        }
+
+        try
+        {
+            m_pContext.reset(context);
+        }
+        catch (...)
+        {
+            delete context;
+            throw;
+        }
+        return context;
+    }
+
+    //! Updates the trigger snapshot of the current thread
+    void update_trigger(thread_context* context)
+    {
+        shared_lock_guard< light_rw_mutex > lock(m_TriggerMutex);
+        context->m_Version = m_Version.load(boost::memory_order_relaxed);
+        context->m_Trigger = m_Trigger;
+        context->m_fTrigger = m_fTrigger;
+    }
+};
+
+//! Constructor
+BOOST_LOG_API flight_recorder::flight_recorder(std::size_t capacity) : m_pImpl(new implementation(capacity))
+{
+}
+
+//! Destructor
+BOOST_LOG_API flight_recorder::~flight_recorder()
+{
+    delete m_pImpl;
+}
+
+//! Returns the maximum number of records retained per thread
+BOOST_LOG_API std::size_t flight_recorder::capacity() const
+{
+    return m_pImpl->m_Capacity.load(boost::memory_order_relaxed);
+}
+
+//! Sets the maximum number of records retained per thread
+BOOST_LOG_API void flight_recorder::set_capacity(std::size_t capacity)
+{
+    m_pImpl->m_Capacity.store(capacity > 0u ? capacity : 1u, boost::memory_order_relaxed);
+}
+
+//! Sets the trigger filter
+BOOST_LOG_API void flight_recorder::set_trigger(filter const& trigger)
+{
+    exclusive_lock_guard< light_rw_mutex > lock(m_pImpl->m_TriggerMutex);
+    m_pImpl->m_Trigger = trigger;
+    m_pImpl->m_fTrigger = true;
+    m_pImpl->m_Version.fetch_add(1u, boost::memory_order_release);
+}
+
+//! Resets the trigger filter
+BOOST_LOG_API void flight_recorder::reset_trigger()
+{
+    exclusive_lock_guard< light_rw_mutex > lock(m_pImpl->m_TriggerMutex);
+    m_pImpl->m_Trigger.reset();
+    m_pImpl->m_fTrigger = false;
+    m_pImpl->m_Version.fetch_add(1u, boost::memory_order_release);
+}
+
+//! Puts the record into the buffer of the current thread
+BOOST_LOG_API bool flight_recorder::push(record_view const& rec)
+{
+    implementation* const impl = m_pImpl;
+    implementation::thread_context* const context = impl->get_context();
+    if (context->m_Version != impl->m_Version.load(boost::memory_order_acquire))
+        impl->update_trigger(context);
+
+    implementation::ring& r = *context->m_pRing;
+    {
+        exclusive_lock_guard< spin_mutex > lock(r.m_Mutex);
+
+        const std::size_t capacity = impl->m_Capacity.load(boost::memory_order_relaxed);
+        if (r.m_Entries.size() != capacity)
+            r.resize(capacity);
+
+        implementation::entry& e = r.m_Entries[r.m_Head];
+        e.first = impl->m_Sequence.fetch_add(1u, boost::memory_order_relaxed);
+        e.second = rec;
+        if (++r.m_Head == capacity)
+            r.m_Head = 0;
+        if (r.m_Size < capacity)
+            ++r.m_Size;
+    }
+
+    return context->m_fTrigger && context->m_Trigger(rec.attribute_values());
+}
+
+//! Extracts records from all buffers
+BOOST_LOG_API void flight_recorder::pop_all(std::vector< record_view >& records)
+{
+    implementation::entry_list entries;
+    {
+        boost::lock_guard< boost::mutex > lock(m_pImpl->m_pRings->m_Mutex);
+
+        std::vector< implementation::ring* >& rings = m_pImpl->m_pRings->m_Rings;
+        for (std::vector< implementation::ring* >::iterator it = rings.begin(); it != rings.end();)
+        {
+            implementation::ring* const r = *it;
+            if (!r->m_Detached)
+            {
+                exclusive_lock_guard< spin_mutex > ring_lock(r->m_Mutex);
+                r->pop_all(entries);
+                ++it;
+            }
+            else
+            {
+                // The terminated thread cannot push records, no need to lock the buffer
+                r->pop_all(entries);
+                delete r;
+                it = rings.erase(it);
+            }
+        }
+    }
+
+    std::sort(entries.begin(), entries.end(), implementation::entry_order());
+
+    records.reserve(records.size() + entries.size());
+    for (implementation::entry_list::iterator it = entries.begin(), end = entries.end(); it != end; ++it)
+    {
+        records.push_back(record_view());
+        records.back().swap(it->second);
+    }
+}
+
+} // namespace aux
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
+
+#endif // BOOST_LOG_NO_THREADS
@@ -13,7 +13,8 @@
  *         at http://www.boost.org/libs/log/doc/log.html.
  */
 
-#include <map>
+#include <cstddef>
+#include <cstring>
 #include <string>
 #include <boost/limits.hpp>
 #include <boost/log/exceptions.hpp>
@@ -22,6 +23,7 @@
 #include <boost/log/utility/type_info_wrapper.hpp>
 #include <boost/log/sources/global_logger_storage.hpp>
 #if !defined(BOOST_LOG_NO_THREADS)
+#include <boost/atomic/atomic.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/log/detail/locks.hpp>
 #endif
@@ -37,19 +39,109 @@ namespace aux {
 
 BOOST_LOG_ANONYMOUS_NAMESPACE {
 
-//! The loggers repository singleton
+/*!
+ * The loggers repository singleton
+ *
+ * The repository is a hash table with a fixed number of buckets, each bucket being a singly linked
+ * list of nodes. Nodes are never removed or modified after being published, and the publication
+ * is done by storing the new list head with release semantics. This allows to look up loggers
+ * without locking. The mutex is only used to serialize logger initialization.
+ */
 struct loggers_repository :
     public log::aux::lazy_singleton< loggers_repository >
 {
-    //! Repository map type
-    typedef std::map< type_info_wrapper, shared_ptr< logger_holder_base > > loggers_map_t;
+    //! The number of buckets in the hash table
+    enum { bucket_count = 256u };
+
+    //! Hash table node
+    struct node
+    {
+        //! Next node in the bucket
+        node* m_pNext;
+        //! Hash value of the tag type name
+        std::size_t m_Hash;
+        //! Tag type info
+        type_info_wrapper m_Key;
+        //! Logger holder
+        shared_ptr< logger_holder_base > m_pHolder;
+
+        node(node* next, std::size_t h, type_info_wrapper const& key, shared_ptr< logger_holder_base > const& holder) :
+            m_pNext(next),
+            m_Hash(h),
+            m_Key(key),
+            m_pHolder(holder)
+        {
+        }
+    };
 
 #if !defined(BOOST_LOG_NO_THREADS)
-    //! Synchronization primitive
-    mutable mutex m_Mutex;
+    //! Bucket type
+    typedef boost::atomic< node* > bucket_type;
+
+    //! Synchronization primitive for logger initialization
+    mutex m_Mutex;
+#else
+    //! Bucket type
+    typedef node* bucket_type;
 #endif
-    //! Map of logger holders
-    loggers_map_t m_Loggers;
+    //! Hash table buckets
+    bucket_type m_Buckets[bucket_count];
+
+    loggers_repository()
+    {
+        for (unsigned int i = 0; i < bucket_count; ++i)
+            m_Buckets[i] = static_cast< node* >(NULL);
+    }
+
+    ~loggers_repository()
+    {
+        for (unsigned int i = 0; i < bucket_count; ++i)
+        {
+            node* p = load_head(m_Buckets[i]);
+            while (p)
+            {
+                node* next = p->m_pNext;
+                delete p;
+                p = next;
+            }
+        }
+    }
+
+    //! Computes the hash value of the tag type name
+    static std::size_t hash(std::type_info const& key)
+    {
+        // FNV-1a hash of the type name. Type names are used instead of type_info addresses because
+        // the latter may differ between modules for the same type.
+        const char* p = key.name();
+        std::size_t h = static_cast< std::size_t >(2166136261u);
+        for (; *p; ++p)
+        {
+            h ^= static_cast< unsigned char >(*p);
+            h *= static_cast< std::size_t >(16777619u);
+        }
+        return h;
+    }
+
+    //! Looks for the logger in the bucket
+    static node* find(node* p, std::size_t h, type_info_wrapper const& key)
+    {
+        for (; p; p = p->m_pNext)
+        {
+            if (p->m_Hash == h && p->m_Key == key)
+                return p;
+        }
+        return NULL;
+    }
+
+    //! Loads the bucket list head
+    static node* load_head(bucket_type const& bucket)
+    {
+#if !defined(BOOST_LOG_NO_THREADS)
+        return bucket.load(boost::memory_order_acquire);
+#else
+        return bucket;
+#endif
+    }
 };
 
 } // namespace
@@ -57,24 +149,36 @@ struct loggers_repository :
 //! Finds or creates the logger and returns its holder
 BOOST_LOG_API shared_ptr< logger_holder_base > global_storage::get_or_init(std::type_info const& key, initializer_t initializer)
 {
-    typedef loggers_repository::loggers_map_t loggers_map_t;
+    typedef loggers_repository::node node;
     loggers_repository& repo = loggers_repository::get();
     type_info_wrapper wrapped_key = key;
+    const std::size_t h = loggers_repository::hash(key);
+    loggers_repository::bucket_type& bucket = repo.m_Buckets[h % loggers_repository::bucket_count];
 
+    // Fast path: the logger is already registered
+    node* head = loggers_repository::load_head(bucket);
+    if (node* p = loggers_repository::find(head, h, wrapped_key))
+        return p->m_pHolder;
+
+    // We have to create a logger instance
     BOOST_LOG_EXPR_IF_MT(log::aux::exclusive_lock_guard< mutex > lock(repo.m_Mutex);)
-    loggers_map_t::iterator it = repo.m_Loggers.find(wrapped_key);
-    if (it != repo.m_Loggers.end())
-    {
-        // There is an instance
-        return it->second;
-    }
-    else
+
+    // Check again in case if some other thread has initialized the logger in the meantime
+    node* new_head = loggers_repository::load_head(bucket);
+    if (new_head != head)
     {
-        // We have to create a logger instance
-        shared_ptr< logger_holder_base > inst = initializer();
-        repo.m_Loggers[wrapped_key] = inst;
-        return inst;
+        if (node* p = loggers_repository::find(new_head, h, wrapped_key))
+            return p->m_pHolder;
     }
+
+    shared_ptr< logger_holder_base > inst = initializer();
+    node* p = new node(new_head, h, wrapped_key, inst);
+#if !defined(BOOST_LOG_NO_THREADS)
+    bucket.store(p, boost::memory_order_release);
+#else
+    bucket = p;
+#endif
+    return inst;
 }
 
 //! Throws the \c odr_violation exception
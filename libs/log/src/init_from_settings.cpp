@@ -253,7 +253,29 @@ protected:
         if (!async)
             p = init_formatter(boost::make_shared< sinks::synchronous_sink< backend_t > >(backend), params, is_formatting_t());
         else
-            p = init_formatter(boost::make_shared< sinks::asynchronous_sink< backend_t > >(backend), params, is_formatting_t());
+        {
+            // Formatting threads
+            unsigned int formatting_threads = 0;
+            if (optional< string_type > formatting_threads_param = params["FormattingThreads"])
+            {
+                formatting_threads = param_cast_to_int< unsigned int >("FormattingThreads", formatting_threads_param.get());
+            }
+
+            // Repeated records merging window
+            unsigned int coalescing_window = 0;
+            if (optional< string_type > coalescing_window_param = params["CoalescingWindow"])
+            {
+                coalescing_window = param_cast_to_int< unsigned int >("CoalescingWindow", coalescing_window_param.get());
+            }
+
+            p = init_formatter(
+                boost::make_shared< sinks::asynchronous_sink< backend_t > >(
+                    backend,
+                    keywords::formatting_threads = formatting_threads,
+                    keywords::coalescing_window = posix_time::milliseconds(coalescing_window)),
+                params,
+                is_formatting_t());
+        }
 #else
         // When multithreading is disabled we always use the unlocked sink frontend
         p = init_formatter(boost::make_shared< sinks::unlocked_sink< backend_t > >(backend), params, is_formatting_t());
@@ -383,6 +405,49 @@ public:
             backend->auto_flush(param_cast_to_bool("AutoFlush", auto_flush_param.get()));
         }
 
+        // Write batch size
+        if (optional< string_type > write_batch_size_param = params["WriteBatchSize"])
+        {
+            backend->set_write_batch_size(param_cast_to_int< std::size_t >("WriteBatchSize", write_batch_size_param.get()));
+        }
+
+        // Mapped extent size
+        if (optional< string_type > mapped_extent_param = params["MappedExtentSize"])
+        {
+            backend->set_mapped_extent_size(param_cast_to_int< std::size_t >("MappedExtentSize", mapped_extent_param.get()));
+        }
+
+        // File synchronization policy
+        if (optional< string_type > sync_policy_param = params["SyncPolicy"])
+        {
+            string_type const& value = sync_policy_param.get();
+            if (value == constants::sync_policy_none())
+                backend->set_sync_policy(sinks::file::no_sync);
+            else if (value == constants::sync_policy_periodic())
+                backend->set_sync_policy(sinks::file::periodic_sync);
+            else if (value == constants::sync_policy_batch())
+                backend->set_sync_policy(sinks::file::batch_sync);
+            else if (value == constants::sync_policy_record())
+                backend->set_sync_policy(sinks::file::record_sync);
+            else
+            {
+                BOOST_LOG_THROW_DESCR(invalid_value,
+                    "File synchronization policy \"" + boost::log::aux::to_narrow(value) + "\" is not supported");
+            }
+        }
+
+        // File synchronization interval
+        if (optional< string_type > sync_interval_param = params["SyncInterval"])
+        {
+            backend->set_sync_interval(posix_time::milliseconds(param_cast_to_int< unsigned int >("SyncInterval", sync_interval_param.get())));
+        }
+
+        // File synchronization size
+        if (optional< string_type > sync_size_param = params["SyncSize"])
+        {
+            backend->set_sync_size(param_cast_to_int< uintmax_t >("SyncSize", sync_size_param.get()));
+        }
+
         // Append
         if (optional< string_type > append_param = params["Append"])
         {
@@ -411,6 +476,12 @@ public:
                 keywords::max_size = max_size,
                 keywords::min_free_space = space));
 
+            // Background file collection
+            if (optional< string_type > backlog_param = params["CollectionBacklogSize"])
+            {
+                backend->set_collection_backlog_size(param_cast_to_int< std::size_t >("CollectionBacklogSize", backlog_param.get()));
+            }
+
             // Scan for log files
             if (optional< string_type > scan_param = params["ScanForFiles"])
             {
@@ -451,7 +522,28 @@ public:
     {
         // Construct the backend
         typedef sinks::syslog_backend backend_t;
-        shared_ptr< backend_t > backend = boost::make_shared< backend_t >();
+        shared_ptr< backend_t > backend;
+
+#if !defined(BOOST_LOG_NO_ASIO)
+        // Transport
+        if (optional< string_type > transport_param = params["Transport"])
+        {
+            string_type const& value = transport_param.get();
+            if (value == constants::syslog_transport_udp())
+                backend = boost::make_shared< backend_t >(keywords::use_impl = sinks::syslog::udp_socket_based);
+            else if (value == constants::syslog_transport_tcp())
+                backend = boost::make_shared< backend_t >(keywords::use_impl = sinks::syslog::tcp_socket_based);
+            else if (value == constants::syslog_transport_local())
+                backend = boost::make_shared< backend_t >(keywords::use_impl = sinks::syslog::local_socket_based);
+            else
+            {
+                BOOST_LOG_THROW_DESCR(invalid_value,
+                    "Syslog transport \"" + boost::log::aux::to_narrow(value) + "\" is not supported");
+            }
+        }
+        else
+#endif // !defined(BOOST_LOG_NO_ASIO)
+            backend = boost::make_shared< backend_t >();
 
         // For now we use only the default level mapping. Will add support for configuration later.
         backend->set_severity_mapper(sinks::syslog::direct_severity_mapping< >(log::aux::default_attribute_names::severity()));
@@ -463,6 +555,16 @@ public:
 
         if (optional< string_type > target_address_param = params["TargetAddress"])
             backend->set_target_address(param_cast_to_address("TargetAddress", target_address_param.get()));
+
+        if (optional< string_type > target_socket_param = params["TargetSocket"])
+            backend->set_target_socket(log::aux::to_narrow(target_socket_param.get()));
+
+        // Stream transport buffering
+        if (optional< string_type > write_threshold_param = params["WriteThreshold"])
+            backend->set_write_threshold(param_cast_to_int< std::size_t >("WriteThreshold", write_threshold_param.get()));
+
+        if (optional< string_type > max_backlog_size_param = params["MaxBacklogSize"])
+            backend->set_max_backlog_size(param_cast_to_int< std::size_t >("MaxBacklogSize", max_backlog_size_param.get()));
 #endif // !defined(BOOST_LOG_NO_ASIO)
 
         return base_type::init_sink(backend, params);
@@ -70,6 +70,8 @@ struct char_constants< char >
     static const char_type* ends_with_keyword() { return "ends_with"; }
     static const char_type* contains_keyword() { return "contains"; }
     static const char_type* matches_keyword() { return "matches"; }
+    static const char_type* rate_limit_keyword() { return "rate_limit"; }
+    static const char_type* sample_keyword() { return "sample"; }
 
     static const char_type* message_text_keyword() { return "_"; }
 
@@ -107,6 +109,15 @@ struct char_constants< char >
     static const char_type* scan_method_all() { return "All"; }
     static const char_type* scan_method_matching() { return "Matching"; }
 
+    static const char_type* sync_policy_none() { return "None"; }
+    static const char_type* sync_policy_periodic() { return "Periodic"; }
+    static const char_type* sync_policy_batch() { return "Batch"; }
+    static const char_type* sync_policy_record() { return "Record"; }
+
+    static const char_type* syslog_transport_udp() { return "UDP"; }
+    static const char_type* syslog_transport_tcp() { return "TCP"; }
+    static const char_type* syslog_transport_local() { return "Local"; }
+
     static const char_type* registration_never() { return "Never"; }
     static const char_type* registration_on_demand() { return "OnDemand"; }
     static const char_type* registration_forced() { return "Forced"; }
@@ -186,6 +197,8 @@ struct char_constants< wchar_t >
     static const char_type* ends_with_keyword() { return L"ends_with"; }
     static const char_type* contains_keyword() { return L"contains"; }
     static const char_type* matches_keyword() { return L"matches"; }
+    static const char_type* rate_limit_keyword() { return L"rate_limit"; }
+    static const char_type* sample_keyword() { return L"sample"; }
 
     static const char_type* message_text_keyword() { return L"_"; }
 
@@ -223,6 +236,15 @@ struct char_constants< wchar_t >
     static const char_type* scan_method_all() { return L"All"; }
     static const char_type* scan_method_matching() { return L"Matching"; }
 
+    static const char_type* sync_policy_none() { return L"None"; }
+    static const char_type* sync_policy_periodic() { return L"Periodic"; }
+    static const char_type* sync_policy_batch() { return L"Batch"; }
+    static const char_type* sync_policy_record() { return L"Record"; }
+
+    static const char_type* syslog_transport_udp() { return L"UDP"; }
+    static const char_type* syslog_transport_tcp() { return L"TCP"; }
+    static const char_type* syslog_transport_local() { return L"Local"; }
+
     static const char_type* registration_never() { return L"Never"; }
     static const char_type* registration_on_demand() { return L"OnDemand"; }
     static const char_type* registration_forced() { return L"Forced"; }
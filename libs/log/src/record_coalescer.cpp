@@ -0,0 +1,428 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   record_coalescer.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/libs/log/doc/log.html.
+ */
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <deque>
+#include <boost/cstdint.hpp>
+#include <boost/mpl/copy.hpp>
+#include <boost/mpl/push_back.hpp>
+#include <boost/mpl/back_inserter.hpp>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/detail/timestamp.hpp>
+#include <boost/log/detail/record_coalescer.hpp>
+#include <boost/log/detail/default_attribute_names.hpp>
+#include <boost/log/attributes/attribute_name.hpp>
+#include <boost/log/attributes/attribute_value.hpp>
+#include <boost/log/attributes/attribute_value_set.hpp>
+#include <boost/log/attributes/attribute_value_impl.hpp>
+#include <boost/log/attributes/value_visitation.hpp>
+#include <boost/log/utility/string_literal.hpp>
+#include <boost/log/utility/type_dispatch/standard_types.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/log/detail/header.hpp>
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace aux {
+
+BOOST_LOG_ANONYMOUS_NAMESPACE {
+
+//! A component of the key that identifies repeated records
+struct key_component
+{
+    //! The kind of the attribute value
+    enum kind_type
+    {
+        absent,
+        integer,
+        narrow_string,
+        wide_string
+    };
+
+    //! The kind of the attribute value
+    kind_type m_Kind;
+    //! The integral value
+    uintmax_t m_Integer;
+    //! Pointer to the string characters
+    const void* m_pData;
+    //! The string size, in bytes
+    std::size_t m_Size;
+
+    key_component() : m_Kind(absent), m_Integer(0u), m_pData(NULL), m_Size(0u) {}
+
+    bool operator== (key_component const& that) const
+    {
+        return m_Kind == that.m_Kind && m_Integer == that.m_Integer && m_Size == that.m_Size &&
+            (m_Size == 0u || std::memcmp(m_pData, that.m_pData, m_Size) == 0);
+    }
+};
+
+//! Attribute value types the key components can be composed of
+typedef mpl::copy<
+    string_types,
+    mpl::back_inserter< mpl::push_back< integral_types, trivial::severity_level >::type >
+>::type key_value_types;
+
+//! The visitor fills the key component from the attribute value
+struct key_component_extractor
+{
+    typedef void result_type;
+
+    key_component* m_pComponent;
+
+    explicit key_component_extractor(key_component& component) : m_pComponent(&component) {}
+
+    template< typename T >
+    void operator() (T const& value) const
+    {
+        m_pComponent->m_Kind = key_component::integer;
+        m_pComponent->m_Integer = static_cast< uintmax_t >(value);
+    }
+
+#ifdef BOOST_LOG_USE_CHAR
+    void operator() (std::string const& value) const
+    {
+        set_string(key_component::narrow_string, value.data(), value.size());
+    }
+    void operator() (string_literal const& value) const
+    {
+        set_string(key_component::narrow_string, value.c_str(), value.size());
+    }
+#endif // BOOST_LOG_USE_CHAR
+#ifdef BOOST_LOG_USE_WCHAR_T
+    void operator() (std::wstring const& value) const
+    {
+        set_string(key_component::wide_string, value.data(), value.size());
+    }
+    void operator() (wstring_literal const& value) const
+    {
+        set_string(key_component::wide_string, value.c_str(), value.size());
+    }
+#endif // BOOST_LOG_USE_WCHAR_T
+
+private:
+    template< typename CharT >
+    void set_string(key_component::kind_type kind, const CharT* str, std::size_t size) const
+    {
+        m_pComponent->m_Kind = kind;
+        m_pComponent->m_pData = str;
+        m_pComponent->m_Size = size * sizeof(CharT);
+    }
+};
+
+} // namespace
+
+//! Record coalescer implementation
+struct record_coalescer::implementation
+{
+    //! The number of key components: severity level, channel and message
+    enum { key_size = 3u };
+    //! The number of entries in the table
+    enum { table_size = 64u };
+    //! The number of entries looked through to find a record
+    enum { probe_length = 4u };
+
+    //! Table entry
+    struct entry
+    {
+        //! The record that opened the window. The key components refer to its attribute values. Empty if the entry is not used.
+        record_view m_First;
+        //! The record key
+        key_component m_Key[key_size];
+        //! The key hash
+        std::size_t m_Hash;
+        //! The time when the window closes
+        uint64_t m_WindowEnd;
+        //! The first repeated record
+        record_view m_FirstRepeated;
+        //! The time stamp of the last repeated record
+        attribute_value m_LastTimeStamp;
+        //! The number of repeated records
+        uintmax_t m_Count;
+
+        entry() : m_Hash(0u), m_WindowEnd(0u), m_Count(0u) {}
+    };
+
+    //! The window, in milliseconds
+    const uint64_t m_Window;
+    //! The time point the coalescer was created at
+    const timestamp m_Start;
+    //! Names of the key attributes
+    attribute_name m_KeyNames[key_size];
+    //! Name of the time stamp attribute
+    const attribute_name m_TimeStampName;
+    //! Table of the recently seen records
+    entry m_Table[table_size];
+    //! Released records
+    std::deque< record_view > m_Released;
+    //! The number of entries with repeated records
+    std::size_t m_MergedCount;
+    //! The time when the first window with repeated records closes. May be earlier than the actual time.
+    uint64_t m_NextExpiration;
+
+    explicit implementation(uint64_t window) :
+        m_Window(window),
+        m_Start(get_timestamp()),
+        m_TimeStampName(default_attribute_names::timestamp()),
+        m_MergedCount(0u),
+        m_NextExpiration(0u)
+    {
+        m_KeyNames[0] = default_attribute_names::severity();
+        m_KeyNames[1] = default_attribute_names::channel();
+        m_KeyNames[2] = default_attribute_names::message();
+    }
+
+    //! Returns the number of milliseconds since the coalescer was created
+    uint64_t now() const
+    {
+        return static_cast< uint64_t >((get_timestamp() - m_Start).milliseconds());
+    }
+
+    //! Extracts the key of the record. Returns \c false if the record cannot be merged with other records.
+    bool extract_key(record_view const& rec, key_component* key) const
+    {
+        attribute_value_set const& values = rec.attribute_values();
+        for (unsigned int i = 0; i < key_size; ++i)
+        {
+            visitation_result res = boost::log::visit< key_value_types >(m_KeyNames[i], values, key_component_extractor(key[i]));
+            if (res.code() == visitation_result::value_has_invalid_type)
+                return false;
+        }
+
+        // Records without a message are never merged
+        return key[key_size - 1u].m_Kind != key_component::absent;
+    }
+
+    //! Computes the key hash
+    static std::size_t hash_key(const key_component* key)
+    {
+        // FNV-1a hash of the key components
+        uint32_t h = 2166136261u;
+        for (unsigned int i = 0; i < key_size; ++i)
+        {
+            key_component const& c = key[i];
+            h = (h ^ static_cast< uint32_t >(c.m_Kind)) * 16777619u;
+            h = (h ^ static_cast< uint32_t >(c.m_Integer)) * 16777619u;
+            const unsigned char* p = static_cast< const unsigned char* >(c.m_pData);
+            for (const unsigned char* end = p + c.m_Size; p != end; ++p)
+                h = (h ^ *p) * 16777619u;
+        }
+        return static_cast< std::size_t >(h);
+    }
+
+    //! Checks if the entry contains the specified key
+    static bool equal_keys(entry const& e, std::size_t hash, const key_component* key)
+    {
+        if (e.m_Hash != hash)
+            return false;
+        for (unsigned int i = 0; i < key_size; ++i)
+        {
+            if (!(e.m_Key[i] == key[i]))
+                return false;
+        }
+        return true;
+    }
+
+    //! Merges the repeated record into the entry
+    void merge(entry& e, record_view const& rec)
+    {
+        if (e.m_Count == 0u)
+        {
+            e.m_FirstRepeated = rec;
+            if (m_MergedCount == 0u || e.m_WindowEnd < m_NextExpiration)
+                m_NextExpiration = e.m_WindowEnd;
+            ++m_MergedCount;
+        }
+
+        attribute_value_set const& values = rec.attribute_values();
+        attribute_value_set::const_iterator it = values.find(m_TimeStampName);
+        if (it != values.end())
+            e.m_LastTimeStamp = it->second;
+        else
+            e.m_LastTimeStamp = attribute_value();
+
+        ++e.m_Count;
+    }
+
+    //! Releases the merged record of the entry, if there is one, and frees the entry
+    void release(entry& e)
+    {
+        if (e.m_Count == 1u)
+        {
+            m_Released.push_back(e.m_FirstRepeated);
+            --m_MergedCount;
+        }
+        else if (e.m_Count > 1u)
+        {
+            attribute_value_set values(e.m_FirstRepeated.attribute_values());
+            values.insert(default_attribute_names::repeat_count(), attributes::make_attribute_value(e.m_Count));
+            attribute_value_set::const_iterator it = values.find(m_TimeStampName);
+            if (it != values.end())
+            {
+                const attribute_value first_timestamp = it->second;
+                values.insert(default_attribute_names::first_timestamp(), first_timestamp);
+            }
+            if (!!e.m_LastTimeStamp)
+                values.insert(default_attribute_names::last_timestamp(), e.m_LastTimeStamp);
+
+            m_Released.push_back(make_record_view(boost::move(values)));
+            --m_MergedCount;
+        }
+
+        e.m_First = record_view();
+        e.m_FirstRepeated = record_view();
+        e.m_LastTimeStamp = attribute_value();
+        e.m_Count = 0u;
+    }
+
+    //! Releases the merged records whose windows are closed at the specified time, or all records
+    void expire(uint64_t time, bool all)
+    {
+        uint64_t next_expiration = 0u;
+        for (unsigned int i = 0; i < table_size; ++i)
+        {
+            entry& e = m_Table[i];
+            if (!!e.m_First)
+            {
+                if (all || e.m_WindowEnd <= time)
+                    release(e);
+                else if (e.m_Count > 0u && (next_expiration == 0u || e.m_WindowEnd < next_expiration))
+                    next_expiration = e.m_WindowEnd;
+            }
+        }
+        m_NextExpiration = next_expiration;
+    }
+
+    //! Passes the record through the stage
+    void push(record_view const& rec)
+    {
+        const uint64_t time = now();
+        if (m_MergedCount > 0u && m_NextExpiration <= time)
+            expire(time, false);
+
+        key_component key[key_size];
+        if (!extract_key(rec, key))
+        {
+            m_Released.push_back(rec);
+            return;
+        }
+
+        const std::size_t hash = hash_key(key);
+        entry* free_entry = NULL;
+        entry* oldest_entry = NULL;
+        for (unsigned int i = 0; i < probe_length; ++i)
+        {
+            entry& e = m_Table[(hash + i) % table_size];
+            if (!!e.m_First)
+            {
+                if (e.m_WindowEnd > time)
+                {
+                    if (equal_keys(e, hash, key))
+                    {
+                        merge(e, rec);
+                        return;
+                    }
+
+                    if (!oldest_entry || e.m_WindowEnd < oldest_entry->m_WindowEnd)
+                        oldest_entry = &e;
+                    continue;
+                }
+
+                // The window is closed
+                release(e);
+            }
+
+            if (!free_entry)
+                free_entry = &e;
+        }
+
+        if (!free_entry)
+        {
+            // Evict the entry with the oldest window
+            free_entry = oldest_entry;
+            release(*free_entry);
+        }
+
+        // The record opens a new window and passes immediately
+        entry& e = *free_entry;
+        e.m_First = rec;
+        extract_key(e.m_First, e.m_Key);
+        e.m_Hash = hash;
+        e.m_WindowEnd = time + m_Window;
+        m_Released.push_back(rec);
+    }
+};
+
+//! Constructor
+BOOST_LOG_API record_coalescer::record_coalescer(uint64_t window) :
+    m_pImpl(new implementation(window))
+{
+}
+
+//! Destructor
+BOOST_LOG_API record_coalescer::~record_coalescer()
+{
+    delete m_pImpl;
+}
+
+//! Passes the record through the stage
+BOOST_LOG_API void record_coalescer::push(record_view const& rec)
+{
+    m_pImpl->push(rec);
+}
+
+//! Releases the merged records whose windows are closed, or all merged records
+BOOST_LOG_API void record_coalescer::expire(bool all)
+{
+    if (m_pImpl->m_MergedCount > 0u)
+        m_pImpl->expire(m_pImpl->now(), all);
+}
+
+//! Extracts the next released record
+BOOST_LOG_API bool record_coalescer::pop(record_view& rec)
+{
+    if (!m_pImpl->m_Released.empty())
+    {
+        rec.swap(m_pImpl->m_Released.front());
+        m_pImpl->m_Released.pop_front();
+        return true;
+    }
+    return false;
+}
+
+//! Returns \c true if there are merged records that are not released yet
+BOOST_LOG_API bool record_coalescer::has_merged_records() const
+{
+    return m_pImpl->m_MergedCount > 0u;
+}
+
+//! Returns the number of milliseconds until the first merged record is due to be released
+BOOST_LOG_API uint64_t record_coalescer::time_to_expiration() const
+{
+    const uint64_t time = m_pImpl->now();
+    return m_pImpl->m_NextExpiration > time ? m_pImpl->m_NextExpiration - time : 0u;
+}
+
+} // namespace aux
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
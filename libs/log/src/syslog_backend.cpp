@@ -18,6 +18,9 @@
 #include "windows_version.hpp"
 #include <boost/log/detail/config.hpp>
 #include <memory>
+#include <deque>
+#include <vector>
+#include <string>
 #include <algorithm>
 #include <stdexcept>
 #include <boost/limits.hpp>
@@ -26,16 +29,25 @@
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/throw_exception.hpp>
+#include <boost/cstdint.hpp>
 #if !defined(BOOST_LOG_NO_ASIO)
+#include <boost/bind.hpp>
 #include <boost/asio/buffer.hpp>
+#include <boost/asio/placeholders.hpp>
+#include <boost/asio/deadline_timer.hpp>
 #include <boost/asio/socket_base.hpp>
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/ip/udp.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
 #include <boost/asio/ip/address.hpp>
 #include <boost/asio/ip/host_name.hpp>
 #endif
 #include <boost/system/error_code.hpp>
+#include <boost/system/system_error.hpp>
 #include <boost/date_time/c_time.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 #include <ctime>
 #include <boost/log/sinks/syslog_backend.hpp>
 #include <boost/log/detail/singleton.hpp>
@@ -44,6 +56,8 @@
 #if !defined(BOOST_LOG_NO_THREADS)
 #include <boost/thread/locks.hpp>
 #include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/condition_variable.hpp>
 #endif
 
 #ifdef BOOST_LOG_USE_NATIVE_SYSLOG
@@ -91,6 +105,9 @@ struct syslog_backend::implementation
 #endif // BOOST_LOG_USE_NATIVE_SYSLOG
 #if !defined(BOOST_LOG_NO_ASIO)
     struct udp_socket_based;
+    struct stream_socket_based;
+    template< typename ProtocolT >
+    struct basic_stream_socket_based;
 #endif
 
     //! Level mapper
@@ -109,6 +126,8 @@ struct syslog_backend::implementation
 
     //! The method sends the formatted message to the syslog host
     virtual void send(syslog::level lev, string_type const& formatted_message) = 0;
+    //! The method sends any buffered messages to the syslog host
+    virtual void flush() {}
 };
 
 
@@ -320,12 +339,12 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
         syslog_udp_socket& operator= (syslog_udp_socket const&);
     };
 
-    //! The class contains the UDP service for syslog sockets to function
-    class syslog_udp_service :
-        public log::aux::lazy_singleton< syslog_udp_service, shared_ptr< syslog_udp_service > >
+    //! The class contains the IO service for syslog sockets to function
+    class syslog_service :
+        public log::aux::lazy_singleton< syslog_service, shared_ptr< syslog_service > >
     {
-        friend class log::aux::lazy_singleton< syslog_udp_service, shared_ptr< syslog_udp_service > >;
-        typedef log::aux::lazy_singleton< syslog_udp_service, shared_ptr< syslog_udp_service > > base_type;
+        friend class log::aux::lazy_singleton< syslog_service, shared_ptr< syslog_service > >;
+        typedef log::aux::lazy_singleton< syslog_service, shared_ptr< syslog_service > > base_type;
 
     public:
         //! The core IO service instance
@@ -338,13 +357,16 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
         mutex m_Mutex;
         //! The resolver is used to acquire connection endpoints
         asio::ip::udp::resolver m_HostNameResolver;
+        //! The resolver is used to acquire connection endpoints for TCP connections
+        asio::ip::tcp::resolver m_StreamHostNameResolver;
 #endif // !defined(BOOST_LOG_NO_THREADS)
 
     private:
         //! Default constructor
-        syslog_udp_service()
+        syslog_service()
 #if !defined(BOOST_LOG_NO_THREADS)
-            : m_HostNameResolver(m_IOService)
+            : m_HostNameResolver(m_IOService),
+              m_StreamHostNameResolver(m_IOService)
 #endif // !defined(BOOST_LOG_NO_THREADS)
         {
             boost::system::error_code err;
@@ -353,7 +375,7 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
         //! Initializes the singleton instance
         static void init_instance()
         {
-            base_type::get_instance().reset(new syslog_udp_service());
+            base_type::get_instance().reset(new syslog_service());
         }
     };
 
@@ -391,6 +413,53 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
         m_Socket.send_to(asio::buffer(packet, packet_size), target);
     }
 
+    //! The function composes a syslog message frame with octet-counting framing, according to RFC6587
+    void make_stream_frame(std::string& frame, int pri, const char* local_host_name, std::string const& message)
+    {
+        std::time_t t = std::time(NULL);
+        std::tm ts;
+        std::tm* time_stamp = boost::date_time::c_time::localtime(&t, &ts);
+
+        static const char months[12][4] =
+        {
+            "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+        };
+
+        // The header has the same format as for UDP packets, but the message itself is not truncated
+        char header[256];
+        int header_size = boost::log::aux::snprintf
+        (
+            header,
+            sizeof(header),
+            "<%d> %s % 2d %02d:%02d:%02d %s ",
+            pri,
+            months[time_stamp->tm_mon],
+            time_stamp->tm_mday,
+            time_stamp->tm_hour,
+            time_stamp->tm_min,
+            time_stamp->tm_sec,
+            local_host_name
+        );
+        if (header_size < 0)
+            header_size = 0;
+        else if (static_cast< unsigned int >(header_size) >= sizeof(header))
+            header_size = static_cast< int >(sizeof(header) - 1u);
+
+        char length[std::numeric_limits< unsigned long >::digits10 + 3];
+        int length_size = boost::log::aux::snprintf
+        (
+            length,
+            sizeof(length),
+            "%lu ",
+            static_cast< unsigned long >(header_size + message.size())
+        );
+
+        frame.reserve(length_size + header_size + message.size());
+        frame.append(length, static_cast< std::size_t >(length_size));
+        frame.append(header, static_cast< std::size_t >(header_size));
+        frame.append(message);
+    }
+
 } // namespace
 
 struct syslog_backend::implementation::udp_socket_based :
@@ -399,7 +468,7 @@ struct syslog_backend::implementation::udp_socket_based :
     //! Protocol to be used
     asio::ip::udp m_Protocol;
     //! Pointer to the list of sockets
-    shared_ptr< syslog_udp_service > m_pService;
+    shared_ptr< syslog_service > m_pService;
     //! Pointer to the socket being used
     std::auto_ptr< syslog_udp_socket > m_pSocket;
     //! The target host to send packets to
@@ -409,7 +478,7 @@ struct syslog_backend::implementation::udp_socket_based :
     explicit udp_socket_based(syslog::facility const& fac, asio::ip::udp const& protocol) :
         implementation(fac),
         m_Protocol(protocol),
-        m_pService(syslog_udp_service::get())
+        m_pService(syslog_service::get())
     {
         if (m_Protocol == asio::ip::udp::v4())
         {
@@ -442,6 +511,523 @@ struct syslog_backend::implementation::udp_socket_based :
     }
 };
 
+//! Common part of the stream socket-based implementations
+/*!
+ * The socket operations are performed asynchronously by a dedicated IO thread (or, in single-threaded builds,
+ * by the thread that feeds or flushes the backend), so that an unresponsive syslog server does not block
+ * the logging threads. The errors of the socket operations are reported by throwing an exception from
+ * the subsequent calls to \c send or \c flush.
+ */
+struct syslog_backend::implementation::stream_socket_based :
+    public implementation
+{
+    //! The type of the queue of pending messages
+    typedef std::deque< std::string > frame_queue;
+
+    enum
+    {
+        //! The minimum interval between connection attempts, in seconds
+        reconnect_interval = 1,
+        //! The maximum duration of a connection or write operation, in seconds
+        io_timeout = 5
+    };
+
+    //! Pointer to the syslog service
+    shared_ptr< syslog_service > m_pService;
+    //! The IO service that runs the socket operations
+    asio::io_service m_IOService;
+    //! The timer limits the duration of the socket operations
+    asio::deadline_timer m_Timer;
+#if !defined(BOOST_LOG_NO_THREADS)
+    //! Synchronization mutex, protects the pending messages and the state shared with the IO thread
+    mutex m_Mutex;
+    //! The condition is signalled when a write attempt completes
+    condition_variable m_Cond;
+    //! The object keeps the IO service running while the IO thread is active
+    std::auto_ptr< asio::io_service::work > m_pWork;
+    //! The IO thread
+    thread m_Thread;
+#endif // !defined(BOOST_LOG_NO_THREADS)
+    //! Framed messages that have not been written to the socket yet
+    frame_queue m_Frames;
+    //! Total size of the pending messages
+    std::size_t m_PendingSize;
+    //! The amount of pending data that triggers writing to the socket
+    std::size_t m_WriteThreshold;
+    //! The maximum amount of pending data to keep while the connection is not available
+    std::size_t m_MaxBacklogSize;
+    //! The number of completed write attempts
+    uintmax_t m_AttemptCount;
+    //! The flag indicates that a write request is being processed
+    bool m_WriteInProgress;
+    //! The flag indicates that all pending messages have to be written, regardless of the threshold
+    bool m_FlushRequested;
+    //! The flag indicates that the connection has to be re-established before writing
+    bool m_ResetRequested;
+    //! The error of the last failed socket operation that has not been reported yet
+    boost::system::error_code m_LastError;
+
+    //  The following members are only used by the socket operations
+    //! The time before which no connection attempts will be made
+    std::time_t m_NextConnectTime;
+    //! The flag indicates that the current socket operation has been aborted due to timeout
+    bool m_TimedOut;
+    //! The messages being written to the socket
+    frame_queue m_WrittenFrames;
+    //! Buffer sequence for gather writes, cached to avoid memory allocations
+    std::vector< asio::const_buffer > m_Buffers;
+
+    //! Constructor
+    explicit stream_socket_based(syslog::facility const& fac) :
+        implementation(fac),
+        m_pService(syslog_service::get()),
+        m_Timer(m_IOService),
+        m_PendingSize(0),
+        m_WriteThreshold(0),
+        m_MaxBacklogSize(1024u * 1024u),
+        m_AttemptCount(0),
+        m_WriteInProgress(false),
+        m_FlushRequested(false),
+        m_ResetRequested(false),
+        m_NextConnectTime(0),
+        m_TimedOut(false)
+    {
+    }
+
+    //! The method sends the formatted message to the syslog host
+    void send(syslog::level lev, string_type const& formatted_message)
+    {
+        std::string frame;
+        make_stream_frame(
+            frame,
+            this->m_Facility | static_cast< int >(lev),
+            m_pService->m_LocalHostName.c_str(),
+            formatted_message);
+
+        {
+            BOOST_LOG_EXPR_IF_MT(lock_guard< mutex > lock(m_Mutex);)
+            m_Frames.push_back(std::string());
+            m_Frames.back().swap(frame);
+            m_PendingSize += m_Frames.back().size();
+
+            // Discard the oldest messages if the backlog is too large, but always keep the latest one
+            while (m_PendingSize > m_MaxBacklogSize && m_Frames.size() > 1u)
+            {
+                m_PendingSize -= m_Frames.front().size();
+                m_Frames.pop_front();
+            }
+
+            if (m_PendingSize > m_WriteThreshold)
+                request_write_unlocked();
+        }
+
+#if defined(BOOST_LOG_NO_THREADS)
+        run_pending();
+#endif
+        rethrow_error();
+    }
+
+    //! The method sends any buffered messages to the syslog host and waits for the write attempt to complete
+    void flush()
+    {
+        {
+#if !defined(BOOST_LOG_NO_THREADS)
+            unique_lock< mutex > lock(m_Mutex);
+#endif
+            if (!m_Frames.empty())
+            {
+                m_FlushRequested = true;
+#if !defined(BOOST_LOG_NO_THREADS)
+                // The write that is in progress may not include the messages that are pending now
+                const uintmax_t attempt_count = m_AttemptCount + (m_WriteInProgress ? 2u : 1u);
+                request_write_unlocked();
+                while (m_WriteInProgress && m_AttemptCount < attempt_count)
+                    m_Cond.wait(lock);
+#else
+                request_write_unlocked();
+#endif
+            }
+        }
+
+#if defined(BOOST_LOG_NO_THREADS)
+        run_pending();
+#endif
+        rethrow_error();
+    }
+
+    //! The method requests to re-establish the connection before writing
+    void reset_connection()
+    {
+        BOOST_LOG_EXPR_IF_MT(lock_guard< mutex > lock(m_Mutex);)
+        m_ResetRequested = true;
+    }
+
+    //! The method sets the amount of pending data that triggers writing to the socket
+    void set_write_threshold(std::size_t size)
+    {
+        BOOST_LOG_EXPR_IF_MT(lock_guard< mutex > lock(m_Mutex);)
+        m_WriteThreshold = size;
+    }
+
+    //! The method sets the maximum amount of pending data to keep while the connection is not available
+    void set_max_backlog_size(std::size_t size)
+    {
+        BOOST_LOG_EXPR_IF_MT(lock_guard< mutex > lock(m_Mutex);)
+        m_MaxBacklogSize = size;
+    }
+
+protected:
+    //! The method makes an attempt to deliver the pending messages and stops the socket operations
+    void stop()
+    {
+        try
+        {
+            flush();
+        }
+        catch (...)
+        {
+        }
+
+#if !defined(BOOST_LOG_NO_THREADS)
+        if (m_Thread.joinable())
+        {
+            m_pWork.reset();
+            m_IOService.stop();
+            m_Thread.join();
+        }
+#endif // !defined(BOOST_LOG_NO_THREADS)
+    }
+
+    //! The method starts writing the pending messages, establishing the connection first, if needed
+    void start_write()
+    {
+        bool reset_requested;
+        {
+            BOOST_LOG_EXPR_IF_MT(lock_guard< mutex > lock(m_Mutex);)
+            reset_requested = m_ResetRequested;
+            m_ResetRequested = false;
+        }
+        if (reset_requested)
+        {
+            disconnect();
+            m_NextConnectTime = 0;
+        }
+
+        if (is_connected())
+            write_frames();
+        else if (std::time(NULL) >= m_NextConnectTime)
+            start_connect();
+        else
+            complete_attempt(boost::system::error_code());
+    }
+
+    //! The method is called when the connection is established or fails
+    void on_connected(boost::system::error_code const& err)
+    {
+        stop_timer();
+        if (!err)
+            write_frames();
+        else
+            fail(err);
+    }
+
+    //! The method is called when the messages are written to the socket or the write fails
+    void on_written(boost::system::error_code const& err, std::size_t written)
+    {
+        stop_timer();
+
+        // Remove the messages that were written completely. A partially written message
+        // will be sent again as a whole after reconnection.
+        while (!m_WrittenFrames.empty() && written >= m_WrittenFrames.front().size())
+        {
+            written -= m_WrittenFrames.front().size();
+            m_WrittenFrames.pop_front();
+        }
+
+        if (!err)
+        {
+            complete_attempt(err);
+        }
+        else
+        {
+            {
+                BOOST_LOG_EXPR_IF_MT(lock_guard< mutex > lock(m_Mutex);)
+                while (!m_WrittenFrames.empty())
+                {
+                    m_PendingSize += m_WrittenFrames.back().size();
+                    m_Frames.push_front(std::string());
+                    m_Frames.front().swap(m_WrittenFrames.back());
+                    m_WrittenFrames.pop_back();
+                }
+            }
+            fail(err);
+        }
+    }
+
+    //! The method starts the timer that limits the duration of the socket operation
+    void start_timer()
+    {
+        m_TimedOut = false;
+        m_Timer.expires_from_now(posix_time::seconds(static_cast< long >(io_timeout)));
+        m_Timer.async_wait(boost::bind(&stream_socket_based::on_timeout, this, asio::placeholders::error));
+    }
+
+    //! The method checks if the connection is established
+    virtual bool is_connected() const = 0;
+    //! The method starts establishing the connection to the syslog host, which completes with \c on_connected
+    virtual void start_connect() = 0;
+    //! The method closes the connection
+    virtual void disconnect() = 0;
+    //! The method starts writing the buffer sequence to the socket, which completes with \c on_written
+    virtual void start_write(std::vector< asio::const_buffer > const& buffers) = 0;
+
+private:
+    //! The method requests writing the pending messages. Must be called with the mutex locked.
+    void request_write_unlocked()
+    {
+        if (!m_WriteInProgress)
+        {
+            m_WriteInProgress = true;
+#if !defined(BOOST_LOG_NO_THREADS)
+            if (!m_Thread.joinable())
+            {
+                m_pWork.reset(new asio::io_service::work(m_IOService));
+                boost::thread(boost::bind(&stream_socket_based::run, this)).swap(m_Thread);
+            }
+#endif // !defined(BOOST_LOG_NO_THREADS)
+            m_IOService.post(boost::bind(&stream_socket_based::start_write, this));
+        }
+    }
+
+#if !defined(BOOST_LOG_NO_THREADS)
+    //! IO thread function
+    void run()
+    {
+        m_IOService.run();
+    }
+#else
+    //! The method performs the requested socket operations in the current thread
+    void run_pending()
+    {
+        m_IOService.reset();
+        m_IOService.run();
+    }
+#endif // !defined(BOOST_LOG_NO_THREADS)
+
+    //! The method throws an exception if a socket operation failed since the last call
+    void rethrow_error()
+    {
+        boost::system::error_code err;
+        {
+            BOOST_LOG_EXPR_IF_MT(lock_guard< mutex > lock(m_Mutex);)
+            if (!m_LastError)
+                return;
+            err = m_LastError;
+            m_LastError.clear();
+        }
+        BOOST_THROW_EXCEPTION(boost::system::system_error(err, "Failed to send log records to the syslog server"));
+    }
+
+    //! The method writes all pending messages to the socket
+    void write_frames()
+    {
+        {
+            BOOST_LOG_EXPR_IF_MT(lock_guard< mutex > lock(m_Mutex);)
+            m_WrittenFrames.swap(m_Frames);
+            m_PendingSize = 0;
+            m_FlushRequested = false;
+        }
+
+        if (m_WrittenFrames.empty())
+        {
+            complete_attempt(boost::system::error_code());
+            return;
+        }
+
+        m_Buffers.clear();
+        for (frame_queue::const_iterator it = m_WrittenFrames.begin(), end = m_WrittenFrames.end(); it != end; ++it)
+        {
+            m_Buffers.push_back(asio::buffer(*it));
+        }
+
+        start_timer();
+        start_write(m_Buffers);
+    }
+
+    //! The method drops the connection after a failed socket operation
+    void fail(boost::system::error_code err)
+    {
+        if (m_TimedOut && err == asio::error::operation_aborted)
+            err = asio::error::timed_out;
+        disconnect();
+        m_NextConnectTime = std::time(NULL) + reconnect_interval;
+        complete_attempt(err);
+    }
+
+    //! The method completes the write attempt and starts the next one if there are enough pending messages
+    void complete_attempt(boost::system::error_code const& err)
+    {
+        bool proceed = false;
+        {
+            BOOST_LOG_EXPR_IF_MT(lock_guard< mutex > lock(m_Mutex);)
+            ++m_AttemptCount;
+            if (err)
+                m_LastError = err;
+            else if (!m_Frames.empty() && (m_FlushRequested || m_PendingSize > m_WriteThreshold) && is_connected())
+                proceed = true;
+
+            if (!proceed)
+            {
+                m_WriteInProgress = false;
+                m_FlushRequested = false;
+            }
+            BOOST_LOG_EXPR_IF_MT(m_Cond.notify_all();)
+        }
+
+        if (proceed)
+            start_write();
+    }
+
+    //! The method cancels the timer
+    void stop_timer()
+    {
+        boost::system::error_code err;
+        m_Timer.expires_at(posix_time::pos_infin, err);
+    }
+
+    //! The method aborts the socket operation if it takes too long
+    void on_timeout(boost::system::error_code const& err)
+    {
+        // The timer may have expired after the operation completed and the timer was restarted for another one
+        if (!err && m_Timer.expires_at() <= asio::deadline_timer::traits_type::now())
+        {
+            m_TimedOut = true;
+            disconnect();
+        }
+    }
+};
+
+//! Stream socket-based implementation for the specified protocol
+template< typename ProtocolT >
+struct syslog_backend::implementation::basic_stream_socket_based :
+    public stream_socket_based
+{
+    //! Protocol type
+    typedef ProtocolT protocol_type;
+    //! Socket type
+    typedef typename protocol_type::socket socket_type;
+    //! Endpoint type
+    typedef typename protocol_type::endpoint endpoint_type;
+
+    //! Protocol to be used
+    protocol_type m_Protocol;
+    //! The socket
+    socket_type m_Socket;
+    //! The target host to connect to
+    endpoint_type m_TargetHost;
+    //! The local address to bind the socket to
+    endpoint_type m_LocalAddress;
+    //! The flag indicates that the socket has to be bound to the local address
+    bool m_BindLocalAddress;
+
+    //! Constructor
+    basic_stream_socket_based(syslog::facility const& fac, protocol_type const& protocol, endpoint_type const& target) :
+        stream_socket_based(fac),
+        m_Protocol(protocol),
+        m_Socket(m_IOService),
+        m_TargetHost(target),
+        m_BindLocalAddress(false)
+    {
+    }
+
+    //! Destructor. Makes an attempt to deliver pending messages.
+    ~basic_stream_socket_based()
+    {
+        stop();
+        disconnect();
+    }
+
+    //! The method sets the target host and drops the current connection
+    void set_target(endpoint_type const& target)
+    {
+        {
+            BOOST_LOG_EXPR_IF_MT(lock_guard< mutex > lock(m_Mutex);)
+            m_TargetHost = target;
+        }
+        reset_connection();
+    }
+
+    //! The method sets the local address and drops the current connection
+    void set_local(endpoint_type const& local)
+    {
+        {
+            BOOST_LOG_EXPR_IF_MT(lock_guard< mutex > lock(m_Mutex);)
+            m_LocalAddress = local;
+            m_BindLocalAddress = true;
+        }
+        reset_connection();
+    }
+
+protected:
+    //! The method checks if the connection is established
+    bool is_connected() const
+    {
+        return m_Socket.is_open();
+    }
+
+    //! The method starts establishing the connection to the syslog host
+    void start_connect()
+    {
+        endpoint_type target, local;
+        bool bind_local_address;
+        {
+            BOOST_LOG_EXPR_IF_MT(lock_guard< mutex > lock(m_Mutex);)
+            target = m_TargetHost;
+            local = m_LocalAddress;
+            bind_local_address = m_BindLocalAddress;
+        }
+
+        boost::system::error_code err;
+        m_Socket.open(m_Protocol, err);
+        if (!err && bind_local_address)
+        {
+            m_Socket.set_option(asio::socket_base::reuse_address(true), err);
+            if (!err)
+                m_Socket.bind(local, err);
+        }
+
+        if (!err)
+        {
+            start_timer();
+            m_Socket.async_connect(target, boost::bind(&basic_stream_socket_based::on_connected, this, asio::placeholders::error));
+        }
+        else
+        {
+            on_connected(err);
+        }
+    }
+
+    //! The method closes the connection
+    void disconnect()
+    {
+        if (m_Socket.is_open())
+        {
+            boost::system::error_code err;
+            m_Socket.shutdown(asio::socket_base::shutdown_both, err);
+            m_Socket.close(err);
+        }
+    }
+
+    //! The method starts writing the buffer sequence to the socket
+    void start_write(std::vector< asio::const_buffer > const& buffers)
+    {
+        asio::async_write(
+            m_Socket,
+            buffers,
+            boost::bind(&basic_stream_socket_based::on_written, this, asio::placeholders::error, asio::placeholders::bytes_transferred));
+    }
+};
+
 #endif // !defined(BOOST_LOG_NO_ASIO)
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -472,6 +1058,12 @@ BOOST_LOG_API void syslog_backend::consume(record_view const& rec, string_type c
         formatted_message);
 }
 
+//! The method writes any buffered messages to the syslog server
+BOOST_LOG_API void syslog_backend::flush()
+{
+    m_pImpl->flush();
+}
+
 
 //! The method creates the backend implementation
 BOOST_LOG_API void syslog_backend::construct(syslog::facility fac, syslog::impl_types use_impl, ip_versions ip_version, std::string const& ident)
@@ -486,6 +1078,36 @@ BOOST_LOG_API void syslog_backend::construct(syslog::facility fac, syslog::impl_
 #endif // BOOST_LOG_USE_NATIVE_SYSLOG
 
 #if !defined(BOOST_LOG_NO_ASIO)
+    if (use_impl == syslog::tcp_socket_based)
+    {
+        typedef implementation::basic_stream_socket_based< asio::ip::tcp > tcp_socket_based_impl;
+        switch (ip_version)
+        {
+        case v4:
+            m_pImpl = new tcp_socket_based_impl(fac, asio::ip::tcp::v4(),
+                asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 514)); // 127.0.0.1:514
+            break;
+        case v6:
+            m_pImpl = new tcp_socket_based_impl(fac, asio::ip::tcp::v6(),
+                asio::ip::tcp::endpoint(asio::ip::address_v6::loopback(), 514)); // ::1, port 514
+            break;
+        default:
+            BOOST_LOG_THROW_DESCR(setup_error, "Incorrect IP version specified");
+        }
+        return;
+    }
+
+    if (use_impl == syslog::local_socket_based)
+    {
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+        typedef implementation::basic_stream_socket_based< asio::local::stream_protocol > local_socket_based_impl;
+        m_pImpl = new local_socket_based_impl(fac, asio::local::stream_protocol(), asio::local::stream_protocol::endpoint());
+        return;
+#else
+        BOOST_LOG_THROW_DESCR(setup_error, "Local sockets are not supported on this platform");
+#endif
+    }
+
     typedef implementation::udp_socket_based udp_socket_based_impl;
     switch (ip_version)
     {
@@ -526,6 +1148,28 @@ BOOST_LOG_API void syslog_backend::set_local_address(std::string const& addr, un
 
         impl->m_pSocket.reset(new syslog_udp_socket(impl->m_pService->m_IOService, impl->m_Protocol, local_address));
     }
+    else
+    {
+        typedef implementation::basic_stream_socket_based< asio::ip::tcp > tcp_socket_based_impl;
+        if (tcp_socket_based_impl* impl = dynamic_cast< tcp_socket_based_impl* >(m_pImpl))
+        {
+            char service_name[std::numeric_limits< int >::digits10 + 3];
+            boost::log::aux::snprintf(service_name, sizeof(service_name), "%d", static_cast< int >(port));
+            asio::ip::tcp::resolver::query q(
+                impl->m_Protocol,
+                addr,
+                service_name,
+                asio::ip::resolver_query_base::address_configured | asio::ip::resolver_query_base::passive);
+            asio::ip::tcp::endpoint local_address;
+
+            {
+                lock_guard< mutex > _(impl->m_pService->m_Mutex);
+                local_address = *impl->m_pService->m_StreamHostNameResolver.resolve(q);
+            }
+
+            impl->set_local(local_address);
+        }
+    }
 #else
     // Boost.ASIO requires threads for the host name resolver,
     // so without threads wi simply assume the string already contains IP address
@@ -541,6 +1185,12 @@ BOOST_LOG_API void syslog_backend::set_local_address(boost::asio::ip::address co
         impl->m_pSocket.reset(new syslog_udp_socket(
             impl->m_pService->m_IOService, impl->m_Protocol, asio::ip::udp::endpoint(addr, port)));
     }
+    else
+    {
+        typedef implementation::basic_stream_socket_based< asio::ip::tcp > tcp_socket_based_impl;
+        if (tcp_socket_based_impl* impl = dynamic_cast< tcp_socket_based_impl* >(m_pImpl))
+            impl->set_local(asio::ip::tcp::endpoint(addr, port));
+    }
 }
 
 //! The method sets the address of the remote host where log records will be sent to.
@@ -562,6 +1212,24 @@ BOOST_LOG_API void syslog_backend::set_target_address(std::string const& addr, u
 
         impl->m_TargetHost = remote_address;
     }
+    else
+    {
+        typedef implementation::basic_stream_socket_based< asio::ip::tcp > tcp_socket_based_impl;
+        if (tcp_socket_based_impl* impl = dynamic_cast< tcp_socket_based_impl* >(m_pImpl))
+        {
+            char service_name[std::numeric_limits< int >::digits10 + 3];
+            boost::log::aux::snprintf(service_name, sizeof(service_name), "%d", static_cast< int >(port));
+            asio::ip::tcp::resolver::query q(impl->m_Protocol, addr, service_name, asio::ip::resolver_query_base::address_configured);
+            asio::ip::tcp::endpoint remote_address;
+
+            {
+                lock_guard< mutex > _(impl->m_pService->m_Mutex);
+                remote_address = *impl->m_pService->m_StreamHostNameResolver.resolve(q);
+            }
+
+            impl->set_target(remote_address);
+        }
+    }
 #else
     // Boost.ASIO requires threads for the host name resolver,
     // so without threads wi simply assume the string already contains IP address
@@ -576,6 +1244,38 @@ BOOST_LOG_API void syslog_backend::set_target_address(boost::asio::ip::address c
     {
         impl->m_TargetHost = asio::ip::udp::endpoint(addr, port);
     }
+    else
+    {
+        typedef implementation::basic_stream_socket_based< asio::ip::tcp > tcp_socket_based_impl;
+        if (tcp_socket_based_impl* impl = dynamic_cast< tcp_socket_based_impl* >(m_pImpl))
+            impl->set_target(asio::ip::tcp::endpoint(addr, port));
+    }
+}
+
+//! The method sets the path of the local stream socket where log records will be sent to.
+BOOST_LOG_API void syslog_backend::set_target_socket(std::string const& path)
+{
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+    typedef implementation::basic_stream_socket_based< asio::local::stream_protocol > local_socket_based_impl;
+    if (local_socket_based_impl* impl = dynamic_cast< local_socket_based_impl* >(m_pImpl))
+        impl->set_target(asio::local::stream_protocol::endpoint(path));
+#endif // defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+}
+
+//! The method sets the amount of buffered data that triggers writing to the socket
+BOOST_LOG_API void syslog_backend::set_write_threshold(std::size_t size)
+{
+    typedef implementation::stream_socket_based stream_socket_based_impl;
+    if (stream_socket_based_impl* impl = dynamic_cast< stream_socket_based_impl* >(m_pImpl))
+        impl->set_write_threshold(size);
+}
+
+//! The method sets the maximum amount of data kept while the connection is not available
+BOOST_LOG_API void syslog_backend::set_max_backlog_size(std::size_t size)
+{
+    typedef implementation::stream_socket_based stream_socket_based_impl;
+    if (stream_socket_based_impl* impl = dynamic_cast< stream_socket_based_impl* >(m_pImpl))
+        impl->set_max_backlog_size(size);
 }
 
 #endif // !defined(BOOST_LOG_NO_ASIO)
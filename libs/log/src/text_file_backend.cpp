@@ -21,6 +21,8 @@
 #include <cstdlib>
 #include <cstddef>
 #include <list>
+#include <deque>
+#include <vector>
 #include <memory>
 #include <string>
 #include <locale>
@@ -42,6 +44,8 @@
 #include <boost/filesystem/fstream.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/convenience.hpp>
+#include <boost/functional/hash/hash.hpp>
+#include <boost/unordered_set.hpp>
 #include <boost/intrusive/list.hpp>
 #include <boost/intrusive/list_hook.hpp>
 #include <boost/intrusive/options.hpp>
@@ -58,10 +62,25 @@
 #include <boost/log/attributes/time_traits.hpp>
 #include <boost/log/sinks/text_file_backend.hpp>
 #include <boost/log/sinks/text_multifile_backend.hpp>
+#include "file_stream.hpp"
+
+#if defined(BOOST_WINDOWS_API)
+#include "windows_version.hpp"
+#include <windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#endif
 
 #if !defined(BOOST_LOG_NO_THREADS)
+#include <boost/exception_ptr.hpp>
 #include <boost/thread/locks.hpp>
 #include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/condition_variable.hpp>
 #endif // !defined(BOOST_LOG_NO_THREADS)
 
 #include <boost/log/detail/header.hpp>
@@ -109,6 +128,92 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
 
     typedef filesystem::filesystem_error filesystem_error;
 
+    //! File identity in the file system
+    struct file_id
+    {
+        uintmax_t m_Device;
+        uintmax_t m_Index;
+
+        file_id() : m_Device(0), m_Index(0) {}
+
+        bool operator== (file_id const& that) const
+        {
+            return m_Device == that.m_Device && m_Index == that.m_Index;
+        }
+        friend std::size_t hash_value(file_id const& id)
+        {
+            std::size_t seed = 0;
+            boost::hash_combine(seed, id.m_Device);
+            boost::hash_combine(seed, id.m_Index);
+            return seed;
+        }
+    };
+
+    //! Attributes of a regular file
+    struct file_attributes
+    {
+        file_id m_Id;
+        uintmax_t m_Size;
+        std::time_t m_TimeStamp;
+    };
+
+#if !defined(BOOST_WINDOWS_API)
+
+    //! Fills file attributes from the file status
+    inline bool to_file_attributes(struct stat const& st, file_attributes& attrs)
+    {
+        if (!S_ISREG(st.st_mode))
+            return false;
+        attrs.m_Id.m_Device = static_cast< uintmax_t >(st.st_dev);
+        attrs.m_Id.m_Index = static_cast< uintmax_t >(st.st_ino);
+        attrs.m_Size = static_cast< uintmax_t >(st.st_size);
+        attrs.m_TimeStamp = st.st_mtime;
+        return true;
+    }
+
+    //! Acquires attributes of a regular file with a single system call. Returns \c false if the file is not a regular file or cannot be accessed.
+    inline bool get_file_attributes(filesystem::path const& p, file_attributes& attrs)
+    {
+        struct stat st;
+        if (::stat(p.c_str(), &st) != 0)
+            return false;
+        return to_file_attributes(st, attrs);
+    }
+
+#else // !defined(BOOST_WINDOWS_API)
+
+    //! Acquires attributes of a regular file. Returns \c false if the file is not a regular file or cannot be accessed.
+    inline bool get_file_attributes(filesystem::path const& p, file_attributes& attrs)
+    {
+        HANDLE h = CreateFileW(
+            p.c_str(),
+            0,
+            FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+            NULL,
+            OPEN_EXISTING,
+            FILE_FLAG_BACKUP_SEMANTICS,
+            NULL);
+        if (h == INVALID_HANDLE_VALUE)
+            return false;
+
+        BY_HANDLE_FILE_INFORMATION info;
+        const BOOL result = GetFileInformationByHandle(h, &info);
+        CloseHandle(h);
+        if (!result || (info.dwFileAttributes & (FILE_ATTRIBUTE_DIRECTORY | FILE_ATTRIBUTE_DEVICE)) != 0)
+            return false;
+
+        attrs.m_Id.m_Device = info.dwVolumeSerialNumber;
+        attrs.m_Id.m_Index = (static_cast< uintmax_t >(info.nFileIndexHigh) << 32) | info.nFileIndexLow;
+        attrs.m_Size = (static_cast< uintmax_t >(info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+
+        // Convert FILETIME (100 ns intervals since 1601-01-01) to time_t
+        const uint64_t file_time = (static_cast< uint64_t >(info.ftLastWriteTime.dwHighDateTime) << 32) | info.ftLastWriteTime.dwLowDateTime;
+        attrs.m_TimeStamp = static_cast< std::time_t >((file_time - 116444736000000000ULL) / 10000000u);
+        return true;
+    }
+
+#endif // !defined(BOOST_WINDOWS_API)
+
     //! An auxiliary traits that contain various constants and functions regarding string and character operations
     template< typename CharT >
     struct file_char_traits;
@@ -469,6 +574,31 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
     }
 
 
+    //! The guard removes the temporary file on destruction, unless released
+    class temporary_file_guard
+    {
+    private:
+        filesystem::path m_Path;
+
+    public:
+        temporary_file_guard() {}
+        ~temporary_file_guard()
+        {
+            if (!m_Path.empty())
+            {
+                system::error_code ec;
+                filesystem::remove(m_Path, ec);
+            }
+        }
+
+        void reset(filesystem::path const& p) { m_Path = p; }
+        void release() { m_Path.clear(); }
+
+    private:
+        temporary_file_guard(temporary_file_guard const&);
+        temporary_file_guard& operator= (temporary_file_guard const&);
+    };
+
     class file_collector_repository;
 
     //! Type of the hook used for sequencing file collectors
@@ -489,9 +619,22 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
             uintmax_t m_Size;
             std::time_t m_TimeStamp;
             filesystem::path m_Path;
+            //! File identity, if known
+            file_id m_Id;
+            bool m_HasId;
+
+            file_info() : m_Size(0), m_TimeStamp(0), m_HasId(false) {}
+
+            //! Ordering by the file time stamp
+            static bool order_by_time(file_info const& left, file_info const& right)
+            {
+                return left.m_TimeStamp < right.m_TimeStamp;
+            }
         };
-        //! A list of the stored files
+        //! A list of the stored files, ordered by the time stamp
         typedef std::list< file_info > file_list;
+        //! A set of identities of the stored files
+        typedef unordered_set< file_id, boost::hash< file_id > > file_id_set;
         //! The string type compatible with the universal path type
         typedef filesystem::path::string_type path_string_type;
 
@@ -504,10 +647,17 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
         mutex m_Mutex;
 #endif // !defined(BOOST_LOG_NO_THREADS)
 
+#if !defined(BOOST_LOG_NO_THREADS)
+        //! The mutex serializes file compression
+        mutex m_CompressionMutex;
+#endif // !defined(BOOST_LOG_NO_THREADS)
+
         //! Total file size upper limit
         uintmax_t m_MaxSize;
         //! Free space lower limit
         uintmax_t m_MinFreeSpace;
+        //! File compressor
+        shared_ptr< file::compressor > m_pCompressor;
         //! The current path at the point when the collector is created
         /*
          * The special member is required to calculate absolute paths with no
@@ -519,6 +669,8 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
 
         //! The list of stored files
         file_list m_Files;
+        //! Identities of the stored files
+        file_id_set m_FileIds;
         //! Total size of the stored files
         uintmax_t m_TotalSize;
 
@@ -528,7 +680,8 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
             shared_ptr< file_collector_repository > const& repo,
             filesystem::path const& target_dir,
             uintmax_t max_size,
-            uintmax_t min_free_space);
+            uintmax_t min_free_space,
+            shared_ptr< file::compressor > const& comp);
 
         //! Destructor
         ~file_collector();
@@ -541,7 +694,14 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
             file::scan_method method, filesystem::path const& pattern, unsigned int* counter);
 
         //! The function updates storage restrictions
-        void update(uintmax_t max_size, uintmax_t min_free_space);
+        void update(uintmax_t max_size, uintmax_t min_free_space, shared_ptr< file::compressor > const& comp);
+
+        //! The function checks if the collector compresses the stored files
+        bool has_compressor()
+        {
+            BOOST_LOG_EXPR_IF_MT(lock_guard< mutex > lock(m_Mutex);)
+            return !!m_pCompressor;
+        }
 
         //! The function checks if the directory is governed by this collector
         bool is_governed(filesystem::path const& dir) const
@@ -560,6 +720,74 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
         {
             return p.filename().string< path_string_type >();
         }
+        //! Returns the suffix of the temporary files the stored files are compressed into
+        static filesystem::path temporary_file_suffix()
+        {
+            return filesystem::path(".tmp");
+        }
+
+        //! Adds the file to the list of stored files, maintaining the order by time
+        void add_file(file_info const& info)
+        {
+            file_list::iterator it = m_Files.end();
+            while (it != m_Files.begin())
+            {
+                file_list::iterator prev = it;
+                --prev;
+                if (!(info.m_TimeStamp < prev->m_TimeStamp))
+                    break;
+                it = prev;
+            }
+            m_Files.insert(it, info);
+            if (info.m_HasId)
+                m_FileIds.insert(info.m_Id);
+            m_TotalSize += info.m_Size;
+        }
+        //! Removes the file from the list of stored files
+        file_list::iterator remove_file(file_list::iterator it)
+        {
+            if (it->m_HasId)
+                m_FileIds.erase(it->m_Id);
+            m_TotalSize -= it->m_Size;
+            return m_Files.erase(it);
+        }
+
+        //! Checks if the file name matches the scan criteria
+        bool is_matching(path_string_type const& file_name, file::scan_method method, path_string_type const& mask, unsigned int& file_number) const
+        {
+            if (method != file::scan_matching)
+                return true;
+            if (match_pattern(file_name, mask, file_number))
+                return true;
+
+            // Compressed files have names with an additional suffix
+            if (!!m_pCompressor)
+            {
+                path_string_type suffix = m_pCompressor->file_name_suffix().string< path_string_type >();
+                if (file_name.size() > suffix.size() && file_name.compare(file_name.size() - suffix.size(), suffix.size(), suffix) == 0)
+                    return match_pattern(file_name.substr(0, file_name.size() - suffix.size()), mask, file_number);
+            }
+
+            return false;
+        }
+
+        //! Checks if the file is a temporary file left by an interrupted compression of a matching file
+        bool is_compression_leftover(path_string_type const& file_name, file::scan_method method, path_string_type const& mask) const
+        {
+            if (!m_pCompressor)
+                return false;
+
+            path_string_type suffix = m_pCompressor->file_name_suffix().string< path_string_type >();
+            suffix += temporary_file_suffix().string< path_string_type >();
+            if (file_name.size() <= suffix.size() || file_name.compare(file_name.size() - suffix.size(), suffix.size(), suffix) != 0)
+                return false;
+
+            unsigned int file_number = 0;
+            return method != file::scan_matching || match_pattern(file_name.substr(0, file_name.size() - suffix.size()), mask, file_number);
+        }
+
+        //! Compresses the file into the storage directory, returns the size of the compressed file
+        uintmax_t compress_file(file::compressor& comp, filesystem::path const& src_path, filesystem::path const& dest_path);
     };
 
 
@@ -594,7 +822,10 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
     public:
         //! Finds or creates a file collector
         shared_ptr< file::collector > get_collector(
-            filesystem::path const& target_dir, uintmax_t max_size, uintmax_t min_free_space);
+            filesystem::path const& target_dir,
+            uintmax_t max_size,
+            uintmax_t min_free_space,
+            shared_ptr< file::compressor > const& comp);
 
         //! Removes the file collector from the list
         void remove_collector(file_collector* p);
@@ -612,11 +843,13 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
         shared_ptr< file_collector_repository > const& repo,
         filesystem::path const& target_dir,
         uintmax_t max_size,
-        uintmax_t min_free_space
+        uintmax_t min_free_space,
+        shared_ptr< file::compressor > const& comp
     ) :
         m_pRepository(repo),
         m_MaxSize(max_size),
         m_MinFreeSpace(min_free_space),
+        m_pCompressor(comp),
         m_BasePath(filesystem::current_path()),
         m_TotalSize(0)
     {
@@ -635,10 +868,28 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
     {
         // Let's construct the new file name
         file_info info;
-        info.m_TimeStamp = filesystem::last_write_time(src_path);
-        info.m_Size = filesystem::file_size(src_path);
+        file_attributes attrs;
+        if (get_file_attributes(src_path, attrs))
+        {
+            info.m_TimeStamp = attrs.m_TimeStamp;
+            info.m_Size = attrs.m_Size;
+        }
+        else
+        {
+            info.m_TimeStamp = filesystem::last_write_time(src_path);
+            info.m_Size = filesystem::file_size(src_path);
+        }
+
+        shared_ptr< file::compressor > comp;
+        {
+            BOOST_LOG_EXPR_IF_MT(lock_guard< mutex > lock(m_Mutex);)
+            comp = m_pCompressor;
+        }
 
         path_string_type file_name = filename_string(src_path);
+        path_string_type::size_type counter_pos = file_name.size();
+        if (!!comp)
+            file_name += comp->file_name_suffix().string< path_string_type >();
         info.m_Path = m_StorageDir / file_name;
 
         // Check if the file is already in the target directory
@@ -646,13 +897,13 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
                             filesystem::system_complete(src_path.parent_path()) :
                             m_BasePath;
         const bool is_in_target_dir = filesystem::equivalent(src_dir, m_StorageDir);
-        if (!is_in_target_dir)
+        if (!is_in_target_dir || !!comp)
         {
             if (filesystem::exists(info.m_Path))
             {
                 // If the file already exists, try to mangle the file name
                 // to ensure there's no conflict. I'll need to make this customizable some day.
-                file_counter_formatter formatter(file_name.size(), 5);
+                file_counter_formatter formatter(counter_pos, 5);
                 unsigned int n = 0;
                 do
                 {
@@ -666,6 +917,18 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
             filesystem::create_directories(m_StorageDir);
         }
 
+        // Compress the file before applying the size thresholds, so that the compressed size is accounted
+        // The compressed file is removed if it cannot be put in place of the original file
+        filesystem::path compressed_path;
+        temporary_file_guard compressed_file_guard;
+        if (!!comp)
+        {
+            compressed_path = info.m_Path;
+            compressed_path += temporary_file_suffix();
+            info.m_Size = compress_file(*comp, src_path, compressed_path);
+            compressed_file_guard.reset(compressed_path);
+        }
+
         BOOST_LOG_EXPR_IF_MT(lock_guard< mutex > lock(m_Mutex);)
 
         // Check if an old file should be erased
@@ -675,7 +938,8 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
             (m_TotalSize + info.m_Size > m_MaxSize || (m_MinFreeSpace && m_MinFreeSpace > free_space)))
         {
             file_info& old_info = *it;
-            if (filesystem::exists(old_info.m_Path) && filesystem::is_regular_file(old_info.m_Path))
+            system::error_code ec;
+            if (filesystem::is_regular_file(filesystem::status(old_info.m_Path, ec)))
             {
                 try
                 {
@@ -684,8 +948,7 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
                     // to the erased file size on compressed filesystems
                     if (m_MinFreeSpace)
                         free_space = filesystem::space(m_StorageDir).available;
-                    m_TotalSize -= old_info.m_Size;
-                    m_Files.erase(it++);
+                    it = remove_file(it);
                 }
                 catch (system::system_error&)
                 {
@@ -696,19 +959,77 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
             else
             {
                 // If it's not a file or is absent, just remove it from the list
-                m_TotalSize -= old_info.m_Size;
-                m_Files.erase(it++);
+                it = remove_file(it);
             }
         }
 
-        if (!is_in_target_dir)
+        if (!!comp)
+        {
+            // Replace the original file with the compressed one
+            filesystem::rename(compressed_path, info.m_Path);
+            compressed_file_guard.release();
+            filesystem::remove(src_path);
+        }
+        else if (!is_in_target_dir)
         {
             // Move/rename the file to the target storage
             move_file(src_path, info.m_Path);
         }
 
-        m_Files.push_back(info);
-        m_TotalSize += info.m_Size;
+        if (get_file_attributes(info.m_Path, attrs))
+        {
+            info.m_Id = attrs.m_Id;
+            info.m_HasId = true;
+        }
+
+        add_file(info);
+    }
+
+    //! Compresses the file into the storage directory, returns the size of the compressed file
+    uintmax_t file_collector::compress_file(file::compressor& comp, filesystem::path const& src_path, filesystem::path const& dest_path)
+    {
+        // Only one file is compressed at a time to limit CPU usage
+        BOOST_LOG_EXPR_IF_MT(lock_guard< mutex > lock(m_CompressionMutex);)
+
+        try
+        {
+            filesystem::ifstream input(src_path, std::ios_base::in | std::ios_base::binary);
+            if (!input.is_open())
+            {
+                BOOST_THROW_EXCEPTION(filesystem_error(
+                    "Failed to open file for compression",
+                    src_path,
+                    system::error_code(system::errc::io_error, system::generic_category())));
+            }
+
+            filesystem::ofstream output(dest_path, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+            if (!output.is_open())
+            {
+                BOOST_THROW_EXCEPTION(filesystem_error(
+                    "Failed to open file for writing",
+                    dest_path,
+                    system::error_code(system::errc::io_error, system::generic_category())));
+            }
+
+            comp.compress(input, output);
+
+            output.close();
+            if (output.fail())
+            {
+                BOOST_THROW_EXCEPTION(filesystem_error(
+                    "Failed to write compressed file",
+                    dest_path,
+                    system::error_code(system::errc::io_error, system::generic_category())));
+            }
+        }
+        catch (...)
+        {
+            system::error_code ec;
+            filesystem::remove(dest_path, ec);
+            throw;
+        }
+
+        return filesystem::file_size(dest_path);
     }
 
     //! Scans the target directory for the files that have already been stored
@@ -738,48 +1059,131 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
                 if (counter)
                     *counter = 0;
 
-                file_list files;
-                filesystem::directory_iterator it(dir), end;
-                uintmax_t total_size = 0;
-                for (; it != end; ++it)
+                // Temporary files of interrupted compressions can only be told apart from the files
+                // being compressed at the moment when no compression is in progress
+#if !defined(BOOST_LOG_NO_THREADS)
+                unique_lock< mutex > compression_lock(m_CompressionMutex, try_to_lock);
+                const bool remove_leftovers = compression_lock.owns_lock();
+#else
+                const bool remove_leftovers = true;
+#endif
+                std::vector< filesystem::path > leftovers;
+
+                std::vector< file_info > files;
+
+#if !defined(BOOST_WINDOWS_API)
+                // Walk the directory with a single stat call per entry
+                DIR* d = ::opendir(dir.c_str());
+                if (!d)
                 {
-                    file_info info;
-                    info.m_Path = *it;
-                    if (filesystem::is_regular_file(info.m_Path))
+                    BOOST_THROW_EXCEPTION(filesystem_error(
+                        "Failed to open directory for scanning",
+                        dir,
+                        system::error_code(errno, system::system_category())));
+                }
+
+                try
+                {
+                    const int dir_fd = ::dirfd(d);
+                    while (struct dirent* entry = ::readdir(d))
                     {
-                        // Check that there are no duplicates in the resulting list
-                        struct local
-                        {
-                            static bool equivalent(filesystem::path const& left, file_info const& right)
-                            {
-                                return filesystem::equivalent(left, right.m_Path);
-                            }
-                        };
-                        if (std::find_if(m_Files.begin(), m_Files.end(),
-                            boost::bind(&local::equivalent, boost::cref(info.m_Path), _1)) == m_Files.end())
+                        const char* name = entry->d_name;
+                        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+                            continue;
+#if defined(DT_REG) && defined(DT_LNK) && defined(DT_UNKNOWN)
+                        if (entry->d_type != DT_REG && entry->d_type != DT_LNK && entry->d_type != DT_UNKNOWN)
+                            continue;
+#endif
+
+                        if (remove_leftovers && is_compression_leftover(name, method, mask))
                         {
-                            // Check that the file name matches the pattern
-                            unsigned int file_number = 0;
-                            if (method != file::scan_matching ||
-                                match_pattern(filename_string(info.m_Path), mask, file_number))
-                            {
-                                info.m_Size = filesystem::file_size(info.m_Path);
-                                total_size += info.m_Size;
-                                info.m_TimeStamp = filesystem::last_write_time(info.m_Path);
-                                files.push_back(info);
-                                ++file_count;
-
-                                if (counter && file_number >= *counter)
-                                    *counter = file_number + 1;
-                            }
+                            leftovers.push_back(dir / name);
+                            continue;
                         }
+
+                        unsigned int file_number = 0;
+                        if (!is_matching(name, method, mask, file_number))
+                            continue;
+
+                        struct stat st;
+                        file_attributes attrs;
+                        if (::fstatat(dir_fd, name, &st, 0) != 0 || !to_file_attributes(st, attrs))
+                            continue;
+
+                        // Check that the file is not already known
+                        if (m_FileIds.find(attrs.m_Id) != m_FileIds.end())
+                            continue;
+
+                        files.push_back(file_info());
+                        file_info& info = files.back();
+                        info.m_Path = dir / name;
+                        info.m_Size = attrs.m_Size;
+                        info.m_TimeStamp = attrs.m_TimeStamp;
+                        info.m_Id = attrs.m_Id;
+                        info.m_HasId = true;
+                        m_FileIds.insert(attrs.m_Id);
+
+                        if (counter && file_number >= *counter)
+                            *counter = file_number + 1;
+                    }
+                }
+                catch (...)
+                {
+                    ::closedir(d);
+                    throw;
+                }
+                ::closedir(d);
+#else // !defined(BOOST_WINDOWS_API)
+                filesystem::directory_iterator it(dir), end;
+                for (; it != end; ++it)
+                {
+                    filesystem::path const& p = it->path();
+                    if (remove_leftovers && is_compression_leftover(filename_string(p), method, mask))
+                    {
+                        leftovers.push_back(p);
+                        continue;
                     }
+
+                    unsigned int file_number = 0;
+                    if (!is_matching(filename_string(p), method, mask, file_number))
+                        continue;
+
+                    file_attributes attrs;
+                    if (!get_file_attributes(p, attrs))
+                        continue;
+
+                    // Check that the file is not already known
+                    if (m_FileIds.find(attrs.m_Id) != m_FileIds.end())
+                        continue;
+
+                    files.push_back(file_info());
+                    file_info& info = files.back();
+                    info.m_Path = p;
+                    info.m_Size = attrs.m_Size;
+                    info.m_TimeStamp = attrs.m_TimeStamp;
+                    info.m_Id = attrs.m_Id;
+                    info.m_HasId = true;
+                    m_FileIds.insert(attrs.m_Id);
+
+                    if (counter && file_number >= *counter)
+                        *counter = file_number + 1;
+                }
+#endif // !defined(BOOST_WINDOWS_API)
+
+                for (std::vector< filesystem::path >::const_iterator it = leftovers.begin(), end = leftovers.end(); it != end; ++it)
+                {
+                    system::error_code ec;
+                    filesystem::remove(*it, ec);
                 }
 
-                // Sort files chronologically
-                m_Files.splice(m_Files.end(), files);
-                m_TotalSize += total_size;
-                m_Files.sort(boost::bind(&file_info::m_TimeStamp, _1) < boost::bind(&file_info::m_TimeStamp, _2));
+                // Sort the found files chronologically, files with equal time stamps keep the order they were found in.
+                // Merging keeps the previously known files ahead of the found ones with the same time stamps.
+                std::stable_sort(files.begin(), files.end(), &file_info::order_by_time);
+                file_list found(files.begin(), files.end());
+                for (std::vector< file_info >::const_iterator it = files.begin(), end = files.end(); it != end; ++it)
+                    m_TotalSize += it->m_Size;
+                file_count = files.size();
+                m_Files.merge(found, &file_info::order_by_time);
             }
         }
 
@@ -787,18 +1191,23 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
     }
 
     //! The function updates storage restrictions
-    void file_collector::update(uintmax_t max_size, uintmax_t min_free_space)
+    void file_collector::update(uintmax_t max_size, uintmax_t min_free_space, shared_ptr< file::compressor > const& comp)
     {
         BOOST_LOG_EXPR_IF_MT(lock_guard< mutex > lock(m_Mutex);)
 
         m_MaxSize = (std::min)(m_MaxSize, max_size);
         m_MinFreeSpace = (std::max)(m_MinFreeSpace, min_free_space);
+        if (!!comp)
+            m_pCompressor = comp;
     }
 
 
     //! Finds or creates a file collector
     shared_ptr< file::collector > file_collector_repository::get_collector(
-        filesystem::path const& target_dir, uintmax_t max_size, uintmax_t min_free_space)
+        filesystem::path const& target_dir,
+        uintmax_t max_size,
+        uintmax_t min_free_space,
+        shared_ptr< file::compressor > const& comp)
     {
         BOOST_LOG_EXPR_IF_MT(lock_guard< mutex > lock(m_Mutex);)
 
@@ -809,7 +1218,7 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
         {
             // This may throw if the collector is being currently destroyed
             p = it->shared_from_this();
-            p->update(max_size, min_free_space);
+            p->update(max_size, min_free_space, comp);
         }
         catch (bad_weak_ptr&)
         {
@@ -818,7 +1227,7 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
         if (!p)
         {
             p = boost::make_shared< file_collector >(
-                file_collector_repository::get(), target_dir, max_size, min_free_space);
+                file_collector_repository::get(), target_dir, max_size, min_free_space, comp);
             m_Collectors.push_back(*p);
         }
 
@@ -832,6 +1241,424 @@ BOOST_LOG_ANONYMOUS_NAMESPACE {
         m_Collectors.erase(m_Collectors.iterator_to(*p));
     }
 
+#if !defined(BOOST_LOG_NO_THREADS)
+
+    //! The class passes rotated files to file collectors in a background thread
+    class file_collection_thread
+    {
+    private:
+        //! A file pending collection
+        struct pending_file
+        {
+            shared_ptr< file::collector > m_pCollector;
+            filesystem::path m_Path;
+        };
+        //! The queue of pending files. The file being collected stays at the front of the queue until it's stored.
+        typedef std::deque< pending_file > pending_files;
+
+    private:
+        //! Synchronization mutex
+        mutex m_Mutex;
+        //! The condition is signalled when the queue changes
+        condition_variable m_Cond;
+        //! Pending files
+        pending_files m_Pending;
+        //! The exception that was thrown by a file collector
+        exception_ptr m_Exception;
+        //! The flag indicates that the thread has to stop
+        bool m_StopRequested;
+        //! Collection thread
+        thread m_Thread;
+
+    public:
+        file_collection_thread() : m_StopRequested(false)
+        {
+        }
+        ~file_collection_thread()
+        {
+            try
+            {
+                stop();
+            }
+            catch (...)
+            {
+            }
+        }
+
+        //! Puts the file to the queue. Blocks while the queue has \a max_backlog_size files.
+        void enqueue(shared_ptr< file::collector > const& collector, filesystem::path const& p, std::size_t max_backlog_size)
+        {
+            unique_lock< mutex > lock(m_Mutex);
+            if (!m_Thread.joinable())
+                boost::thread(boost::bind(&file_collection_thread::run, this)).swap(m_Thread);
+
+            while (m_Pending.size() >= max_backlog_size)
+                m_Cond.wait(lock);
+
+            m_Pending.push_back(pending_file());
+            pending_file& f = m_Pending.back();
+            f.m_pCollector = collector;
+            f.m_Path = p;
+            m_Cond.notify_all();
+        }
+
+        //! Waits until the specified file is collected
+        void wait_for(filesystem::path const& p)
+        {
+            unique_lock< mutex > lock(m_Mutex);
+            while (is_pending(p))
+                m_Cond.wait(lock);
+        }
+
+        //! Waits until all pending files are collected
+        void wait_all()
+        {
+            unique_lock< mutex > lock(m_Mutex);
+            while (!m_Pending.empty())
+                m_Cond.wait(lock);
+        }
+
+        //! Rethrows the exception that was thrown by a file collector, if any
+        void rethrow_exception()
+        {
+            exception_ptr ex;
+            {
+                lock_guard< mutex > lock(m_Mutex);
+                if (!m_Exception)
+                    return;
+                ex = m_Exception;
+                m_Exception = exception_ptr();
+            }
+            boost::rethrow_exception(ex);
+        }
+
+        //! Collects all pending files and stops the thread
+        void stop()
+        {
+            {
+                lock_guard< mutex > lock(m_Mutex);
+                if (!m_Thread.joinable())
+                    return;
+                m_StopRequested = true;
+                m_Cond.notify_all();
+            }
+            m_Thread.join();
+            m_StopRequested = false;
+        }
+
+    private:
+        //! Checks if the file is in the queue
+        bool is_pending(filesystem::path const& p) const
+        {
+            for (pending_files::const_iterator it = m_Pending.begin(), end = m_Pending.end(); it != end; ++it)
+            {
+                if (it->m_Path == p)
+                    return true;
+            }
+            return false;
+        }
+
+        //! Thread function
+        void run()
+        {
+            unique_lock< mutex > lock(m_Mutex);
+            while (true)
+            {
+                if (!m_Pending.empty())
+                {
+                    pending_file f = m_Pending.front();
+                    lock.unlock();
+
+                    exception_ptr ex;
+                    try
+                    {
+                        f.m_pCollector->store_file(f.m_Path);
+                    }
+                    catch (...)
+                    {
+                        ex = current_exception();
+                    }
+
+                    lock.lock();
+                    if (ex && !m_Exception)
+                        m_Exception = ex;
+                    m_Pending.pop_front();
+                    m_Cond.notify_all();
+                }
+                else if (m_StopRequested)
+                    break;
+                else
+                    m_Cond.wait(lock);
+            }
+        }
+
+        //  Copying prohibited
+        file_collection_thread(file_collection_thread const&);
+        file_collection_thread& operator= (file_collection_thread const&);
+    };
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
+
+    //! The class synchronizes the written files with the storage device and collects statistics
+    class file_synchronizer
+    {
+    public:
+        //! File handle type
+        typedef boost::log::aux::file_streambuf::native_handle_type native_handle_type;
+
+    private:
+#if !defined(BOOST_LOG_NO_THREADS)
+        //! Synchronization mutex, protects the statistics and the requests
+        mutex m_Mutex;
+        //! The mutex is locked while the background thread synchronizes the file
+        mutex m_FileMutex;
+        //! The condition is signalled when synchronization is requested or the synchronization interval changes
+        condition_variable m_Cond;
+        //! The handle of the file that is synchronized in background
+        native_handle_type m_Handle;
+        //! The amount of data requested to be synchronized
+        uintmax_t m_RequestedSize;
+        //! The amount of data being synchronized by the background thread
+        uintmax_t m_InFlightSize;
+        //! The time interval after which the background thread synchronizes the written data, in milliseconds
+        int64_t m_Interval;
+        //! The flag indicates that synchronization has been requested
+        bool m_SyncRequested;
+        //! The flag indicates that the background thread has to synchronize the file when the interval elapses
+        bool m_TimerSet;
+        //! The flag indicates that the thread has to stop
+        bool m_StopRequested;
+        //! Synchronization thread
+        thread m_Thread;
+#endif // !defined(BOOST_LOG_NO_THREADS)
+        //! The amount of data written since the last synchronization or synchronization request
+        uintmax_t m_UnsyncedSize;
+        //! The time of the last synchronization or synchronization request
+        boost::log::aux::timestamp m_LastSyncTime;
+        //! Statistics
+        file::sync_statistics m_Statistics;
+
+    public:
+#if !defined(BOOST_LOG_NO_THREADS)
+        file_synchronizer() :
+            m_Handle(-1),
+            m_RequestedSize(0),
+            m_InFlightSize(0),
+            m_Interval(0),
+            m_SyncRequested(false),
+            m_TimerSet(false),
+            m_StopRequested(false),
+            m_UnsyncedSize(0)
+        {
+        }
+        ~file_synchronizer()
+        {
+            {
+                lock_guard< mutex > lock(m_Mutex);
+                m_StopRequested = true;
+                m_Cond.notify_all();
+            }
+            if (m_Thread.joinable())
+                m_Thread.join();
+        }
+#else // !defined(BOOST_LOG_NO_THREADS)
+        file_synchronizer() : m_UnsyncedSize(0)
+        {
+        }
+#endif // !defined(BOOST_LOG_NO_THREADS)
+
+        //! Starts a new synchronization interval, should be called when a new file is opened
+        void restart_interval()
+        {
+            BOOST_LOG_EXPR_IF_MT(lock_guard< mutex > lock(m_Mutex);)
+            m_LastSyncTime = boost::log::aux::get_timestamp();
+        }
+
+        /*!
+         * Accounts the data written to the file. Returns \c true if the file has to be synchronized now.
+         * Otherwise the background thread synchronizes the data written to the file when the interval elapses.
+         */
+        bool on_written(boost::log::aux::file_streambuf& buf, uintmax_t size, uintmax_t sync_size, posix_time::time_duration const& interval)
+        {
+            BOOST_LOG_EXPR_IF_MT(lock_guard< mutex > lock(m_Mutex);)
+            m_UnsyncedSize += size;
+            const int64_t interval_ms = interval.total_milliseconds();
+            if (m_UnsyncedSize >= sync_size || (boost::log::aux::get_timestamp() - m_LastSyncTime).milliseconds() >= interval_ms)
+                return true;
+
+#if !defined(BOOST_LOG_NO_THREADS)
+            m_Handle = buf.native_handle();
+            if (!m_TimerSet || m_Interval != interval_ms)
+            {
+                if (!m_Thread.joinable())
+                    boost::thread(boost::bind(&file_synchronizer::run, this)).swap(m_Thread);
+                m_Interval = interval_ms;
+                m_TimerSet = true;
+                m_Cond.notify_all();
+            }
+#else
+            (void)buf;
+#endif
+            return false;
+        }
+
+        //! Synchronizes the file in the current thread
+        void sync(boost::log::aux::file_streambuf& buf)
+        {
+            const posix_time::ptime start = posix_time::microsec_clock::universal_time();
+            const bool result = buf.sync_data();
+            BOOST_LOG_EXPR_IF_MT(lock_guard< mutex > lock(m_Mutex);)
+            update_statistics(result, posix_time::microsec_clock::universal_time() - start);
+            m_UnsyncedSize = 0;
+            m_LastSyncTime = boost::log::aux::get_timestamp();
+#if !defined(BOOST_LOG_NO_THREADS)
+            // The data requested to be synchronized in background is synchronized now
+            m_RequestedSize = 0;
+            m_InFlightSize = 0;
+            m_SyncRequested = false;
+            m_TimerSet = false;
+#endif
+        }
+
+        //! Requests synchronization of the written file data in background. The file buffer should have been written.
+        void request(boost::log::aux::file_streambuf& buf)
+        {
+#if !defined(BOOST_LOG_NO_THREADS)
+            lock_guard< mutex > lock(m_Mutex);
+            if (!m_Thread.joinable())
+                boost::thread(boost::bind(&file_synchronizer::run, this)).swap(m_Thread);
+            m_Handle = buf.native_handle();
+            m_RequestedSize += m_UnsyncedSize;
+            m_UnsyncedSize = 0;
+            m_LastSyncTime = boost::log::aux::get_timestamp();
+            m_SyncRequested = true;
+            m_TimerSet = false;
+            m_Cond.notify_all();
+#else
+            sync(buf);
+#endif
+        }
+
+        //! Waits for the background synchronization to complete and makes the thread forget the file
+        void detach()
+        {
+#if !defined(BOOST_LOG_NO_THREADS)
+            lock_guard< mutex > file_lock(m_FileMutex);
+            lock_guard< mutex > lock(m_Mutex);
+            m_Handle = -1;
+            m_RequestedSize = 0;
+            m_SyncRequested = false;
+            m_TimerSet = false;
+#endif
+            m_UnsyncedSize = 0;
+        }
+
+        //! Returns the statistics
+        file::sync_statistics get_statistics()
+        {
+            BOOST_LOG_EXPR_IF_MT(lock_guard< mutex > lock(m_Mutex);)
+            file::sync_statistics stats = m_Statistics;
+            stats.pending_size = m_UnsyncedSize;
+#if !defined(BOOST_LOG_NO_THREADS)
+            stats.pending_size += m_RequestedSize + m_InFlightSize;
+#endif
+            return stats;
+        }
+
+    private:
+        //! Updates the statistics after synchronization
+        void update_statistics(bool result, posix_time::time_duration const& time)
+        {
+            if (result)
+                ++m_Statistics.sync_count;
+            else
+                ++m_Statistics.failure_count;
+            m_Statistics.total_sync_time += time;
+            if (m_Statistics.max_sync_time < time)
+                m_Statistics.max_sync_time = time;
+        }
+
+#if !defined(BOOST_LOG_NO_THREADS)
+        //! Thread function
+        void run()
+        {
+            unique_lock< mutex > lock(m_Mutex);
+            while (true)
+            {
+                if (m_StopRequested)
+                    break;
+                if (!m_SyncRequested)
+                {
+                    if (!m_TimerSet)
+                    {
+                        m_Cond.wait(lock);
+                        continue;
+                    }
+
+                    const int64_t elapsed = (boost::log::aux::get_timestamp() - m_LastSyncTime).milliseconds();
+                    if (elapsed < m_Interval)
+                    {
+                        m_Cond.timed_wait(lock, posix_time::milliseconds(m_Interval - elapsed));
+                        continue;
+                    }
+
+                    // No records have been written since the interval elapsed, synchronize the data that has already been
+                    // written to the file. The data still buffered in the file stream is synchronized with the next request.
+                    m_RequestedSize += m_UnsyncedSize;
+                    m_UnsyncedSize = 0;
+                    m_LastSyncTime = boost::log::aux::get_timestamp();
+                    m_SyncRequested = true;
+                    m_TimerSet = false;
+                }
+
+                lock.unlock();
+                {
+                    // The file mutex is always locked first to avoid deadlocks with detach()
+                    lock_guard< mutex > file_lock(m_FileMutex);
+                    native_handle_type handle;
+                    {
+                        lock_guard< mutex > state_lock(m_Mutex);
+                        handle = m_Handle;
+                        m_InFlightSize = m_RequestedSize;
+                        m_RequestedSize = 0;
+                        m_SyncRequested = false;
+                    }
+
+                    if (handle >= 0)
+                    {
+                        const posix_time::ptime start = posix_time::microsec_clock::universal_time();
+                        const bool result = boost::log::aux::file_streambuf::sync_handle(handle);
+                        const posix_time::time_duration time = posix_time::microsec_clock::universal_time() - start;
+
+                        lock_guard< mutex > state_lock(m_Mutex);
+                        update_statistics(result, time);
+                    }
+
+                    lock_guard< mutex > state_lock(m_Mutex);
+                    m_InFlightSize = 0;
+                }
+                lock.lock();
+            }
+        }
+#endif // !defined(BOOST_LOG_NO_THREADS)
+
+        //  Copying prohibited
+        file_synchronizer(file_synchronizer const&);
+        file_synchronizer& operator= (file_synchronizer const&);
+    };
+
+    /*!
+     * Returns the delay, in milliseconds, before the time-based rotation predicates need to read the clock again.
+     * The clock is read at least once a second so that the predicates react to clock adjustments.
+     */
+    inline int64_t get_check_delay(posix_time::time_duration const& time_left)
+    {
+        if (time_left.is_special())
+            return 1000;
+        const int64_t delay = static_cast< int64_t >(time_left.total_milliseconds());
+        return delay < 0 ? static_cast< int64_t >(0) : (delay > 1000 ? static_cast< int64_t >(1000) : delay);
+    }
+
     //! Checks if the time point is valid
     void check_time_point_validity(unsigned char hour, unsigned char minute, unsigned char second)
     {
@@ -867,7 +1694,16 @@ namespace aux {
         uintmax_t max_size,
         uintmax_t min_free_space)
     {
-        return file_collector_repository::get()->get_collector(target_dir, max_size, min_free_space);
+        return file_collector_repository::get()->get_collector(target_dir, max_size, min_free_space, shared_ptr< compressor >());
+    }
+
+    BOOST_LOG_API shared_ptr< collector > make_collector(
+        filesystem::path const& target_dir,
+        uintmax_t max_size,
+        uintmax_t min_free_space,
+        shared_ptr< compressor > const& comp)
+    {
+        return file_collector_repository::get()->get_collector(target_dir, max_size, min_free_space, comp);
     }
 
 } // namespace aux
@@ -883,7 +1719,9 @@ BOOST_LOG_API rotation_at_time_point::rotation_at_time_point(
     m_Hour(hour),
     m_Minute(minute),
     m_Second(second),
-    m_Previous(date_time::not_a_date_time)
+    m_Previous(date_time::not_a_date_time),
+    m_Next(date_time::not_a_date_time),
+    m_CheckDelay(0)
 {
     check_time_point_validity(hour, minute, second);
 }
@@ -900,7 +1738,9 @@ BOOST_LOG_API rotation_at_time_point::rotation_at_time_point(
     m_Hour(hour),
     m_Minute(minute),
     m_Second(second),
-    m_Previous(date_time::not_a_date_time)
+    m_Previous(date_time::not_a_date_time),
+    m_Next(date_time::not_a_date_time),
+    m_CheckDelay(0)
 {
     check_time_point_validity(hour, minute, second);
 }
@@ -917,7 +1757,9 @@ BOOST_LOG_API rotation_at_time_point::rotation_at_time_point(
     m_Hour(hour),
     m_Minute(minute),
     m_Second(second),
-    m_Previous(date_time::not_a_date_time)
+    m_Previous(date_time::not_a_date_time),
+    m_Next(date_time::not_a_date_time),
+    m_CheckDelay(0)
 {
     check_time_point_validity(hour, minute, second);
 }
@@ -925,18 +1767,38 @@ BOOST_LOG_API rotation_at_time_point::rotation_at_time_point(
 //! Checks if it's time to rotate the file
 BOOST_LOG_API bool rotation_at_time_point::operator()() const
 {
-    bool result = false;
-    posix_time::time_duration rotation_time(
-        static_cast< posix_time::time_duration::hour_type >(m_Hour),
-        static_cast< posix_time::time_duration::min_type >(m_Minute),
-        static_cast< posix_time::time_duration::sec_type >(m_Second));
-    posix_time::ptime now = posix_time::second_clock::local_time();
+    // Avoid reading the clock until the next rotation time is close
+    const boost::log::aux::timestamp check_time = boost::log::aux::get_timestamp();
+    if (!m_Previous.is_special() && (check_time - m_LastCheck).milliseconds() < m_CheckDelay)
+        return false;
 
+    bool result = false;
+    posix_time::ptime now = posix_time::microsec_clock::local_time();
     if (m_Previous.is_special())
     {
         m_Previous = now;
-        return false;
+        m_Next = next_rotation_time();
     }
+    else if (now >= m_Next)
+    {
+        m_Previous = now;
+        m_Next = next_rotation_time();
+        result = true;
+    }
+
+    m_LastCheck = check_time;
+    m_CheckDelay = get_check_delay(m_Next - now);
+
+    return result;
+}
+
+//! Computes the rotation time that follows the previous rotation
+posix_time::ptime rotation_at_time_point::next_rotation_time() const
+{
+    posix_time::time_duration rotation_time(
+        static_cast< posix_time::time_duration::hour_type >(m_Hour),
+        static_cast< posix_time::time_duration::min_type >(m_Minute),
+        static_cast< posix_time::time_duration::sec_type >(m_Second));
 
     const bool time_of_day_passed = rotation_time.total_seconds() <= m_Previous.time_of_day().total_seconds();
     switch (m_DayKind)
@@ -947,10 +1809,8 @@ BOOST_LOG_API bool rotation_at_time_point::operator()() const
             gregorian::date previous_date = m_Previous.date();
             if (time_of_day_passed)
                 previous_date += gregorian::days(1);
-            posix_time::ptime next(previous_date, rotation_time);
-            result = (now >= next);
+            return posix_time::ptime(previous_date, rotation_time);
         }
-        break;
 
     case weekday:
         {
@@ -963,10 +1823,8 @@ BOOST_LOG_API bool rotation_at_time_point::operator()() const
                 next_date += gregorian::weeks(1);
             }
 
-            posix_time::ptime next(next_date, rotation_time);
-            result = (now >= next);
+            return posix_time::ptime(next_date, rotation_time);
         }
-        break;
 
     case monthday:
         {
@@ -980,36 +1838,36 @@ BOOST_LOG_API bool rotation_at_time_point::operator()() const
                 next_date += gregorian::months(1);
             }
 
-            posix_time::ptime next(next_date, rotation_time);
-            result = (now >= next);
+            return posix_time::ptime(next_date, rotation_time);
         }
-        break;
 
     default:
-        break;
+        return posix_time::ptime(posix_time::pos_infin);
     }
-
-    if (result)
-        m_Previous = now;
-
-    return result;
 }
 
 //! Checks if it's time to rotate the file
 BOOST_LOG_API bool rotation_at_time_interval::operator()() const
 {
+    // Avoid reading the clock until the end of the interval is close
+    const boost::log::aux::timestamp check_time = boost::log::aux::get_timestamp();
+    if (!m_Previous.is_special() && (check_time - m_LastCheck).milliseconds() < m_CheckDelay)
+        return false;
+
     bool result = false;
-    posix_time::ptime now = posix_time::second_clock::universal_time();
+    posix_time::ptime now = posix_time::microsec_clock::universal_time();
     if (m_Previous.is_special())
     {
         m_Previous = now;
-        return false;
     }
-
-    result = (now - m_Previous) >= m_Interval;
-
-    if (result)
+    else if ((now - m_Previous) >= m_Interval)
+    {
         m_Previous = now;
+        result = true;
+    }
+
+    m_LastCheck = check_time;
+    m_CheckDelay = get_check_delay(m_Previous + m_Interval - now);
 
     return result;
 }
@@ -1038,12 +1896,41 @@ struct text_file_backend::implementation
     //! Current file name
     filesystem::path m_FileName;
     //! File stream
-    filesystem::ofstream m_File;
-    //! Characters written
+    boost::log::aux::file_ostream m_File;
+    //! Characters written, including the accumulated records
     uintmax_t m_CharactersWritten;
 
+    //! Accumulated records. Only the first m_BatchCount elements contain records, the rest are kept for reuse.
+    std::vector< string_type > m_Batch;
+    //! Number of accumulated records
+    std::size_t m_BatchCount;
+    //! The number of records to accumulate before writing them to the file
+    std::size_t m_WriteBatchSize;
+    //! The size of the file regions that are mapped to memory, zero if the files are not mapped
+    std::size_t m_MappedExtentSize;
+
+    //! File synchronization policy
+    file::sync_policy m_SyncPolicy;
+    //! The time interval between synchronizations with the periodic policy
+    posix_time::time_duration m_SyncInterval;
+    //! The amount of written data that triggers synchronization with the periodic policy
+    uintmax_t m_SyncSize;
+    //! File synchronizer
+    file_synchronizer m_Synchronizer;
+
     //! File collector functional object
     shared_ptr< file::collector > m_pFileCollector;
+    //! The maximum number of rotated files waiting for collection in background, if the files are compressed and the size was not set by the user
+    enum { default_compression_backlog_size = 4 };
+
+    //! The maximum number of rotated files waiting for collection in background
+    std::size_t m_CollectionBacklogSize;
+    //! The flag indicates that the backlog size was set by the user
+    bool m_fCollectionBacklogSizeSet;
+#if !defined(BOOST_LOG_NO_THREADS)
+    //! Background file collection thread
+    file_collection_thread m_CollectionThread;
+#endif
     //! File open handler
     open_handler_type m_OpenHandler;
     //! File close handler
@@ -1060,10 +1947,85 @@ struct text_file_backend::implementation
         m_FileOpenMode(std::ios_base::trunc | std::ios_base::out),
         m_FileCounter(0),
         m_CharactersWritten(0),
+        m_BatchCount(0),
+        m_WriteBatchSize(0),
+        m_MappedExtentSize(0),
+        m_SyncPolicy(file::no_sync),
+        m_SyncInterval(posix_time::seconds(1)),
+        m_SyncSize((std::numeric_limits< uintmax_t >::max)()),
+        m_CollectionBacklogSize(0),
+        m_fCollectionBacklogSizeSet(false),
         m_FileRotationSize(rotation_size),
         m_AutoFlush(auto_flush)
     {
     }
+
+    //! The method returns the maximum number of rotated files waiting for collection in background, or zero if files are collected immediately
+    std::size_t get_collection_backlog_size() const
+    {
+        if (m_fCollectionBacklogSizeSet)
+            return m_CollectionBacklogSize;
+
+        // Files are compressed in background by default, so that compression does not block logging
+        file_collector* collector = dynamic_cast< file_collector* >(m_pFileCollector.get());
+        if (collector && collector->has_compressor())
+            return default_compression_backlog_size;
+
+        return 0;
+    }
+
+    //! The method writes the accumulated records to the file
+    void write_batch()
+    {
+        if (m_BatchCount > 0)
+        {
+            const std::size_t count = m_BatchCount;
+            m_BatchCount = 0;
+            const bool result = m_File.rdbuf()->write_strings(m_Batch.begin(), m_Batch.begin() + count);
+            for (std::size_t i = 0; i < count; ++i)
+                m_Batch[i].clear();
+            if (!result)
+                m_File.setstate(std::ios_base::badbit);
+            else if (m_SyncPolicy == file::batch_sync)
+                sync_file();
+        }
+    }
+
+    //! The method writes the accumulated records and synchronizes the file with the storage device
+    void sync_file()
+    {
+        write_batch();
+        m_Synchronizer.sync(*m_File.rdbuf());
+    }
+
+    //! The method synchronizes the file according to the policy after a record of the specified size is written
+    void on_record_written(std::size_t size, bool accumulated)
+    {
+        switch (m_SyncPolicy)
+        {
+        case file::record_sync:
+            sync_file();
+            break;
+
+        case file::batch_sync:
+            // The accumulated records are synchronized in write_batch()
+            if (!accumulated)
+                sync_file();
+            break;
+
+        case file::periodic_sync:
+            if (m_Synchronizer.on_written(*m_File.rdbuf(), size, m_SyncSize, m_SyncInterval))
+            {
+                write_batch();
+                m_File.flush();
+                m_Synchronizer.request(*m_File.rdbuf());
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
 };
 
 //! Constructor. No streams attached to the constructed backend, auto flush feature disabled.
@@ -1120,16 +2082,55 @@ BOOST_LOG_API void text_file_backend::auto_flush(bool f)
     m_pImpl->m_AutoFlush = f;
 }
 
-//! The method writes the message to the sink
-BOOST_LOG_API void text_file_backend::consume(record_view const& rec, string_type const& formatted_message)
+//! Sets the number of formatted records to accumulate before writing them to the file
+BOOST_LOG_API void text_file_backend::set_write_batch_size(std::size_t size)
+{
+    m_pImpl->m_WriteBatchSize = size;
+    if (m_pImpl->m_BatchCount >= size)
+        m_pImpl->write_batch();
+}
+
+//! Sets the size of the file regions that are mapped to memory
+BOOST_LOG_API void text_file_backend::set_mapped_extent_size(std::size_t size)
+{
+    m_pImpl->m_MappedExtentSize = size;
+}
+
+//! Sets the policy of synchronizing the written data with the storage device
+BOOST_LOG_API void text_file_backend::set_sync_policy(file::sync_policy policy)
+{
+    if (m_pImpl->m_SyncPolicy == file::periodic_sync && policy != file::periodic_sync)
+        m_pImpl->m_Synchronizer.detach();
+    m_pImpl->m_SyncPolicy = policy;
+}
+
+//! Sets the time interval for the periodic synchronization policy
+BOOST_LOG_API void text_file_backend::set_sync_interval(posix_time::time_duration const& interval)
+{
+    m_pImpl->m_SyncInterval = interval;
+}
+
+//! Sets the amount of written data that triggers synchronization with the periodic synchronization policy
+BOOST_LOG_API void text_file_backend::set_sync_size(uintmax_t size)
+{
+    m_pImpl->m_SyncSize = size;
+}
+
+//! Returns the file synchronization statistics
+BOOST_LOG_API file::sync_statistics text_file_backend::get_sync_statistics() const
+{
+    return m_pImpl->m_Synchronizer.get_statistics();
+}
+
+//! The method rotates the file if needed and opens a new one before writing a record of the specified size
+void text_file_backend::prepare_file(std::size_t size)
 {
-    typedef file_char_traits< string_type::value_type > traits_t;
     if
     (
         (
             m_pImpl->m_File.is_open() &&
             (
-                m_pImpl->m_CharactersWritten + formatted_message.size() >= m_pImpl->m_FileRotationSize ||
+                m_pImpl->m_CharactersWritten + size >= m_pImpl->m_FileRotationSize ||
                 (!m_pImpl->m_TimeBasedRotation.empty() && m_pImpl->m_TimeBasedRotation())
             )
         ) ||
@@ -1143,8 +2144,13 @@ BOOST_LOG_API void text_file_backend::consume(record_view const& rec, string_typ
     {
         m_pImpl->m_FileName = m_pImpl->m_StorageDir / m_pImpl->m_FileNameGenerator(m_pImpl->m_FileCounter++);
 
+#if !defined(BOOST_LOG_NO_THREADS)
+        // Don't overwrite the previous file with the same name until it is collected
+        m_pImpl->m_CollectionThread.wait_for(m_pImpl->m_FileName);
+#endif
+
         filesystem::create_directories(m_pImpl->m_FileName.parent_path());
-        m_pImpl->m_File.open(m_pImpl->m_FileName, m_pImpl->m_FileOpenMode);
+        m_pImpl->m_File.open(m_pImpl->m_FileName, m_pImpl->m_FileOpenMode, m_pImpl->m_MappedExtentSize);
         if (!m_pImpl->m_File.is_open())
         {
             filesystem_error err(
@@ -1158,7 +2164,19 @@ BOOST_LOG_API void text_file_backend::consume(record_view const& rec, string_typ
             m_pImpl->m_OpenHandler(m_pImpl->m_File);
 
         m_pImpl->m_CharactersWritten = static_cast< std::streamoff >(m_pImpl->m_File.tellp());
+        m_pImpl->m_Synchronizer.restart_interval();
     }
+}
+
+//! The method writes the message to the sink
+BOOST_LOG_API void text_file_backend::consume(record_view const& rec, string_type const& formatted_message)
+{
+    typedef file_char_traits< string_type::value_type > traits_t;
+
+    prepare_file(formatted_message.size());
+
+    // Keep the records in order if some of them were accumulated
+    m_pImpl->write_batch();
 
     m_pImpl->m_File.write(formatted_message.data(), static_cast< std::streamsize >(formatted_message.size()));
     m_pImpl->m_File.put(traits_t::newline);
@@ -1167,13 +2185,59 @@ BOOST_LOG_API void text_file_backend::consume(record_view const& rec, string_typ
 
     if (m_pImpl->m_AutoFlush)
         m_pImpl->m_File.flush();
+
+    m_pImpl->on_record_written(formatted_message.size() + 1, false);
+}
+
+//! The method takes the message and writes it to the sink
+BOOST_LOG_API void text_file_backend::consume_and_take(record_view const& rec, string_type& formatted_message)
+{
+    typedef file_char_traits< string_type::value_type > traits_t;
+
+    if (m_pImpl->m_WriteBatchSize == 0)
+    {
+        consume(rec, formatted_message);
+        return;
+    }
+
+    prepare_file(formatted_message.size());
+
+    // Take the formatted record and give away an empty string that was used for one of the previous records
+    std::vector< string_type >& batch = m_pImpl->m_Batch;
+    if (m_pImpl->m_BatchCount == batch.size())
+        batch.push_back(string_type());
+    string_type& slot = batch[m_pImpl->m_BatchCount++];
+    slot.swap(formatted_message);
+    slot.push_back(traits_t::newline);
+
+    const std::size_t size = slot.size();
+    m_pImpl->m_CharactersWritten += size;
+
+    if (m_pImpl->m_BatchCount >= m_pImpl->m_WriteBatchSize || m_pImpl->m_AutoFlush)
+    {
+        m_pImpl->write_batch();
+        if (m_pImpl->m_AutoFlush)
+            m_pImpl->m_File.flush();
+    }
+
+    m_pImpl->on_record_written(size, true);
 }
 
 //! The method flushes the currently open log file
 BOOST_LOG_API void text_file_backend::flush()
 {
     if (m_pImpl->m_File.is_open())
+    {
+        m_pImpl->write_batch();
         m_pImpl->m_File.flush();
+        if (m_pImpl->m_SyncPolicy != file::no_sync)
+            m_pImpl->sync_file();
+    }
+
+#if !defined(BOOST_LOG_NO_THREADS)
+    m_pImpl->m_CollectionThread.wait_all();
+    m_pImpl->m_CollectionThread.rethrow_exception();
+#endif
 }
 
 //! The method sets file name mask
@@ -1252,13 +2316,42 @@ BOOST_LOG_API void text_file_backend::set_file_name_pattern_internal(filesystem:
 //! The method rotates the file
 BOOST_LOG_API void text_file_backend::rotate_file()
 {
+    m_pImpl->write_batch();
     if (!m_pImpl->m_CloseHandler.empty())
         m_pImpl->m_CloseHandler(m_pImpl->m_File);
+    if (m_pImpl->m_SyncPolicy != file::no_sync && m_pImpl->m_File.is_open())
+        m_pImpl->sync_file();
+    m_pImpl->m_Synchronizer.detach();
     m_pImpl->m_File.close();
     m_pImpl->m_File.clear();
     m_pImpl->m_CharactersWritten = 0;
     if (!!m_pImpl->m_pFileCollector)
+    {
+#if !defined(BOOST_LOG_NO_THREADS)
+        const std::size_t backlog_size = m_pImpl->get_collection_backlog_size();
+        if (backlog_size > 0)
+        {
+            m_pImpl->m_CollectionThread.enqueue(m_pImpl->m_pFileCollector, m_pImpl->m_FileName, backlog_size);
+            m_pImpl->m_CollectionThread.rethrow_exception();
+            return;
+        }
+#endif
         m_pImpl->m_pFileCollector->store_file(m_pImpl->m_FileName);
+    }
+}
+
+//! The method sets the maximum number of rotated files waiting for collection in background
+BOOST_LOG_API void text_file_backend::set_collection_backlog_size(std::size_t size)
+{
+    m_pImpl->m_CollectionBacklogSize = size;
+    m_pImpl->m_fCollectionBacklogSizeSet = true;
+#if !defined(BOOST_LOG_NO_THREADS)
+    if (size == 0)
+    {
+        m_pImpl->m_CollectionThread.stop();
+        m_pImpl->m_CollectionThread.rethrow_exception();
+    }
+#endif
 }
 
 //! The method sets the file open mode
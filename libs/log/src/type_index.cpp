@@ -0,0 +1,77 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   type_index.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header is the Boost.Log library implementation, see the library documentation
+ *         at http://www.boost.org/libs/log/doc/log.html.
+ */
+
+#include <map>
+#include <utility>
+#include <boost/log/detail/type_index.hpp>
+#include <boost/log/detail/singleton.hpp>
+#include <boost/log/utility/type_info_wrapper.hpp>
+#if !defined(BOOST_LOG_NO_THREADS)
+#include <boost/thread/mutex.hpp>
+#include <boost/log/detail/locks.hpp>
+#endif
+#include <boost/log/detail/header.hpp>
+
+namespace boost {
+
+BOOST_LOG_OPEN_NAMESPACE
+
+namespace aux {
+
+BOOST_LOG_ANONYMOUS_NAMESPACE {
+
+//! The registry of type indices
+struct type_index_registry :
+    public lazy_singleton< type_index_registry >
+{
+    //! The type of the map of the registered types
+    typedef std::map< type_info_wrapper, type_index > index_map;
+
+#if !defined(BOOST_LOG_NO_THREADS)
+    //! Synchronization primitive
+    mutex m_Mutex;
+#endif
+    //! Registered types
+    index_map m_Indices;
+    //! The last allocated index
+    type_index m_LastIndex;
+
+    type_index_registry() : m_LastIndex(0)
+    {
+    }
+};
+
+} // namespace
+
+BOOST_LOG_API type_index register_type_index(std::type_info const& type)
+{
+    type_index_registry& registry = type_index_registry::get();
+    BOOST_LOG_EXPR_IF_MT(exclusive_lock_guard< mutex > lock(registry.m_Mutex);)
+
+    std::pair< type_index_registry::index_map::iterator, bool > res =
+        registry.m_Indices.insert(type_index_registry::index_map::value_type(type_info_wrapper(type), 0u));
+    if (res.second)
+        res.first->second = ++registry.m_LastIndex;
+
+    return res.first->second;
+}
+
+} // namespace aux
+
+BOOST_LOG_CLOSE_NAMESPACE // namespace log
+
+} // namespace boost
+
+#include <boost/log/detail/footer.hpp>
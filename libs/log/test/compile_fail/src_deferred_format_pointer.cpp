@@ -0,0 +1,32 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   src_deferred_format_pointer.cpp
+ * \author Andrey Semashev
+ * \date   17.10.2026
+ *
+ * \brief  This test checks that it is not possible to pass a pointer to a string
+ *         as a format string to the deferred formatting macros.
+ */
+
+#define BOOST_TEST_MODULE src_deferred_format_pointer
+
+#include <string>
+#include <boost/log/sources/logger.hpp>
+#include <boost/log/sources/deferred_format.hpp>
+
+namespace logging = boost::log;
+namespace src = logging::sources;
+
+int main(int, char*[])
+{
+    src::logger lg;
+    std::string fmt = "%1%";
+    BOOST_LOG_FMT(lg, fmt.c_str()) % 10;
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   attribute_lookup.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This code measures performance of attribute value set construction and attribute lookup
+ *         for different numbers of attributes
+ */
+
+#include <cstdio>
+#include <vector>
+#include <iomanip>
+#include <iostream>
+#include <boost/date_time/microsec_time_clock.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include <boost/log/attributes/constant.hpp>
+#include <boost/log/attributes/attribute_name.hpp>
+#include <boost/log/attributes/attribute_set.hpp>
+#include <boost/log/attributes/attribute_value_set.hpp>
+
+enum config
+{
+    ITERATION_COUNT = 1000000
+};
+
+namespace logging = boost::log;
+namespace attrs = boost::log::attributes;
+
+namespace {
+
+    inline boost::posix_time::ptime now()
+    {
+        return boost::date_time::microsec_clock< boost::posix_time::ptime >::universal_time();
+    }
+
+    void report(const char* name, unsigned int operation_count, boost::posix_time::ptime const& start, boost::posix_time::ptime const& end)
+    {
+        unsigned long long duration = (end - start).total_microseconds();
+        std::cout << std::setw(28) << std::left << name << ": " << duration << " us ("
+            << std::fixed << std::setprecision(3) << static_cast< double >(duration) * 1000.0 / static_cast< double >(operation_count)
+            << " ns per operation)" << std::endl;
+    }
+
+    unsigned int test(unsigned int attribute_count)
+    {
+        std::cout << attribute_count << " attributes:" << std::endl;
+
+        // Distribute attributes between the source, thread and global sets, like it happens in real applications
+        std::vector< logging::attribute_name > names;
+        logging::attribute_set source_attrs, thread_attrs, global_attrs;
+        for (unsigned int i = 0; i < attribute_count; ++i)
+        {
+            char buf[32];
+            std::sprintf(buf, "Attr%u", i);
+            names.push_back(logging::attribute_name(buf));
+
+            logging::attribute_set& attrs = (i % 3 == 0 ? source_attrs : (i % 3 == 1 ? thread_attrs : global_attrs));
+            attrs.insert(names.back(), attrs::constant< unsigned int >(i));
+        }
+
+        unsigned int found = 0;
+
+        // Lookup in attribute sets
+        boost::posix_time::ptime start = now();
+        for (unsigned int n = 0; n < ITERATION_COUNT; ++n)
+        {
+            for (unsigned int i = 0; i < attribute_count; ++i)
+                found += source_attrs.count(names[i]);
+        }
+        report("  attribute set lookup", ITERATION_COUNT * attribute_count, start, now());
+
+        // Attribute value set construction
+        start = now();
+        for (unsigned int n = 0; n < ITERATION_COUNT; ++n)
+        {
+            logging::attribute_value_set values(source_attrs, thread_attrs, global_attrs);
+            values.freeze();
+            found += static_cast< unsigned int >(values.size());
+        }
+        report("  value set construction", ITERATION_COUNT, start, now());
+
+        // Lookup in a frozen attribute value set
+        logging::attribute_value_set values(source_attrs, thread_attrs, global_attrs);
+        values.freeze();
+        start = now();
+        for (unsigned int n = 0; n < ITERATION_COUNT; ++n)
+        {
+            for (unsigned int i = 0; i < attribute_count; ++i)
+                found += static_cast< unsigned int >(values.count(names[i]));
+        }
+        report("  value set lookup", ITERATION_COUNT * attribute_count, start, now());
+
+        return found;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    unsigned int found = test(5);
+    found += test(20);
+    found += test(60);
+
+    // Make sure the results are used so that the compiler doesn't optimize the loops away
+    return found == 0 ? 1 : 0;
+}
@@ -0,0 +1,139 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   binary_sink.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This code measures the cost and the output size of writing log records with the text
+ *         and binary stream sink backends
+ */
+
+#include <string>
+#include <iomanip>
+#include <iostream>
+#include <streambuf>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/date_time/microsec_time_clock.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include <boost/log/core.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/log/attributes/clock.hpp>
+#include <boost/log/attributes/current_thread_id.hpp>
+#include <boost/log/sources/severity_logger.hpp>
+#include <boost/log/sources/record_ostream.hpp>
+#include <boost/log/sinks/sync_frontend.hpp>
+#include <boost/log/sinks/text_ostream_backend.hpp>
+#include <boost/log/sinks/binary_ostream_backend.hpp>
+#include <boost/log/expressions.hpp>
+#include <boost/log/support/date_time.hpp>
+
+enum config
+{
+    RECORD_COUNT = 1000000
+};
+
+namespace logging = boost::log;
+namespace expr = boost::log::expressions;
+namespace sinks = boost::log::sinks;
+namespace attrs = boost::log::attributes;
+namespace src = boost::log::sources;
+
+namespace {
+
+    //! A stream buffer that discards the output and counts the written bytes
+    class counting_buf :
+        public std::streambuf
+    {
+    public:
+        std::size_t m_Size;
+
+        counting_buf() : m_Size(0) {}
+
+    protected:
+        int_type overflow(int_type c)
+        {
+            if (!traits_type::eq_int_type(c, traits_type::eof()))
+                ++m_Size;
+            return traits_type::not_eof(c);
+        }
+        std::streamsize xsputn(const char_type*, std::streamsize n)
+        {
+            m_Size += static_cast< std::size_t >(n);
+            return n;
+        }
+    };
+
+    inline boost::posix_time::ptime now()
+    {
+        return boost::date_time::microsec_clock< boost::posix_time::ptime >::universal_time();
+    }
+
+    void run(const char* name)
+    {
+        src::severity_logger< logging::trivial::severity_level > lg;
+        const std::string user = "user@example.com";
+
+        boost::posix_time::ptime start = now();
+        for (unsigned int i = 0; i < RECORD_COUNT; ++i)
+        {
+            BOOST_LOG_SEV(lg, logging::trivial::info) << "Request " << i << " from " << user << " completed";
+        }
+        boost::posix_time::ptime end = now();
+
+        unsigned long long duration = (end - start).total_microseconds();
+        std::cout << std::setw(16) << std::left << name << ": " << duration << " us ("
+            << std::fixed << std::setprecision(3) << static_cast< double >(duration) * 1000.0 / static_cast< double >(RECORD_COUNT)
+            << " ns per record)";
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    boost::shared_ptr< logging::core > core = logging::core::get();
+    core->add_global_attribute("TimeStamp", attrs::local_clock());
+    core->add_global_attribute("ThreadID", attrs::current_thread_id());
+
+    {
+        counting_buf buf;
+        boost::shared_ptr< std::ostream > strm = boost::make_shared< std::ostream >(&buf);
+
+        typedef sinks::synchronous_sink< sinks::text_ostream_backend > text_sink;
+        boost::shared_ptr< text_sink > sink = boost::make_shared< text_sink >();
+        sink->locked_backend()->add_stream(strm);
+        sink->set_formatter
+        (
+            expr::stream
+                << expr::format_date_time< boost::posix_time::ptime >("TimeStamp", "%Y-%m-%d %H:%M:%S.%f")
+                << " [" << expr::attr< logging::aux::thread::id >("ThreadID")
+                << "] <" << logging::trivial::severity
+                << "> " << expr::smessage
+        );
+        core->add_sink(sink);
+        run("text");
+        std::cout << ", " << buf.m_Size / RECORD_COUNT << " bytes per record" << std::endl;
+        core->remove_sink(sink);
+    }
+
+    {
+        counting_buf buf;
+        boost::shared_ptr< std::ostream > strm = boost::make_shared< std::ostream >(&buf);
+
+        typedef sinks::synchronous_sink< sinks::binary_ostream_backend > binary_sink;
+        boost::shared_ptr< binary_sink > sink = boost::make_shared< binary_sink >();
+        sink->locked_backend()->set_stream(strm);
+        core->add_sink(sink);
+        run("binary");
+        std::cout << ", " << buf.m_Size / RECORD_COUNT << " bytes per record" << std::endl;
+        core->remove_sink(sink);
+    }
+
+    return 0;
+}
@@ -0,0 +1,114 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   deferred_format.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This code measures the cost of writing log records with the streaming and deferred formatting macros
+ *         in the logging thread, and the cost of composing the deferred messages
+ */
+
+#include <string>
+#include <iomanip>
+#include <iostream>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/date_time/microsec_time_clock.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include <boost/log/core.hpp>
+#include <boost/log/sources/logger.hpp>
+#include <boost/log/sources/record_ostream.hpp>
+#include <boost/log/sources/deferred_format.hpp>
+#include <boost/log/sinks/sync_frontend.hpp>
+#include <boost/log/sinks/basic_sink_backend.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
+#include <boost/log/expressions/message.hpp>
+
+enum config
+{
+    RECORD_COUNT = 1000000
+};
+
+namespace logging = boost::log;
+namespace expr = boost::log::expressions;
+namespace sinks = boost::log::sinks;
+namespace src = boost::log::sources;
+
+namespace {
+
+    //! A fake sink backend that optionally reads the message, like a formatter would
+    class fake_backend :
+        public sinks::basic_sink_backend< sinks::synchronized_feeding >
+    {
+    public:
+        bool m_ReadMessage;
+        std::size_t m_Size;
+
+        fake_backend() : m_ReadMessage(false), m_Size(0) {}
+
+        void consume(logging::record_view const& rec)
+        {
+            if (m_ReadMessage)
+                m_Size += logging::extract_or_default< std::string >(expr::smessage.get_name(), rec.attribute_values(), std::string()).size();
+        }
+    };
+
+    inline boost::posix_time::ptime now()
+    {
+        return boost::date_time::microsec_clock< boost::posix_time::ptime >::universal_time();
+    }
+
+    void report(const char* name, boost::posix_time::ptime const& start, boost::posix_time::ptime const& end)
+    {
+        unsigned long long duration = (end - start).total_microseconds();
+        std::cout << std::setw(36) << std::left << name << ": " << duration << " us ("
+            << std::fixed << std::setprecision(3) << static_cast< double >(duration) * 1000.0 / static_cast< double >(RECORD_COUNT)
+            << " ns per record)" << std::endl;
+    }
+
+    void test(const char* title, bool read_message)
+    {
+        typedef sinks::synchronous_sink< fake_backend > fake_sink;
+        boost::shared_ptr< fake_sink > sink = boost::make_shared< fake_sink >();
+        sink->locked_backend()->m_ReadMessage = read_message;
+        logging::core::get()->add_sink(sink);
+
+        std::cout << title << ":" << std::endl;
+
+        src::logger lg;
+        const std::string user = "user@example.com";
+
+        boost::posix_time::ptime start = now();
+        for (unsigned int i = 0; i < RECORD_COUNT; ++i)
+        {
+            BOOST_LOG(lg) << "Request " << i << " from " << user << " completed in " << 0.25 << " ms";
+        }
+        report("  streaming", start, now());
+
+        start = now();
+        for (unsigned int i = 0; i < RECORD_COUNT; ++i)
+        {
+            BOOST_LOG_FMT(lg, "Request %1% from %2% completed in %3% ms") % i % user % 0.25;
+        }
+        report("  deferred formatting", start, now());
+
+        logging::core::get()->remove_sink(sink);
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    // The first test shows the cost in the logging thread when the message is formatted in another thread,
+    // e.g. by an asynchronous sink. The second one includes formatting of the message.
+    test("Message is not formatted in the logging thread", false);
+    test("Message is formatted in the logging thread", true);
+
+    return 0;
+}
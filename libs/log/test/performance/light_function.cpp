@@ -0,0 +1,107 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   light_function.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This code measures performance of construction, copying and invocation of the light function wrapper
+ */
+
+#include <iomanip>
+#include <iostream>
+#include <boost/date_time/microsec_time_clock.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/log/detail/light_function.hpp>
+
+enum config
+{
+    ITERATION_COUNT = 10000000
+};
+
+namespace logging = boost::log;
+
+namespace {
+
+    //! A function object that fits into the internal buffer of the wrapper
+    struct small_fun
+    {
+        int m_Value;
+
+        explicit small_fun(int value) : m_Value(value) {}
+        int operator() (int x) const { return x + m_Value; }
+    };
+
+    //! A function object that does not fit into the internal buffer of the wrapper
+    struct large_fun
+    {
+        int m_Values[16];
+
+        explicit large_fun(int value) { m_Values[0] = value; }
+        int operator() (int x) const { return x + m_Values[0]; }
+    };
+
+    typedef logging::aux::light_function< int (int) > function_type;
+
+    inline boost::posix_time::ptime now()
+    {
+        return boost::date_time::microsec_clock< boost::posix_time::ptime >::universal_time();
+    }
+
+    void report(const char* name, boost::posix_time::ptime const& start, boost::posix_time::ptime const& end)
+    {
+        unsigned long long duration = (end - start).total_microseconds();
+        std::cout << std::setw(24) << std::left << name << ": " << duration << " us ("
+            << std::fixed << std::setprecision(3) << static_cast< double >(duration) * 1000.0 / static_cast< double >(ITERATION_COUNT)
+            << " ns per operation)" << std::endl;
+    }
+
+    template< typename FunT >
+    int test(const char* name, FunT const& fun)
+    {
+        int result = 0;
+        std::cout << name << ":" << std::endl;
+
+        boost::posix_time::ptime start = now();
+        for (unsigned int i = 0; i < ITERATION_COUNT; ++i)
+        {
+            function_type f(fun);
+            result += f(i);
+        }
+        report("  construction", start, now());
+
+        function_type f(fun);
+        start = now();
+        for (unsigned int i = 0; i < ITERATION_COUNT; ++i)
+        {
+            function_type g(f);
+            result += g(i);
+        }
+        report("  copying", start, now());
+
+        start = now();
+        for (unsigned int i = 0; i < ITERATION_COUNT; ++i)
+        {
+            result += f(i);
+        }
+        report("  invocation", start, now());
+
+        return result;
+    }
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::cout << "Test config: " << ITERATION_COUNT << " iterations, function size " << sizeof(function_type) << " bytes" << std::endl;
+
+    int result = test("Small function object", small_fun(1));
+    result += test("Large function object", large_fun(2));
+
+    // Make sure the results are used so that the compiler doesn't optimize the loops away
+    return result == 0 ? 1 : 0;
+}
@@ -279,3 +279,80 @@ BOOST_AUTO_TEST_CASE(erasure)
     BOOST_CHECK(set2.empty());
     BOOST_CHECK_EQUAL(set2.size(), 0UL);
 }
+
+// The test checks that large sets work as expected when elements are inserted and erased
+BOOST_AUTO_TEST_CASE(large_set)
+{
+    typedef logging::attribute_set attr_set;
+
+    enum { attribute_count = 60 };
+
+    std::vector< logging::attribute_name > names;
+    for (unsigned int i = 0; i < attribute_count; ++i)
+    {
+        std::string name = "LargeSetAttr";
+        name.push_back(static_cast< char >('A' + i / 26));
+        name.push_back(static_cast< char >('a' + i % 26));
+        names.push_back(logging::attribute_name(name));
+    }
+
+    attr_set set1;
+    for (unsigned int i = 0; i < attribute_count; ++i)
+        BOOST_CHECK(set1.insert(names[i], attrs::constant< unsigned int >(i)).second);
+    BOOST_CHECK_EQUAL(set1.size(), static_cast< attr_set::size_type >(attribute_count));
+
+    // Erase every other element and then insert them back a few times
+    for (unsigned int n = 0; n < 10; ++n)
+    {
+        for (unsigned int i = n % 2; i < attribute_count; i += 2)
+            BOOST_CHECK_EQUAL(set1.erase(names[i]), 1UL);
+        BOOST_CHECK_EQUAL(set1.size(), static_cast< attr_set::size_type >(attribute_count / 2));
+
+        for (unsigned int i = 0; i < attribute_count; ++i)
+            BOOST_CHECK_EQUAL(set1.count(names[i]), static_cast< attr_set::size_type >((i % 2) != (n % 2)));
+
+        for (unsigned int i = n % 2; i < attribute_count; i += 2)
+            BOOST_CHECK(set1.insert(names[i], attrs::constant< unsigned int >(i)).second);
+        BOOST_CHECK_EQUAL(set1.size(), static_cast< attr_set::size_type >(attribute_count));
+    }
+
+    // The copy must contain all elements
+    attr_set set2 = set1;
+    for (unsigned int i = 0; i < attribute_count; ++i)
+    {
+        attr_set::iterator it = set2.find(names[i]);
+        BOOST_REQUIRE(it != set2.end());
+        BOOST_CHECK(it->first == names[i]);
+    }
+}
+
+// The test checks that elements inserted in front of the elements with greater name ids can be found and are not duplicated
+BOOST_AUTO_TEST_CASE(reverse_order_insertion)
+{
+    typedef logging::attribute_set attr_set;
+
+    enum { attribute_count = 40 };
+
+    std::vector< logging::attribute_name > names;
+    for (unsigned int i = 0; i < attribute_count; ++i)
+    {
+        std::string name = "ReverseSetAttr";
+        name.push_back(static_cast< char >('A' + i / 26));
+        name.push_back(static_cast< char >('a' + i % 26));
+        names.push_back(logging::attribute_name(name));
+    }
+
+    attr_set set1;
+    for (unsigned int i = attribute_count; i > 0; --i)
+    {
+        BOOST_CHECK(set1.insert(names[i - 1], attrs::constant< unsigned int >(i - 1)).second);
+        BOOST_CHECK(set1.find(names[i - 1]) != set1.end());
+    }
+
+    for (unsigned int i = 0; i < attribute_count; ++i)
+    {
+        BOOST_CHECK_EQUAL(set1.count(names[i]), 1UL);
+        BOOST_CHECK(!set1.insert(names[i], attrs::constant< unsigned int >(i)).second);
+    }
+    BOOST_CHECK_EQUAL(set1.size(), static_cast< attr_set::size_type >(attribute_count));
+}
@@ -222,3 +222,121 @@ BOOST_AUTO_TEST_CASE(lookup)
     BOOST_CHECK_EQUAL(view1.count(data::attr3()), 1UL);
     BOOST_CHECK_EQUAL(view1.count(data::attr4()), 0UL);
 }
+
+// The test checks lookup of attributes with both small and large ids
+BOOST_AUTO_TEST_CASE(lookup_many_attributes)
+{
+    typedef logging::attribute_set attr_set;
+    typedef logging::attribute_value_set attr_values;
+
+    enum { attribute_count = 40 };
+
+    attr_set set1, set2, set3;
+    set1["Severity"] = attrs::constant< int >(-1);
+    std::vector< logging::attribute_name > names;
+    for (int i = 0; i < attribute_count; ++i)
+    {
+        std::string name = "LookupAttr";
+        name.push_back(static_cast< char >('A' + i / 26));
+        name.push_back(static_cast< char >('a' + i % 26));
+        names.push_back(logging::attribute_name(name));
+        (i % 2 == 0 ? set1 : set2)[names.back()] = attrs::constant< int >(i);
+    }
+
+    attr_values view1(set1, set2, set3);
+
+    // Look up values before the set is frozen
+    int val = 0;
+    for (int i = attribute_count - 1; i >= 0; --i)
+    {
+        attr_values::const_iterator it = view1.find(names[i]);
+        BOOST_REQUIRE(it != view1.end());
+        BOOST_CHECK(get_attr_value(it->second, val));
+        BOOST_CHECK_EQUAL(val, i);
+    }
+    BOOST_CHECK(view1.find("Channel") == view1.end());
+
+    view1.freeze();
+    BOOST_CHECK_EQUAL(view1.size(), static_cast< attr_values::size_type >(attribute_count + 1));
+    BOOST_CHECK(view1.find("Channel") == view1.end());
+
+    // The inserted element must not replace the existing one
+    BOOST_CHECK(!view1.insert("Severity", attrs::constant< int >(10).get_value()).second);
+
+    // Look up values in the copy of the set
+    attr_values view2 = view1;
+    BOOST_CHECK(get_attr_value(view2["Severity"], val));
+    BOOST_CHECK_EQUAL(val, -1);
+    for (int i = 0; i < attribute_count; ++i)
+    {
+        BOOST_CHECK(get_attr_value(view2[names[i]], val));
+        BOOST_CHECK_EQUAL(val, i);
+    }
+}
+
+// The test checks that the values that do not fit into the reserved storage are accounted
+BOOST_AUTO_TEST_CASE(insertion_beyond_reserve)
+{
+    typedef logging::attribute_value_set attr_values;
+
+    enum { attribute_count = 20 };
+
+    attr_values view1(2);
+    for (int i = 0; i < attribute_count; ++i)
+    {
+        std::string name = "ReserveValueAttr";
+        name.push_back(static_cast< char >('a' + i));
+        BOOST_CHECK(view1.insert(name, attrs::constant< int >(i).get_value()).second);
+    }
+    BOOST_CHECK_EQUAL(view1.size(), static_cast< attr_values::size_type >(attribute_count));
+    BOOST_CHECK_EQUAL(static_cast< attr_values::size_type >(std::distance(view1.begin(), view1.end())), view1.size());
+
+    // The copy must contain all values
+    attr_values view2 = view1;
+    BOOST_CHECK_EQUAL(view2.size(), static_cast< attr_values::size_type >(attribute_count));
+    int val = 0;
+    for (int i = 0; i < attribute_count; ++i)
+    {
+        std::string name = "ReserveValueAttr";
+        name.push_back(static_cast< char >('a' + i));
+        BOOST_CHECK(get_attr_value(view2[name], val));
+        BOOST_CHECK_EQUAL(val, i);
+    }
+}
+
+// The test checks that values inserted in front of the values with greater name ids can be found and are not duplicated
+BOOST_AUTO_TEST_CASE(reverse_order_insertion)
+{
+    typedef logging::attribute_set attr_set;
+    typedef logging::attribute_value_set attr_values;
+
+    enum { attribute_count = 40 };
+
+    std::vector< logging::attribute_name > names;
+    for (int i = 0; i < attribute_count; ++i)
+    {
+        std::string name = "ReverseValueAttr";
+        name.push_back(static_cast< char >('A' + i / 26));
+        name.push_back(static_cast< char >('a' + i % 26));
+        names.push_back(logging::attribute_name(name));
+    }
+
+    attr_set set1, set2, set3;
+    attr_values view1(set1, set2, set3);
+    for (int i = attribute_count; i > 0; --i)
+    {
+        BOOST_CHECK(view1.insert(names[i - 1], attrs::constant< int >(i - 1).get_value()).second);
+        BOOST_CHECK(view1.find(names[i - 1]) != view1.end());
+    }
+
+    int val = 0;
+    for (int i = 0; i < attribute_count; ++i)
+    {
+        attr_values::const_iterator it = view1.find(names[i]);
+        BOOST_REQUIRE(it != view1.end());
+        BOOST_CHECK(get_attr_value(it->second, val));
+        BOOST_CHECK_EQUAL(val, i);
+        BOOST_CHECK(!view1.insert(names[i], attrs::constant< int >(-1).get_value()).second);
+    }
+    BOOST_CHECK_EQUAL(view1.size(), static_cast< attr_values::size_type >(attribute_count));
+}
@@ -0,0 +1,70 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   attr_mutable_constant.cpp
+ * \author Andrey Semashev
+ * \date   17.10.2026
+ *
+ * \brief  This header contains tests for the mutable constant attribute.
+ */
+
+#define BOOST_TEST_MODULE attr_mutable_constant
+
+#include <boost/test/included/unit_test.hpp>
+#include <boost/log/attributes/attribute_value.hpp>
+#include <boost/log/attributes/mutable_constant.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
+
+namespace logging = boost::log;
+namespace attrs = logging::attributes;
+
+namespace {
+
+    //! The number of existing counted objects
+    unsigned int g_LiveCount = 0u;
+
+    //! The value type counts its instances
+    struct counted
+    {
+        int m_Value;
+
+        explicit counted(int value) : m_Value(value) { ++g_LiveCount; }
+        counted(counted const& that) : m_Value(that.m_Value) { ++g_LiveCount; }
+        ~counted() { --g_LiveCount; }
+    };
+
+    typedef attrs::mutable_constant< counted, attrs::lock_free_update > counted_constant;
+
+} // namespace
+
+// The test checks that the lock-free mutable constant releases the replaced values unless they are acquired
+BOOST_AUTO_TEST_CASE(lock_free_reclamation)
+{
+    {
+        counted_constant attr = counted_constant(counted(0));
+        BOOST_CHECK_EQUAL(g_LiveCount, 1u);
+
+        logging::attribute_value acquired = attr.get_value();
+        for (int i = 1; i <= 10; ++i)
+        {
+            attr.set(counted(i));
+            BOOST_CHECK_EQUAL(attr.get().m_Value, i);
+
+            // The current value and the acquired one
+            BOOST_CHECK_EQUAL(g_LiveCount, 2u);
+        }
+
+        // The acquired value is not affected by the modifications
+        logging::value_ref< counted > ref = logging::extract< counted >(acquired);
+        BOOST_REQUIRE(!!ref);
+        BOOST_CHECK_EQUAL(ref.get().m_Value, 0);
+
+        acquired = logging::attribute_value();
+        BOOST_CHECK_EQUAL(g_LiveCount, 1u);
+    }
+    BOOST_CHECK_EQUAL(g_LiveCount, 0u);
+}
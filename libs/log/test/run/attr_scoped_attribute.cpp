@@ -0,0 +1,148 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   attr_scoped_attribute.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header contains tests for the scoped attributes.
+ */
+
+#define BOOST_TEST_MODULE attr_scoped_attribute
+
+#include <string>
+#include <boost/test/included/unit_test.hpp>
+#include <boost/move/utility.hpp>
+#include <boost/log/core/core.hpp>
+#include <boost/log/core/record.hpp>
+#include <boost/log/core/record_view.hpp>
+#include <boost/log/attributes/constant.hpp>
+#include <boost/log/attributes/attribute_set.hpp>
+#include <boost/log/attributes/scoped_attribute.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
+#include <boost/log/sources/logger.hpp>
+
+namespace logging = boost::log;
+namespace attrs = logging::attributes;
+namespace src = logging::sources;
+
+namespace {
+
+    //! Makes a record with the thread-specific attributes
+    logging::record_view make_thread_record()
+    {
+        logging::attribute_set attrs;
+        logging::record rec = logging::core::get()->open_record(attrs);
+        BOOST_REQUIRE(!!rec);
+        return rec.lock();
+    }
+
+    //! Makes a record with the logger
+    template< typename LoggerT >
+    logging::record_view make_logger_record(LoggerT& lg)
+    {
+        logging::record rec = lg.open_record();
+        BOOST_REQUIRE(!!rec);
+        return rec.lock();
+    }
+
+    std::string get_tag(logging::record_view const& rec)
+    {
+        return logging::extract_or_default< std::string >("Tag", rec, std::string());
+    }
+
+    std::string get_tag(logging::attribute_set const& attrs)
+    {
+        logging::attribute_set::const_iterator it = attrs.find("Tag");
+        if (it == attrs.end())
+            return std::string();
+        return logging::extract_or_default< std::string >(it->second.get_value(), std::string());
+    }
+
+} // namespace
+
+// The test checks that the scoped thread tag is registered and unregistered
+BOOST_AUTO_TEST_CASE(thread_tag)
+{
+    {
+        BOOST_LOG_SCOPED_THREAD_TAG("Tag", "Outer");
+        BOOST_CHECK_EQUAL(get_tag(logging::core::get()->get_thread_attributes()), "Outer");
+        BOOST_CHECK_EQUAL(get_tag(make_thread_record()), "Outer");
+
+        {
+            // Same-named attributes are not overridden
+            BOOST_LOG_SCOPED_THREAD_TAG("Tag", "Inner");
+            BOOST_CHECK_EQUAL(get_tag(make_thread_record()), "Outer");
+        }
+
+        BOOST_CHECK_EQUAL(get_tag(make_thread_record()), "Outer");
+    }
+
+    BOOST_CHECK(logging::core::get()->get_thread_attributes().empty());
+    BOOST_CHECK_EQUAL(get_tag(make_thread_record()), "");
+}
+
+// The test checks that the records and attribute sets that outlive the scope do not refer to the scoped tag
+BOOST_AUTO_TEST_CASE(thread_tag_detaching)
+{
+    logging::record_view rec;
+    logging::attribute_set attrs;
+    {
+        BOOST_LOG_SCOPED_THREAD_TAG("Tag", std::string("Request 1"));
+        rec = make_thread_record();
+        attrs = logging::core::get()->get_thread_attributes();
+    }
+
+    BOOST_CHECK_EQUAL(get_tag(rec), "Request 1");
+    BOOST_CHECK_EQUAL(get_tag(attrs), "Request 1");
+}
+
+// The test checks that the scoped thread attribute is registered and unregistered
+BOOST_AUTO_TEST_CASE(thread_attribute)
+{
+    {
+        BOOST_LOG_SCOPED_THREAD_ATTR("Tag", attrs::constant< std::string >("Attribute"));
+        BOOST_CHECK_EQUAL(get_tag(make_thread_record()), "Attribute");
+
+        // The attribute can be erased from the set before the scope is left
+        logging::core::get()->set_thread_attributes(logging::attribute_set());
+        BOOST_CHECK_EQUAL(get_tag(make_thread_record()), "");
+    }
+
+    BOOST_CHECK(logging::core::get()->get_thread_attributes().empty());
+}
+
+// The test checks that the scoped logger tags are registered and unregistered
+BOOST_AUTO_TEST_CASE(logger_tag)
+{
+    src::logger lg;
+    logging::record_view rec;
+    {
+        BOOST_LOG_SCOPED_LOGGER_TAG(lg, "Tag", "Logger");
+        BOOST_CHECK_EQUAL(get_tag(lg.get_attributes()), "Logger");
+        rec = make_logger_record(lg);
+        BOOST_CHECK_EQUAL(get_tag(rec), "Logger");
+
+        // Copies of the logger do not refer to the scoped tag
+        src::logger lg_copy(lg);
+        BOOST_CHECK_EQUAL(get_tag(make_logger_record(lg_copy)), "Logger");
+    }
+
+    BOOST_CHECK(lg.get_attributes().empty());
+    BOOST_CHECK_EQUAL(get_tag(rec), "Logger");
+
+#if !defined(BOOST_LOG_NO_THREADS)
+    src::logger_mt lg_mt;
+    {
+        BOOST_LOG_SCOPED_LOGGER_TAG(lg_mt, "Tag", "Logger MT");
+        rec = make_logger_record(lg_mt);
+    }
+
+    BOOST_CHECK(lg_mt.get_attributes().empty());
+    BOOST_CHECK_EQUAL(get_tag(rec), "Logger MT");
+#endif // !defined(BOOST_LOG_NO_THREADS)
+}
@@ -0,0 +1,115 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   attr_string_view_value.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header contains tests for the string attribute values that refer to external strings.
+ */
+
+#define BOOST_TEST_MODULE attr_string_view_value
+
+#include <string>
+#include <boost/test/included/unit_test.hpp>
+#include <boost/log/core/record.hpp>
+#include <boost/log/attributes/attribute_value.hpp>
+#include <boost/log/attributes/attribute_value_set.hpp>
+#include <boost/log/attributes/string_view_value.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
+#include <boost/log/sources/logger.hpp>
+#include <boost/log/sources/record_ostream.hpp>
+#include <boost/log/utility/string_literal.hpp>
+#include <boost/log/utility/type_dispatch/standard_types.hpp>
+#include <boost/log/utility/manipulators/add_value.hpp>
+
+namespace logging = boost::log;
+namespace attrs = logging::attributes;
+namespace src = logging::sources;
+
+// The test checks that the value refers to the string and can be extracted as a string and as a literal
+BOOST_AUTO_TEST_CASE(extraction)
+{
+    std::string str = "Hello";
+    logging::attribute_value value = attrs::make_string_view_value(str);
+    BOOST_CHECK(value.get_type() == logging::type_info_wrapper(typeid(std::string)));
+
+    logging::value_ref< logging::string_literal > lit = value.extract< logging::string_literal >();
+    BOOST_REQUIRE(!!lit);
+    BOOST_CHECK(lit.get().c_str() == str.c_str());
+    BOOST_CHECK_EQUAL(lit.get(), "Hello");
+
+    BOOST_CHECK_EQUAL(logging::extract_or_default< std::string >(value, std::string()), "Hello");
+
+    // Visitors that support both types receive the literal
+    logging::value_ref< logging::string_types > any = value.extract< logging::string_types >();
+    BOOST_REQUIRE(!!any);
+    BOOST_CHECK_EQUAL(any.which(), 1u);
+}
+
+// The test checks that the detached value owns a copy of the string
+BOOST_AUTO_TEST_CASE(detaching)
+{
+    char buf[16] = "Hello";
+    logging::attribute_value value = attrs::make_string_view_value(buf);
+    BOOST_CHECK_EQUAL(logging::extract_or_default< logging::string_literal >(value, logging::string_literal()).c_str(), static_cast< const char* >(buf));
+
+    logging::attribute_value detached = value;
+    detached.detach_from_thread();
+    buf[0] = 'J';
+
+    BOOST_CHECK_EQUAL(logging::extract_or_default< std::string >(value, std::string()), "Jello");
+    BOOST_CHECK_EQUAL(logging::extract_or_default< std::string >(detached, std::string()), "Hello");
+    BOOST_CHECK_EQUAL(logging::extract_or_default< logging::string_literal >(detached, logging::string_literal()), "Hello");
+
+    // Detaching an owning value does not copy the string again
+    logging::attribute_value detached_again = detached;
+    detached_again.detach_from_thread();
+    BOOST_CHECK(logging::extract< logging::string_literal >(detached_again).get().c_str() == logging::extract< logging::string_literal >(detached).get().c_str());
+}
+
+// The test checks that add_value_ref refers to strings and character arrays instead of copying them
+BOOST_AUTO_TEST_CASE(add_value_ref)
+{
+    src::logger lg;
+    std::string str = "String";
+    logging::record rec = lg.open_record();
+    BOOST_REQUIRE(!!rec);
+    {
+        logging::record_ostream strm(rec);
+        strm << logging::add_value_ref("String", str) << logging::add_value_ref("Literal", "Literal");
+    }
+
+    logging::attribute_value_set const& values = rec.attribute_values();
+
+    logging::value_ref< logging::string_literal > lit = logging::extract< logging::string_literal >("String", values);
+    BOOST_REQUIRE(!!lit);
+    BOOST_CHECK(lit.get().c_str() == str.c_str());
+
+    BOOST_CHECK_EQUAL(logging::extract_or_default< logging::string_literal >("Literal", values, logging::string_literal()), "Literal");
+    BOOST_CHECK_EQUAL(logging::extract_or_default< std::string >("Literal", values, std::string()), "Literal");
+}
+
+// The test checks that add_value copies strings
+BOOST_AUTO_TEST_CASE(add_value)
+{
+    src::logger lg;
+    std::string str = "String";
+    logging::record rec = lg.open_record();
+    BOOST_REQUIRE(!!rec);
+    {
+        logging::record_ostream strm(rec);
+        strm << logging::add_value("String", str) << logging::add_value("Temporary", std::string("Temporary"));
+    }
+
+    // The values are owned by the record and do not refer to the strings
+    str = "Modified";
+    logging::attribute_value_set const& values = rec.attribute_values();
+    BOOST_CHECK(!logging::extract< logging::string_literal >("String", values));
+    BOOST_CHECK_EQUAL(logging::extract_or_default< std::string >("String", values, std::string()), "String");
+    BOOST_CHECK_EQUAL(logging::extract_or_default< std::string >("Temporary", values, std::string()), "Temporary");
+}
@@ -0,0 +1,279 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   filt_rate_limit.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header contains tests for the \c rate_limit and \c sample filters.
+ */
+
+#define BOOST_TEST_MODULE filt_rate_limit
+
+#include <string>
+#include <vector>
+#include <boost/make_shared.hpp>
+#include <boost/test/included/unit_test.hpp>
+#include <boost/date_time/microsec_time_clock.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/log/core.hpp>
+#include <boost/log/attributes/call_site.hpp>
+#include <boost/log/attributes/constant.hpp>
+#include <boost/log/attributes/attribute_set.hpp>
+#include <boost/log/attributes/attribute_value_set.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
+#include <boost/log/expressions.hpp>
+#include <boost/log/sinks/sync_frontend.hpp>
+#include <boost/log/sinks/basic_sink_backend.hpp>
+#include <boost/log/sources/logger.hpp>
+#include <boost/log/sources/severity_logger.hpp>
+#include <boost/log/sources/record_ostream.hpp>
+#include <boost/log/utility/setup/filter_parser.hpp>
+
+namespace logging = boost::log;
+namespace attrs = logging::attributes;
+namespace expr = logging::expressions;
+namespace sinks = logging::sinks;
+namespace src = logging::sources;
+
+namespace {
+
+    const char file1[] = "file1.cpp";
+    const char file2[] = "file2.cpp";
+
+    //! Checks the filter with the call site attribute value
+    bool check(logging::filter const& f, logging::call_site const& site)
+    {
+        logging::attribute_set set1, set2, set3;
+        set1["CallSite"] = attrs::make_constant(site);
+        logging::attribute_value_set values(set1, set2, set3);
+        return f(values);
+    }
+
+    //! The backend stores messages and call sites of log records
+    class collecting_backend :
+        public sinks::basic_sink_backend< sinks::synchronized_feeding >
+    {
+    public:
+        std::vector< std::string > m_Messages;
+        std::vector< logging::call_site > m_Sites;
+        std::vector< int > m_Severities;
+
+        void consume(logging::record_view const& rec)
+        {
+            m_Messages.push_back(logging::extract_or_default< std::string >("Message", rec.attribute_values(), std::string()));
+            m_Sites.push_back(logging::extract_or_default< logging::call_site >("CallSite", rec.attribute_values(), logging::call_site()));
+            m_Severities.push_back(logging::extract_or_default< int >("Severity", rec.attribute_values(), -1));
+        }
+    };
+
+} // namespace
+
+// The test checks that the logging macros only track call sites after a call site attribute is created. Must be the first test.
+BOOST_AUTO_TEST_CASE(call_site_tracking)
+{
+    BOOST_CHECK(!logging::aux::is_call_site_tracking_enabled());
+    attrs::current_call_site attr;
+    BOOST_CHECK(logging::aux::is_call_site_tracking_enabled());
+}
+
+// The test checks that the rate limit is applied to every call site independently
+BOOST_AUTO_TEST_CASE(rate_limit)
+{
+    logging::filter f = expr::rate_limit("CallSite", 3u, boost::posix_time::hours(1));
+
+    const logging::call_site site1(file1, 10u), site2(file1, 20u), site3(file2, 10u);
+    for (unsigned int i = 0; i < 3u; ++i)
+        BOOST_CHECK(check(f, site1));
+    BOOST_CHECK(!check(f, site1));
+    BOOST_CHECK(!check(f, site1));
+
+    BOOST_CHECK(check(f, site2));
+    BOOST_CHECK(check(f, site3));
+
+    // Copies of the filter share the counters
+    logging::filter f2 = f;
+    BOOST_CHECK(!check(f2, site1));
+
+    // Records without the call site always pass
+    logging::attribute_set set1, set2, set3;
+    logging::attribute_value_set values(set1, set2, set3);
+    BOOST_CHECK(f(values));
+}
+
+// The test checks that the sampling filter passes every N-th record at every call site
+BOOST_AUTO_TEST_CASE(sample)
+{
+    logging::filter f = expr::sample("CallSite", 4u);
+
+    const logging::call_site site1(file1, 10u), site2(file2, 10u);
+    for (unsigned int i = 0; i < 12u; ++i)
+    {
+        BOOST_CHECK_EQUAL(check(f, site1), (i % 4u) == 0u);
+    }
+    BOOST_CHECK(check(f, site2));
+    BOOST_CHECK(!check(f, site2));
+}
+
+// The test checks that filters can be specified in the settings syntax
+BOOST_AUTO_TEST_CASE(settings)
+{
+    const logging::call_site site1(file1, 10u);
+
+    logging::filter f = logging::parse_filter("%CallSite% rate_limit 2/1h");
+    BOOST_CHECK(check(f, site1));
+    BOOST_CHECK(check(f, site1));
+    BOOST_CHECK(!check(f, site1));
+
+    f = logging::parse_filter("%CallSite% sample 2");
+    BOOST_CHECK(check(f, site1));
+    BOOST_CHECK(!check(f, site1));
+    BOOST_CHECK(check(f, site1));
+
+    BOOST_CHECK_THROW(logging::parse_filter("%CallSite% rate_limit 2/1day"), logging::parse_error);
+    BOOST_CHECK_THROW(logging::parse_filter("%CallSite% sample 0"), logging::parse_error);
+}
+
+// The test checks that the logging macros capture call sites and report suppressed records
+BOOST_AUTO_TEST_CASE(suppressed_records_summary)
+{
+    boost::shared_ptr< logging::core > core = logging::core::get();
+    boost::shared_ptr< collecting_backend > backend = boost::make_shared< collecting_backend >();
+    boost::shared_ptr< sinks::synchronous_sink< collecting_backend > > sink =
+        boost::make_shared< sinks::synchronous_sink< collecting_backend > >(backend);
+    core->add_sink(sink);
+    core->add_global_attribute("CallSite", attrs::current_call_site());
+    core->set_filter(expr::rate_limit("CallSite", 1u, boost::posix_time::milliseconds(200)));
+
+    src::logger lg;
+    for (unsigned int i = 0; i < 2u; ++i)
+    {
+        for (unsigned int j = 0; j < 5u; ++j)
+        {
+            BOOST_LOG(lg) << "Record " << i;
+        }
+        if (i == 0u)
+        {
+            // Wait until the next record is allowed to pass
+            typedef boost::date_time::microsec_clock< boost::posix_time::ptime > clock;
+            const boost::posix_time::ptime deadline = clock::universal_time() + boost::posix_time::milliseconds(300);
+            while (clock::universal_time() < deadline) {}
+        }
+    }
+
+    core->reset_filter();
+    core->remove_global_attribute(core->get_global_attributes().find("CallSite"));
+    core->remove_sink(sink);
+
+    BOOST_REQUIRE_EQUAL(backend->m_Messages.size(), 3u);
+    BOOST_CHECK_EQUAL(backend->m_Messages[0], "Record 0");
+    BOOST_CHECK_EQUAL(backend->m_Messages[1], "Suppressed 4 log records");
+    BOOST_CHECK_EQUAL(backend->m_Messages[2], "Record 1");
+
+    BOOST_CHECK(backend->m_Sites[0].file_name() != NULL);
+    BOOST_CHECK(backend->m_Sites[0] == backend->m_Sites[1]);
+    BOOST_CHECK(backend->m_Sites[0] == backend->m_Sites[2]);
+}
+
+namespace {
+
+    //! Makes a record with the severity level 1
+    void log_here(src::severity_logger< int >& lg)
+    {
+        BOOST_LOG_SEV(lg, 1) << "Record";
+    }
+
+    //! Makes a record with the severity level 2 at a different call site
+    void log_elsewhere(src::severity_logger< int >& lg)
+    {
+        BOOST_LOG_SEV(lg, 2) << "Elsewhere";
+    }
+
+} // namespace
+
+// The test checks that suppressed records are only reported at their call site, with the named arguments of that call site
+BOOST_AUTO_TEST_CASE(call_site_summary_arguments)
+{
+    boost::shared_ptr< logging::core > core = logging::core::get();
+    boost::shared_ptr< collecting_backend > backend = boost::make_shared< collecting_backend >();
+    boost::shared_ptr< sinks::synchronous_sink< collecting_backend > > sink =
+        boost::make_shared< sinks::synchronous_sink< collecting_backend > >(backend);
+    core->add_sink(sink);
+    std::pair< logging::attribute_set::iterator, bool > res = core->add_global_attribute("CallSite", attrs::current_call_site());
+    core->set_filter(expr::rate_limit("CallSite", 1u, boost::posix_time::milliseconds(200)));
+
+    src::severity_logger< int > lg;
+    for (unsigned int i = 0; i < 5u; ++i)
+        log_here(lg);
+
+    // Wait until the period expires
+    typedef boost::date_time::microsec_clock< boost::posix_time::ptime > clock;
+    const boost::posix_time::ptime deadline = clock::universal_time() + boost::posix_time::milliseconds(300);
+    while (clock::universal_time() < deadline) {}
+
+    // Records at other call sites do not report the suppressed records
+    log_elsewhere(lg);
+    log_here(lg);
+
+    core->reset_filter();
+    core->remove_global_attribute(res.first);
+    core->remove_sink(sink);
+
+    BOOST_REQUIRE_EQUAL(backend->m_Messages.size(), 4u);
+    BOOST_CHECK_EQUAL(backend->m_Messages[0], "Record");
+    BOOST_CHECK_EQUAL(backend->m_Messages[1], "Elsewhere");
+    BOOST_CHECK_EQUAL(backend->m_Messages[2], "Suppressed 4 log records");
+    BOOST_CHECK_EQUAL(backend->m_Messages[3], "Record");
+
+    BOOST_CHECK_EQUAL(backend->m_Severities[0], 1);
+    BOOST_CHECK_EQUAL(backend->m_Severities[1], 2);
+    BOOST_CHECK_EQUAL(backend->m_Severities[2], 1);
+    BOOST_CHECK_EQUAL(backend->m_Severities[3], 1);
+
+    BOOST_CHECK(backend->m_Sites[0] != backend->m_Sites[1]);
+    BOOST_CHECK(backend->m_Sites[0] == backend->m_Sites[2]);
+    BOOST_CHECK(backend->m_Sites[0] == backend->m_Sites[3]);
+}
+
+// The test checks that the filters register the call site attribute
+BOOST_AUTO_TEST_CASE(call_site_attribute_registration)
+{
+    boost::shared_ptr< logging::core > core = logging::core::get();
+    boost::shared_ptr< collecting_backend > backend = boost::make_shared< collecting_backend >();
+    boost::shared_ptr< sinks::synchronous_sink< collecting_backend > > sink =
+        boost::make_shared< sinks::synchronous_sink< collecting_backend > >(backend);
+    core->add_sink(sink);
+
+    logging::attribute_set globals = core->get_global_attributes();
+    BOOST_REQUIRE(globals.find("Site") == globals.end());
+    core->set_filter(logging::parse_filter("%Site% rate_limit 2/1h"));
+    globals = core->get_global_attributes();
+    BOOST_CHECK(globals.find("Site") != globals.end());
+
+    src::logger lg;
+    for (unsigned int i = 0; i < 5u; ++i)
+    {
+        BOOST_LOG(lg) << "Record";
+    }
+
+    core->reset_filter();
+    globals.erase("Site");
+    core->set_global_attributes(globals);
+    core->remove_sink(sink);
+
+    BOOST_CHECK_EQUAL(backend->m_Messages.size(), 2u);
+
+    // An attribute that is already registered is left intact
+    std::pair< logging::attribute_set::iterator, bool > res =
+        core->add_global_attribute("Site", attrs::make_constant(logging::call_site(file1, 10u)));
+    BOOST_REQUIRE(res.second);
+    logging::filter f = expr::sample("Site", 2u);
+    globals = core->get_global_attributes();
+    BOOST_REQUIRE(globals.find("Site") != globals.end());
+    BOOST_CHECK(globals.find("Site")->second.get_value().extract_or_default(logging::call_site()) == logging::call_site(file1, 10u));
+    core->remove_global_attribute(res.first);
+}
@@ -21,6 +21,8 @@
 #include <ostream>
 #include <algorithm>
 #include <boost/date_time.hpp>
+#include <boost/move/utility.hpp>
+#include <boost/range/iterator_range_core.hpp>
 #include <boost/test/included/unit_test.hpp>
 #include <boost/log/expressions.hpp>
 #include <boost/log/attributes/constant.hpp>
@@ -210,3 +212,32 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(time_duration, CharT, char_types)
         BOOST_CHECK(equal_strings(strm1.str(), strm2.str()));
     }
 }
+
+// The test checks that date and time formatters keep their literals when copied and moved
+BOOST_AUTO_TEST_CASE_TEMPLATE(formatter_copy_and_move, CharT, char_types)
+{
+    typedef std::basic_string< CharT > string;
+    typedef logging::basic_formatting_ostream< CharT > osstream;
+    typedef typename logging::expressions::aux::date_time_formatter_generator_traits< ptime, CharT >::formatter formatter;
+
+    const CharT literal[] = { static_cast< CharT >('a'), static_cast< CharT >('b'), static_cast< CharT >('c') };
+    ptime t1(gdate(2009, 2, 7), ptime::time_duration_type(14, 40, 15));
+
+    formatter f1;
+    f1.add_literal(boost::make_iterator_range(literal, literal + 2));
+    f1.add_literal(boost::make_iterator_range(literal + 2, literal + 3));
+
+    // Moving swaps the formatter contents with the empty formatter
+    formatter f2(boost::move(f1));
+    formatter f3;
+    f3 = f2;
+
+    string str1, str2;
+    osstream strm1(str1), strm2(str2);
+    f2(strm1, t1);
+    f3(strm2, t1);
+    strm1.flush();
+    strm2.flush();
+    BOOST_CHECK(equal_strings(str1, string(literal, literal + 3)));
+    BOOST_CHECK(equal_strings(str2, string(literal, literal + 3)));
+}
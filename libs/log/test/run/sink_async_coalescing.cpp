@@ -0,0 +1,380 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   sink_async_coalescing.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header contains tests for merging repeated records in the asynchronous sink frontend.
+ */
+
+#define BOOST_TEST_MODULE sink_async_coalescing
+
+#include <boost/log/detail/config.hpp>
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+#include <string>
+#include <deque>
+#include <vector>
+#include <functional>
+#include <boost/make_shared.hpp>
+#include <boost/mpl/list.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/test/included/unit_test.hpp>
+#include <boost/log/attributes/constant.hpp>
+#include <boost/log/attributes/attribute_set.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
+#include <boost/log/sinks/async_frontend.hpp>
+#include <boost/log/sinks/basic_sink_backend.hpp>
+#include <boost/log/sinks/block_on_overflow.hpp>
+#include <boost/log/sinks/bounded_fifo_queue.hpp>
+#include <boost/log/sinks/bounded_ordering_queue.hpp>
+#include <boost/log/sinks/unbounded_ordering_queue.hpp>
+#include <boost/log/utility/record_ordering.hpp>
+#include "make_record.hpp"
+
+namespace logging = boost::log;
+namespace attrs = logging::attributes;
+namespace sinks = logging::sinks;
+namespace keywords = logging::keywords;
+
+namespace {
+
+    //! The backend stores records
+    class collecting_backend :
+        public sinks::basic_sink_backend< sinks::synchronized_feeding >
+    {
+    public:
+        std::vector< logging::record_view > m_Records;
+
+        void consume(logging::record_view const& rec)
+        {
+            m_Records.push_back(rec);
+        }
+    };
+
+    typedef sinks::asynchronous_sink< collecting_backend > sink_t;
+
+    //! Makes a record with the specified message, severity level and time stamp
+    logging::record_view make_message(std::string const& message, int severity, unsigned int timestamp)
+    {
+        logging::attribute_set attrs;
+        attrs["Message"] = attrs::make_constant(message);
+        attrs["Severity"] = attrs::make_constant(severity);
+        attrs["TimeStamp"] = attrs::make_constant(timestamp);
+        return make_record_view(attrs);
+    }
+
+    std::string get_message(logging::record_view const& rec)
+    {
+        return logging::extract_or_default< std::string >("Message", rec, std::string());
+    }
+
+    int get_severity(logging::record_view const& rec)
+    {
+        return logging::extract_or_default< int >("Severity", rec, -1);
+    }
+
+    boost::uintmax_t get_repeat_count(logging::record_view const& rec)
+    {
+        return logging::extract_or_default< boost::uintmax_t >("RepeatCount", rec, static_cast< boost::uintmax_t >(0u));
+    }
+
+} // namespace
+
+// The test checks that repeated records are merged and the merged records are passed on flush
+BOOST_AUTO_TEST_CASE(merging)
+{
+    boost::shared_ptr< collecting_backend > backend = boost::make_shared< collecting_backend >();
+    boost::shared_ptr< sink_t > sink = boost::make_shared< sink_t >(
+        backend, keywords::start_thread = false, keywords::coalescing_window = boost::posix_time::hours(1));
+
+    unsigned int timestamp = 0;
+    for (unsigned int i = 0; i < 5u; ++i)
+        sink->consume(make_message("Connection failed", 1, timestamp++));
+    sink->consume(make_message("Connection restored", 1, timestamp++));
+    sink->consume(make_message("Connection failed", 2, timestamp++));
+    sink->consume(make_message("Connection failed", 2, timestamp++));
+
+    // Records without a message are not merged
+    logging::attribute_set attrs;
+    sink->consume(make_record_view(attrs));
+    sink->consume(make_record_view(attrs));
+
+    sink->flush();
+
+    BOOST_REQUIRE_EQUAL(backend->m_Records.size(), 7u);
+
+    // The first records of every kind pass immediately
+    BOOST_CHECK_EQUAL(get_message(backend->m_Records[0]), "Connection failed");
+    BOOST_CHECK_EQUAL(get_repeat_count(backend->m_Records[0]), 0u);
+    BOOST_CHECK_EQUAL(get_message(backend->m_Records[1]), "Connection restored");
+    BOOST_CHECK_EQUAL(get_message(backend->m_Records[2]), "Connection failed");
+    BOOST_CHECK_EQUAL(get_severity(backend->m_Records[2]), 2);
+    BOOST_CHECK_EQUAL(get_message(backend->m_Records[3]), "");
+    BOOST_CHECK_EQUAL(get_message(backend->m_Records[4]), "");
+
+    // The repeated records are passed on flush
+    bool merged_found = false, single_found = false;
+    for (unsigned int i = 5u; i < 7u; ++i)
+    {
+        logging::record_view const& rec = backend->m_Records[i];
+        BOOST_CHECK_EQUAL(get_message(rec), "Connection failed");
+        if (get_severity(rec) == 1)
+        {
+            merged_found = true;
+            BOOST_CHECK_EQUAL(get_repeat_count(rec), 4u);
+            BOOST_CHECK_EQUAL(logging::extract_or_default< unsigned int >("FirstTimeStamp", rec, 0u), 1u);
+            BOOST_CHECK_EQUAL(logging::extract_or_default< unsigned int >("LastTimeStamp", rec, 0u), 4u);
+            BOOST_CHECK_EQUAL(logging::extract_or_default< unsigned int >("TimeStamp", rec, 0u), 1u);
+        }
+        else
+        {
+            // A single repeated record is passed unchanged
+            single_found = true;
+            BOOST_CHECK_EQUAL(get_severity(rec), 2);
+            BOOST_CHECK_EQUAL(get_repeat_count(rec), 0u);
+            BOOST_CHECK_EQUAL(logging::extract_or_default< unsigned int >("TimeStamp", rec, 0u), 7u);
+        }
+    }
+    BOOST_CHECK(merged_found);
+    BOOST_CHECK(single_found);
+}
+
+namespace {
+
+    //! User-defined severity levels
+    enum user_severity_level
+    {
+        normal,
+        warning
+    };
+
+} // namespace
+
+// The test checks that the records with severity levels of unsupported types are passed unchanged and not merged
+BOOST_AUTO_TEST_CASE(unsupported_key_types)
+{
+    boost::shared_ptr< collecting_backend > backend = boost::make_shared< collecting_backend >();
+    boost::shared_ptr< sink_t > sink = boost::make_shared< sink_t >(
+        backend, keywords::start_thread = false, keywords::coalescing_window = boost::posix_time::hours(1));
+
+    for (unsigned int i = 0; i < 3u; ++i)
+    {
+        logging::attribute_set attrs;
+        attrs["Message"] = attrs::make_constant(std::string("Connection failed"));
+        attrs["Severity"] = attrs::make_constant(warning);
+        attrs["TimeStamp"] = attrs::make_constant(i);
+        sink->consume(make_record_view(attrs));
+    }
+
+    sink->flush();
+
+    BOOST_REQUIRE_EQUAL(backend->m_Records.size(), 3u);
+    for (unsigned int i = 0; i < 3u; ++i)
+    {
+        logging::record_view const& rec = backend->m_Records[i];
+        BOOST_CHECK_EQUAL(get_repeat_count(rec), 0u);
+        BOOST_CHECK_EQUAL(logging::extract_or_default< unsigned int >("TimeStamp", rec, 100u), i);
+        BOOST_CHECK(logging::extract_or_default< user_severity_level >("Severity", rec, normal) == warning);
+    }
+}
+
+// The test checks that the merged records are passed when the window closes
+BOOST_AUTO_TEST_CASE(window_expiration)
+{
+    boost::shared_ptr< collecting_backend > backend = boost::make_shared< collecting_backend >();
+    boost::shared_ptr< sink_t > sink = boost::make_shared< sink_t >(
+        backend, keywords::coalescing_window = boost::posix_time::milliseconds(50));
+
+    for (unsigned int i = 0; i < 3u; ++i)
+        sink->consume(make_message("Connection failed", 1, i));
+
+    // Wait for the window to close, without flushing the sink
+    std::size_t count = 0;
+    for (unsigned int i = 0; i < 100u && count < 2u; ++i)
+    {
+        boost::this_thread::sleep(boost::posix_time::milliseconds(20));
+        count = sink->locked_backend()->m_Records.size();
+    }
+
+    sink->stop();
+
+    BOOST_REQUIRE_EQUAL(backend->m_Records.size(), 2u);
+    BOOST_CHECK_EQUAL(get_repeat_count(backend->m_Records[0]), 0u);
+    BOOST_CHECK_EQUAL(get_repeat_count(backend->m_Records[1]), 2u);
+
+    // After the window is closed the record passes immediately again
+    sink->consume(make_message("Connection failed", 1, 3u));
+    sink->flush();
+    BOOST_REQUIRE_EQUAL(backend->m_Records.size(), 3u);
+    BOOST_CHECK_EQUAL(get_repeat_count(backend->m_Records[2]), 0u);
+}
+
+namespace {
+
+    typedef logging::attribute_value_ordering< unsigned int, std::less< unsigned int > > timestamp_ordering;
+
+    //! A custom queueing strategy that does not support dequeueing records with a deadline
+    class untimed_queue
+    {
+    private:
+        boost::mutex m_Mutex;
+        boost::condition_variable m_Cond;
+        std::deque< logging::record_view > m_Records;
+        bool m_Interrupted;
+
+    protected:
+        untimed_queue() : m_Interrupted(false)
+        {
+        }
+        template< typename ArgsT >
+        explicit untimed_queue(ArgsT const&) : m_Interrupted(false)
+        {
+        }
+
+        void enqueue(logging::record_view const& rec)
+        {
+            boost::lock_guard< boost::mutex > lock(m_Mutex);
+            m_Records.push_back(rec);
+            m_Cond.notify_one();
+        }
+
+        bool try_enqueue(logging::record_view const& rec)
+        {
+            enqueue(rec);
+            return true;
+        }
+
+        bool try_dequeue_ready(logging::record_view& rec)
+        {
+            boost::lock_guard< boost::mutex > lock(m_Mutex);
+            return pop(rec);
+        }
+
+        bool try_dequeue(logging::record_view& rec)
+        {
+            return try_dequeue_ready(rec);
+        }
+
+        bool dequeue_ready(logging::record_view& rec)
+        {
+            boost::unique_lock< boost::mutex > lock(m_Mutex);
+            while (!m_Interrupted)
+            {
+                if (pop(rec))
+                    return true;
+                m_Cond.wait(lock);
+            }
+            m_Interrupted = false;
+            return false;
+        }
+
+        void interrupt_dequeue()
+        {
+            boost::lock_guard< boost::mutex > lock(m_Mutex);
+            m_Interrupted = true;
+            m_Cond.notify_one();
+        }
+
+    private:
+        bool pop(logging::record_view& rec)
+        {
+            if (m_Records.empty())
+                return false;
+            rec = m_Records.front();
+            m_Records.pop_front();
+            return true;
+        }
+    };
+
+    typedef boost::mpl::list<
+        sinks::unbounded_fifo_queue,
+        sinks::bounded_fifo_queue< 100u, sinks::block_on_overflow >,
+        sinks::unbounded_ordering_queue< timestamp_ordering >,
+        sinks::bounded_ordering_queue< timestamp_ordering, 100u, sinks::block_on_overflow >,
+        untimed_queue
+    > queueing_strategies;
+
+    //! Waits until the backend receives the specified number of records
+    template< typename SinkT >
+    std::size_t wait_for_records(SinkT& sink, std::size_t count)
+    {
+        std::size_t received = 0;
+        for (unsigned int i = 0; i < 200u && received < count; ++i)
+        {
+            boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+            received = sink.locked_backend()->m_Records.size();
+        }
+        return received;
+    }
+
+} // namespace
+
+// The test checks that the feeding thread passes new records and merged records while the windows are open with every queueing strategy
+BOOST_AUTO_TEST_CASE_TEMPLATE(queueing_strategies_wait, QueueT, queueing_strategies)
+{
+    typedef sinks::asynchronous_sink< collecting_backend, QueueT > queueing_sink_t;
+
+    boost::shared_ptr< collecting_backend > backend = boost::make_shared< collecting_backend >();
+    boost::shared_ptr< queueing_sink_t > sink = boost::make_shared< queueing_sink_t >(
+        backend,
+        keywords::coalescing_window = boost::posix_time::milliseconds(300),
+        keywords::order = logging::make_attr_ordering("TimeStamp", std::less< unsigned int >()),
+        keywords::ordering_window = boost::posix_time::milliseconds(10));
+
+    sink->consume(make_message("Connection failed", 1, 0u));
+    sink->consume(make_message("Connection failed", 1, 1u));
+    BOOST_REQUIRE_EQUAL(wait_for_records(*sink, 1u), 1u);
+
+    // A new record is passed while the window of the merged record is open
+    sink->consume(make_message("Connection restored", 1, 2u));
+    BOOST_REQUIRE_EQUAL(wait_for_records(*sink, 2u), 2u);
+
+    // The merged record is passed when the window closes
+    BOOST_REQUIRE_EQUAL(wait_for_records(*sink, 3u), 3u);
+
+    sink->stop();
+
+    BOOST_CHECK_EQUAL(get_message(backend->m_Records[0]), "Connection failed");
+    BOOST_CHECK_EQUAL(get_message(backend->m_Records[1]), "Connection restored");
+    BOOST_CHECK_EQUAL(get_message(backend->m_Records[2]), "Connection failed");
+    BOOST_CHECK_EQUAL(get_repeat_count(backend->m_Records[2]), 0u);
+}
+
+// The test checks that the queueing strategies that do not support dequeueing with a deadline can be used without merging
+BOOST_AUTO_TEST_CASE(untimed_queue_without_merging)
+{
+    BOOST_CHECK(!!sinks::aux::has_timed_dequeue_ready< sinks::unbounded_fifo_queue >::value);
+    BOOST_CHECK(!sinks::aux::has_timed_dequeue_ready< untimed_queue >::value);
+
+    typedef sinks::asynchronous_sink< collecting_backend, untimed_queue > untimed_sink_t;
+    boost::shared_ptr< collecting_backend > backend = boost::make_shared< collecting_backend >();
+    boost::shared_ptr< untimed_sink_t > sink = boost::make_shared< untimed_sink_t >(backend);
+
+    sink->consume(make_message("Connection failed", 1, 0u));
+    sink->consume(make_message("Connection failed", 1, 1u));
+    sink->stop();
+    sink->flush();
+
+    BOOST_CHECK_EQUAL(backend->m_Records.size(), 2u);
+}
+
+#else // !defined(BOOST_LOG_NO_THREADS)
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_CASE(threads_not_supported)
+{
+}
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
@@ -0,0 +1,128 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   sink_async_formatting.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header contains tests for parallel record formatting in the asynchronous sink frontend.
+ */
+
+#define BOOST_TEST_MODULE sink_async_formatting
+
+#include <boost/log/detail/config.hpp>
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <boost/lexical_cast.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/test/included/unit_test.hpp>
+#include <boost/log/attributes/constant.hpp>
+#include <boost/log/attributes/attribute_set.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
+#include <boost/log/sinks/async_frontend.hpp>
+#include <boost/log/sinks/basic_sink_backend.hpp>
+#include <boost/log/utility/formatting_ostream.hpp>
+#include "make_record.hpp"
+
+namespace logging = boost::log;
+namespace attrs = logging::attributes;
+namespace sinks = logging::sinks;
+namespace keywords = logging::keywords;
+
+namespace {
+
+    //! The backend stores formatted records
+    class collecting_backend :
+        public sinks::basic_formatted_sink_backend< char, sinks::synchronized_feeding >
+    {
+    public:
+        std::vector< std::string > m_Records;
+
+        void consume(logging::record_view const&, string_type const& formatted_message)
+        {
+            m_Records.push_back(formatted_message);
+        }
+    };
+
+    //! The formatter takes different time to format different records
+    struct slow_formatter
+    {
+        typedef void result_type;
+
+        void operator() (logging::record_view const& rec, logging::formatting_ostream& strm) const
+        {
+            const unsigned int n = logging::extract_or_throw< unsigned int >("Seq", rec);
+            if (n % 100u == 7u)
+                throw std::runtime_error("Formatting failed");
+            boost::this_thread::sleep(boost::posix_time::microseconds((n * 7u) % 13u));
+            strm << n;
+        }
+    };
+
+    //! The exception handler counts the exceptions
+    struct counting_handler
+    {
+        typedef void result_type;
+
+        unsigned int* m_pCount;
+
+        explicit counting_handler(unsigned int& count) : m_pCount(&count) {}
+        void operator() () const { ++*m_pCount; }
+    };
+
+} // namespace
+
+// The test checks that records are formatted in parallel and passed to the backend in the original order
+BOOST_AUTO_TEST_CASE(ordering)
+{
+    typedef sinks::asynchronous_sink< collecting_backend > sink_t;
+
+    enum { record_count = 1000 };
+    unsigned int exception_count = 0;
+
+    boost::shared_ptr< sink_t > sink = boost::make_shared< sink_t >(
+        boost::make_shared< collecting_backend >(), keywords::formatting_threads = 4u);
+    sink->set_formatter(slow_formatter());
+    sink->set_exception_handler(counting_handler(exception_count));
+
+    for (unsigned int i = 0; i < record_count; ++i)
+    {
+        logging::attribute_set attrs;
+        attrs["Seq"] = attrs::make_constant(i);
+        sink->consume(make_record_view(attrs));
+    }
+
+    sink->flush();
+    sink->stop();
+
+    BOOST_CHECK_EQUAL(exception_count, record_count / 100u);
+
+    sinks::asynchronous_sink< collecting_backend >::locked_backend_ptr backend = sink->locked_backend();
+    BOOST_REQUIRE_EQUAL(backend->m_Records.size(), static_cast< std::size_t >(record_count - record_count / 100u));
+    std::size_t index = 0;
+    for (unsigned int i = 0; i < record_count; ++i)
+    {
+        if (i % 100u != 7u)
+            BOOST_CHECK_EQUAL(backend->m_Records[index++], boost::lexical_cast< std::string >(i));
+    }
+}
+
+#else // !defined(BOOST_LOG_NO_THREADS)
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_CASE(threads_not_supported)
+{
+}
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
@@ -0,0 +1,250 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   sink_binary_ostream.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header contains tests for the binary stream sink backend and the binary log reader.
+ */
+
+#define BOOST_TEST_MODULE sink_binary_ostream
+
+#include <string>
+#include <sstream>
+#include <ostream>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/test/included/unit_test.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/date_time/gregorian/gregorian_types.hpp>
+#include <boost/log/exceptions.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/log/core/record_view.hpp>
+#include <boost/log/attributes/attribute_set.hpp>
+#include <boost/log/attributes/constant.hpp>
+#include <boost/log/sinks/binary_ostream_backend.hpp>
+#include <boost/log/utility/binary_log_reader.hpp>
+#include "make_record.hpp"
+
+namespace logging = boost::log;
+namespace attrs = logging::attributes;
+namespace sinks = logging::sinks;
+namespace binary_log = logging::binary_log;
+
+namespace {
+
+    //! The function returns the textual representation of the field
+    std::string to_string(binary_log::field const& f)
+    {
+        return boost::lexical_cast< std::string >(f);
+    }
+
+    //! A user-defined severity level
+    enum my_severity_level
+    {
+        normal,
+        warning,
+        error
+    };
+
+    template< typename CharT, typename TraitsT >
+    inline std::basic_ostream< CharT, TraitsT >& operator<< (std::basic_ostream< CharT, TraitsT >& strm, my_severity_level level)
+    {
+        static const char* const names[] = { "normal", "warning", "error" };
+        strm << names[level];
+        return strm;
+    }
+
+} // namespace
+
+// The test checks that attribute values are written and read back
+BOOST_AUTO_TEST_CASE(round_trip)
+{
+    boost::shared_ptr< std::stringstream > strm = boost::make_shared< std::stringstream >();
+    sinks::binary_ostream_backend backend;
+    backend.set_stream(strm);
+
+    const boost::posix_time::ptime ts(boost::gregorian::date(2026, 10, 16), boost::posix_time::time_duration(12, 30, 15) + boost::posix_time::microseconds(250));
+
+    logging::attribute_set set;
+    set["Flag"] = attrs::make_constant(true);
+    set["Int"] = attrs::make_constant(-150);
+    set["UInt"] = attrs::make_constant(300u);
+    set["Double"] = attrs::make_constant(2.5);
+    set["String"] = attrs::make_constant(std::string("hello"));
+    set["TimeStamp"] = attrs::make_constant(ts);
+    set["Duration"] = attrs::make_constant(boost::posix_time::time_duration(1, 2, 3) + boost::posix_time::microseconds(4));
+    set["Severity"] = attrs::make_constant(logging::trivial::warning);
+    backend.consume(make_record_view(set));
+
+    set["TimeStamp"] = attrs::make_constant(ts + boost::posix_time::milliseconds(10));
+    set["Int"] = attrs::make_constant(std::string("not an int"));
+    backend.consume(make_record_view(set));
+
+    binary_log::reader reader(*strm);
+    binary_log::field_list fields;
+
+    BOOST_REQUIRE(reader.read(fields));
+    BOOST_REQUIRE_EQUAL(fields.size(), 8u);
+    for (binary_log::field_list::const_iterator it = fields.begin(), end = fields.end(); it != end; ++it)
+    {
+        if (it->name == "Flag")
+        {
+            BOOST_CHECK_EQUAL(it->type, binary_log::boolean_type);
+            BOOST_CHECK_EQUAL(it->uint_value, 1u);
+        }
+        else if (it->name == "Int")
+        {
+            BOOST_CHECK_EQUAL(it->type, binary_log::signed_integer_type);
+            BOOST_CHECK_EQUAL(it->int_value, -150);
+        }
+        else if (it->name == "UInt")
+        {
+            BOOST_CHECK_EQUAL(it->type, binary_log::unsigned_integer_type);
+            BOOST_CHECK_EQUAL(it->uint_value, 300u);
+        }
+        else if (it->name == "Double")
+        {
+            BOOST_CHECK_EQUAL(it->type, binary_log::floating_point_type);
+            BOOST_CHECK_EQUAL(it->float_value, 2.5);
+        }
+        else if (it->name == "String")
+        {
+            BOOST_CHECK_EQUAL(it->type, binary_log::string_type);
+            BOOST_CHECK_EQUAL(it->string_value, "hello");
+        }
+        else if (it->name == "TimeStamp")
+        {
+            BOOST_CHECK_EQUAL(it->type, binary_log::timestamp_type);
+            BOOST_CHECK_EQUAL(to_string(*it), "2026-10-16 12:30:15.000250");
+        }
+        else if (it->name == "Duration")
+        {
+            BOOST_CHECK_EQUAL(it->type, binary_log::duration_type);
+            BOOST_CHECK_EQUAL(to_string(*it), "01:02:03.000004");
+        }
+        else if (it->name == "Severity")
+        {
+            BOOST_CHECK_EQUAL(it->type, binary_log::severity_type);
+            BOOST_CHECK_EQUAL(to_string(*it), "warning");
+        }
+        else
+        {
+            BOOST_ERROR("Unexpected attribute: " << it->name);
+        }
+    }
+
+    // The timestamp is delta-encoded, the attribute with the same name and a different type gets a new key
+    BOOST_REQUIRE(reader.read(fields));
+    BOOST_REQUIRE_EQUAL(fields.size(), 8u);
+    for (binary_log::field_list::const_iterator it = fields.begin(), end = fields.end(); it != end; ++it)
+    {
+        if (it->name == "TimeStamp")
+            BOOST_CHECK_EQUAL(to_string(*it), "2026-10-16 12:30:15.010250");
+        else if (it->name == "Int")
+            BOOST_CHECK_EQUAL(it->string_value, "not an int");
+    }
+
+    BOOST_CHECK(!reader.read(fields));
+}
+
+// The test checks that attribute names are written only once per stream
+BOOST_AUTO_TEST_CASE(dictionary)
+{
+    boost::shared_ptr< std::stringstream > strm = boost::make_shared< std::stringstream >();
+    sinks::binary_ostream_backend backend;
+    backend.set_stream(strm);
+
+    logging::attribute_set set;
+    set["A fairly long attribute name"] = attrs::make_constant(10);
+    logging::record_view rec = make_record_view(set);
+
+    backend.consume(rec);
+    const std::size_t first_size = strm->str().size();
+    backend.consume(rec);
+    const std::size_t second_size = strm->str().size() - first_size;
+    BOOST_CHECK_LT(second_size, 5u);
+
+    // Every stream receives its own header and dictionary, so that the streams can be read separately and concatenated
+    boost::shared_ptr< std::stringstream > strm2 = boost::make_shared< std::stringstream >();
+    backend.set_stream(strm2);
+    backend.consume(rec);
+    BOOST_CHECK_EQUAL(strm2->str(), strm->str().substr(0u, strm2->str().size()));
+
+    std::stringstream concatenated(strm->str() + strm2->str());
+    binary_log::reader reader(concatenated);
+    binary_log::field_list fields;
+    unsigned int count = 0u;
+    while (reader.read(fields))
+    {
+        BOOST_REQUIRE_EQUAL(fields.size(), 1u);
+        BOOST_CHECK_EQUAL(fields[0].name, "A fairly long attribute name");
+        BOOST_CHECK_EQUAL(fields[0].int_value, 10);
+        ++count;
+    }
+    BOOST_CHECK_EQUAL(count, 3u);
+}
+
+// The test checks that values of unsupported types are written as formatted strings if the type is registered and as the type name otherwise
+BOOST_AUTO_TEST_CASE(unsupported_types)
+{
+    boost::shared_ptr< std::stringstream > strm = boost::make_shared< std::stringstream >();
+    sinks::binary_ostream_backend backend;
+    backend.set_stream(strm);
+
+    logging::attribute_set set;
+    set["Severity"] = attrs::make_constant(warning);
+    backend.consume(make_record_view(set));
+
+    backend.register_formatted_type< my_severity_level >();
+    backend.consume(make_record_view(set));
+
+    binary_log::reader reader(*strm);
+    binary_log::field_list fields;
+
+    BOOST_REQUIRE(reader.read(fields));
+    BOOST_REQUIRE_EQUAL(fields.size(), 1u);
+    BOOST_CHECK_EQUAL(fields[0].name, "Severity");
+    BOOST_CHECK_EQUAL(fields[0].type, binary_log::unsupported_type);
+    BOOST_CHECK_NE(fields[0].string_value.find("my_severity_level"), std::string::npos);
+    BOOST_CHECK_EQUAL(to_string(fields[0]), "[unsupported type: " + fields[0].string_value + "]");
+
+    BOOST_REQUIRE(reader.read(fields));
+    BOOST_REQUIRE_EQUAL(fields.size(), 1u);
+    BOOST_CHECK_EQUAL(fields[0].name, "Severity");
+    BOOST_CHECK_EQUAL(fields[0].type, binary_log::formatted_type);
+    BOOST_CHECK_EQUAL(fields[0].string_value, "warning");
+    BOOST_CHECK_EQUAL(to_string(fields[0]), "warning");
+
+    BOOST_CHECK(!reader.read(fields));
+}
+
+// The test checks that the reader handles truncated and invalid input
+BOOST_AUTO_TEST_CASE(invalid_input)
+{
+    boost::shared_ptr< std::stringstream > strm = boost::make_shared< std::stringstream >();
+    sinks::binary_ostream_backend backend;
+    backend.set_stream(strm);
+
+    logging::attribute_set set;
+    set["String"] = attrs::make_constant(std::string("hello"));
+    backend.consume(make_record_view(set));
+    backend.consume(make_record_view(set));
+
+    // The incomplete last record is ignored
+    const std::string data = strm->str();
+    std::stringstream truncated(data.substr(0u, data.size() - 2u));
+    binary_log::reader reader(truncated);
+    binary_log::field_list fields;
+    BOOST_CHECK(reader.read(fields));
+    BOOST_CHECK(!reader.read(fields));
+
+    std::stringstream not_a_log("Hello, world!");
+    BOOST_CHECK_THROW(binary_log::reader r(not_a_log), logging::parse_error);
+}
@@ -0,0 +1,208 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   sink_flight_recorder.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header contains tests for the flight recorder sink frontend.
+ */
+
+#define BOOST_TEST_MODULE sink_flight_recorder
+
+#include <boost/log/detail/config.hpp>
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/barrier.hpp>
+#include <boost/test/included/unit_test.hpp>
+#include <boost/log/attributes/constant.hpp>
+#include <boost/log/attributes/attribute_set.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
+#include <boost/log/expressions.hpp>
+#include <boost/log/sinks/flight_recorder_frontend.hpp>
+#include <boost/log/detail/flight_recorder.hpp>
+#include <boost/log/sinks/basic_sink_backend.hpp>
+#include "make_record.hpp"
+
+namespace logging = boost::log;
+namespace attrs = logging::attributes;
+namespace expr = logging::expressions;
+namespace sinks = logging::sinks;
+namespace keywords = logging::keywords;
+
+namespace {
+
+    //! The backend stores sequence numbers of records
+    class collecting_backend :
+        public sinks::basic_sink_backend< sinks::synchronized_feeding >
+    {
+    public:
+        std::vector< unsigned int > m_Records;
+
+        void consume(logging::record_view const& rec)
+        {
+            m_Records.push_back(logging::extract_or_default< unsigned int >("Seq", rec.attribute_values(), 0u));
+        }
+    };
+
+    typedef sinks::flight_recorder_sink< collecting_backend > sink_t;
+
+    void log(sink_t& sink, unsigned int seq, int severity)
+    {
+        logging::attribute_set attrs;
+        attrs["Seq"] = attrs::make_constant(seq);
+        attrs["Severity"] = attrs::make_constant(severity);
+        sink.consume(make_record_view(attrs));
+    }
+
+    void log_range(sink_t& sink, unsigned int from, unsigned int to)
+    {
+        for (unsigned int i = from; i < to; ++i)
+            log(sink, i, 0);
+    }
+
+} // namespace
+
+// The test checks that records are retained until dumping is triggered
+BOOST_AUTO_TEST_CASE(trigger)
+{
+    sink_t sink(boost::make_shared< collecting_backend >(), keywords::capacity = 10u);
+    sink.set_trigger(expr::attr< int >("Severity") >= 3);
+
+    log_range(sink, 0u, 25u);
+    BOOST_CHECK(sink.locked_backend()->m_Records.empty());
+
+    // Only the most recent records are retained, including the triggering one
+    log(sink, 25u, 3);
+    {
+        sink_t::locked_backend_ptr backend = sink.locked_backend();
+        BOOST_REQUIRE_EQUAL(backend->m_Records.size(), 10u);
+        for (unsigned int i = 0; i < 10u; ++i)
+            BOOST_CHECK_EQUAL(backend->m_Records[i], 16u + i);
+        backend->m_Records.clear();
+    }
+
+    // The buffer is empty after dumping
+    log_range(sink, 26u, 29u);
+    sink.dump();
+    {
+        sink_t::locked_backend_ptr backend = sink.locked_backend();
+        BOOST_REQUIRE_EQUAL(backend->m_Records.size(), 3u);
+        BOOST_CHECK_EQUAL(backend->m_Records[0], 26u);
+        BOOST_CHECK_EQUAL(backend->m_Records[2], 28u);
+        backend->m_Records.clear();
+    }
+
+    sink.dump();
+    BOOST_CHECK(sink.locked_backend()->m_Records.empty());
+}
+
+// The test checks that records from different threads are dumped in order, including the records of terminated threads
+BOOST_AUTO_TEST_CASE(multiple_threads)
+{
+    sink_t sink(boost::make_shared< collecting_backend >(), keywords::capacity = 100u);
+
+    log_range(sink, 0u, 10u);
+    boost::thread(boost::bind(&log_range, boost::ref(sink), 10u, 20u)).join();
+    log_range(sink, 20u, 30u);
+    boost::thread(boost::bind(&log_range, boost::ref(sink), 30u, 40u)).join();
+
+    sink.dump();
+
+    sink_t::locked_backend_ptr backend = sink.locked_backend();
+    BOOST_REQUIRE_EQUAL(backend->m_Records.size(), 40u);
+    for (unsigned int i = 0; i < 40u; ++i)
+        BOOST_CHECK_EQUAL(backend->m_Records[i], i);
+}
+
+// The test checks that the buffered records are dumped when the sink is destroyed
+BOOST_AUTO_TEST_CASE(dump_on_destruction)
+{
+    boost::shared_ptr< collecting_backend > backend = boost::make_shared< collecting_backend >();
+    {
+        sink_t sink(backend, keywords::capacity = 10u);
+        log_range(sink, 0u, 5u);
+        BOOST_CHECK(backend->m_Records.empty());
+    }
+    BOOST_CHECK_EQUAL(backend->m_Records.size(), 5u);
+
+    backend->m_Records.clear();
+    {
+        sink_t sink(backend, keywords::capacity = 10u);
+        sink.dump_on_destruction(false);
+        log_range(sink, 0u, 5u);
+    }
+    BOOST_CHECK(backend->m_Records.empty());
+}
+
+namespace {
+
+    struct recreation_state
+    {
+        logging::aux::flight_recorder* m_pRecorder;
+        boost::barrier m_Barrier;
+
+        recreation_state() : m_pRecorder(NULL), m_Barrier(2) {}
+    };
+
+    logging::record_view make_seq_record(unsigned int seq)
+    {
+        logging::attribute_set attrs;
+        attrs["Seq"] = attrs::make_constant(seq);
+        return make_record_view(attrs);
+    }
+
+    //! The thread pushes records to the recorder before and after the recorder is recreated
+    void push_around_recreation(recreation_state& state)
+    {
+        state.m_pRecorder->push(make_seq_record(1u));
+        state.m_Barrier.wait();
+        // The main thread recreates the recorder here
+        state.m_Barrier.wait();
+        state.m_pRecorder->push(make_seq_record(2u));
+    }
+
+} // namespace
+
+// The test checks that a recorder created after another recorder is destroyed does not use the buffers of the destroyed recorder
+BOOST_AUTO_TEST_CASE(recreated_recorder)
+{
+    recreation_state state;
+    state.m_pRecorder = new logging::aux::flight_recorder(10u);
+
+    boost::thread th(boost::bind(&push_around_recreation, boost::ref(state)));
+    state.m_Barrier.wait();
+
+    // The new recorder is likely to be allocated at the same address as the destroyed one
+    delete state.m_pRecorder;
+    state.m_pRecorder = new logging::aux::flight_recorder(10u);
+
+    state.m_Barrier.wait();
+    th.join();
+
+    std::vector< logging::record_view > records;
+    state.m_pRecorder->pop_all(records);
+    delete state.m_pRecorder;
+
+    BOOST_REQUIRE_EQUAL(records.size(), 1u);
+    BOOST_CHECK_EQUAL(logging::extract_or_default< unsigned int >("Seq", records[0], 0u), 2u);
+}
+
+#else // !defined(BOOST_LOG_NO_THREADS)
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_CASE(threads_not_supported)
+{
+}
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
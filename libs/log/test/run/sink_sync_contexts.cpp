@@ -0,0 +1,213 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   sink_sync_contexts.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header contains tests for the per-thread filtering and formatting contexts of sink frontends.
+ */
+
+#define BOOST_TEST_MODULE sink_sync_contexts
+
+#include <boost/log/detail/config.hpp>
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+#include <new>
+#include <set>
+#include <string>
+#include <boost/bind.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/barrier.hpp>
+#include <boost/test/included/unit_test.hpp>
+#include <boost/log/attributes/attribute_set.hpp>
+#include <boost/log/sinks/sync_frontend.hpp>
+#include <boost/log/sinks/basic_sink_backend.hpp>
+#include <boost/log/utility/formatting_ostream.hpp>
+#include "make_record.hpp"
+
+namespace logging = boost::log;
+namespace sinks = logging::sinks;
+
+namespace {
+
+    //! The backend stores the last formatted record
+    class last_record_backend :
+        public sinks::basic_formatted_sink_backend< char, sinks::synchronized_feeding >
+    {
+    public:
+        std::string m_LastRecord;
+
+        void consume(logging::record_view const&, string_type const& formatted_message)
+        {
+            m_LastRecord = formatted_message;
+        }
+    };
+
+    typedef sinks::synchronous_sink< last_record_backend > sink_t;
+
+    //! The filter returns a constant result
+    struct constant_filter
+    {
+        typedef bool result_type;
+
+        bool m_Result;
+
+        explicit constant_filter(bool result) : m_Result(result) {}
+        bool operator() (logging::attribute_value_set const&) const { return m_Result; }
+    };
+
+    //! The formatter outputs a constant string
+    struct constant_formatter
+    {
+        typedef void result_type;
+
+        std::string m_Text;
+
+        explicit constant_formatter(std::string const& text) : m_Text(text) {}
+        void operator() (logging::record_view const&, logging::formatting_ostream& strm) const { strm << m_Text; }
+    };
+
+    //! The set of filter object addresses the records were filtered with
+    struct filter_instances
+    {
+        boost::mutex m_Mutex;
+        std::set< const void* > m_Addresses;
+    };
+
+    //! The filter records the address of the filter object that is called
+    struct recording_filter
+    {
+        typedef bool result_type;
+
+        filter_instances* m_pInstances;
+
+        explicit recording_filter(filter_instances& instances) : m_pInstances(&instances) {}
+        bool operator() (logging::attribute_value_set const&) const
+        {
+            boost::lock_guard< boost::mutex > lock(m_pInstances->m_Mutex);
+            m_pInstances->m_Addresses.insert(this);
+            return true;
+        }
+    };
+
+    //! Sink storage that allows to construct sinks at the same address
+    struct sink_storage
+    {
+        boost::aligned_storage< sizeof(sink_t), boost::alignment_of< sink_t >::value >::type m_Storage;
+
+        sink_t* get() { return static_cast< sink_t* >(static_cast< void* >(&m_Storage)); }
+    };
+
+    struct test_state
+    {
+        sink_storage m_Storage;
+        boost::barrier m_Barrier;
+        bool m_FirstConsumed;
+        bool m_SecondConsumed;
+        std::string m_FirstRecord;
+        std::string m_SecondRecord;
+
+        test_state() : m_Barrier(2), m_FirstConsumed(false), m_SecondConsumed(false) {}
+    };
+
+    //! Passes a record through the sink and returns the formatted record, if the record passed the filter
+    bool pass_record(sink_t& sink, std::string& formatted_record)
+    {
+        logging::record_view rec = make_record_view(logging::attribute_set());
+        if (!sink.will_consume(rec.attribute_values()))
+            return false;
+        sink.consume(rec);
+        formatted_record = sink.locked_backend()->m_LastRecord;
+        return true;
+    }
+
+    //! The thread passes records through the sink before and after the sink is recreated
+    void logging_thread(test_state& state)
+    {
+        state.m_FirstConsumed = pass_record(*state.m_Storage.get(), state.m_FirstRecord);
+        state.m_Barrier.wait();
+        // The main thread recreates the sink here
+        state.m_Barrier.wait();
+        sink_t& sink = *state.m_Storage.get();
+        logging::record_view rec = make_record_view(logging::attribute_set());
+        state.m_SecondConsumed = sink.will_consume(rec.attribute_values());
+        sink.consume(rec);
+        state.m_SecondRecord = sink.locked_backend()->m_LastRecord;
+    }
+
+    //! The thread passes records through the sink
+    void feeding_thread(sink_t& sink, unsigned int count)
+    {
+        std::string formatted_record;
+        for (unsigned int i = 0; i < count; ++i)
+            pass_record(sink, formatted_record);
+    }
+
+} // namespace
+
+// The test checks that a sink created at the address of a destroyed sink does not use the contexts of the destroyed sink
+BOOST_AUTO_TEST_CASE(recreated_sink)
+{
+    test_state state;
+
+    sink_t* sink = new (state.m_Storage.get()) sink_t();
+    sink->set_filter(constant_filter(true));
+    sink->set_formatter(constant_formatter("first"));
+
+    boost::thread th(boost::bind(&logging_thread, boost::ref(state)));
+    state.m_Barrier.wait();
+
+    sink->~sink_t();
+    // The new sink has the same number of modifications as the destroyed one
+    sink = new (state.m_Storage.get()) sink_t();
+    sink->set_filter(constant_filter(false));
+    sink->set_formatter(constant_formatter("second"));
+
+    state.m_Barrier.wait();
+    th.join();
+
+    BOOST_CHECK(state.m_FirstConsumed);
+    BOOST_CHECK_EQUAL(state.m_FirstRecord, "first");
+    BOOST_CHECK(!state.m_SecondConsumed);
+    BOOST_CHECK_EQUAL(state.m_SecondRecord, "second");
+
+    sink->~sink_t();
+}
+
+// The test checks that the filter is shared by all threads
+BOOST_AUTO_TEST_CASE(shared_filter)
+{
+    enum { thread_count = 4, record_count = 1000 };
+
+    filter_instances instances;
+    sink_t sink;
+    sink.set_filter(recording_filter(instances));
+
+    boost::thread_group threads;
+    for (unsigned int i = 0; i < thread_count; ++i)
+        threads.create_thread(boost::bind(&feeding_thread, boost::ref(sink), static_cast< unsigned int >(record_count)));
+    threads.join_all();
+
+    BOOST_CHECK_EQUAL(instances.m_Addresses.size(), 1u);
+}
+
+#else // !defined(BOOST_LOG_NO_THREADS)
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_CASE(sink_contexts)
+{
+    // Per-thread contexts are only used in multithreaded builds
+}
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
@@ -0,0 +1,173 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   sink_syslog_stream.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header contains tests for the stream socket-based syslog backend.
+ */
+
+#define BOOST_TEST_MODULE sink_syslog_stream
+
+#include <boost/log/detail/config.hpp>
+
+#if !defined(BOOST_LOG_WITHOUT_SYSLOG) && !defined(BOOST_LOG_NO_ASIO)
+
+#include <cstddef>
+#include <string>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/system/system_error.hpp>
+#include <boost/test/included/unit_test.hpp>
+#include <boost/log/core/record_view.hpp>
+#include <boost/log/sinks/syslog_backend.hpp>
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+namespace logging = boost::log;
+namespace sinks = logging::sinks;
+namespace keywords = logging::keywords;
+namespace asio = boost::asio;
+
+namespace {
+
+    typedef asio::local::stream_protocol protocol;
+
+    //! The class creates a listening socket in the temporary directory
+    struct listener
+    {
+        std::string m_Path;
+        asio::io_service m_IOService;
+        protocol::acceptor m_Acceptor;
+
+        listener() :
+            m_Path((boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("boost_log_syslog_%%%%-%%%%-%%%%")).string()),
+            m_Acceptor(m_IOService, protocol::endpoint(m_Path))
+        {
+        }
+        ~listener()
+        {
+            boost::system::error_code err;
+            m_Acceptor.close(err);
+            boost::filesystem::remove(m_Path, err);
+        }
+    };
+
+    //! The function reads one octet-counted frame from the socket
+    std::string read_frame(protocol::socket& socket)
+    {
+        std::string length;
+        char c = 0;
+        while (true)
+        {
+            asio::read(socket, asio::buffer(&c, 1));
+            if (c == ' ')
+                break;
+            length.push_back(c);
+        }
+
+        std::string frame(boost::lexical_cast< std::size_t >(length), '\0');
+        asio::read(socket, asio::buffer(&frame[0], frame.size()));
+        return frame;
+    }
+
+    //! The function checks that the frame contains the syslog header and the message
+    void check_frame(std::string const& frame, std::string const& message)
+    {
+        BOOST_REQUIRE_GT(frame.size(), message.size());
+        BOOST_CHECK_EQUAL(frame.substr(0, 5), std::string("<14> "));
+        BOOST_CHECK(frame.compare(frame.size() - message.size(), message.size(), message) == 0);
+    }
+
+} // namespace
+
+// The test checks that records are framed with octet counting and are not truncated
+BOOST_AUTO_TEST_CASE(octet_counting_framing)
+{
+    listener srv;
+
+    sinks::syslog_backend backend(keywords::use_impl = sinks::syslog::local_socket_based);
+    backend.set_target_socket(srv.m_Path);
+    backend.set_write_threshold(1024u * 1024u);
+
+    const std::string short_message = "Hello, world!";
+    const std::string long_message(5000u, 'x');
+
+    logging::record_view rec;
+    backend.consume(rec, short_message);
+    backend.consume(rec, long_message);
+    backend.flush();
+
+    protocol::socket socket(srv.m_IOService);
+    srv.m_Acceptor.accept(socket);
+
+    check_frame(read_frame(socket), short_message);
+    check_frame(read_frame(socket), long_message);
+}
+
+// The test checks that records are kept in the backlog while the server is not available
+BOOST_AUTO_TEST_CASE(backlog_and_reconnection)
+{
+    std::string path;
+    {
+        listener unavailable;
+        path = unavailable.m_Path;
+    }
+
+    sinks::syslog_backend backend(keywords::use_impl = sinks::syslog::local_socket_based);
+    backend.set_target_socket(path);
+    backend.set_max_backlog_size(1u);
+
+    logging::record_view rec;
+    backend.consume(rec, std::string(10u, 'a'));
+
+    // The connection failure is reported on flushing
+    BOOST_CHECK_THROW(backend.flush(), boost::system::system_error);
+
+    backend.consume(rec, std::string(10u, 'b'));
+    backend.consume(rec, std::string(10u, 'c'));
+
+    // Only the latest record must have been kept due to the backlog size limit
+    listener srv;
+    backend.set_target_socket(srv.m_Path);
+    backend.flush();
+
+    protocol::socket socket(srv.m_IOService);
+    srv.m_Acceptor.accept(socket);
+
+    check_frame(read_frame(socket), std::string(10u, 'c'));
+
+    // After the connection is established the records are sent immediately
+    backend.consume(rec, std::string(10u, 'd'));
+    check_frame(read_frame(socket), std::string(10u, 'd'));
+}
+
+#else // defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_CASE(local_sockets_not_supported)
+{
+}
+
+#endif // defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+#else // !defined(BOOST_LOG_WITHOUT_SYSLOG) && !defined(BOOST_LOG_NO_ASIO)
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_CASE(syslog_not_supported)
+{
+}
+
+#endif // !defined(BOOST_LOG_WITHOUT_SYSLOG) && !defined(BOOST_LOG_NO_ASIO)
@@ -0,0 +1,303 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   sink_text_file.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header contains tests for the text file sink backend.
+ */
+
+#define BOOST_TEST_MODULE sink_text_file
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iterator>
+#include <boost/filesystem/path.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/test/included/unit_test.hpp>
+#include <boost/log/core/record_view.hpp>
+#include <boost/log/sinks/text_file_backend.hpp>
+#if !defined(BOOST_LOG_NO_THREADS)
+#include <boost/thread/thread.hpp>
+#endif
+
+namespace logging = boost::log;
+namespace sinks = logging::sinks;
+namespace keywords = logging::keywords;
+
+namespace {
+
+    //! The class creates a temporary directory for log files
+    struct temp_directory
+    {
+        boost::filesystem::path m_Path;
+
+        temp_directory() :
+            m_Path(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("boost_log_text_file_%%%%-%%%%-%%%%"))
+        {
+            boost::filesystem::create_directories(m_Path);
+        }
+        ~temp_directory()
+        {
+            boost::system::error_code err;
+            boost::filesystem::remove_all(m_Path, err);
+        }
+    };
+
+    //! The function reads the whole file
+    std::string read_file(boost::filesystem::path const& p)
+    {
+        std::ifstream file(p.string().c_str(), std::ios_base::in | std::ios_base::binary);
+        return std::string((std::istreambuf_iterator< char >(file)), std::istreambuf_iterator< char >());
+    }
+
+    //! The function writes the header to the file
+    void write_header(sinks::text_file_backend::stream_type& strm)
+    {
+        strm << "header\n";
+    }
+
+    //! The function writes the footer to the file
+    void write_footer(sinks::text_file_backend::stream_type& strm)
+    {
+        strm << "footer\n";
+    }
+
+} // namespace
+
+// The test checks that accumulated records are written to the file in order
+BOOST_AUTO_TEST_CASE(write_batch)
+{
+    temp_directory dir;
+    const boost::filesystem::path file_name = dir.m_Path / "test.log";
+    logging::record_view rec;
+
+    {
+        sinks::text_file_backend backend(keywords::file_name = dir.m_Path / "test.log");
+        backend.set_write_batch_size(3);
+        backend.set_close_handler(&write_footer);
+
+        std::string message = "1";
+        backend.consume_and_take(rec, message);
+        BOOST_CHECK(message.empty());
+        message = "2";
+        backend.consume(rec, message);
+        // The contents of a string passed by reference to const are not taken
+        BOOST_CHECK_EQUAL(message, "2");
+
+        // The records are not written until the batch is complete
+        backend.flush();
+        BOOST_CHECK_EQUAL(read_file(file_name), std::string("1\n2\n"));
+
+        message = "3";
+        backend.consume_and_take(rec, message);
+        message = "4";
+        backend.consume_and_take(rec, message);
+        backend.consume(rec, std::string("5"));
+        message = "6";
+        backend.consume_and_take(rec, message);
+    }
+
+    // The accumulated records must be written before the footer
+    BOOST_CHECK_EQUAL(read_file(file_name), std::string("1\n2\n3\n4\n5\n6\nfooter\n"));
+}
+
+// The test checks that file rotation takes the accumulated records into account
+BOOST_AUTO_TEST_CASE(write_batch_rotation)
+{
+    temp_directory dir;
+    logging::record_view rec;
+
+    {
+        sinks::text_file_backend backend(
+            keywords::file_name = dir.m_Path / "test_%N.log",
+            keywords::rotation_size = 8);
+        backend.set_write_batch_size(16);
+
+        for (char c = 'a'; c < 'g'; ++c)
+        {
+            std::string message(2u, c);
+            backend.consume_and_take(rec, message);
+        }
+    }
+
+    BOOST_CHECK_EQUAL(read_file(dir.m_Path / "test_0.log"), std::string("aa\nbb\n"));
+    BOOST_CHECK_EQUAL(read_file(dir.m_Path / "test_1.log"), std::string("cc\ndd\n"));
+    BOOST_CHECK_EQUAL(read_file(dir.m_Path / "test_2.log"), std::string("ee\nff\n"));
+}
+
+// The test checks that files are written through memory mapping
+BOOST_AUTO_TEST_CASE(mapped_file)
+{
+    temp_directory dir;
+    logging::record_view rec;
+
+    // Make sure the backend starts writing in the middle of a memory page in append mode
+    {
+        std::ofstream file((dir.m_Path / "test_0.log").string().c_str());
+        file << "existing\n";
+    }
+
+    std::vector< std::string > expected(1u, std::string("existing\nheader\n"));
+    {
+        sinks::text_file_backend backend(
+            keywords::file_name = dir.m_Path / "test_%N.log",
+            keywords::open_mode = std::ios_base::out | std::ios_base::app,
+            keywords::rotation_size = 10000);
+        backend.set_mapped_extent_size(1);
+        backend.set_open_handler(&write_header);
+        backend.set_close_handler(&write_footer);
+
+        for (unsigned int i = 0; i < 4000; ++i)
+        {
+            std::string message = boost::lexical_cast< std::string >(i * 7u);
+            if (expected.back().size() + message.size() >= 10000u)
+            {
+                expected.back() += "footer\n";
+                expected.push_back("header\n");
+            }
+            expected.back() += message;
+            expected.back() += '\n';
+            backend.consume(rec, message);
+        }
+    }
+    expected.back() += "footer\n";
+
+    BOOST_REQUIRE_GT(expected.size(), 2u);
+    for (unsigned int i = 0; i < expected.size(); ++i)
+        BOOST_CHECK(read_file(dir.m_Path / ("test_" + boost::lexical_cast< std::string >(i) + ".log")) == expected[i]);
+}
+
+// The test checks that files are synchronized according to the policy
+BOOST_AUTO_TEST_CASE(sync_policy)
+{
+    temp_directory dir;
+    logging::record_view rec;
+
+    sinks::text_file_backend backend(keywords::file_name = dir.m_Path / "test.log");
+    backend.set_sync_policy(sinks::file::record_sync);
+    backend.consume(rec, std::string("1"));
+    backend.consume(rec, std::string("2"));
+    BOOST_CHECK_EQUAL(backend.get_sync_statistics().sync_count, 2u);
+
+    backend.set_sync_policy(sinks::file::batch_sync);
+    backend.set_write_batch_size(2);
+    std::string message = "3";
+    backend.consume_and_take(rec, message);
+    BOOST_CHECK_EQUAL(backend.get_sync_statistics().sync_count, 2u);
+    message = "4";
+    backend.consume_and_take(rec, message);
+    BOOST_CHECK_EQUAL(backend.get_sync_statistics().sync_count, 3u);
+
+    backend.set_write_batch_size(0);
+    backend.set_sync_policy(sinks::file::periodic_sync);
+    backend.set_sync_interval(boost::posix_time::hours(1));
+    backend.set_sync_size(4);
+    backend.consume(rec, std::string("5"));
+    BOOST_CHECK_EQUAL(backend.get_sync_statistics().pending_size, 2u);
+
+    // Flushing synchronizes the file and waits for the background synchronization
+    backend.consume(rec, std::string("6"));
+    backend.flush();
+    sinks::file::sync_statistics stats = backend.get_sync_statistics();
+    BOOST_CHECK_EQUAL(stats.failure_count, 0u);
+    BOOST_CHECK_EQUAL(stats.pending_size, 0u);
+    BOOST_CHECK_GE(stats.sync_count, 4u);
+    BOOST_CHECK_EQUAL(read_file(dir.m_Path / "test.log"), std::string("1\n2\n3\n4\n5\n6\n"));
+}
+
+// The test checks that scanning for files finds the matching files only once
+BOOST_AUTO_TEST_CASE(scan_for_files)
+{
+    temp_directory dir;
+    const boost::filesystem::path target = dir.m_Path / "target";
+    boost::filesystem::create_directories(target);
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        std::ofstream file((target / ("test_" + boost::lexical_cast< std::string >(i) + ".log")).string().c_str());
+        file << i << std::endl;
+    }
+    std::ofstream((target / "other.txt").string().c_str());
+
+    boost::shared_ptr< sinks::file::collector > collector = sinks::file::make_collector(keywords::target = target);
+
+    unsigned int counter = 0;
+    BOOST_CHECK_EQUAL(collector->scan_for_files(sinks::file::scan_matching, target / "test_%N.log", &counter), 3u);
+    BOOST_CHECK_EQUAL(counter, 3u);
+
+    // The files that are already known are not counted again
+    BOOST_CHECK_EQUAL(collector->scan_for_files(sinks::file::scan_all), 1u);
+    BOOST_CHECK_EQUAL(collector->scan_for_files(sinks::file::scan_all), 0u);
+}
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+// The test checks that the time interval rotation predicate detects the end of the interval
+BOOST_AUTO_TEST_CASE(rotation_at_time_interval)
+{
+    sinks::file::rotation_at_time_interval predicate(boost::posix_time::seconds(1));
+    BOOST_CHECK(!predicate());
+    BOOST_CHECK(!predicate());
+
+    boost::this_thread::sleep(boost::posix_time::milliseconds(1100));
+    BOOST_CHECK(predicate());
+    BOOST_CHECK(!predicate());
+}
+
+// The test checks that rotated files are collected in background
+BOOST_AUTO_TEST_CASE(background_collection)
+{
+    temp_directory dir;
+    logging::record_view rec;
+
+    {
+        sinks::text_file_backend backend(
+            keywords::file_name = dir.m_Path / "test.log",
+            keywords::rotation_size = 4);
+        backend.set_file_collector(sinks::file::make_collector(keywords::target = dir.m_Path / "target"));
+        backend.set_collection_backlog_size(1);
+
+        backend.consume(rec, std::string("aaa"));
+        backend.consume(rec, std::string("bbb"));
+        backend.consume(rec, std::string("ccc"));
+
+        // Flushing waits for the rotated files to be collected
+        backend.flush();
+        BOOST_CHECK_EQUAL(read_file(dir.m_Path / "target" / "test.log"), std::string("aaa\n"));
+        BOOST_CHECK_EQUAL(read_file(dir.m_Path / "test.log"), std::string("ccc\n"));
+    }
+
+    BOOST_CHECK_EQUAL(read_file(dir.m_Path / "target" / "test.log00000"), std::string("bbb\n"));
+    BOOST_CHECK_EQUAL(read_file(dir.m_Path / "target" / "test.log00001"), std::string("ccc\n"));
+}
+
+// The test checks that the written data is synchronized in background when the interval elapses
+BOOST_AUTO_TEST_CASE(periodic_sync_timer)
+{
+    temp_directory dir;
+    logging::record_view rec;
+
+    sinks::text_file_backend backend(keywords::file_name = dir.m_Path / "test.log", keywords::auto_flush = true);
+    backend.set_sync_policy(sinks::file::periodic_sync);
+    backend.set_sync_interval(boost::posix_time::milliseconds(100));
+
+    backend.consume(rec, std::string("1"));
+    BOOST_CHECK_EQUAL(backend.get_sync_statistics().pending_size, 2u);
+
+    // No more records are written, the background thread synchronizes the file when the interval elapses
+    for (unsigned int i = 0; i < 50 && backend.get_sync_statistics().sync_count == 0; ++i)
+        boost::this_thread::sleep(boost::posix_time::milliseconds(100));
+
+    sinks::file::sync_statistics stats = backend.get_sync_statistics();
+    BOOST_CHECK_EQUAL(stats.sync_count, 1u);
+    BOOST_CHECK_EQUAL(stats.pending_size, 0u);
+}
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
@@ -0,0 +1,237 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   sink_text_file_compression.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header contains tests for the compression of the files stored by the text file sink backend.
+ *
+ * The test requires Boost.Iostreams and zlib.
+ */
+
+#define BOOST_TEST_MODULE sink_text_file_compression
+
+#include <string>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <iterator>
+#include <boost/filesystem/path.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/test/included/unit_test.hpp>
+#include <boost/log/detail/config.hpp>
+#if !defined(BOOST_LOG_NO_THREADS)
+#include <boost/thread/thread.hpp>
+#endif
+#include <boost/log/core/record_view.hpp>
+#include <boost/log/sinks/text_file_backend.hpp>
+#include <boost/log/sinks/gzip_compressor.hpp>
+
+namespace logging = boost::log;
+namespace sinks = logging::sinks;
+namespace keywords = logging::keywords;
+
+namespace {
+
+    //! The class creates a temporary directory for log files
+    struct temp_directory
+    {
+        boost::filesystem::path m_Path;
+
+        temp_directory() :
+            m_Path(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("boost_log_text_file_%%%%-%%%%-%%%%"))
+        {
+            boost::filesystem::create_directories(m_Path);
+        }
+        ~temp_directory()
+        {
+            boost::system::error_code err;
+            boost::filesystem::remove_all(m_Path, err);
+        }
+    };
+
+    //! The compressor always fails
+    struct failing_compressor :
+        public sinks::file::compressor
+    {
+        boost::filesystem::path file_name_suffix() const
+        {
+            return boost::filesystem::path(".gz");
+        }
+
+        void compress(std::istream&, std::ostream& output)
+        {
+            output << "partial";
+            output.flush();
+            throw std::runtime_error("compression failed");
+        }
+    };
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+    //! The compressor saves the identifier of the thread it is called in
+    struct thread_recording_compressor :
+        public sinks::file::compressor
+    {
+        boost::thread::id m_ThreadId;
+
+        boost::filesystem::path file_name_suffix() const
+        {
+            return boost::filesystem::path(".z");
+        }
+
+        void compress(std::istream& input, std::ostream& output)
+        {
+            m_ThreadId = boost::this_thread::get_id();
+            output << input.rdbuf();
+        }
+    };
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
+
+} // namespace
+
+// The test checks that stored files are compressed
+BOOST_AUTO_TEST_CASE(compression)
+{
+    temp_directory dir;
+    const boost::filesystem::path target = dir.m_Path / "target";
+    logging::record_view rec;
+
+    {
+        sinks::text_file_backend backend(
+            keywords::file_name = dir.m_Path / "test_%N.log",
+            keywords::rotation_size = 4);
+        backend.set_file_collector(sinks::file::make_collector(
+            keywords::target = target,
+            keywords::compressor = boost::make_shared< sinks::file::gzip_compressor >()));
+
+        backend.consume(rec, std::string("aaa"));
+        backend.consume(rec, std::string("bbb"));
+    }
+
+    BOOST_CHECK(!boost::filesystem::exists(target / "test_0.log"));
+    BOOST_REQUIRE(boost::filesystem::exists(target / "test_0.log.gz"));
+    BOOST_CHECK(boost::filesystem::exists(target / "test_1.log.gz"));
+    BOOST_CHECK(!boost::filesystem::exists(target / "test_0.log.gz.tmp"));
+
+    std::ifstream file((target / "test_0.log.gz").string().c_str(), std::ios_base::in | std::ios_base::binary);
+    boost::iostreams::filtering_istream strm;
+    strm.push(boost::iostreams::gzip_decompressor());
+    strm.push(file);
+    std::string content((std::istreambuf_iterator< char >(strm)), std::istreambuf_iterator< char >());
+    BOOST_CHECK_EQUAL(content, std::string("aaa\n"));
+}
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+// The test checks that the files are compressed in background unless the collection backlog size is set to zero
+BOOST_AUTO_TEST_CASE(background_compression)
+{
+    temp_directory dir;
+    logging::record_view rec;
+
+    boost::shared_ptr< thread_recording_compressor > comp = boost::make_shared< thread_recording_compressor >();
+    {
+        sinks::text_file_backend backend(
+            keywords::file_name = dir.m_Path / "test_%N.log",
+            keywords::rotation_size = 4);
+        backend.set_file_collector(sinks::file::make_collector(
+            keywords::target = dir.m_Path / "target1",
+            keywords::compressor = comp));
+
+        backend.consume(rec, std::string("aaa"));
+        backend.consume(rec, std::string("bbb"));
+        backend.flush();
+    }
+
+    BOOST_CHECK(comp->m_ThreadId != boost::thread::id());
+    BOOST_CHECK(comp->m_ThreadId != boost::this_thread::get_id());
+    BOOST_CHECK(boost::filesystem::exists(dir.m_Path / "target1" / "test_0.log.z"));
+
+    comp = boost::make_shared< thread_recording_compressor >();
+    {
+        sinks::text_file_backend backend(
+            keywords::file_name = dir.m_Path / "test_%N.log",
+            keywords::rotation_size = 4);
+        backend.set_file_collector(sinks::file::make_collector(
+            keywords::target = dir.m_Path / "target2",
+            keywords::compressor = comp));
+        backend.set_collection_backlog_size(0);
+
+        backend.consume(rec, std::string("aaa"));
+        backend.consume(rec, std::string("bbb"));
+    }
+
+    BOOST_CHECK(comp->m_ThreadId == boost::this_thread::get_id());
+    BOOST_CHECK(boost::filesystem::exists(dir.m_Path / "target2" / "test_0.log.z"));
+}
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
+
+// The test checks that no temporary files are left when compression fails
+BOOST_AUTO_TEST_CASE(failed_compression)
+{
+    temp_directory dir;
+    const boost::filesystem::path target = dir.m_Path / "target";
+    {
+        std::ofstream file((dir.m_Path / "test_0.log").string().c_str());
+        file << "aaa" << std::endl;
+    }
+
+    boost::shared_ptr< sinks::file::collector > collector = sinks::file::make_collector(
+        keywords::target = target,
+        keywords::compressor = boost::make_shared< failing_compressor >());
+
+    BOOST_CHECK_THROW(collector->store_file(dir.m_Path / "test_0.log"), std::runtime_error);
+    BOOST_CHECK(boost::filesystem::exists(dir.m_Path / "test_0.log"));
+    BOOST_CHECK(boost::filesystem::is_empty(target));
+}
+
+// The test checks that scanning for files recognizes compressed files
+BOOST_AUTO_TEST_CASE(scan_for_compressed_files)
+{
+    temp_directory dir;
+    const boost::filesystem::path target = dir.m_Path / "target";
+    boost::filesystem::create_directories(target);
+    std::ofstream((target / "test_0.log").string().c_str());
+    std::ofstream((target / "test_1.log.gz").string().c_str());
+    std::ofstream((target / "test_2.log.bz2").string().c_str());
+
+    boost::shared_ptr< sinks::file::collector > collector = sinks::file::make_collector(
+        keywords::target = target,
+        keywords::compressor = boost::make_shared< sinks::file::gzip_compressor >());
+
+    unsigned int counter = 0;
+    BOOST_CHECK_EQUAL(collector->scan_for_files(sinks::file::scan_matching, target / "test_%N.log", &counter), 2u);
+    BOOST_CHECK_EQUAL(counter, 2u);
+}
+
+// The test checks that scanning for files removes the temporary files of interrupted compressions
+BOOST_AUTO_TEST_CASE(scan_removes_compression_leftovers)
+{
+    temp_directory dir;
+    const boost::filesystem::path target = dir.m_Path / "target";
+    boost::filesystem::create_directories(target);
+    std::ofstream((target / "test_0.log.gz").string().c_str());
+    std::ofstream((target / "test_1.log.gz.tmp").string().c_str());
+    std::ofstream((target / "other.gz.tmp").string().c_str());
+
+    boost::shared_ptr< sinks::file::collector > collector = sinks::file::make_collector(
+        keywords::target = target,
+        keywords::compressor = boost::make_shared< sinks::file::gzip_compressor >());
+
+    BOOST_CHECK_EQUAL(collector->scan_for_files(sinks::file::scan_matching, target / "test_%N.log"), 1u);
+    BOOST_CHECK(!boost::filesystem::exists(target / "test_1.log.gz.tmp"));
+    // Files that do not match the pattern are not touched
+    BOOST_CHECK(boost::filesystem::exists(target / "other.gz.tmp"));
+}
@@ -0,0 +1,148 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   src_channel_logger.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header contains tests for the channel loggers and the lock-free mutable constants.
+ */
+
+#define BOOST_TEST_MODULE src_channel_logger
+
+#include <string>
+#include <boost/test/included/unit_test.hpp>
+#include <boost/log/core/record.hpp>
+#include <boost/log/attributes/mutable_constant.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
+#include <boost/log/sources/channel_logger.hpp>
+#include <boost/log/keywords/channel.hpp>
+
+#if !defined(BOOST_LOG_NO_THREADS)
+#include <boost/bind.hpp>
+#include <boost/atomic/atomic.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/barrier.hpp>
+#endif
+
+namespace logging = boost::log;
+namespace attrs = logging::attributes;
+namespace src = logging::sources;
+namespace keywords = logging::keywords;
+
+namespace {
+
+    std::string get_channel(logging::record const& rec)
+    {
+        return logging::extract_or_default< std::string >("Channel", rec.attribute_values(), std::string());
+    }
+
+} // namespace
+
+// The test checks that the lock-free mutable constant stores and returns values
+BOOST_AUTO_TEST_CASE(lock_free_mutable_constant)
+{
+    attrs::mutable_constant< int, attrs::lock_free_update > attr(10);
+    logging::attribute_value value = attr.get_value();
+    BOOST_CHECK_EQUAL(attr.get(), 10);
+
+    attr.set(20);
+    BOOST_CHECK_EQUAL(attr.get(), 20);
+    BOOST_CHECK_EQUAL(logging::extract_or_default< int >(attr.get_value(), 0), 20);
+
+    // The previously acquired values are not affected
+    BOOST_CHECK_EQUAL(logging::extract_or_default< int >(value, 0), 10);
+}
+
+// The test checks that the channel name specified in the logging statement is persistent
+BOOST_AUTO_TEST_CASE(channel_logger)
+{
+    src::channel_logger< > lg(keywords::channel = "Default");
+
+    logging::record rec = lg.open_record();
+    BOOST_REQUIRE(!!rec);
+    BOOST_CHECK_EQUAL(get_channel(rec), "Default");
+
+    rec = lg.open_record(keywords::channel = std::string("Net"));
+    BOOST_REQUIRE(!!rec);
+    BOOST_CHECK_EQUAL(get_channel(rec), "Net");
+    BOOST_CHECK_EQUAL(lg.channel(), "Net");
+
+    lg.channel("Disk");
+    rec = lg.open_record();
+    BOOST_REQUIRE(!!rec);
+    BOOST_CHECK_EQUAL(get_channel(rec), "Disk");
+}
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+// The test checks that the channel name specified in the logging statement is only stored in the logger if it differs from the current one
+BOOST_AUTO_TEST_CASE(channel_logger_mt_store)
+{
+    src::channel_logger_mt< > lg(keywords::channel = "Default");
+
+    logging::record rec1 = lg.open_record();
+    BOOST_REQUIRE(!!rec1);
+    logging::value_ref< std::string > ch1 = logging::extract< std::string >("Channel", rec1.attribute_values());
+    BOOST_REQUIRE(!!ch1);
+
+    // The records share the stored channel name
+    logging::record rec2 = lg.open_record(keywords::channel = std::string("Default"));
+    BOOST_REQUIRE(!!rec2);
+    logging::value_ref< std::string > ch2 = logging::extract< std::string >("Channel", rec2.attribute_values());
+    BOOST_REQUIRE(!!ch2);
+    BOOST_CHECK(&ch1.get() == &ch2.get());
+
+    logging::record rec3 = lg.open_record(keywords::channel = std::string("Net"));
+    BOOST_REQUIRE(!!rec3);
+    logging::value_ref< std::string > ch3 = logging::extract< std::string >("Channel", rec3.attribute_values());
+    BOOST_REQUIRE(!!ch3);
+    BOOST_CHECK(&ch1.get() != &ch3.get());
+    BOOST_CHECK_EQUAL(ch3.get(), "Net");
+    BOOST_CHECK_EQUAL(lg.channel(), "Net");
+    BOOST_CHECK_EQUAL(ch1.get(), "Default");
+}
+
+namespace {
+
+    enum { thread_count = 4, record_count = 2000 };
+
+    //! Opens records with the channel name specific to the thread and counts records with unexpected channel names
+    void open_records(src::channel_logger_mt< >& lg, boost::barrier& bar, unsigned int index, boost::atomic< unsigned int >& errors)
+    {
+        const std::string channel = std::string("Thread") + static_cast< char >('0' + index);
+        bar.wait();
+        for (unsigned int i = 0; i < record_count; ++i)
+        {
+            logging::record rec = lg.open_record(keywords::channel = std::string(channel));
+            if (!rec || get_channel(rec) != channel)
+                errors.fetch_add(1u, boost::memory_order_relaxed);
+        }
+    }
+
+} // namespace
+
+// The test checks that the records opened concurrently with different channel names get their own channel names
+BOOST_AUTO_TEST_CASE(channel_logger_mt)
+{
+    src::channel_logger_mt< > lg(keywords::channel = "Default");
+    boost::barrier bar(thread_count);
+    boost::atomic< unsigned int > errors(0u);
+
+    boost::thread_group threads;
+    for (unsigned int i = 0; i < thread_count; ++i)
+        threads.create_thread(boost::bind(&open_records, boost::ref(lg), boost::ref(bar), i, boost::ref(errors)));
+    threads.join_all();
+
+    BOOST_CHECK_EQUAL(errors.load(), 0u);
+
+    // The channel name of the logger is the one set last
+    const std::string channel = lg.channel();
+    BOOST_CHECK(channel.size() == 7u && channel.compare(0, 6, "Thread") == 0);
+}
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
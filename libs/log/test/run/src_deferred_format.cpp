@@ -0,0 +1,173 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   src_deferred_format.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header contains tests for the deferred message formatting.
+ */
+
+#define BOOST_TEST_MODULE src_deferred_format
+
+#include <string>
+#include <ostream>
+#include <boost/test/included/unit_test.hpp>
+#include <boost/move/utility.hpp>
+#include <boost/log/core/core.hpp>
+#include <boost/log/core/record.hpp>
+#include <boost/log/core/record_view.hpp>
+#include <boost/log/attributes/attribute_set.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
+#include <boost/log/expressions/message.hpp>
+#include <boost/log/sources/deferred_format.hpp>
+#if !defined(BOOST_LOG_NO_THREADS)
+#include <vector>
+#include <boost/smart_ptr/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/log/sources/logger.hpp>
+#include <boost/log/sinks/async_frontend.hpp>
+#include <boost/log/sinks/basic_sink_backend.hpp>
+#include <boost/log/expressions.hpp>
+#endif
+
+namespace logging = boost::log;
+namespace expr = logging::expressions;
+
+namespace {
+
+    //! A logger that saves the pushed record
+    struct test_logger
+    {
+        typedef char char_type;
+
+        logging::attribute_set m_Attributes;
+        logging::record_view m_Record;
+
+        logging::record open_record()
+        {
+            return logging::core::get()->open_record(m_Attributes);
+        }
+
+        void push_record(BOOST_RV_REF(logging::record) rec)
+        {
+            m_Record = rec.lock();
+        }
+
+        std::string message() const
+        {
+            return logging::extract_or_default< std::string >(expr::smessage.get_name(), m_Record.attribute_values(), std::string());
+        }
+    };
+
+} // namespace
+
+// The test checks that the arguments are formatted into the message
+BOOST_AUTO_TEST_CASE(argument_formatting)
+{
+    test_logger lg;
+
+    BOOST_LOG_DEFERRED_FORMAT(lg, "int: %1%, double: %2%, char: %3%") % 10 % 5.5 % 'x';
+    BOOST_CHECK_EQUAL(lg.message(), "int: 10, double: 5.5, char: x");
+
+    // Placeholders may be reordered and repeated, placeholders without arguments produce no output
+    BOOST_LOG_FMT(lg, "%2% %1% %2% [%3%]") % 1 % 2;
+    BOOST_CHECK_EQUAL(lg.message(), "2 1 2 []");
+
+    // Format strings without placeholders
+    BOOST_LOG_FMT(lg, "Hello, world!");
+    BOOST_CHECK_EQUAL(lg.message(), "Hello, world!");
+}
+
+// The test checks that strings are captured by value
+BOOST_AUTO_TEST_CASE(string_capturing)
+{
+    test_logger lg;
+
+    std::string str = "abc";
+    char buf[] = "def";
+    {
+        logging::record rec = lg.open_record();
+        BOOST_REQUIRE(!!rec);
+        logging::aux::make_deferred_record_pump(lg, rec, "%1% %2% %3%") % str % buf % "ghi";
+        str = "xyz";
+        buf[0] = 'x';
+    }
+    BOOST_CHECK_EQUAL(lg.message(), "abc def ghi");
+}
+
+// The test checks that many arguments can be captured
+BOOST_AUTO_TEST_CASE(many_arguments)
+{
+    test_logger lg;
+
+    std::string long_str(500, 'a');
+    BOOST_LOG_FMT(lg, "%1%%2%%3%%4%%5%%6%%7%%8%%9%%10%%11%%12%")
+        % 1 % 2 % 3 % 4 % 5 % 6 % 7 % 8 % 9 % long_str % 11u % 12L;
+    BOOST_CHECK_EQUAL(lg.message(), "123456789" + long_str + "1112");
+}
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+namespace {
+
+    //! The thread that has output the marker
+    boost::thread::id g_OutputThread;
+
+    //! The argument saves the thread that outputs it
+    struct thread_marker
+    {
+        int m_Value;
+    };
+
+    inline std::ostream& operator<< (std::ostream& strm, thread_marker const& marker)
+    {
+        g_OutputThread = boost::this_thread::get_id();
+        strm << marker.m_Value;
+        return strm;
+    }
+
+    //! The backend stores formatted records
+    class collecting_backend :
+        public logging::sinks::basic_formatted_sink_backend< char, logging::sinks::synchronized_feeding >
+    {
+    public:
+        std::vector< std::string > m_Records;
+
+        void consume(logging::record_view const&, string_type const& formatted_message)
+        {
+            m_Records.push_back(formatted_message);
+        }
+    };
+
+} // namespace
+
+// The test checks that the message is composed in the feeding thread of an asynchronous sink rather than in the logging thread
+BOOST_AUTO_TEST_CASE(async_composition)
+{
+    typedef logging::sinks::asynchronous_sink< collecting_backend > sink_t;
+
+    boost::shared_ptr< sink_t > sink = boost::make_shared< sink_t >();
+    sink->set_formatter(expr::stream << expr::smessage);
+    logging::core::get()->add_sink(sink);
+
+    logging::sources::logger lg;
+    thread_marker marker = { 7 };
+    BOOST_LOG_FMT(lg, "marker: %1%") % marker;
+    sink->flush();
+
+    logging::core::get()->remove_sink(sink);
+    sink->stop();
+
+    BOOST_REQUIRE_EQUAL(sink->locked_backend()->m_Records.size(), 1u);
+    BOOST_CHECK_EQUAL(sink->locked_backend()->m_Records[0], "marker: 7");
+    BOOST_CHECK(g_OutputThread != boost::thread::id());
+    BOOST_CHECK(g_OutputThread != boost::this_thread::get_id());
+}
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
@@ -0,0 +1,124 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   src_global_logger.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header contains tests for the global logger storage.
+ */
+
+#define BOOST_TEST_MODULE src_global_logger
+
+// Test the eager initialization mode
+#define BOOST_LOG_EAGER_GLOBAL_LOGGERS
+
+#include <cstddef>
+#include <boost/test/included/unit_test.hpp>
+#include <boost/log/sources/logger.hpp>
+#include <boost/log/sources/global_logger_storage.hpp>
+#ifndef BOOST_LOG_NO_THREADS
+#include <boost/bind.hpp>
+#include <boost/ref.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/barrier.hpp>
+#endif // BOOST_LOG_NO_THREADS
+
+namespace logging = boost::log;
+namespace src = logging::sources;
+
+namespace {
+
+    unsigned int g_InitCount1 = 0;
+    unsigned int g_InitCount2 = 0;
+
+} // namespace
+
+BOOST_LOG_INLINE_GLOBAL_LOGGER_INIT(my_logger1, src::logger_mt)
+{
+    ++g_InitCount1;
+    return src::logger_mt();
+}
+
+BOOST_LOG_INLINE_GLOBAL_LOGGER_INIT(my_logger2, src::logger_mt)
+{
+    ++g_InitCount2;
+    return src::logger_mt();
+}
+
+// The test checks that global loggers are initialized on namespace scope initialization stage in eager mode
+BOOST_AUTO_TEST_CASE(eager_initialization)
+{
+    BOOST_CHECK_EQUAL(g_InitCount1, 1u);
+    BOOST_CHECK_EQUAL(g_InitCount2, 1u);
+}
+
+// The test checks that the logger instances are unique
+BOOST_AUTO_TEST_CASE(unique_instances)
+{
+    src::logger_mt& lg1 = my_logger1::get();
+    src::logger_mt& lg2 = my_logger2::get();
+    BOOST_CHECK(&lg1 != &lg2);
+    BOOST_CHECK_EQUAL(&lg1, &my_logger1::get());
+    BOOST_CHECK_EQUAL(&lg2, &my_logger2::get());
+
+    // Look up the repository directly
+    boost::shared_ptr< src::aux::logger_holder_base > holder1 = src::aux::global_storage::get_or_init(
+        typeid(boost::log::aux::visible_type< my_logger1 >), NULL);
+    BOOST_REQUIRE(!!holder1);
+    BOOST_CHECK_EQUAL(&static_cast< src::aux::logger_holder< src::logger_mt >& >(*holder1).m_Logger, &lg1);
+    BOOST_CHECK_EQUAL(g_InitCount1, 1u);
+    BOOST_CHECK_EQUAL(g_InitCount2, 1u);
+}
+
+#ifndef BOOST_LOG_NO_THREADS
+
+namespace {
+
+    struct my_tag_base
+    {
+        typedef src::logger_mt logger_type;
+        enum registration_line_t { registration_line = __LINE__ };
+        static const char* registration_file() { return __FILE__; }
+        static logger_type construct_logger() { return logger_type(); }
+    };
+
+    template< unsigned int N >
+    struct my_tag : public my_tag_base {};
+
+    void acquire_loggers(boost::barrier& bar, src::logger_mt* (&results)[4])
+    {
+        bar.wait();
+        results[0] = &src::aux::logger_singleton< my_tag< 0 > >::get();
+        results[1] = &src::aux::logger_singleton< my_tag< 1 > >::get();
+        results[2] = &src::aux::logger_singleton< my_tag< 2 > >::get();
+        results[3] = &src::aux::logger_singleton< my_tag< 3 > >::get();
+    }
+
+} // namespace
+
+// The test checks that loggers are initialized only once when requested from multiple threads
+BOOST_AUTO_TEST_CASE(concurrent_initialization)
+{
+    enum { thread_count = 4 };
+    boost::barrier bar(thread_count);
+    src::logger_mt* results[thread_count][4] = {};
+
+    boost::thread_group threads;
+    for (unsigned int i = 0; i < thread_count; ++i)
+        threads.create_thread(boost::bind(&acquire_loggers, boost::ref(bar), boost::ref(results[i])));
+    threads.join_all();
+
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+        BOOST_CHECK(results[0][i] != NULL);
+        for (unsigned int j = 1; j < thread_count; ++j)
+            BOOST_CHECK_EQUAL(results[0][i], results[j][i]);
+    }
+}
+
+#endif // BOOST_LOG_NO_THREADS
@@ -0,0 +1,191 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   src_lock_free_logger.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header contains tests for the loggers with the lock-free threading model.
+ */
+
+#define BOOST_TEST_MODULE src_lock_free_logger
+
+#include <string>
+#include <boost/test/included/unit_test.hpp>
+#include <boost/log/core/record.hpp>
+#include <boost/log/attributes/constant.hpp>
+#include <boost/log/attributes/attribute_set.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
+#include <boost/log/sources/basic_logger.hpp>
+#include <boost/log/sources/features.hpp>
+#include <boost/log/sources/severity_feature.hpp>
+#include <boost/log/sources/channel_feature.hpp>
+#include <boost/log/sources/severity_logger.hpp>
+#include <boost/log/sources/threading_models.hpp>
+#include <boost/log/keywords/channel.hpp>
+#include <boost/log/keywords/severity.hpp>
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+#include <boost/bind.hpp>
+#include <boost/atomic/atomic.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/barrier.hpp>
+#include <boost/log/detail/light_rw_mutex.hpp>
+
+namespace logging = boost::log;
+namespace attrs = logging::attributes;
+namespace src = logging::sources;
+namespace keywords = logging::keywords;
+
+namespace {
+
+    //! A severity and channel logger with the lock-free threading model
+    class lock_free_logger :
+        public src::basic_composite_logger<
+            char,
+            lock_free_logger,
+            src::lock_free_thread_model< logging::aux::light_rw_mutex >,
+            src::features<
+                src::severity< int >,
+                src::channel< std::string >
+            >
+        >
+    {
+        BOOST_LOG_FORWARD_LOGGER_MEMBERS(lock_free_logger)
+    };
+
+    int get_severity(logging::record const& rec)
+    {
+        return logging::extract_or_default< int >("Severity", rec.attribute_values(), -1);
+    }
+
+    std::string get_channel(logging::record const& rec)
+    {
+        return logging::extract_or_default< std::string >("Channel", rec.attribute_values(), std::string());
+    }
+
+} // namespace
+
+// The test checks that the severity level and channel name are attached to the records
+BOOST_AUTO_TEST_CASE(severity_and_channel)
+{
+    lock_free_logger lg((keywords::severity = 2, keywords::channel = "Default"));
+
+    logging::record rec = lg.open_record();
+    BOOST_REQUIRE(!!rec);
+    BOOST_CHECK_EQUAL(get_severity(rec), 2);
+    BOOST_CHECK_EQUAL(get_channel(rec), "Default");
+
+    rec = lg.open_record(keywords::severity = 5);
+    BOOST_REQUIRE(!!rec);
+    BOOST_CHECK_EQUAL(get_severity(rec), 5);
+    BOOST_CHECK_EQUAL(get_channel(rec), "Default");
+
+    // Levels that are not cached
+    rec = lg.open_record(keywords::severity = 1000);
+    BOOST_REQUIRE(!!rec);
+    BOOST_CHECK_EQUAL(get_severity(rec), 1000);
+
+    rec = lg.open_record((keywords::severity = 3, keywords::channel = std::string("Net")));
+    BOOST_REQUIRE(!!rec);
+    BOOST_CHECK_EQUAL(get_severity(rec), 3);
+    BOOST_CHECK_EQUAL(get_channel(rec), "Net");
+
+    // Copies of the logger have the same attributes
+    lock_free_logger copy(lg);
+    rec = copy.open_record(keywords::severity = 4);
+    BOOST_REQUIRE(!!rec);
+    BOOST_CHECK_EQUAL(get_severity(rec), 4);
+    BOOST_CHECK_EQUAL(get_channel(rec), "Net");
+}
+
+// The test checks that attribute modifications are visible in the records opened afterwards
+BOOST_AUTO_TEST_CASE(attribute_modification)
+{
+    src::severity_logger_mt< int > locking_lg;
+    lock_free_logger lg;
+
+    std::pair< logging::attribute_set::iterator, bool > res = lg.add_attribute("MyAttr", attrs::constant< int >(10));
+    BOOST_REQUIRE(res.second);
+
+    logging::record rec = lg.open_record();
+    BOOST_REQUIRE(!!rec);
+    BOOST_CHECK_EQUAL(logging::extract_or_default< int >("MyAttr", rec.attribute_values(), 0), 10);
+    BOOST_CHECK(lg.get_attributes().find("MyAttr") != lg.get_attributes().end());
+
+    lg.remove_attribute(res.first);
+    rec = lg.open_record();
+    BOOST_REQUIRE(!!rec);
+    BOOST_CHECK(rec.attribute_values().find("MyAttr") == rec.attribute_values().end());
+
+    // The severity level of a record is not affected by the logger attributes
+    lg.add_attribute("Severity", attrs::constant< int >(100));
+    rec = lg.open_record(keywords::severity = 1);
+    BOOST_REQUIRE(!!rec);
+    BOOST_CHECK_EQUAL(get_severity(rec), 1);
+
+    // Loggers with locking threading models still register the severity attribute
+    BOOST_CHECK(locking_lg.get_attributes().find("Severity") != locking_lg.get_attributes().end());
+    rec = locking_lg.open_record(keywords::severity = 7);
+    BOOST_REQUIRE(!!rec);
+    BOOST_CHECK_EQUAL(get_severity(rec), 7);
+}
+
+namespace {
+
+    enum { thread_count = 4, record_count = 2000 };
+
+    //! Opens records with the severity level specific to the thread and counts records with unexpected severity levels
+    void open_records(lock_free_logger& lg, boost::barrier& bar, int index, boost::atomic< unsigned int >& errors)
+    {
+        bar.wait();
+        for (unsigned int i = 0; i < record_count; ++i)
+        {
+            logging::record rec = lg.open_record(keywords::severity = index);
+            if (!rec || get_severity(rec) != index)
+                errors.fetch_add(1u, boost::memory_order_relaxed);
+        }
+    }
+
+    //! Modifies the logger attributes concurrently with opening records
+    void modify_attributes(lock_free_logger& lg, boost::barrier& bar)
+    {
+        bar.wait();
+        for (unsigned int i = 0; i < record_count / 10; ++i)
+        {
+            std::pair< logging::attribute_set::iterator, bool > res = lg.add_attribute("MyAttr", attrs::constant< unsigned int >(i));
+            lg.remove_attribute(res.first);
+        }
+    }
+
+} // namespace
+
+// The test checks that records opened concurrently get their own severity levels
+BOOST_AUTO_TEST_CASE(concurrent_records)
+{
+    lock_free_logger lg;
+    boost::barrier bar(thread_count + 1);
+    boost::atomic< unsigned int > errors(0u);
+
+    boost::thread_group threads;
+    for (int i = 0; i < thread_count; ++i)
+        threads.create_thread(boost::bind(&open_records, boost::ref(lg), boost::ref(bar), i, boost::ref(errors)));
+    threads.create_thread(boost::bind(&modify_attributes, boost::ref(lg), boost::ref(bar)));
+    threads.join_all();
+
+    BOOST_CHECK_EQUAL(errors.load(), 0u);
+}
+
+#else // !defined(BOOST_LOG_NO_THREADS)
+
+BOOST_AUTO_TEST_CASE(lock_free_logger)
+{
+    // The lock-free threading model is not available in single-threaded builds
+}
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
@@ -0,0 +1,70 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   src_logger_attributes.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header contains tests for the attribute management of loggers.
+ */
+
+#define BOOST_TEST_MODULE src_logger_attributes
+
+#include <boost/test/included/unit_test.hpp>
+#include <boost/log/attributes/constant.hpp>
+#include <boost/log/attributes/attribute_set.hpp>
+#include <boost/log/sources/logger.hpp>
+#include <boost/log/sources/severity_logger.hpp>
+
+namespace logging = boost::log;
+namespace attrs = logging::attributes;
+namespace src = logging::sources;
+
+namespace {
+
+    //! Checks that the logger attributes can be acquired and replaced through the logger interface
+    template< typename LoggerT >
+    void check_attributes(LoggerT& lg)
+    {
+        lg.add_attribute("MyAttr", attrs::constant< int >(10));
+
+        // The method is available through a const reference to the logger
+        LoggerT const& const_lg = lg;
+        logging::attribute_set attrs = const_lg.get_attributes();
+        BOOST_CHECK(attrs.find("MyAttr") != attrs.end());
+
+        attrs.erase("MyAttr");
+        lg.set_attributes(attrs);
+        attrs = const_lg.get_attributes();
+        BOOST_CHECK(attrs.find("MyAttr") == attrs.end());
+    }
+
+} // namespace
+
+// The test checks that the attributes of single-threaded loggers can be acquired and replaced
+BOOST_AUTO_TEST_CASE(single_threaded_loggers)
+{
+    src::logger lg;
+    check_attributes(lg);
+
+    src::severity_logger< int > severity_lg;
+    check_attributes(severity_lg);
+}
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+// The test checks that the attributes of thread-safe loggers can be acquired and replaced
+BOOST_AUTO_TEST_CASE(thread_safe_loggers)
+{
+    src::logger_mt lg;
+    check_attributes(lg);
+
+    src::severity_logger_mt< int > severity_lg;
+    check_attributes(severity_lg);
+}
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
@@ -0,0 +1,111 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   util_atomic_intrusive_ptr.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header contains tests for the atomic reference-counted pointer.
+ */
+
+#define BOOST_TEST_MODULE util_atomic_intrusive_ptr
+
+#include <boost/test/included/unit_test.hpp>
+#include <boost/log/detail/config.hpp>
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+#include <boost/intrusive_ptr.hpp>
+#include <boost/log/detail/atomic_intrusive_ptr.hpp>
+
+namespace logging = boost::log;
+
+namespace {
+
+    //! The number of existing objects
+    unsigned int g_LiveCount = 0u;
+
+    //! Reference-counted object
+    struct object
+    {
+        unsigned int m_RefCount;
+        int m_Value;
+
+        explicit object(int value) : m_RefCount(0u), m_Value(value) { ++g_LiveCount; }
+        ~object() { --g_LiveCount; }
+
+        friend void intrusive_ptr_add_ref(object* p) { ++p->m_RefCount; }
+        friend void intrusive_ptr_release(object* p)
+        {
+            if (--p->m_RefCount == 0u)
+                delete p;
+        }
+    };
+
+    typedef logging::aux::atomic_intrusive_ptr< object > object_ptr;
+
+} // namespace
+
+// The test checks that the pointer stores and returns objects
+BOOST_AUTO_TEST_CASE(load_and_store)
+{
+    {
+        object_ptr ptr(new object(1));
+        boost::intrusive_ptr< object > p = ptr.load();
+        BOOST_REQUIRE(!!p);
+        BOOST_CHECK_EQUAL(p->m_Value, 1);
+
+        ptr.store(new object(2));
+        BOOST_CHECK_EQUAL(ptr.load()->m_Value, 2);
+
+        // The previously loaded object is not affected
+        BOOST_CHECK_EQUAL(p->m_Value, 1);
+        p.reset();
+        BOOST_CHECK_EQUAL(g_LiveCount, 1u);
+
+        ptr.store(boost::intrusive_ptr< object >());
+        BOOST_CHECK(!ptr.load());
+    }
+    BOOST_CHECK_EQUAL(g_LiveCount, 0u);
+}
+
+// The test checks that the replaced objects are released unless they are being read
+BOOST_AUTO_TEST_CASE(reclamation)
+{
+    {
+        object_ptr ptr(new object(0));
+        {
+            object_ptr::read_guard outer(ptr);
+            BOOST_CHECK_EQUAL(outer->m_Value, 0);
+            for (int i = 1; i <= 10; ++i)
+            {
+                ptr.store(new object(i));
+
+                // Nested reads are protected as well
+                object_ptr::read_guard inner(ptr);
+                BOOST_CHECK_EQUAL(inner->m_Value, i);
+            }
+
+            // Only the object being read by the outer guard is retired
+            BOOST_CHECK_EQUAL(outer->m_Value, 0);
+            BOOST_CHECK_EQUAL(g_LiveCount, 2u);
+        }
+
+        ptr.store(new object(11));
+        BOOST_CHECK_EQUAL(g_LiveCount, 1u);
+    }
+    BOOST_CHECK_EQUAL(g_LiveCount, 0u);
+}
+
+#else // !defined(BOOST_LOG_NO_THREADS)
+
+BOOST_AUTO_TEST_CASE(atomic_intrusive_ptr)
+{
+    // The atomic pointer is not available in single-threaded builds
+}
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
@@ -102,6 +102,46 @@ namespace {
         std::string m_String;
     };
 
+    // A family of distinct types
+    template< unsigned int N >
+    struct tag {};
+
+    // The visitor remembers the last dispatched tag
+    struct tag_visitor
+    {
+        unsigned int* m_pLast;
+
+        explicit tag_visitor(unsigned int& last) : m_pLast(&last) {}
+
+        template< unsigned int N >
+        void operator() (tag< N > const&) const
+        {
+            *m_pLast = N;
+        }
+    };
+
+    // The function registers the tag in the dispatcher
+    template< unsigned int N >
+    void register_tag(logging::dynamic_type_dispatcher& disp, unsigned int& last)
+    {
+        disp.register_type< tag< N > >(tag_visitor(last));
+    }
+
+    // The function checks that the tag is dispatched to the visitor
+    template< unsigned int N >
+    bool dispatch_tag(logging::type_dispatcher& disp, unsigned int& last)
+    {
+        last = ~0u;
+        logging::type_dispatcher::callback< tag< N > > callback = disp.get_callback< tag< N > >();
+        if (callback)
+        {
+            callback(tag< N >());
+            return last == N;
+        }
+        else
+            return false;
+    }
+
 } // namespace
 
 // The test checks that general functionality works
@@ -136,3 +176,36 @@ BOOST_AUTO_TEST_CASE(type_dispatch)
     vis.set_expected();
     BOOST_CHECK(!val3.dispatch(disp));
 }
+
+// The test checks that dispatching works with a larger number of types
+BOOST_AUTO_TEST_CASE(type_dispatch_many_types)
+{
+    unsigned int last = 0;
+    logging::dynamic_type_dispatcher disp;
+
+    register_tag< 0 >(disp, last);
+    register_tag< 1 >(disp, last);
+    register_tag< 2 >(disp, last);
+    register_tag< 3 >(disp, last);
+    register_tag< 4 >(disp, last);
+    register_tag< 5 >(disp, last);
+    register_tag< 6 >(disp, last);
+    register_tag< 7 >(disp, last);
+    register_tag< 8 >(disp, last);
+    register_tag< 9 >(disp, last);
+    BOOST_CHECK(disp.registered_types_count() == 10);
+
+    // Registering the same type again replaces the visitor
+    register_tag< 5 >(disp, last);
+    BOOST_CHECK(disp.registered_types_count() == 10);
+
+    BOOST_CHECK(dispatch_tag< 0 >(disp, last));
+    BOOST_CHECK(dispatch_tag< 5 >(disp, last));
+    BOOST_CHECK(dispatch_tag< 9 >(disp, last));
+    BOOST_CHECK(!dispatch_tag< 10 >(disp, last));
+
+    // The copy of the dispatcher supports the same types
+    logging::dynamic_type_dispatcher disp_copy(disp);
+    BOOST_CHECK(dispatch_tag< 4 >(disp_copy, last));
+    BOOST_CHECK(!dispatch_tag< 10 >(disp_copy, last));
+}
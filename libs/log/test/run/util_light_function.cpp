@@ -0,0 +1,121 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   util_light_function.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header contains tests for the light function wrapper.
+ */
+
+#define BOOST_TEST_MODULE util_light_function
+
+#include <string>
+#include <cstddef>
+#include <boost/move/utility.hpp>
+#include <boost/test/included/unit_test.hpp>
+#include <boost/log/detail/light_function.hpp>
+
+namespace logging = boost::log;
+
+namespace {
+
+    int add_one(int x)
+    {
+        return x + 1;
+    }
+
+    // A function object that fits into the internal buffer
+    struct small_fun
+    {
+        int m_Value;
+
+        explicit small_fun(int value) : m_Value(value) {}
+        int operator() (int x) const { return x + m_Value; }
+    };
+
+    // A function object that does not fit into the internal buffer
+    struct large_fun
+    {
+        int m_Values[32];
+
+        explicit large_fun(int value) { m_Values[0] = value; }
+        int operator() (int x) const { return x + m_Values[0]; }
+    };
+
+    // A function object that tracks the number of its instances
+    struct counting_fun
+    {
+        static int instances;
+
+        counting_fun() { ++instances; }
+        counting_fun(counting_fun const&) { ++instances; }
+        ~counting_fun() { --instances; }
+        void operator() () const {}
+    };
+
+    int counting_fun::instances = 0;
+
+} // namespace
+
+// The test checks that the function can be constructed, copied, moved and called
+BOOST_AUTO_TEST_CASE(construction_and_invocation)
+{
+    typedef logging::aux::light_function< int (int) > function_type;
+
+    function_type empty;
+    BOOST_CHECK(!empty);
+    BOOST_CHECK(empty.empty());
+
+    function_type f1 = &add_one;
+    BOOST_CHECK_EQUAL(f1(1), 2);
+
+    function_type f2 = small_fun(10);
+    BOOST_CHECK_EQUAL(f2(1), 11);
+
+    function_type f3 = large_fun(100);
+    BOOST_CHECK_EQUAL(f3(1), 101);
+
+    function_type f4(f3);
+    BOOST_CHECK_EQUAL(f4(2), 102);
+    BOOST_CHECK_EQUAL(f3(2), 102);
+
+    f4 = f2;
+    BOOST_CHECK_EQUAL(f4(2), 12);
+
+    function_type f5(boost::move(f2));
+    BOOST_CHECK_EQUAL(f5(3), 13);
+    BOOST_CHECK(f2.empty());
+
+    f5.swap(f3);
+    BOOST_CHECK_EQUAL(f5(3), 103);
+    BOOST_CHECK_EQUAL(f3(3), 13);
+
+    f5.clear();
+    BOOST_CHECK(f5.empty());
+}
+
+// The test checks that the stored function objects are properly destroyed
+BOOST_AUTO_TEST_CASE(object_lifetime)
+{
+    typedef logging::aux::light_function< void () > function_type;
+
+    {
+        function_type f1 = counting_fun();
+        function_type f2 = f1;
+        function_type f3(f1);
+        BOOST_CHECK_EQUAL(counting_fun::instances, 3);
+
+        f3.swap(f2);
+        f2 = boost::move(f3);
+        BOOST_CHECK_EQUAL(counting_fun::instances, 2);
+
+        f1();
+        f2();
+    }
+    BOOST_CHECK_EQUAL(counting_fun::instances, 0);
+}
@@ -0,0 +1,96 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   util_lockable_traits.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header contains tests for the traits that detect the locking capabilities of mutexes.
+ */
+
+#define BOOST_TEST_MODULE util_lockable_traits
+
+#include <boost/test/included/unit_test.hpp>
+#include <boost/log/detail/config.hpp>
+#include <boost/log/detail/locks.hpp>
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+#include <boost/log/detail/spin_mutex.hpp>
+#include <boost/log/detail/light_rw_mutex.hpp>
+
+namespace logging = boost::log;
+
+namespace {
+
+    //! A type that has no locking members
+    struct not_lockable
+    {
+    };
+
+    //! A type that has locking members with unexpected signatures
+    struct wrong_signature
+    {
+        bool lock(int);
+        void unlock(int);
+        bool lock_shared(int);
+        void unlock_shared(int);
+    };
+
+    //! A mutex that only supports exclusive locking
+    struct exclusive_mutex
+    {
+        void lock() {}
+        void unlock() {}
+    };
+
+    //! A mutex that supports shared locking
+    struct shared_mutex
+    {
+        void lock() {}
+        void unlock() {}
+        void lock_shared() {}
+        void unlock_shared() {}
+    };
+
+} // namespace
+
+// The test checks that mutexes are detected as exclusively lockable
+BOOST_AUTO_TEST_CASE(exclusively_lockable)
+{
+    BOOST_CHECK(!!logging::aux::is_exclusively_lockable< exclusive_mutex >::value);
+    BOOST_CHECK(!!logging::aux::is_exclusively_lockable< shared_mutex >::value);
+    BOOST_CHECK(!!logging::aux::is_exclusively_lockable< logging::aux::spin_mutex >::value);
+    BOOST_CHECK(!!logging::aux::is_exclusively_lockable< logging::aux::light_rw_mutex >::value);
+
+    // Types without the locking members are not lockable and do not cause compilation errors
+    BOOST_CHECK(!logging::aux::is_exclusively_lockable< not_lockable >::value);
+    BOOST_CHECK(!logging::aux::is_exclusively_lockable< wrong_signature >::value);
+    BOOST_CHECK(!logging::aux::is_exclusively_lockable< int >::value);
+}
+
+// The test checks that only mutexes with shared locking members are detected as shared lockable
+BOOST_AUTO_TEST_CASE(shared_lockable)
+{
+    BOOST_CHECK(!!logging::aux::is_shared_lockable< shared_mutex >::value);
+    BOOST_CHECK(!!logging::aux::is_shared_lockable< logging::aux::light_rw_mutex >::value);
+
+    BOOST_CHECK(!logging::aux::is_shared_lockable< exclusive_mutex >::value);
+    BOOST_CHECK(!logging::aux::is_shared_lockable< logging::aux::spin_mutex >::value);
+    BOOST_CHECK(!logging::aux::is_shared_lockable< not_lockable >::value);
+    BOOST_CHECK(!logging::aux::is_shared_lockable< wrong_signature >::value);
+    BOOST_CHECK(!logging::aux::is_shared_lockable< int >::value);
+}
+
+#else // !defined(BOOST_LOG_NO_THREADS)
+
+BOOST_AUTO_TEST_CASE(lockable_traits)
+{
+    // The traits are not available in single-threaded builds
+}
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
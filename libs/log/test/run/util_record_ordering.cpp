@@ -0,0 +1,167 @@
+/*
+ *          Copyright Andrey Semashev 2007 - 2013.
+ * Distributed under the Boost Software License, Version 1.0.
+ *    (See accompanying file LICENSE_1_0.txt or copy at
+ *          http://www.boost.org/LICENSE_1_0.txt)
+ */
+/*!
+ * \file   util_record_ordering.cpp
+ * \author Andrey Semashev
+ * \date   16.10.2026
+ *
+ * \brief  This header contains tests for the record ordering predicates and ordering queues.
+ */
+
+#define BOOST_TEST_MODULE util_record_ordering
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <boost/mpl/vector.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/included/unit_test.hpp>
+#include <boost/log/attributes/constant.hpp>
+#include <boost/log/attributes/attribute_set.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
+#include <boost/log/utility/record_ordering.hpp>
+#include <boost/log/detail/ordering_key.hpp>
+#include "make_record.hpp"
+
+#if !defined(BOOST_LOG_NO_THREADS)
+#include <boost/log/sinks/async_frontend.hpp>
+#include <boost/log/sinks/basic_sink_backend.hpp>
+#include <boost/log/sinks/unbounded_ordering_queue.hpp>
+#include <boost/log/sinks/bounded_ordering_queue.hpp>
+#include <boost/log/sinks/block_on_overflow.hpp>
+#endif
+
+namespace logging = boost::log;
+namespace attrs = logging::attributes;
+namespace sinks = logging::sinks;
+namespace keywords = logging::keywords;
+
+namespace {
+
+    //! Makes a record with the specified sequence number
+    logging::record_view make_seq_record(unsigned int seq)
+    {
+        logging::attribute_set attrs;
+        attrs["Seq"] = attrs::make_constant(seq);
+        return make_record_view(attrs);
+    }
+
+    //! Makes a record without the sequence number
+    logging::record_view make_empty_record()
+    {
+        logging::attribute_set attrs;
+        return make_record_view(attrs);
+    }
+
+} // namespace
+
+// The test checks that ordering keys are only supported for single trivially copyable types
+BOOST_AUTO_TEST_CASE(ordering_key_support)
+{
+    BOOST_CHECK((logging::aux::has_ordering_key< logging::attribute_value_ordering< unsigned int > >::value));
+    BOOST_CHECK((!logging::aux::has_ordering_key< logging::attribute_value_ordering< std::string > >::value));
+    BOOST_CHECK((!logging::aux::has_ordering_key< logging::attribute_value_ordering< boost::mpl::vector< int, unsigned int > > >::value));
+    BOOST_CHECK((!logging::aux::has_ordering_key< logging::abstract_ordering<> >::value));
+}
+
+// The test checks that the ordering keys are ordered the same way as the records
+BOOST_AUTO_TEST_CASE(ordering_key_comparison)
+{
+    typedef logging::attribute_value_ordering< unsigned int > ordering_t;
+    ordering_t order("Seq");
+
+    std::vector< logging::record_view > records;
+    records.push_back(make_seq_record(1u));
+    records.push_back(make_seq_record(2u));
+    records.push_back(make_seq_record(2u));
+    records.push_back(make_empty_record());
+    records.push_back(make_empty_record());
+
+    for (std::size_t i = 0; i < records.size(); ++i)
+    {
+        for (std::size_t j = 0; j < records.size(); ++j)
+        {
+            BOOST_CHECK_EQUAL(order.compare_ordering_keys(order.get_ordering_key(records[i]), order.get_ordering_key(records[j])), order(records[i], records[j]));
+        }
+    }
+}
+
+#if !defined(BOOST_LOG_NO_THREADS)
+
+namespace {
+
+    //! The backend stores sequence numbers of records
+    class collecting_backend :
+        public sinks::basic_sink_backend< sinks::synchronized_feeding >
+    {
+    public:
+        std::vector< unsigned int > m_Records;
+
+        void consume(logging::record_view const& rec)
+        {
+            m_Records.push_back(logging::extract_or_default< unsigned int >("Seq", rec, 0u));
+        }
+    };
+
+    //! Feeds records in a shuffled order through the sink and checks that they come out ordered
+    template< typename SinkT >
+    void check_ordering(SinkT& sink, collecting_backend& backend)
+    {
+        enum { record_count = 200 };
+        for (unsigned int i = 0; i < record_count; ++i)
+            sink.consume(make_seq_record((i * 73u) % record_count));
+
+        sink.flush();
+
+        BOOST_REQUIRE_EQUAL(backend.m_Records.size(), static_cast< std::size_t >(record_count));
+        for (unsigned int i = 0; i < record_count; ++i)
+            BOOST_CHECK_EQUAL(backend.m_Records[i], i);
+    }
+
+} // namespace
+
+// The test checks that the unbounded ordering queue orders records by the precomputed keys
+BOOST_AUTO_TEST_CASE(unbounded_ordering_queue)
+{
+    typedef sinks::asynchronous_sink<
+        collecting_backend,
+        sinks::unbounded_ordering_queue< logging::attribute_value_ordering< unsigned int > >
+    > sink_t;
+
+    boost::shared_ptr< collecting_backend > backend = boost::make_shared< collecting_backend >();
+    sink_t sink(backend, keywords::start_thread = false, keywords::order = logging::attribute_value_ordering< unsigned int >("Seq"));
+    check_ordering(sink, *backend);
+}
+
+// The test checks that the bounded ordering queue orders records by the precomputed keys
+BOOST_AUTO_TEST_CASE(bounded_ordering_queue)
+{
+    typedef sinks::asynchronous_sink<
+        collecting_backend,
+        sinks::bounded_ordering_queue< logging::attribute_value_ordering< unsigned int >, 1000, sinks::block_on_overflow >
+    > sink_t;
+
+    boost::shared_ptr< collecting_backend > backend = boost::make_shared< collecting_backend >();
+    sink_t sink(backend, keywords::start_thread = false, keywords::order = logging::attribute_value_ordering< unsigned int >("Seq"));
+    check_ordering(sink, *backend);
+}
+
+// The test checks that records are still ordered with predicates that do not support precomputed keys
+BOOST_AUTO_TEST_CASE(ordering_without_keys)
+{
+    typedef logging::attribute_value_ordering< boost::mpl::vector< int, unsigned int > > ordering_t;
+    typedef sinks::asynchronous_sink<
+        collecting_backend,
+        sinks::unbounded_ordering_queue< ordering_t >
+    > sink_t;
+
+    boost::shared_ptr< collecting_backend > backend = boost::make_shared< collecting_backend >();
+    sink_t sink(backend, keywords::start_thread = false, keywords::order = ordering_t("Seq"));
+    check_ordering(sink, *backend);
+}
+
+#endif // !defined(BOOST_LOG_NO_THREADS)
@@ -137,6 +137,39 @@ namespace {
         std::string m_String;
     };
 
+    // A family of distinct types
+    template< unsigned int N >
+    struct tag {};
+
+    // The visitor remembers the last dispatched tag
+    struct tag_visitor
+    {
+        unsigned int m_Last;
+
+        tag_visitor() : m_Last(~0u) {}
+
+        template< unsigned int N >
+        void operator() (tag< N > const&)
+        {
+            m_Last = N;
+        }
+    };
+
+    // The function checks that the tag is dispatched to the visitor
+    template< unsigned int N >
+    bool dispatch_tag(logging::type_dispatcher& disp, tag_visitor& vis)
+    {
+        vis.m_Last = ~0u;
+        logging::type_dispatcher::callback< tag< N > > callback = disp.get_callback< tag< N > >();
+        if (callback)
+        {
+            callback(tag< N >());
+            return vis.m_Last == N;
+        }
+        else
+            return false;
+    }
+
 } // namespace
 
 // The test checks that general functionality works
@@ -145,3 +178,21 @@ BOOST_AUTO_TEST_CASE(type_dispatch)
     my_dispatcher disp;
     test_general_functionality(disp);
 }
+
+// The test checks that dispatching works with a larger number of types
+BOOST_AUTO_TEST_CASE(type_dispatch_many_types)
+{
+    typedef boost::mpl::vector<
+        tag< 0 >, tag< 1 >, tag< 2 >, tag< 3 >, tag< 4 >, tag< 5 >,
+        tag< 6 >, tag< 7 >, tag< 8 >, tag< 9 >, tag< 10 >, tag< 11 >
+    > types;
+
+    tag_visitor vis;
+    logging::static_type_dispatcher< types > disp(vis);
+
+    BOOST_CHECK(dispatch_tag< 0 >(disp, vis));
+    BOOST_CHECK(dispatch_tag< 3 >(disp, vis));
+    BOOST_CHECK(dispatch_tag< 7 >(disp, vis));
+    BOOST_CHECK(dispatch_tag< 11 >(disp, vis));
+    BOOST_CHECK(!dispatch_tag< 12 >(disp, vis));
+}